@@ -177,7 +177,6 @@ if(BUILD_CONFIGURE MATCHES "UTEST")
     set(MUE_BUILD_APPSHELL_MODULE OFF)
     set(MUSE_MODULE_AUTOBOT OFF)
     set(MUSE_MODULE_CLOUD OFF)
-    set(MUE_BUILD_CONVERTER_MODULE OFF)
     set(MUE_BUILD_INSPECTOR_MODULE OFF)
     set(MUE_BUILD_INSTRUMENTSSCENE_MODULE OFF)
     set(MUSE_MODULE_LANGUAGES OFF)
@@ -225,6 +224,7 @@ endif()
 if (NOT MUSE_ENABLE_UNIT_TESTS)
 
     set(MUE_BUILD_BRAILLE_TESTS OFF)
+    set(MUE_BUILD_CONVERTER_TESTS OFF)
     set(MUE_BUILD_ENGRAVING_TESTS OFF)
     set(MUE_BUILD_IMPORTEXPORT_TESTS OFF)
     set(MUE_BUILD_NOTATION_TESTS OFF)
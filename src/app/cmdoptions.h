@@ -12,6 +12,7 @@ namespace mu::app {
 enum class ConvertType {
     File,
     Batch,
+    Server,
     ConvertScoreParts,
     ExportScoreMedia,
     ExportScoreMeta,
@@ -38,7 +39,10 @@ struct CmdOptions {
         ScoreTransposeOptions,
         ForceMode,
         SoundProfile,
-        ExtensionUri
+        ExtensionUri,
+
+        // Server
+        ServerSocket
 
         // Video
     };
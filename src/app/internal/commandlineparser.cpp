@@ -86,6 +86,10 @@ void CommandLineParser::init()
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
     m_parser.addOption(QCommandLineOption("extension", "Use extension to process a conversion job", "uri"));
+    m_parser.addOption(QCommandLineOption("convert-server",
+                                          "Run as a conversion server: read conversion jobs (one JSON job array per line) "
+                                          "from stdin or a local socket, and write the results as JSON lines"));
+    m_parser.addOption(QCommandLineOption("convert-server-socket", "Listen on a local socket instead of stdin", "name"));
 
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
@@ -318,6 +322,14 @@ void CommandLineParser::parse(int argc, char** argv)
         m_options.converterTask.inputFile = fromUserInputPath(m_parser.value("j"));
     }
 
+    if (m_parser.isSet("convert-server")) {
+        m_options.runMode = IApplication::RunMode::ConsoleApp;
+        m_options.converterTask.type = ConvertType::Server;
+        if (m_parser.isSet("convert-server-socket")) {
+            m_options.converterTask.params[CmdOptions::ParamKey::ServerSocket] = m_parser.value("convert-server-socket");
+        }
+    }
+
     if (m_parser.isSet("score-media")) {
         m_options.runMode = IApplication::RunMode::ConsoleApp;
         m_options.converterTask.type = ConvertType::ExportScoreMedia;
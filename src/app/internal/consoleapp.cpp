@@ -279,6 +279,10 @@ int ConsoleApp::processConverter(const CmdOptions::ConverterTask& task)
     case ConvertType::Batch:
         ret = converter()->batchConvert(task.inputFile, stylePath, forceMode, soundProfile, extensionUri);
         break;
+    case ConvertType::Server: {
+        muse::io::path_t socketName = task.params[CmdOptions::ParamKey::ServerSocket].toString();
+        ret = converter()->runServer(socketName, stylePath, forceMode, soundProfile);
+    } break;
     case ConvertType::File: {
         std::string transposeOptionsJson = task.params[CmdOptions::ParamKey::ScoreTransposeOptions].toString().toStdString();
         ret = converter()->fileConvert(task.inputFile, task.outputFile, stylePath, forceMode, soundProfile, extensionUri,
@@ -47,6 +47,7 @@ DockPage {
         case "interactive": root.central = interactiveComp; break
         case "crashhandler": root.central = crashhandlerComp; break
         case "corruptscore": root.central = corruptScoreComp; break
+        case "undostack": root.central = undoStackComp; break
         case "mpe": root.central = mpeComponent; break
         case "extensions": root.central = extensionsComp; break
         case "navigation": root.central = keynavComp; break
@@ -79,6 +80,7 @@ DockPage {
                         { "name": "interactive", "title": "Interactive" },
                         { "name": "crashhandler", "title": "Crash handler" },
                         { "name": "corruptscore", "title": "Corrupt score" },
+                        { "name": "undostack", "title": "Undo memory" },
                         { "name": "mpe", "title": "MPE" },
                         { "name": "extensions", "title": "Extensions" },
                         { "name": "navigation", "title": "KeyNav" }
@@ -126,6 +128,14 @@ DockPage {
         }
     }
 
+    Component {
+        id: undoStackComp
+
+        Loader {
+            source: "qrc:/qml/DevTools/UndoStack/UndoStackDevTools.qml"
+        }
+    }
+
     Component {
         id: mpeComponent
 
@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+import QtQuick 2.15
+
+import Muse.Ui 1.0
+import Muse.UiComponents 1.0
+import MuseScore.Engraving 1.0
+
+Rectangle {
+    color: ui.theme.backgroundSecondaryColor
+
+    UndoStackDevToolsModel {
+        id: model
+    }
+
+    Component.onCompleted: {
+        model.reload()
+    }
+
+    Column {
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.margins: 12
+
+        spacing: 12
+
+        StyledTextLabel {
+            text: "Memory usage: " + model.usage + " (budget: " + model.budget + ")"
+        }
+
+        StyledTextLabel {
+            text: "Actions in history: " + model.macroCount + ", evicted: " + model.evictedMacroCount
+        }
+
+        StyledTextLabel {
+            text: "Coalesced property changes: " + model.coalescedCommandCount
+        }
+
+        FlatButton {
+            text: "Refresh"
+            onClicked: model.reload()
+        }
+    }
+}
@@ -42,6 +42,8 @@ enum class Err {
 
     OutFileFailedOpen = 1330,
     OutFileFailedWrite = 1331,
+
+    ServerFailedListen = 1340,
 };
 
 inline muse::Ret make_ret(Err e)
@@ -44,6 +44,11 @@ public:
                                    const muse::String& soundProfile = muse::String(),
                                    const muse::UriQuery& extensionUri = muse::UriQuery(), muse::ProgressPtr progress = nullptr) = 0;
 
+    //! NOTE Runs until stopped by the client, see ConverterController::runServer
+    virtual muse::Ret runServer(const muse::io::path_t& socketName = muse::io::path_t(),
+                                const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false,
+                                const muse::String& soundProfile = muse::String()) = 0;
+
     virtual muse::Ret convertScoreParts(const muse::io::path_t& in, const muse::io::path_t& out,
                                         const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false) = 0;
 
@@ -293,28 +293,22 @@ Ret BackendApi::exportScorePngs(const INotationPtr notation, BackendJsonWriter&
     jsonWriter.addKey("pngs");
     jsonWriter.openArray();
 
-    PageList notationPages = pages(notation);
+    const size_t pageCount = pages(notation).size();
 
-    bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        ByteArray pngData;
-        Buffer pngDevice(&pngData);
-        pngDevice.open(IODevice::ReadWrite);
-
-        INotationWriter::Options options = {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
+    auto pageOptions = [](size_t pageIndex) {
+        return INotationWriter::Options {
+            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(pageIndex)) },
             { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
         };
+    };
 
-        Ret writeRet = pngWriter->write(notation, pngDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
-        }
+    auto addPage = [&jsonWriter, pageCount](size_t pageIndex, const ByteArray& pngData) {
+        bool lastArrayValue = ((pageCount - 1) == pageIndex);
+        jsonWriter.addBase64Value(pngData, !lastArrayValue);
+        return make_ret(Ret::Code::Ok);
+    };
 
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(pngData.toQByteArrayNoCopy().toBase64(), !lastArrayValue);
-    }
+    bool result = ConverterUtils::writePages(pngWriter, notation, pageOptions, true, addPage);
 
     jsonWriter.closeArray(addSeparator);
 
@@ -335,30 +329,32 @@ Ret BackendApi::exportScoreSvgs(const INotationPtr notation, const muse::io::pat
     jsonWriter.addKey("svgs");
     jsonWriter.openArray();
 
-    PageList notationPages = pages(notation);
+    const size_t pageCount = pages(notation).size();
     QVariantMap beatsColors = readBeatsColors(highlightConfigPath);
 
-    bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        ByteArray svgData;
-        Buffer svgDevice(&svgData);
-        svgDevice.open(IODevice::ReadWrite);
-
+    auto pageOptions = [&beatsColors](size_t pageIndex) {
         INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
-            { INotationWriter::OptionKey::BEATS_COLORS, Val::fromQVariant(beatsColors) }
+            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(pageIndex)) },
+            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
         };
 
-        Ret writeRet = svgWriter->write(notation, svgDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
+        //! NOTE The colors are set on the score items, which are shared by all pages,
+        //! so it's enough to pass them for the first page, that is written before the others
+        if (pageIndex == 0) {
+            options[INotationWriter::OptionKey::BEATS_COLORS] = Val::fromQVariant(beatsColors);
         }
 
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(svgData.toQByteArrayNoCopy().toBase64(), !lastArrayValue);
-    }
+        return options;
+    };
+
+    auto addPage = [&jsonWriter, pageCount](size_t pageIndex, const ByteArray& svgData) {
+        bool lastArrayValue = ((pageCount - 1) == pageIndex);
+        jsonWriter.addBase64Value(svgData, !lastArrayValue);
+        return make_ret(Ret::Code::Ok);
+    };
+
+    //! NOTE The SVG writer clones the staff lines of the page, so the pages are written one by one
+    bool result = ConverterUtils::writePages(svgWriter, notation, pageOptions, false, addPage);
 
     jsonWriter.closeArray(addSeparator);
 
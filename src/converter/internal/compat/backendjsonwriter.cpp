@@ -21,6 +21,8 @@
  */
 #include "backendjsonwriter.h"
 
+#include <algorithm>
+
 #include <QIODevice>
 
 using namespace mu::converter;
@@ -59,6 +61,25 @@ void BackendJsonWriter::addValue(const QByteArray& data, bool addSeparator, bool
     }
 }
 
+void BackendJsonWriter::addBase64Value(const muse::ByteArray& data, bool addSeparator)
+{
+    //! NOTE Encoded by chunks, so the encoded copy of the whole data is never held in memory.
+    //! The chunk size is a multiple of 3, so there is no padding between the chunks
+    static constexpr size_t CHUNK_SIZE = 3 * 16 * 1024;
+
+    m_destinationDevice->write("\"");
+    for (size_t pos = 0; pos < data.size(); pos += CHUNK_SIZE) {
+        const size_t len = std::min(CHUNK_SIZE, data.size() - pos);
+        const QByteArray chunk = QByteArray::fromRawData(reinterpret_cast<const char*>(data.constData()) + pos, static_cast<int>(len));
+        m_destinationDevice->write(chunk.toBase64());
+    }
+    m_destinationDevice->write("\"");
+
+    if (addSeparator) {
+        m_destinationDevice->write(",\n");
+    }
+}
+
 void BackendJsonWriter::openArray()
 {
     m_destinationDevice->write(" [");
@@ -24,6 +24,8 @@
 
 #include <QByteArray>
 
+#include "types/bytearray.h"
+
 class QIODevice;
 
 namespace mu::converter {
@@ -35,6 +37,7 @@ public:
 
     void addKey(const char* arrayName);
     void addValue(const QByteArray& data, bool addSeparator = false, bool isJson = false);
+    void addBase64Value(const muse::ByteArray& data, bool addSeparator = false);
 
     void openArray();
     void closeArray(bool addSeparator = false);
@@ -26,12 +26,15 @@
 #include <QJsonArray>
 #include <QJsonParseError>
 
+#include <chrono>
+
 #include "global/io/file.h"
 #include "global/io/dir.h"
 
 #include "convertercodes.h"
 #include "compat/backendapi.h"
 #include "internal/converterutils.h"
+#include "internal/converterserver.h"
 
 #include "log.h"
 
@@ -46,6 +49,11 @@ static const std::string PNG_SUFFIX = "png";
 static const std::string SVG_SUFFIX = "svg";
 static const std::string MP3_SUFFIX = "mp3";
 
+static int64_t msecsSince(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 Ret ConverterController::batchConvert(const muse::io::path_t& batchJobFile, const muse::io::path_t& stylePath, bool forceMode,
                                       const String& soundProfile, const muse::UriQuery& extensionUri, muse::ProgressPtr progress)
 {
@@ -95,6 +103,93 @@ Ret ConverterController::batchConvert(const muse::io::path_t& batchJobFile, cons
     return ret;
 }
 
+Ret ConverterController::runServer(const muse::io::path_t& socketName, const muse::io::path_t& stylePath, bool forceMode,
+                                   const String& soundProfile)
+{
+    TRACEFUNC;
+
+    ConverterServer server(socketName.toQString());
+    Ret ret = server.listen();
+    if (!ret) {
+        return ret;
+    }
+
+    //! NOTE The jobs are converted one by one, on the main thread:
+    //! the engraving objects register themselves in shared registries, which are not thread-safe
+    serve(server, [this, &stylePath, forceMode, &soundProfile](const Job& job) {
+        return fileConvert(job.in, job.out, stylePath, forceMode, soundProfile, muse::UriQuery(), job.transposeOptions);
+    });
+
+    server.close();
+
+    return make_ret(Ret::Code::Ok);
+}
+
+void ConverterController::serve(ConverterServer& server, const JobRunner& runJob) const
+{
+    using clock = std::chrono::steady_clock;
+
+    auto writeJson = [&server](const QJsonObject& obj) {
+        server.writeResponse(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    };
+
+    QByteArray request;
+    while (server.readRequest(request)) {
+        if (request.isEmpty()) {
+            continue;
+        }
+
+        const clock::time_point batchStartedAt = clock::now();
+
+        QJsonParseError err;
+        const QJsonDocument doc = QJsonDocument::fromJson(request, &err);
+        if (err.error == QJsonParseError::NoError && doc.isObject()) {
+            if (doc.object().value(u"quit").toBool()) {
+                LOGI() << "quit requested";
+                return;
+            }
+        }
+
+        RetVal<BatchJob> batchJob = parseBatchJob(request);
+        if (!batchJob.ret) {
+            LOGE() << "failed parse batch job, err: " << batchJob.ret.toString();
+            writeJson(QJsonObject {
+                { "ok", false },
+                { "error", QString::fromStdString(batchJob.ret.toString()) },
+            });
+            continue;
+        }
+
+        size_t failed = 0;
+        for (const Job& job : batchJob.val) {
+            const int64_t waitMs = msecsSince(batchStartedAt);
+
+            const clock::time_point startedAt = clock::now();
+            const Ret ret = runJob(job);
+            const int64_t convertMs = msecsSince(startedAt);
+
+            if (!ret) {
+                ++failed;
+            }
+
+            writeJson(QJsonObject {
+                { "in", job.in.toQString() },
+                { "out", job.out.toQString() },
+                { "ok", ret.success() },
+                { "error", ret.success() ? QString() : QString::fromStdString(ret.toString()) },
+                { "waitMs", static_cast<qint64>(waitMs) },
+                { "convertMs", static_cast<qint64>(convertMs) },
+            });
+        }
+
+        writeJson(QJsonObject {
+            { "jobs", static_cast<qint64>(batchJob.val.size()) },
+            { "failed", static_cast<qint64>(failed) },
+            { "totalMs", static_cast<qint64>(msecsSince(batchStartedAt)) },
+        });
+    }
+}
+
 Ret ConverterController::fileConvert(const muse::io::path_t& in, const muse::io::path_t& out,
                                      const muse::io::path_t& stylePath,
                                      bool forceMode,
@@ -236,14 +331,17 @@ RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(const m
 {
     TRACEFUNC;
 
-    RetVal<BatchJob> rv;
     QFile file(batchJobFile.toQString());
     if (!file.open(QIODevice::ReadOnly)) {
-        rv.ret = make_ret(Err::BatchJobFileFailedOpen);
-        return rv;
+        return make_ret(Err::BatchJobFileFailedOpen);
     }
 
-    const QByteArray data = file.readAll();
+    return parseBatchJob(file.readAll());
+}
+
+RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(const QByteArray& data) const
+{
+    RetVal<BatchJob> rv;
 
     QJsonParseError err;
     const QJsonDocument doc = QJsonDocument::fromJson(data, &err);
@@ -337,30 +435,54 @@ Ret ConverterController::convertPageByPage(INotationWriterPtr writer, INotationP
 {
     TRACEFUNC;
 
-    for (size_t i = 0; i < notation->elements()->pages().size(); i++) {
-        const String filePath = muse::io::path_t(io::dirpath(out) + "/"
-                                                 + io::completeBasename(out) + "-%1."
-                                                 + io::suffix(out)).toString().arg(i + 1);
-
-        File file(filePath);
-        if (!file.open(File::WriteOnly)) {
-            return make_ret(Err::OutFileFailedOpen);
-        }
+    auto pageFilePath = [&out](size_t pageIndex) {
+        return muse::io::path_t(io::dirpath(out) + "/"
+                                + io::completeBasename(out) + "-%1."
+                                + io::suffix(out)).toString().arg(pageIndex + 1);
+    };
 
-        INotationWriter::Options options = {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
+    auto pageOptions = [](size_t pageIndex) {
+        return INotationWriter::Options {
+            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(pageIndex)) },
         };
+    };
 
-        file.setMeta("dir_path", out.toStdString());
-        file.setMeta("file_path", filePath.toStdString());
+    Ret ret = make_ret(Ret::Code::Ok);
 
-        Ret ret = writer->write(notation, file, options);
+    auto savePage = [&ret, &pageFilePath](size_t pageIndex, const ByteArray& data) {
         if (!ret) {
-            LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
-            return make_ret(Err::OutFileFailedWrite);
+            return ret;
+        }
+
+        const String filePath = pageFilePath(pageIndex);
+
+        File file(filePath);
+        if (!file.open(File::WriteOnly)) {
+            ret = make_ret(Err::OutFileFailedOpen);
+            return ret;
+        }
+
+        if (file.write(data) != data.size()) {
+            LOGE() << "failed write, path: " << filePath;
+            ret = make_ret(Err::OutFileFailedWrite);
+            return ret;
         }
 
         file.close();
+
+        return ret;
+    };
+
+    //! NOTE PNG pages are painted concurrently, and saved in order as soon as they are ready
+    const bool concurrently = io::suffix(out) == PNG_SUFFIX;
+    Ret writeRet = ConverterUtils::writePages(writer, notation, pageOptions, concurrently, savePage);
+    if (!ret) {
+        return ret;
+    }
+
+    if (!writeRet) {
+        LOGE() << "failed write, err: " << writeRet.toString() << ", path: " << out;
+        return make_ret(Err::OutFileFailedWrite);
     }
 
     return make_ret(Ret::Code::Ok);
@@ -21,8 +21,17 @@
  */
 #pragma once
 
+#include <functional>
 #include <list>
 
+#include <QByteArray>
+
+#include "muse_framework_config.h"
+
+#ifdef MUSE_ENABLE_UNIT_TESTS
+#include <gtest/gtest_prod.h>
+#endif
+
 #include "../iconvertercontroller.h"
 
 #include "modularity/ioc.h"
@@ -35,6 +44,7 @@
 #include "types/retval.h"
 
 namespace mu::converter {
+class ConverterServer;
 class ConverterController : public IConverterController, public muse::Injectable
 {
     muse::Inject<project::IProjectCreator> notationCreator = { this };
@@ -57,6 +67,10 @@ public:
                            const muse::String& soundProfile = muse::String(),
                            const muse::UriQuery& extensionUri = muse::UriQuery(), muse::ProgressPtr progress = nullptr) override;
 
+    muse::Ret runServer(const muse::io::path_t& socketName = muse::io::path_t(),
+                        const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false,
+                        const muse::String& soundProfile = muse::String()) override;
+
     muse::Ret convertScoreParts(const muse::io::path_t& in, const muse::io::path_t& out,
                                 const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false) override;
 
@@ -78,6 +92,11 @@ public:
 
 private:
 
+#ifdef MUSE_ENABLE_UNIT_TESTS
+    FRIEND_TEST(Converter_ServerTests, ServeJobs);
+    FRIEND_TEST(Converter_ServerTests, InvalidRequest);
+#endif
+
     struct Job {
         muse::io::path_t in;
         muse::io::path_t out;
@@ -87,6 +106,12 @@ private:
     using BatchJob = std::list<Job>;
 
     muse::RetVal<BatchJob> parseBatchJob(const muse::io::path_t& batchJobFile) const;
+    muse::RetVal<BatchJob> parseBatchJob(const QByteArray& data) const;
+
+    //! NOTE Serves the requests until the client asks to quit, or there are no more requests.
+    //! The jobs of a request are run in order, and the result of each one is written as soon as it's done
+    using JobRunner = std::function<muse::Ret(const Job& job)>;
+    void serve(ConverterServer& server, const JobRunner& runJob) const;
 
     muse::Ret fileConvert(const muse::io::path_t& in, const muse::io::path_t& out,
                           const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false,
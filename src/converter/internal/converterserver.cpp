@@ -0,0 +1,162 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "converterserver.h"
+
+#include <iostream>
+#include <string>
+
+#include <QLocalServer>
+#include <QLocalSocket>
+
+#include "convertercodes.h"
+
+#include "log.h"
+
+using namespace mu::converter;
+using namespace muse;
+
+ConverterServer::ConverterServer(const QString& socketName)
+    : m_socketName(socketName)
+{
+}
+
+ConverterServer::~ConverterServer()
+{
+    close();
+}
+
+Ret ConverterServer::listen()
+{
+    if (m_socketName.isEmpty()) {
+        return make_ret(Ret::Code::Ok);
+    }
+
+    m_server = new QLocalServer();
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+
+    //! NOTE Remove a stale socket file left by a server that was not shut down properly
+    QLocalServer::removeServer(m_socketName);
+
+    if (!m_server->listen(m_socketName)) {
+        LOGE() << "failed listen: " << m_socketName << ", err: " << m_server->errorString();
+        std::string err = m_server->errorString().toStdString();
+        delete m_server;
+        m_server = nullptr;
+        return make_ret(Err::ServerFailedListen, err);
+    }
+
+    LOGI() << "listening on: " << m_server->fullServerName();
+
+    return make_ret(Ret::Code::Ok);
+}
+
+void ConverterServer::close()
+{
+    if (m_client) {
+        m_client->disconnectFromServer();
+        delete m_client;
+        m_client = nullptr;
+    }
+
+    if (m_server) {
+        m_server->close();
+        delete m_server;
+        m_server = nullptr;
+    }
+}
+
+bool ConverterServer::waitForClient()
+{
+    if (m_client && m_client->state() == QLocalSocket::ConnectedState) {
+        return true;
+    }
+
+    if (m_client) {
+        delete m_client;
+        m_client = nullptr;
+    }
+
+    while (m_server && m_server->isListening()) {
+        if (m_server->waitForNewConnection(-1)) {
+            m_client = m_server->nextPendingConnection();
+            if (m_client) {
+                LOGI() << "client connected";
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool ConverterServer::readRequest(QByteArray& line)
+{
+    if (!m_server) {
+        std::string str;
+        if (!std::getline(std::cin, str)) {
+            return false;
+        }
+
+        line = QByteArray::fromStdString(str).trimmed();
+        return true;
+    }
+
+    while (waitForClient()) {
+        while (!m_client->canReadLine()) {
+            if (!m_client->waitForReadyRead(-1)) {
+                break;
+            }
+        }
+
+        if (m_client->canReadLine()) {
+            line = m_client->readLine().trimmed();
+            return true;
+        }
+
+        //! NOTE The client is gone, a request without the trailing newline is still served
+        if (m_client->bytesAvailable() > 0) {
+            line = m_client->readAll().trimmed();
+            return true;
+        }
+
+        LOGI() << "client disconnected";
+    }
+
+    return false;
+}
+
+void ConverterServer::writeResponse(const QByteArray& line)
+{
+    if (!m_server) {
+        std::cout.write(line.constData(), line.size());
+        std::cout << std::endl;
+        return;
+    }
+
+    if (!m_client || m_client->state() != QLocalSocket::ConnectedState) {
+        return;
+    }
+
+    m_client->write(line);
+    m_client->write("\n");
+    m_client->waitForBytesWritten(-1);
+}
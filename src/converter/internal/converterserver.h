@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include "types/ret.h"
+
+class QLocalServer;
+class QLocalSocket;
+
+namespace mu::converter {
+//! NOTE Line based transport of the conversion server.
+//! Without a socket name requests are read from stdin and responses are written to stdout,
+//! otherwise a local socket (UNIX domain socket / named pipe) is listened and clients are served one after another.
+class ConverterServer
+{
+public:
+    explicit ConverterServer(const QString& socketName = QString());
+    ~ConverterServer();
+
+    muse::Ret listen();
+    void close();
+
+    //! NOTE Blocks until the next request line is available.
+    //! Returns false when there will be no more requests (stdin closed, or the server is closed)
+    bool readRequest(QByteArray& line);
+    void writeResponse(const QByteArray& line);
+
+private:
+    bool waitForClient();
+
+    QString m_socketName;
+    QLocalServer* m_server = nullptr;
+    QLocalSocket* m_client = nullptr;
+};
+}
@@ -24,11 +24,24 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 
+#include <algorithm>
+#include <future>
+#include <thread>
+
+#include "global/runtime.h"
+#include "global/io/buffer.h"
+#include "global/concurrency/taskscheduler.h"
+
+#include "engraving/dom/mscore.h"
+#include "engraving/dom/page.h"
+#include "engraving/dom/score.h"
+
 #include "convertercodes.h"
 
 using namespace muse;
 using namespace mu::converter;
 using namespace mu::notation;
+using namespace mu::project;
 
 RetVal<TransposeOptions> ConverterUtils::parseTransposeOptions(const std::string& optionsJson)
 {
@@ -128,3 +141,108 @@ Ret ConverterUtils::applyTranspose(const INotationPtr notation, const TransposeO
 
     return ok ? make_ret(Ret::Code::Ok) : make_ret(Err::TransposeFailed);
 }
+
+Ret ConverterUtils::writePages(INotationWriterPtr writer, INotationPtr notation, const PageOptions& pageOptions, bool concurrently,
+                               const PageReceiver& receiver)
+{
+    IF_ASSERT_FAILED(writer && notation && notation->elements()) {
+        return make_ret(Err::UnknownError);
+    }
+
+    mu::engraving::Score* score = notation->elements()->msScore();
+    IF_ASSERT_FAILED(score) {
+        return make_ret(Err::UnknownError);
+    }
+
+    //! NOTE Prepared here, so that the workers don't touch anything but their own page
+    std::vector<INotationWriter::Options> options;
+    options.reserve(score->pages().size());
+    for (size_t i = 0; i < score->pages().size(); ++i) {
+        options.push_back(pageOptions(i));
+    }
+
+    auto writePage = [writer, notation, &options](size_t pageIndex, io::IODevice& device) {
+        return writer->write(notation, device, options.at(pageIndex));
+    };
+
+    const size_t threadCount = concurrently ? std::thread::hardware_concurrency() : 1;
+
+    return writePages(score, writePage, threadCount, receiver);
+}
+
+Ret ConverterUtils::writePages(mu::engraving::Score* score, const PageWriter& pageWriter, size_t threadCount,
+                               const PageReceiver& receiver)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(score && pageWriter) {
+        return make_ret(Err::UnknownError);
+    }
+
+    const std::vector<mu::engraving::Page*>& pages = score->pages();
+    if (pages.empty()) {
+        return make_ret(Ret::Code::Ok);
+    }
+
+    auto writePage = [&pageWriter](size_t pageIndex) {
+        RetVal<muse::ByteArray> page;
+        io::Buffer device(&page.val);
+        device.open(io::IODevice::ReadWrite);
+
+        page.ret = pageWriter(pageIndex, device);
+        if (!page.ret) {
+            LOGW() << "failed write page: " << pageIndex << ", err: " << page.ret.toString();
+        }
+
+        device.close();
+        return page;
+    };
+
+    Ret result = make_ret(Ret::Code::Ok);
+    auto receive = [&result, &receiver](size_t pageIndex, const RetVal<muse::ByteArray>& page) {
+        if (!page.ret && result) {
+            result = page.ret;
+        }
+
+        Ret ret = receiver(pageIndex, page.val);
+        if (!ret && result) {
+            result = ret;
+        }
+    };
+
+    //! NOTE The print state is set up once, by the first page, and is kept until all pages are written,
+    //! so the pages written concurrently only read it
+    const mu::engraving::PrintStateGuard printState(score);
+
+    //! NOTE The first page is written alone: it loads the fonts and sets up the print state, shared by all pages
+    receive(0, writePage(0));
+
+    //! NOTE Nested conversions are not parallelized any further
+    threadCount = std::min(threadCount, pages.size() - 1);
+    if (threadCount <= 1 || std::this_thread::get_id() != muse::runtime::mainThreadId()) {
+        for (size_t i = 1; i < pages.size(); ++i) {
+            receive(i, writePage(i));
+        }
+
+        return result;
+    }
+
+    //! NOTE Pages build their item lookup trees lazily, on the first lookup
+    for (mu::engraving::Page* page : pages) {
+        page->items(page->ldata()->bbox());
+    }
+
+    TaskScheduler workers(static_cast<thread_pool_size_t>(threadCount));
+
+    std::vector<std::future<RetVal<muse::ByteArray> > > pending;
+    pending.reserve(pages.size() - 1);
+    for (size_t i = 1; i < pages.size(); ++i) {
+        pending.push_back(workers.submit(writePage, i));
+    }
+
+    for (size_t i = 1; i < pages.size(); ++i) {
+        receive(i, pending.at(i - 1).get());
+    }
+
+    return result;
+}
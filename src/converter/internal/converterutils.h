@@ -21,8 +21,16 @@
  */
 #pragma once
 
+#include <functional>
+
+#include "types/bytearray.h"
 #include "notation/inotation.h"
 #include "notation/notationtypes.h"
+#include "project/inotationwriter.h"
+
+namespace mu::engraving {
+class Score;
+}
 
 namespace mu::converter {
 class ConverterUtils
@@ -33,5 +41,20 @@ public:
 
     static muse::Ret applyTranspose(const notation::INotationPtr notation, const std::string& optionsJson);
     static muse::Ret applyTranspose(const notation::INotationPtr notation, const notation::TransposeOptions& options);
+
+    using PageOptions = std::function<project::INotationWriter::Options(size_t pageIndex)>;
+    using PageWriter = std::function<muse::Ret(size_t pageIndex, muse::io::IODevice& device)>;
+    using PageReceiver = std::function<muse::Ret(size_t pageIndex, const muse::ByteArray& data)>;
+
+    //! NOTE Writes every page with a per page writer (png, svg).
+    //! The pages may be painted concurrently only by the writers that don't create or change any engraving object (png),
+    //! the others (svg) write them one by one.
+    //! The receiver is called on the calling thread, in page order, as soon as the page is ready
+    static muse::Ret writePages(project::INotationWriterPtr writer, notation::INotationPtr notation, const PageOptions& pageOptions,
+                                bool concurrently, const PageReceiver& receiver);
+
+    //! NOTE With a single thread, the pages are written on the calling thread
+    static muse::Ret writePages(engraving::Score* score, const PageWriter& pageWriter, size_t threadCount,
+                                const PageReceiver& receiver);
 };
 }
@@ -0,0 +1,187 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2026 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalSocket>
+
+#include "global/runtime.h"
+
+#include "converter/convertercodes.h"
+#include "converter/internal/convertercontroller.h"
+#include "converter/internal/converterserver.h"
+
+using namespace muse;
+
+namespace mu::converter {
+static constexpr int TIMEOUT_MS = 10000;
+
+class Converter_ServerTests : public ::testing::Test
+{
+public:
+    //! NOTE Sends the requests, then reads the responses until the server closes the connection
+    static std::vector<QJsonObject> sendRequests(const QString& socketName, const std::vector<QByteArray>& requests)
+    {
+        std::vector<QJsonObject> responses;
+
+        QLocalSocket socket;
+        socket.connectToServer(socketName);
+        if (!socket.waitForConnected(TIMEOUT_MS)) {
+            ADD_FAILURE() << "failed connect: " << socket.errorString().toStdString();
+            return responses;
+        }
+
+        for (const QByteArray& request : requests) {
+            socket.write(request + "\n");
+        }
+
+        while (socket.bytesToWrite() > 0 && socket.waitForBytesWritten(TIMEOUT_MS)) {
+        }
+
+        while (true) {
+            while (socket.canReadLine()) {
+                responses.push_back(QJsonDocument::fromJson(socket.readLine()).object());
+            }
+
+            if (!socket.waitForReadyRead(TIMEOUT_MS)) {
+                break;
+            }
+        }
+
+        return responses;
+    }
+
+    static void checkJobResponse(const QJsonObject& response, const QString& in, const QString& out, bool ok)
+    {
+        EXPECT_EQ(response.value("in").toString(), in);
+        EXPECT_EQ(response.value("out").toString(), out);
+        EXPECT_EQ(response.value("ok").toBool(), ok);
+        EXPECT_EQ(response.value("error").toString().isEmpty(), ok);
+        EXPECT_TRUE(response.contains("waitMs"));
+        EXPECT_TRUE(response.contains("convertMs"));
+    }
+
+    static void checkBatchResponse(const QJsonObject& response, int jobs, int failed)
+    {
+        EXPECT_EQ(response.value("jobs").toInt(), jobs);
+        EXPECT_EQ(response.value("failed").toInt(), failed);
+        EXPECT_TRUE(response.contains("totalMs"));
+    }
+};
+
+TEST_F(Converter_ServerTests, ServeJobs)
+{
+    //! [GIVEN] A server listening on a local socket
+    const QString socketName = "muse_converter_tests_serve_jobs";
+    ConverterServer server(socketName);
+    ASSERT_TRUE(server.listen());
+
+    //! [GIVEN] A client sending two requests, asking to quit, then sending one more request
+    const std::vector<QByteArray> requests {
+        R"([{"in": "a.mscz", "out": "a.pdf"}, {"in": "b.mscz", "out": "b.mid"}, {"in": "c.mscz", "out": "c.mxl"}])",
+        R"([{"in": "d.mscz", "out": "d.png"}])",
+        R"({"quit": true})",
+        R"([{"in": "e.mscz", "out": "e.pdf"}])",
+    };
+
+    std::vector<QJsonObject> responses;
+    std::thread client([&socketName, &requests, &responses]() {
+        responses = sendRequests(socketName, requests);
+    });
+
+    //! [WHEN] The requests are served, with a job runner failing for one of the files
+    std::vector<std::string> convertedFiles;
+    auto runJob = [&convertedFiles](const ConverterController::Job& job) {
+        EXPECT_EQ(std::this_thread::get_id(), muse::runtime::mainThreadId());
+
+        convertedFiles.push_back(job.out.toStdString());
+        return job.out == "b.mid" ? make_ret(Err::OutFileFailedWrite) : make_ret(Ret::Code::Ok);
+    };
+
+    ConverterController controller(muse::modularity::globalCtx());
+    controller.serve(server, runJob);
+    server.close();
+    client.join();
+
+    //! [THEN] The jobs before the quit request are run in order, on the main thread
+    EXPECT_EQ(convertedFiles, std::vector<std::string>({ "a.pdf", "b.mid", "c.mxl", "d.png" }));
+
+    //! [THEN] Each job has a response, and each request a summary
+    ASSERT_EQ(responses.size(), 6u);
+    checkJobResponse(responses.at(0), "a.mscz", "a.pdf", true);
+    checkJobResponse(responses.at(1), "b.mscz", "b.mid", false);
+    checkJobResponse(responses.at(2), "c.mscz", "c.mxl", true);
+    checkBatchResponse(responses.at(3), 3, 1);
+    checkJobResponse(responses.at(4), "d.mscz", "d.png", true);
+    checkBatchResponse(responses.at(5), 1, 0);
+}
+
+TEST_F(Converter_ServerTests, InvalidRequest)
+{
+    //! [GIVEN] A server listening on a local socket
+    const QString socketName = "muse_converter_tests_invalid_request";
+    ConverterServer server(socketName);
+    ASSERT_TRUE(server.listen());
+
+    //! [GIVEN] A client sending invalid requests and an empty line, then a valid one
+    const std::vector<QByteArray> requests {
+        "not a json",
+        R"({"in": "a.mscz", "out": "a.pdf"})",
+        "",
+        R"([{"in": "a.mscz", "out": "a.pdf"}])",
+        R"({"quit": true})",
+    };
+
+    std::vector<QJsonObject> responses;
+    std::thread client([&socketName, &requests, &responses]() {
+        responses = sendRequests(socketName, requests);
+    });
+
+    //! [WHEN] The requests are served
+    size_t jobCount = 0;
+    auto runJob = [&jobCount](const ConverterController::Job&) {
+        ++jobCount;
+        return make_ret(Ret::Code::Ok);
+    };
+
+    ConverterController controller(muse::modularity::globalCtx());
+    controller.serve(server, runJob);
+    server.close();
+    client.join();
+
+    //! [THEN] The invalid requests are answered with an error, the empty line is skipped, and the server keeps serving
+    EXPECT_EQ(jobCount, 1u);
+
+    ASSERT_EQ(responses.size(), 4u);
+    for (size_t i = 0; i < 2; ++i) {
+        EXPECT_FALSE(responses.at(i).value("ok").toBool(true));
+        EXPECT_FALSE(responses.at(i).value("error").toString().isEmpty());
+    }
+
+    checkJobResponse(responses.at(2), "a.mscz", "a.pdf", true);
+    checkBatchResponse(responses.at(3), 1, 0);
+}
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2026 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <QBuffer>
+#include <QImage>
+
+#include "draw/painter.h"
+
+#include "engraving/tests/utils/scorerw.h"
+
+#include "engraving/dom/masterscore.h"
+#include "engraving/rendering/iscorerenderer.h"
+
+#include "converter/internal/converterutils.h"
+
+using namespace mu;
+using namespace mu::converter;
+using namespace mu::engraving;
+using namespace muse;
+
+static const String TEST_SCORE_PATH(u"data/test.mscx");
+static constexpr int PAGE_DPI = 72;
+
+class ConverterUtilsTests : public ::testing::Test
+{
+public:
+    //! NOTE Paints the page like the PNG writer does
+    static Ret writePngPage(Score* score, size_t pageIndex, io::IODevice& device)
+    {
+        const auto renderer = modularity::globalIoc()->resolve<rendering::IScoreRenderer>("utests");
+
+        rendering::IScoreRenderer::PaintOptions opt;
+        opt.fromPage = static_cast<int>(pageIndex);
+        opt.toPage = opt.fromPage;
+        opt.deviceDpi = PAGE_DPI;
+        opt.isPrinting = true;
+        opt.printPageBackground = false;
+
+        const SizeF pageSizeInch = renderer->pageSizeInch(score, opt);
+
+        QImage image(std::lrint(pageSizeInch.width() * PAGE_DPI), std::lrint(pageSizeInch.height() * PAGE_DPI),
+                     QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::white);
+
+        {
+            muse::draw::Painter painter(&image, "converterutilstests");
+            renderer->paintScore(&painter, score, opt);
+        }
+
+        QByteArray data;
+        QBuffer buf(&data);
+        buf.open(QIODevice::WriteOnly);
+        image.save(&buf, "png");
+
+        device.write(ByteArray::fromQByteArrayNoCopy(data));
+
+        return make_ret(Ret::Code::Ok);
+    }
+
+    static std::vector<ByteArray> writePngPages(Score* score, size_t threadCount)
+    {
+        auto writePage = [score](size_t pageIndex, io::IODevice& device) {
+            return writePngPage(score, pageIndex, device);
+        };
+
+        std::vector<ByteArray> pages;
+        auto receivePage = [&pages](size_t pageIndex, const ByteArray& data) {
+            EXPECT_EQ(pageIndex, pages.size());
+            pages.push_back(data);
+            return make_ret(Ret::Code::Ok);
+        };
+
+        EXPECT_TRUE(ConverterUtils::writePages(score, writePage, threadCount, receivePage));
+
+        return pages;
+    }
+};
+
+TEST_F(ConverterUtilsTests, WritePagesConcurrently)
+{
+    //! [GIVEN] A score laid out on several pages
+    MasterScore* score = ScoreRW::readScore(TEST_SCORE_PATH);
+    ASSERT_TRUE(score);
+
+    score->startCmd(TranslatableString::untranslatable("Converter utils tests"));
+    score->appendMeasures(300 - static_cast<int>(score->nmeasures()));
+    score->endCmd();
+    ASSERT_GE(score->npages(), 3u);
+
+    //! [WHEN] The pages are written one by one, then concurrently
+    const std::vector<ByteArray> sequential = writePngPages(score, 1);
+    const std::vector<ByteArray> concurrent = writePngPages(score, 4);
+
+    //! [THEN] The pages are the same, byte for byte
+    ASSERT_EQ(sequential.size(), score->npages());
+    ASSERT_EQ(concurrent.size(), sequential.size());
+    for (size_t i = 0; i < sequential.size(); ++i) {
+        EXPECT_FALSE(sequential.at(i).empty());
+        EXPECT_TRUE(concurrent.at(i) == sequential.at(i)) << "page: " << i;
+    }
+
+    delete score;
+}
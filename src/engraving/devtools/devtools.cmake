@@ -8,6 +8,8 @@ set(DEVTOOLS_SRC
     ${CMAKE_CURRENT_LIST_DIR}/engravingelementsmodel.h
     ${CMAKE_CURRENT_LIST_DIR}/corruptscoredevtoolsmodel.cpp
     ${CMAKE_CURRENT_LIST_DIR}/corruptscoredevtoolsmodel.h
+    ${CMAKE_CURRENT_LIST_DIR}/undostackdevtoolsmodel.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/undostackdevtoolsmodel.h
 
     ${CMAKE_CURRENT_LIST_DIR}/drawdata/drawdatatypes.h
     ${CMAKE_CURRENT_LIST_DIR}/drawdata/drawdataerrors.h
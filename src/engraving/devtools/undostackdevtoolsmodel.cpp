@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "undostackdevtoolsmodel.h"
+
+#include "dataformatter.h"
+
+using namespace mu::engraving;
+
+UndoStackDevToolsModel::UndoStackDevToolsModel(QObject* parent)
+    : QObject(parent), muse::Injectable(muse::iocCtxForQmlObject(this))
+{
+}
+
+QString UndoStackDevToolsModel::budget() const
+{
+    return m_stats.budget ? muse::DataFormatter::formatFileSize(m_stats.budget).toQString() : QStringLiteral("unlimited");
+}
+
+QString UndoStackDevToolsModel::usage() const
+{
+    return muse::DataFormatter::formatFileSize(m_stats.usage).toQString();
+}
+
+int UndoStackDevToolsModel::macroCount() const
+{
+    return static_cast<int>(m_stats.macroCount);
+}
+
+int UndoStackDevToolsModel::evictedMacroCount() const
+{
+    return static_cast<int>(m_stats.evictedMacroCount);
+}
+
+int UndoStackDevToolsModel::coalescedCommandCount() const
+{
+    return static_cast<int>(m_stats.coalescedCommandCount);
+}
+
+void UndoStackDevToolsModel::reload()
+{
+    mu::notation::IMasterNotationPtr masterNotation = globalContext()->currentMasterNotation();
+    const UndoStack* undoStack = masterNotation ? masterNotation->masterScore()->undoStack() : nullptr;
+
+    m_stats = undoStack ? undoStack->memoryStats() : UndoStack::MemoryStats();
+
+    emit statsChanged();
+}
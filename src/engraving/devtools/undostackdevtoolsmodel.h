@@ -0,0 +1,65 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_ENGRAVING_UNDOSTACKDEVTOOLSMODEL_H
+#define MU_ENGRAVING_UNDOSTACKDEVTOOLSMODEL_H
+
+#include <QObject>
+
+#include "modularity/ioc.h"
+#include "context/iglobalcontext.h"
+
+#include "dom/undo.h"
+
+namespace mu::engraving {
+class UndoStackDevToolsModel : public QObject, public muse::Injectable
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString budget READ budget NOTIFY statsChanged)
+    Q_PROPERTY(QString usage READ usage NOTIFY statsChanged)
+    Q_PROPERTY(int macroCount READ macroCount NOTIFY statsChanged)
+    Q_PROPERTY(int evictedMacroCount READ evictedMacroCount NOTIFY statsChanged)
+    Q_PROPERTY(int coalescedCommandCount READ coalescedCommandCount NOTIFY statsChanged)
+
+    muse::Inject<context::IGlobalContext> globalContext = { this };
+
+public:
+    explicit UndoStackDevToolsModel(QObject* parent = nullptr);
+
+    QString budget() const;
+    QString usage() const;
+    int macroCount() const;
+    int evictedMacroCount() const;
+    int coalescedCommandCount() const;
+
+    Q_INVOKABLE void reload();
+
+signals:
+    void statsChanged();
+
+private:
+    UndoStack::MemoryStats m_stats;
+};
+}
+
+#endif // MU_ENGRAVING_UNDOSTACKDEVTOOLSMODEL_H
@@ -20,7 +20,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "bsp.h"
 #include "engravingitem.h"
@@ -29,86 +31,62 @@ using namespace mu;
 
 namespace mu::engraving {
 //---------------------------------------------------------
-//   InsertItemBspTreeVisitor
+//   Bounds
 //---------------------------------------------------------
 
-class InsertItemBspTreeVisitor : public BspTreeVisitor
+double BspTree::Bounds::distanceSquared(const PointF& p) const
 {
-    OBJECT_ALLOCATOR(engraving, InsertItemBspTreeVisitor)
-public:
-    EngravingItem* item;
-
-    inline void visit(std::list<EngravingItem*>* items) { items->push_front(item); }
-};
-
-//---------------------------------------------------------
-//   RemoveItemBspTreeVisitor
-//---------------------------------------------------------
+    const double dx = std::max({ left - p.x(), 0.0, p.x() - right });
+    const double dy = std::max({ top - p.y(), 0.0, p.y() - bottom });
+    return dx * dx + dy * dy;
+}
 
-class RemoveItemBspTreeVisitor : public BspTreeVisitor
+void BspTree::Bounds::unite(const Bounds& b)
 {
-    OBJECT_ALLOCATOR(engraving, RemoveItemBspTreeVisitor)
-public:
-    EngravingItem* item;
-
-    inline void visit(std::list<EngravingItem*>* items) { items->remove(item); }
-};
+    left = std::min(left, b.left);
+    top = std::min(top, b.top);
+    right = std::max(right, b.right);
+    bottom = std::max(bottom, b.bottom);
+}
 
 //---------------------------------------------------------
-//   FindItemBspTreeVisitor
+//   sortTileRecursive
+//    orders items[begin, end) so that consecutive runs of
+//    nodeSize items are spatially close: vertical slices
+//    sorted by x, each slice sorted by y
 //---------------------------------------------------------
 
-class FindItemBspTreeVisitor : public BspTreeVisitor
+template<typename T>
+static void sortTileRecursive(std::vector<T>& items, size_t begin, size_t end, size_t nodeSize)
 {
-    OBJECT_ALLOCATOR(engraving, FindItemBspTreeVisitor)
-public:
-    std::list<EngravingItem*> foundItems;
-
-    void visit(std::list<EngravingItem*>* items)
-    {
-        for (auto it = items->begin(); it != items->end(); ++it) {
-            EngravingItem* item = *it;
-            if (!item->itemDiscovered) {
-                item->itemDiscovered = true;
-                foundItems.push_front(item);
-            }
-        }
-    }
-};
+    const size_t nodeCount = (end - begin + nodeSize - 1) / nodeSize;
+    const size_t sliceCount = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(nodeCount))));
+    const size_t sliceSize = sliceCount * nodeSize;
 
-//---------------------------------------------------------
-//   BspTree
-//---------------------------------------------------------
+    auto first = items.begin() + begin;
+    auto last = items.begin() + end;
 
-BspTree::BspTree()
-    : m_leafCnt(0)
-{
-    m_depth = 0;
-}
+    std::sort(first, last, [](const T& a, const T& b) {
+        return a.bounds.left + a.bounds.right < b.bounds.left + b.bounds.right;
+    });
 
-//---------------------------------------------------------
-//   intmaxlog
-//---------------------------------------------------------
-
-static inline int intmaxlog(int n)
-{
-    return n > 0 ? std::max(int(::ceil(::log(double(n)) / ::log(double(2)))), 5) : 0;
+    for (auto slice = first; slice < last; slice += std::min<ptrdiff_t>(sliceSize, last - slice)) {
+        std::sort(slice, slice + std::min<ptrdiff_t>(sliceSize, last - slice), [](const T& a, const T& b) {
+            return a.bounds.top + a.bounds.bottom < b.bounds.top + b.bounds.bottom;
+        });
+    }
 }
 
 //---------------------------------------------------------
 //   initialize
+//    the tree is bulk loaded on the first lookup after
+//    the items have been inserted
 //---------------------------------------------------------
 
-void BspTree::initialize(const RectF& rec, int n)
+void BspTree::initialize(const RectF&, int n)
 {
-    m_depth      = intmaxlog(n);
-    this->m_rect = rec;
-    m_leafCnt    = 0;
-
-    m_nodes.resize((1 << (m_depth + 1)) - 1);
-    m_leaves.resize(1LL << m_depth);
-    std::fill(m_leaves.begin(), m_leaves.end(), std::list<EngravingItem*>());
-    initialize(rec, m_depth, 0);
+    clear();
+    m_pending.reserve(n > 0 ? static_cast<size_t>(n) : 0);
 }
 
 //---------------------------------------------------------
@@ -117,319 +95,331 @@ void BspTree::initialize(const RectF& rec, int n)
 
 void BspTree::clear()
 {
-    m_leafCnt = 0;
+    m_entries.clear();
     m_nodes.clear();
-    m_leaves.clear();
+    m_index.clear();
+    m_pending.clear();
+    m_removedCount = 0;
+    m_dirty = false;
 }
 
 //---------------------------------------------------------
 //   insert
 //---------------------------------------------------------
 
-void BspTree::insert(EngravingItem* element)
+void BspTree::insert(EngravingItem* item)
 {
-    InsertItemBspTreeVisitor insertVisitor;
-    insertVisitor.item = element;
-    climbTree(&insertVisitor, element->pageBoundingRect());
+    Entry entry;
+    entry.bounds = Bounds(item->pageBoundingRect());
+    entry.item = item;
+    m_pending.push_back(entry);
+
+    if (m_nodes.empty() || needsRebuild()) {
+        m_dirty = true;
+    }
 }
 
 //---------------------------------------------------------
 //   remove
 //---------------------------------------------------------
 
-void BspTree::remove(EngravingItem* element)
+void BspTree::remove(EngravingItem* item)
 {
-    RemoveItemBspTreeVisitor removeVisitor;
-    removeVisitor.item = element;
-    climbTree(&removeVisitor, element->pageBoundingRect());
+    auto pending = std::remove_if(m_pending.begin(), m_pending.end(), [item](const Entry& e) { return e.item == item; });
+    m_pending.erase(pending, m_pending.end());
+
+    auto it = std::lower_bound(m_index.begin(), m_index.end(), std::make_pair(item, uint32_t(0)));
+    for (; it != m_index.end() && it->first == item; ++it) {
+        Entry& entry = m_entries[it->second];
+        if (entry.item) {
+            entry.item = nullptr;
+            ++m_removedCount;
+        }
+    }
+
+    if (needsRebuild()) {
+        m_dirty = true;
+    }
 }
 
 //---------------------------------------------------------
-//   items
+//   update
+//    refits the tree after the item has moved; returns false
+//    if the item is not in the tree
 //---------------------------------------------------------
 
-std::vector<EngravingItem*> BspTree::items(const RectF& rec)
+bool BspTree::update(EngravingItem* item)
 {
-    FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, rec);
-    std::vector<EngravingItem*> l;
-    for (EngravingItem* e : findVisitor.foundItems) {
-        e->itemDiscovered = false;
-        if (e->pageBoundingRect().intersects(rec)) {
-            l.push_back(e);
+    const Bounds bounds(item->pageBoundingRect());
+    bool found = false;
+
+    for (Entry& entry : m_pending) {
+        if (entry.item == item) {
+            entry.bounds = bounds;
+            found = true;
         }
     }
-    return l;
+
+    auto it = std::lower_bound(m_index.begin(), m_index.end(), std::make_pair(item, uint32_t(0)));
+    for (; it != m_index.end() && it->first == item; ++it) {
+        Entry& entry = m_entries[it->second];
+        if (!entry.item) {
+            continue;
+        }
+
+        entry.bounds = bounds;
+        found = true;
+
+        if (!m_dirty) {
+            refit(entry.leaf);
+        }
+    }
+
+    return found;
 }
 
 //---------------------------------------------------------
 //   items
 //---------------------------------------------------------
 
-std::vector<EngravingItem*> BspTree::items(const PointF& pos)
+std::vector<EngravingItem*> BspTree::items(const RectF& rect)
 {
-    FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, pos);
-
     std::vector<EngravingItem*> l;
-    for (EngravingItem* e : findVisitor.foundItems) {
-        e->itemDiscovered = false;
-        if (e->contains(pos)) {
-            l.push_back(e);
-        }
-    }
+    visitItems(rect, [&l](EngravingItem* item) { l.push_back(item); });
     return l;
 }
 
 //---------------------------------------------------------
-//   nearestNeighbor (public)
+//   items
 //---------------------------------------------------------
 
-EngravingItem* BspTree::nearestNeighbor(const PointF& pos)
+std::vector<EngravingItem*> BspTree::items(const PointF& pos)
 {
-    EngravingItem* nn = nullptr;
-    double bestDistance = std::numeric_limits<double>::max();
-    nearestNeighbor(pos, &nn, bestDistance);
-    return nn;
+    std::vector<EngravingItem*> l;
+    visitItems(pos, [&l](EngravingItem* item) { l.push_back(item); });
+    return l;
 }
 
 //---------------------------------------------------------
-//   nearestNeighbor (private)
+//   nearestNeighbor
+//    item with the bounding rect center closest to pos
 //---------------------------------------------------------
 
-void BspTree::nearestNeighbor(const PointF& pos, EngravingItem** bestItem, double& bestDistance, int nodeIndex)
+EngravingItem* BspTree::nearestNeighbor(const PointF& pos)
 {
-    if (m_nodes.empty()) {
-        return;
+    if (m_dirty) {
+        build();
     }
 
-    Node* node = &m_nodes[nodeIndex];
+    EngravingItem* bestItem = nullptr;
+    double bestDistance = std::numeric_limits<double>::max();
 
-    // Base case: go through the items in the leaf node (if any), and update bestItem/bestDistance accordingly
-    if (node->type == Node::Type::LEAF) {
-        for (auto item : m_leaves[node->leafIndex]) {
-            PointF itemPos = item->pageBoundingRect().center();
-            double currDistance = std::sqrt(std::pow(pos.x() - itemPos.x(), 2) + std::pow(pos.y() - itemPos.y(), 2));
-            if (currDistance < bestDistance) {
-                *bestItem = item;
-                bestDistance = currDistance;
-            }
+    auto checkEntry = [&](const Entry& entry) {
+        if (!entry.item) {
+            return;
         }
-        return;
+        const PointF center = entry.bounds.center();
+        const double dx = pos.x() - center.x();
+        const double dy = pos.y() - center.y();
+        const double distance = dx * dx + dy * dy;
+        if (distance < bestDistance) {
+            bestItem = entry.item;
+            bestDistance = distance;
+        }
+    };
+
+    for (const Entry& entry : m_pending) {
+        checkEntry(entry);
     }
 
-    // Find which child contains pos and which is the "sibling"
-    int containerIdx = firstChildIndex(nodeIndex);
-    int siblingIdx =  containerIdx + 1;
-    if (node->type == Node::Type::VERTICAL) {
-        if (pos.x() >= node->offset) {
-            ++containerIdx;
-            --siblingIdx;
-        }
-    } else if (pos.y() >= node->offset) {
-        ++containerIdx;
-        --siblingIdx;
+    if (m_nodes.empty()) {
+        return bestItem;
     }
 
-    // Recursion on container node
-    nearestNeighbor(pos, bestItem, bestDistance, containerIdx);
+    // The distance to a node is a lower bound of the distance to any center inside it,
+    // so the nodes that are farther away than the best candidate found so far are skipped
+    uint32_t stack[STACK_SIZE];
+    size_t top = 0;
+    stack[top++] = static_cast<uint32_t>(m_nodes.size() - 1);
 
-    // If the distance to the "offset" is shorter than the best distance we've found so far, then it's possible that the nearest
-    // neighbour is in the sibling node (so we should search there too).
-    double distanceToOffset;
-    if (node->type == Node::Type::HORIZONTAL) {
-        distanceToOffset = std::abs(pos.y() - node->offset);
-    } else {
-        distanceToOffset = std::abs(pos.x() - node->offset);
-    }
+    while (top > 0) {
+        const Node& node = m_nodes[stack[--top]];
+        if (node.bounds.distanceSquared(pos) >= bestDistance) {
+            continue;
+        }
 
-    if (distanceToOffset < bestDistance) {
-        // Recursion on sibling node
-        nearestNeighbor(pos, bestItem, bestDistance, siblingIdx);
+        if (node.isLeaf) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                checkEntry(m_entries[i]);
+            }
+            continue;
+        }
+
+        // Visit the closest child first, to tighten bestDistance early
+        const size_t childrenBegin = top;
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            stack[top++] = i;
+        }
+        std::sort(stack + childrenBegin, stack + top, [this, &pos](uint32_t a, uint32_t b) {
+            return m_nodes[a].bounds.distanceSquared(pos) > m_nodes[b].bounds.distanceSquared(pos);
+        });
     }
+
+    return bestItem;
 }
 
-#ifndef NDEBUG
 //---------------------------------------------------------
-//   debug
+//   leafCount
 //---------------------------------------------------------
 
-String BspTree::debug(int index) const
+int BspTree::leafCount() const
 {
-    const Node* node = &m_nodes.at(index);
-
-    String tmp;
-    if (node->type == Node::Type::LEAF) {
-        RectF rec = rectForIndex(index);
-        if (!m_leaves[node->leafIndex].empty()) {
-            tmp += String(u"[%1, %2, %3, %4] contains %5 items\n")
-                   .arg(rec.left()).arg(rec.top())
-                   .arg(rec.width()).arg(rec.height())
-                   .arg(m_leaves[node->leafIndex].size());
-        }
-    } else {
-        if (node->type == Node::Type::HORIZONTAL) {
-            tmp += debug(firstChildIndex(index));
-            tmp += debug(firstChildIndex(index) + 1);
-        } else {
-            tmp += debug(firstChildIndex(index));
-            tmp += debug(firstChildIndex(index) + 1);
-        }
-    }
-    return tmp;
+    return static_cast<int>(std::count_if(m_nodes.begin(), m_nodes.end(), [](const Node& n) { return n.isLeaf; }));
 }
 
-#endif
-
 //---------------------------------------------------------
-//   initialize
+//   intersects
 //---------------------------------------------------------
 
-void BspTree::initialize(const RectF& rec, int dep, int index)
+bool BspTree::intersects(const EngravingItem* item, const RectF& rect)
 {
-    Node* node = &m_nodes[index];
-    if (index == 0) {
-        node->type = Node::Type::HORIZONTAL;
-        node->offset = rec.center().y();
-    }
-
-    if (dep) {
-        Node::Type type;
-        RectF rect1, rect2;
-        double offset1, offset2;
-
-        if (node->type == Node::Type::HORIZONTAL) {
-            type = Node::Type::VERTICAL;
-            rect1.setRect(rec.left(), rec.top(), rec.width(), rec.height() * .5);
-            rect2.setRect(rect1.left(), rect1.bottom(), rect1.width(), rec.height() - rect1.height());
-            offset1 = rect1.center().x();
-            offset2 = rect2.center().x();
-        } else {
-            type = Node::Type::HORIZONTAL;
-            rect1.setRect(rec.left(), rec.top(), rec.width() * .5, rec.height());
-            rect2.setRect(rect1.right(), rect1.top(), rec.width() - rect1.width(), rect1.height());
-            offset1 = rect1.center().y();
-            offset2 = rect2.center().y();
-        }
+    return item->pageBoundingRect().intersects(rect);
+}
 
-        int childIndex = firstChildIndex(index);
+//---------------------------------------------------------
+//   contains
+//---------------------------------------------------------
 
-        Node* child   = &m_nodes[childIndex];
-        child->offset = offset1;
-        child->type   = type;
+bool BspTree::contains(const EngravingItem* item, const PointF& pos)
+{
+    return item->contains(pos);
+}
 
-        child = &m_nodes[childIndex + 1];
-        child->offset = offset2;
-        child->type   = type;
+//---------------------------------------------------------
+//   needsRebuild
+//    a few insertions and removals after the build are
+//    cheaper to handle in place than by rebuilding the tree
+//---------------------------------------------------------
 
-        initialize(rect1, dep - 1, childIndex);
-        initialize(rect2, dep - 1, childIndex + 1);
-    } else {
-        node->type      = Node::Type::LEAF;
-        node->leafIndex = m_leafCnt++;
-    }
+bool BspTree::needsRebuild() const
+{
+    const size_t threshold = std::max<size_t>(NODE_SIZE * 4, m_index.size() / 8);
+    return m_pending.size() > threshold || m_removedCount > threshold;
 }
 
 //---------------------------------------------------------
-//   climbTree
+//   build
 //---------------------------------------------------------
 
-void BspTree::climbTree(BspTreeVisitor* visitor, const PointF& pos, int index)
+void BspTree::build()
 {
-    if (m_nodes.empty()) {
-        return;
-    }
+    m_dirty = false;
 
-    Node* node = &m_nodes[index];
-    int childIndex = firstChildIndex(index);
-
-    switch (node->type) {
-    case Node::Type::LEAF:
-        visitor->visit(&m_leaves[node->leafIndex]);
-        break;
-    case Node::Type::VERTICAL:
-        if (pos.x() < node->offset) {
-            climbTree(visitor, pos, childIndex);
-        } else {
-            climbTree(visitor, pos, childIndex + 1);
+    std::vector<Entry> entries;
+    entries.reserve(m_index.size() - m_removedCount + m_pending.size());
+    for (const Entry& entry : m_entries) {
+        if (entry.item) {
+            entries.push_back(entry);
         }
-        break;
-    case Node::Type::HORIZONTAL:
-        if (pos.y() < node->offset) {
-            climbTree(visitor, pos, childIndex);
-        } else {
-            climbTree(visitor, pos, childIndex + 1);
-        }
-        break;
     }
-}
+    entries.insert(entries.end(), m_pending.begin(), m_pending.end());
 
-//---------------------------------------------------------
-//   climbTree
-//---------------------------------------------------------
+    m_entries = std::move(entries);
+    m_pending.clear();
+    m_nodes.clear();
+    m_index.clear();
+    m_removedCount = 0;
 
-void BspTree::climbTree(BspTreeVisitor* visitor, const RectF& rec, int index)
-{
-    if (m_nodes.empty()) {
+    if (m_entries.empty()) {
         return;
     }
 
-    Node* node = &m_nodes[index];
-    int childIndex = firstChildIndex(index);
-
-    switch (node->type) {
-    case Node::Type::LEAF:
-        visitor->visit(&m_leaves[node->leafIndex]);
-        break;
-    case Node::Type::VERTICAL:
-        if (rec.left() < node->offset) {
-            climbTree(visitor, rec, childIndex);
-            if (rec.right() >= node->offset) {
-                climbTree(visitor, rec, childIndex + 1);
+    sortTileRecursive(m_entries, 0, m_entries.size(), NODE_SIZE);
+
+    for (size_t i = 0; i < m_entries.size(); i += NODE_SIZE) {
+        Node leaf;
+        leaf.first = static_cast<uint32_t>(i);
+        leaf.count = static_cast<uint32_t>(std::min(NODE_SIZE, m_entries.size() - i));
+        leaf.isLeaf = true;
+        leaf.bounds = m_entries[i].bounds;
+        for (uint32_t j = leaf.first + 1; j < leaf.first + leaf.count; ++j) {
+            leaf.bounds.unite(m_entries[j].bounds);
+        }
+        m_nodes.push_back(leaf);
+    }
+
+    // Pack each level into the parents of the next one, until a single root is left
+    size_t levelBegin = 0;
+    size_t levelEnd = m_nodes.size();
+    while (levelEnd - levelBegin > 1) {
+        sortTileRecursive(m_nodes, levelBegin, levelEnd, NODE_SIZE);
+
+        for (size_t i = levelBegin; i < levelEnd; i += NODE_SIZE) {
+            Node parent;
+            parent.first = static_cast<uint32_t>(i);
+            parent.count = static_cast<uint32_t>(std::min(NODE_SIZE, levelEnd - i));
+            parent.bounds = m_nodes[i].bounds;
+            for (uint32_t j = parent.first + 1; j < parent.first + parent.count; ++j) {
+                parent.bounds.unite(m_nodes[j].bounds);
             }
-        } else {
-            climbTree(visitor, rec, childIndex + 1);
+            m_nodes.push_back(parent);
         }
-        break;
-    case Node::Type::HORIZONTAL:
-        if (rec.top() < node->offset) {
-            climbTree(visitor, rec, childIndex);
-            if (rec.bottom() >= node->offset) {
-                climbTree(visitor, rec, childIndex + 1);
+
+        levelBegin = levelEnd;
+        levelEnd = m_nodes.size();
+    }
+
+    m_index.reserve(m_entries.size());
+    for (size_t n = 0; n < m_nodes.size(); ++n) {
+        const Node& node = m_nodes[n];
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            if (node.isLeaf) {
+                m_entries[i].leaf = static_cast<int>(n);
+                m_index.emplace_back(m_entries[i].item, i);
+            } else {
+                m_nodes[i].parent = static_cast<int>(n);
             }
-        } else {
-            climbTree(visitor, rec, childIndex + 1);
         }
     }
+    std::sort(m_index.begin(), m_index.end());
 }
 
 //---------------------------------------------------------
-//   rectForIndex
+//   refit
 //---------------------------------------------------------
 
-RectF BspTree::rectForIndex(int index) const
+void BspTree::refit(int nodeIndex)
 {
-    if (index <= 0) {
-        return m_rect;
+    while (nodeIndex >= 0) {
+        Node& node = m_nodes[nodeIndex];
+        Bounds bounds = node.isLeaf ? m_entries[node.first].bounds : m_nodes[node.first].bounds;
+        for (uint32_t i = node.first + 1; i < node.first + node.count; ++i) {
+            bounds.unite(node.isLeaf ? m_entries[i].bounds : m_nodes[i].bounds);
+        }
+        node.bounds = bounds;
+        nodeIndex = node.parent;
     }
+}
 
-    int parentIdx = parentIndex(index);
-    RectF rec   = rectForIndex(parentIdx);
-    const Node* parent = &m_nodes.at(parentIdx);
+#ifndef NDEBUG
+//---------------------------------------------------------
+//   debug
+//---------------------------------------------------------
 
-    if (parent->type == Node::Type::HORIZONTAL) {
-        if (index & 1) {
-            rec.setRight(parent->offset);
-        } else {
-            rec.setLeft(parent->offset);
-        }
-    } else {
-        if (index & 1) {
-            rec.setBottom(parent->offset);
-        } else {
-            rec.setTop(parent->offset);
+String BspTree::debug() const
+{
+    String tmp;
+    for (const Node& node : m_nodes) {
+        if (!node.isLeaf) {
+            continue;
         }
+        tmp += String(u"[%1, %2, %3, %4] contains %5 items\n")
+               .arg(node.bounds.left).arg(node.bounds.top)
+               .arg(node.bounds.right - node.bounds.left).arg(node.bounds.bottom - node.bounds.top)
+               .arg(static_cast<int>(node.count));
     }
-    return rec;
+    return tmp;
 }
+
+#endif
 }
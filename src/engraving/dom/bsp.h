@@ -23,94 +23,174 @@
 #ifndef MU_ENGRAVING_BSP_H
 #define MU_ENGRAVING_BSP_H
 
-#include <list>
+#include <cassert>
+#include <cstdint>
+#include <vector>
 
-#include "global/allocator.h"
 #include "types/string.h"
 #include "../types/types.h"
 
 namespace mu::engraving {
-class BspTreeVisitor;
-class InsertItemBspTreeVisitor;
-class RemoveItemBspTreeVisitor;
-class FindItemBspTreeVisitor;
-
 class EngravingItem;
 
 //---------------------------------------------------------
 //   BspTree
-//    binary space partitioning
+//    packed bounding volume hierarchy over the page bounding
+//    rects of the items, bulk loaded with sort-tile-recursive
 //---------------------------------------------------------
 
 class BspTree
 {
 public:
-    struct Node {
-        enum class Type : char {
-            HORIZONTAL, VERTICAL, LEAF
-        };
-        union {
-            double offset;
-            int leafIndex;
-        };
-        Type type;
-    };
-private:
-
-    void initialize(const RectF& rect, int depth, int index);
-    void climbTree(BspTreeVisitor* visitor, const PointF& pos, int index = 0);
-    void climbTree(BspTreeVisitor* visitor, const RectF& rect, int index = 0);
+    BspTree() = default;
 
-    void findItems(std::list<EngravingItem*>* foundItems, const RectF& rect, int index);
-    void findItems(std::list<EngravingItem*>* foundItems, const PointF& pos, int index);
-
-    void nearestNeighbor(const PointF& pos, EngravingItem** bestItem, double& bestDistance, int nodeIndex = 0);
-
-    RectF rectForIndex(int index) const;
-
-    unsigned int m_depth = 0;
-    std::vector<Node> m_nodes;
-    std::vector<std::list<EngravingItem*> > m_leaves;
-    int m_leafCnt = 0;
-    RectF m_rect;
-
-public:
-    BspTree();
-
-    void initialize(const RectF& rect, int depth);
+    void initialize(const RectF& rect, int n);
     void clear();
 
     void insert(EngravingItem* item);
     void remove(EngravingItem* item);
+    bool update(EngravingItem* item);
 
     std::vector<EngravingItem*> items(const RectF& rect);
     std::vector<EngravingItem*> items(const PointF& pos);
 
+    //! NOTE Same items as items(), without collecting them into a vector.
+    //! The tree must not be modified from inside the visitor.
+    template<typename F>
+    void visitItems(const RectF& rect, F&& func);
+    template<typename F>
+    void visitItems(const PointF& pos, F&& func);
+
     EngravingItem* nearestNeighbor(const PointF& pos);
 
-    int leafCount() const { return m_leafCnt; }
-    inline int firstChildIndex(int index) const { return index * 2 + 1; }
-
-    inline int parentIndex(int index) const
-    {
-        return index > 0 ? ((index & 1) ? ((index - 1) / 2) : ((index - 2) / 2)) : -1;
-    }
+    size_t size() const { return m_index.size() + m_pending.size() - m_removedCount; }
+    int leafCount() const;
 
 #ifndef NDEBUG
-    String debug(int index) const;
+    String debug() const;
 #endif
+
+private:
+    struct Bounds {
+        double left = 0.0;
+        double top = 0.0;
+        double right = 0.0;
+        double bottom = 0.0;
+
+        Bounds() = default;
+        explicit Bounds(const RectF& r)
+            : left(r.left()), top(r.top()), right(r.right()), bottom(r.bottom()) {}
+
+        bool intersects(const Bounds& b) const
+        {
+            return left <= b.right && b.left <= right && top <= b.bottom && b.top <= bottom;
+        }
+
+        bool contains(const PointF& p) const
+        {
+            return left <= p.x() && p.x() <= right && top <= p.y() && p.y() <= bottom;
+        }
+
+        PointF center() const { return PointF((left + right) * 0.5, (top + bottom) * 0.5); }
+        double distanceSquared(const PointF& p) const;
+        void unite(const Bounds& b);
+    };
+
+    struct Entry {
+        Bounds bounds;
+        EngravingItem* item = nullptr; // nullptr once removed
+        int leaf = -1;
+    };
+
+    struct Node {
+        Bounds bounds;
+        uint32_t first = 0; // into m_entries for leaves, into m_nodes otherwise
+        uint32_t count = 0;
+        int parent = -1;
+        bool isLeaf = false;
+    };
+
+    static constexpr size_t NODE_SIZE = 16;
+    static constexpr size_t STACK_SIZE = 256;
+
+    static bool intersects(const EngravingItem* item, const RectF& rect);
+    static bool contains(const EngravingItem* item, const PointF& pos);
+
+    void build();
+    void refit(int nodeIndex);
+    bool needsRebuild() const;
+
+    template<typename Overlaps, typename F>
+    void visitEntries(const Overlaps& overlaps, F&& func);
+
+    std::vector<Entry> m_entries;
+    std::vector<Node> m_nodes; // leaves first, the root is the last node
+    std::vector<std::pair<EngravingItem*, uint32_t> > m_index; // sorted by item, points into m_entries
+    std::vector<Entry> m_pending; // inserted since the last build
+    size_t m_removedCount = 0;
+    bool m_dirty = false;
 };
 
-//---------------------------------------------------------
-//   BspTreeVisitor
-//---------------------------------------------------------
+template<typename Overlaps, typename F>
+void BspTree::visitEntries(const Overlaps& overlaps, F&& func)
+{
+    if (m_dirty) {
+        build();
+    }
 
-class BspTreeVisitor
+    if (!m_nodes.empty()) {
+        uint32_t stack[STACK_SIZE];
+        size_t top = 0;
+        stack[top++] = static_cast<uint32_t>(m_nodes.size() - 1);
+
+        while (top > 0) {
+            const Node& node = m_nodes[stack[--top]];
+            if (!overlaps(node.bounds)) {
+                continue;
+            }
+
+            if (node.isLeaf) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    const Entry& entry = m_entries[i];
+                    if (entry.item && overlaps(entry.bounds)) {
+                        func(entry.item);
+                    }
+                }
+            } else {
+                assert(top + node.count <= STACK_SIZE);
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    stack[top++] = i;
+                }
+            }
+        }
+    }
+
+    for (const Entry& entry : m_pending) {
+        if (overlaps(entry.bounds)) {
+            func(entry.item);
+        }
+    }
+}
+
+template<typename F>
+void BspTree::visitItems(const RectF& rect, F&& func)
 {
-    OBJECT_ALLOCATOR(engraving, BspTreeVisitor)
-public:
-    virtual ~BspTreeVisitor() {}
-    virtual void visit(std::list<EngravingItem*>* items) = 0;
-};
+    const Bounds bounds(rect);
+    visitEntries([&bounds](const Bounds& b) { return b.intersects(bounds); }, [&rect, &func](EngravingItem* item) {
+        if (intersects(item, rect)) {
+            func(item);
+        }
+    });
+}
+
+template<typename F>
+void BspTree::visitItems(const PointF& pos, F&& func)
+{
+    visitEntries([&pos](const Bounds& b) { return b.contains(pos); }, [&pos, &func](EngravingItem* item) {
+        if (contains(item, pos)) {
+            func(item);
+        }
+    });
+}
 } // namespace mu::engraving
 #endif
@@ -60,6 +60,7 @@ MasterScore::MasterScore(const muse::modularity::ContextPtr& iocCtx, std::weak_p
 {
     m_project = project;
     m_undoStack   = new UndoStack();
+    m_undoStack->setMemoryBudget(configuration()->undoMemoryBudget());
     m_tempomap    = new TempoMap;
     m_sigmap      = new TimeSigMap();
     m_expandedRepeatList  = new RepeatList(this);
@@ -22,6 +22,8 @@
 
 #include "measurebase.h"
 
+#include <algorithm>
+
 #include "factory.h"
 #include "layoutbreak.h"
 #include "measure.h"
@@ -823,6 +825,7 @@ void MeasureBaseList::push_front(MeasureBase* e)
 
 void MeasureBaseList::add(MeasureBase* e)
 {
+    invalidateTickIndex();
     MeasureBase* el = e->next();
     if (el == 0) {
         push_back(e);
@@ -844,6 +847,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    invalidateTickIndex();
     --m_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -863,6 +867,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    invalidateTickIndex();
     ++m_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++m_size;
@@ -887,6 +892,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    invalidateTickIndex();
     --m_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --m_size;
@@ -911,6 +917,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    invalidateTickIndex();
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -933,3 +940,64 @@ void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
         e->setParent(nb);
     }
 }
+
+//---------------------------------------------------------
+//   rebuildTickIndex
+//---------------------------------------------------------
+
+void MeasureBaseList::rebuildTickIndex() const
+{
+    m_tickIndex.clear();
+    m_tickIndex.reserve(m_size);
+    for (MeasureBase* mb = m_first; mb; mb = mb->next()) {
+        if (mb->isMeasure()) {
+            m_tickIndex.push_back(toMeasure(mb));
+        }
+    }
+    m_tickIndexValid = true;
+}
+
+//---------------------------------------------------------
+//   findInTickIndex
+//---------------------------------------------------------
+
+Measure* MeasureBaseList::findInTickIndex(const Fraction& tick) const
+{
+    auto it = std::upper_bound(m_tickIndex.cbegin(), m_tickIndex.cend(), tick, [](const Fraction& t, const Measure* m) {
+        return t < m->tick();
+    });
+
+    if (it == m_tickIndex.cbegin()) {
+        return nullptr;
+    }
+
+    return *(it - 1);
+}
+
+//---------------------------------------------------------
+//   measureAtTick
+//    return the last measure starting at or before tick,
+//    using binary search over the cached measure order
+//---------------------------------------------------------
+
+Measure* MeasureBaseList::measureAtTick(const Fraction& tick) const
+{
+    if (!m_tickIndexValid) {
+        rebuildTickIndex();
+    }
+
+    Measure* m = findInTickIndex(tick);
+    if (!m) {
+        return nullptr;
+    }
+
+    // The measures may have been relinked without going through this list;
+    // make sure the found measure is still consistent with its neighbour
+    Measure* next = m->nextMeasure();
+    if (next && tick >= next->tick()) {
+        rebuildTickIndex();
+        m = findInTickIndex(tick);
+    }
+
+    return m;
+}
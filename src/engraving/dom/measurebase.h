@@ -28,6 +28,8 @@
  Definition of MeasureBase class.
 */
 
+#include <vector>
+
 #include "engravingitem.h"
 
 namespace mu::engraving {
@@ -229,7 +231,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return m_first; }
     MeasureBase* last()  const { return m_last; }
-    void clear() { m_first = m_last = 0; m_size = 0; }
+    void clear() { m_first = m_last = 0; m_size = 0; invalidateTickIndex(); }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -238,13 +240,25 @@ public:
     int size() const { return m_size; }
     bool empty() const { return m_size == 0; }
 
+    Measure* measureAtTick(const Fraction& tick) const;
+    void invalidateTickIndex() { m_tickIndexValid = false; }
+
 private:
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
 
+    void rebuildTickIndex() const;
+    Measure* findInTickIndex(const Fraction& tick) const;
+
     int m_size = 0;
     MeasureBase* m_first = nullptr;
     MeasureBase* m_last = nullptr;
+
+    // Measures in list order, used for binary search by tick.
+    // Only the order is cached: the ticks are read from the measures themselves,
+    // so the index only needs to be rebuilt when the list structure changes.
+    mutable std::vector<Measure*> m_tickIndex;
+    mutable bool m_tickIndexValid = false;
 };
 } // namespace mu::engraving
 #endif
@@ -22,6 +22,9 @@
 
 #include "mscore.h"
 
+#include <map>
+#include <mutex>
+
 #include "figuredbass.h"
 #include "hairpin.h"
 #include "lyrics.h"
@@ -130,4 +133,62 @@ std::string MScore::errorToString(MsError err)
 
     return {};
 }
+
+//---------------------------------------------------------
+//   PrintStateGuard
+//---------------------------------------------------------
+
+static std::mutex s_printStateMutex;
+static size_t s_printStateGuards = 0;
+static bool s_isPrintStateSet = false;
+static double s_pixelRatioBackup = 0.0;
+static std::map<Score*, size_t> s_printingScores;
+
+PrintStateGuard::PrintStateGuard(Score* score, const State& state)
+    : m_score(score)
+{
+    acquire(&state);
+}
+
+PrintStateGuard::PrintStateGuard(Score* score)
+    : m_score(score)
+{
+    acquire(nullptr);
+}
+
+void PrintStateGuard::acquire(const State* state)
+{
+    std::lock_guard lock(s_printStateMutex);
+
+    ++s_printStateGuards;
+
+    if (m_score && s_printingScores[m_score]++ == 0) {
+        m_score->setPrinting(true); // don’t print page break symbols etc.
+    }
+
+    if (state && !s_isPrintStateSet) {
+        s_pixelRatioBackup = MScore::pixelRatio;
+        MScore::pixelRatio = state->pixelRatio;
+        MScore::pdfPrinting = true;
+        MScore::svgPrinting = state->svgPrinting;
+        s_isPrintStateSet = true;
+    }
+}
+
+PrintStateGuard::~PrintStateGuard()
+{
+    std::lock_guard lock(s_printStateMutex);
+
+    if (m_score && --s_printingScores[m_score] == 0) {
+        s_printingScores.erase(m_score);
+        m_score->setPrinting(false);
+    }
+
+    if (--s_printStateGuards == 0 && s_isPrintStateSet) {
+        MScore::pixelRatio = s_pixelRatioBackup;
+        MScore::pdfPrinting = false;
+        MScore::svgPrinting = false;
+        s_isPrintStateSet = false;
+    }
+}
 }
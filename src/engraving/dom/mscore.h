@@ -246,6 +246,42 @@ public:
 
     static std::string errorToString(MsError err);
 };
+
+class Score;
+
+//---------------------------------------------------------
+//   PrintStateGuard
+//---------------------------------------------------------
+
+//! NOTE The print state (MScore::pixelRatio, pdfPrinting, svgPrinting and the printing flag of the score) is global,
+//! while the pages of a score may be painted concurrently (see ConverterUtils::writePages).
+//! So it is set up by the first guard and restored by the last one; the guards in between only read it,
+//! and are expected to want the same state
+class PrintStateGuard
+{
+public:
+    struct State {
+        double pixelRatio = 1.0;
+        bool svgPrinting = false;
+    };
+
+    //! Sets up the state, unless it's already set up by another guard
+    PrintStateGuard(Score* score, const State& state);
+
+    //! Only keeps the state set up by the guards created meanwhile until it's destroyed,
+    //! so that the state is set up once for all the pages painted in its scope
+    explicit PrintStateGuard(Score* score);
+
+    ~PrintStateGuard();
+
+    PrintStateGuard(const PrintStateGuard&) = delete;
+    PrintStateGuard& operator=(const PrintStateGuard&) = delete;
+
+private:
+    void acquire(const State* state);
+
+    Score* m_score = nullptr;
+};
 } // namespace mu::engraving
 
 #endif
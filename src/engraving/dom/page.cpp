@@ -74,6 +74,18 @@ std::vector<EngravingItem*> Page::items(const PointF& point)
     return bspTree.items(point);
 }
 
+//---------------------------------------------------------
+//   updateBspTree
+//    refits the lookup tree after a single item has moved
+//---------------------------------------------------------
+
+void Page::updateBspTree(EngravingItem* item)
+{
+    if (m_bspTreeValid && !bspTree.update(item)) {
+        m_bspTreeValid = false;
+    }
+}
+
 //---------------------------------------------------------
 //   appendSystem
 //---------------------------------------------------------
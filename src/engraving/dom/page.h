@@ -76,7 +76,10 @@ public:
 
     std::vector<EngravingItem*> items(const RectF& r);
     std::vector<EngravingItem*> items(const PointF& p);
+    template<typename F>
+    void visitItems(const RectF& r, F&& func);
     void invalidateBspTree() { m_bspTreeValid = false; }
+    void updateBspTree(EngravingItem* item);
     PointF pagePos() const override { return PointF(); }       ///< position in page coordinates
     std::vector<EngravingItem*> elements() const;              ///< list of visible elements
     RectF tbbox() const;                             // tight bounding box, excluding white space
@@ -103,5 +106,14 @@ private:
     BspTree bspTree;
     bool m_bspTreeValid = false;
 };
+
+template<typename F>
+void Page::visitItems(const RectF& r, F&& func)
+{
+    if (!m_bspTreeValid) {
+        doRebuildBspTree();
+    }
+    bspTree.visitItems(r, std::forward<F>(func));
+}
 } // namespace mu::engraving
 #endif
@@ -23,6 +23,7 @@
 #ifndef MU_ENGRAVING_REPEATLIST_H
 #define MU_ENGRAVING_REPEATLIST_H
 
+#include <atomic>
 #include <set>
 #include <vector>
 
@@ -113,7 +114,9 @@ private:
     void flatten();
 
     Score* m_score = nullptr;
-    mutable unsigned m_idx1, m_idx2 = 0;     // cached values
+    //! NOTE Lookup hints, relaxed atomics so that the const lookups can be used from several threads
+    mutable std::atomic<unsigned> m_idx1 = 0;
+    mutable std::atomic<unsigned> m_idx2 = 0;
 
     bool m_expanded = false;
     bool m_scoreChanged = true;
@@ -31,11 +31,14 @@
 #include <map>
 
 #include "containers.h"
+#include "global/allocator.h"
 
 #include "style/style.h"
 #include "style/defaultstyle.h"
 #include "compat/dummyelement.h"
 
+#include "engravingproject.h"
+
 #include "iengravingfont.h"
 #include "types/translatablestring.h"
 #include "types/typesconv.h"
@@ -4201,16 +4204,14 @@ void Score::lassoSelect(const RectF& bbox)
             break;
         }
 
-        std::vector<EngravingItem*> items = page->items(frr);
         std::vector<EngravingItem*> itemsToSelect;
-
-        for (EngravingItem* item : items) {
+        page->visitItems(frr, [&frr, &itemsToSelect](EngravingItem* item) {
             if (frr.contains(item->pageBoundingRect())) {
                 if (item->type() != ElementType::MEASURE && item->selectable()) {
                     itemsToSelect.push_back(item);
                 }
             }
-        }
+        });
 
         select(itemsToSelect, SelectType::ADD, 0);
     }
@@ -6022,6 +6023,10 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 {
     TRACEFUNC;
 
+    //! NOTE The items created by the layout belong to the project, like the loaded ones
+    std::shared_ptr<EngravingProject> project = masterScore()->project().lock();
+    muse::ObjectArena::Scope arenaScope(project ? project->allocatorArena() : nullptr);
+
     Fraction start = st;
     Fraction end = et;
 
@@ -60,42 +60,30 @@ void SpannerMap::update() const
 //   findContained
 //---------------------------------------------------------
 
-const SpannerMap::IntervalList& SpannerMap::findContained(int start, int stop, bool excludeCollisions) const
+SpannerMap::IntervalList SpannerMap::findContained(int start, int stop, bool excludeCollisions) const
 {
-    if (m_dirty) {
-        update();
-    }
-
-    m_results.clear();
+    ensureUpdated();
 
     if (excludeCollisions) {
-        m_results = m_collisionFreeTree.findContained(start, stop);
-    } else {
-        m_results = m_tree.findContained(start, stop);
+        return m_collisionFreeTree.findContained(start, stop);
     }
 
-    return m_results;
+    return m_tree.findContained(start, stop);
 }
 
 //---------------------------------------------------------
 //   findOverlapping
 //---------------------------------------------------------
 
-const SpannerMap::IntervalList& SpannerMap::findOverlapping(int start, int stop, bool excludeCollisions) const
+SpannerMap::IntervalList SpannerMap::findOverlapping(int start, int stop, bool excludeCollisions) const
 {
-    if (m_dirty) {
-        update();
-    }
-
-    m_results.clear();
+    ensureUpdated();
 
     if (excludeCollisions) {
-        m_results = m_collisionFreeTree.findOverlapping(start, stop);
-    } else {
-        m_results = m_tree.findOverlapping(start, stop);
+        return m_collisionFreeTree.findOverlapping(start, stop);
     }
 
-    return m_results;
+    return m_tree.findOverlapping(start, stop);
 }
 
 void SpannerMap::collectIntervals(IntervalList& regularIntervals, IntervalList& collisionFreeIntervals) const
@@ -44,8 +44,10 @@ public:
 
     SpannerMap();
 
-    const IntervalList& findContained(int start, int stop, bool excludeCollisions = false) const;
-    const IntervalList& findOverlapping(int start, int stop, bool excludeCollisions = false) const;
+    //! NOTE The results are returned by value, so that the lookups can be used from several threads
+    //! once the lookup tree is up to date (see ensureUpdated)
+    IntervalList findContained(int start, int stop, bool excludeCollisions = false) const;
+    IntervalList findOverlapping(int start, int stop, bool excludeCollisions = false) const;
     const std::multimap<int, Spanner*>& map() const { return *this; }
 
     void collectIntervals(IntervalList& regularIntervals, IntervalList& collisionFreeIntervals) const;
@@ -59,6 +61,7 @@ public:
     void clear() { std::multimap<int, Spanner*>::clear(); m_dirty = true; }
     bool empty() const { return std::multimap<int, Spanner*>::empty(); }
     void update() const;
+    void ensureUpdated() const { if (m_dirty) { update(); } }
     void setDirty() const { m_dirty = true; }     // must be called if a spanner changes start/length
 #ifndef NDEBUG
     void dump() const;
@@ -69,7 +72,6 @@ private:
     mutable bool m_dirty = false;
     mutable interval_tree::IntervalTree<Spanner*> m_tree;
     mutable interval_tree::IntervalTree<Spanner*> m_collisionFreeTree;
-    mutable std::vector<interval_tree::Interval<Spanner*> > m_results;
 };
 } // namespace mu::engraving
 
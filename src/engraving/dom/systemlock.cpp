@@ -154,7 +154,7 @@ void SystemLockIndicator::setSelected(bool v)
 {
     EngravingItem::setSelected(v);
     renderer()->layoutItem(this);
-    system()->page()->invalidateBspTree();
+    system()->page()->updateBspTree(this);
 }
 
 char16_t SystemLockIndicator::iconCode() const
@@ -192,6 +192,16 @@ UndoCommand::~UndoCommand()
     }
 }
 
+//---------------------------------------------------------
+//   deleteChildren
+//---------------------------------------------------------
+
+void UndoCommand::deleteChildren()
+{
+    muse::DeleteAll(childList);
+    childList.clear();
+}
+
 //---------------------------------------------------------
 //   UndoCommand::cleanup
 //---------------------------------------------------------
@@ -203,6 +213,24 @@ void UndoCommand::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   memoryUsage
+//    commands that don't report their own size are
+//    counted as a plain UndoCommand
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage() const
+{
+    // std::list node: two links and the pointer
+    static constexpr size_t LIST_NODE_SIZE = 3 * sizeof(void*);
+
+    size_t size = sizeof(UndoCommand);
+    for (const UndoCommand* c : childList) {
+        size += LIST_NODE_SIZE + c->memoryUsage();
+    }
+    return size;
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -385,6 +413,14 @@ void UndoStack::pushAndPerform(UndoCommand* cmd, EditData* ed)
         LOG_UNDO() << cmd->name();
     }
 #endif
+    const std::list<UndoCommand*>& commands = m_activeCommand->commands();
+    if (!commands.empty() && commands.back()->canCoalesce(cmd)) {
+        cmd->redo(ed);
+        delete cmd;
+        ++m_coalescedCount;
+        return;
+    }
+
     m_activeCommand->appendChild(cmd);
     cmd->redo(ed);
 }
@@ -414,21 +450,27 @@ void UndoStack::remove(size_t idx)
     assert(m_currentIndex != muse::nidx);
     // remove redo stack
     while (m_macroList.size() > m_currentIndex) {
-        UndoCommand* cmd = muse::takeLast(m_macroList);
         m_stateList.pop_back();
-        cmd->cleanup(false);      // delete elements for which UndoCommand() holds ownership
-        delete cmd;
-//            --curIdx;
+        deleteMacro(muse::takeLast(m_macroList), false);
     }
     while (m_macroList.size() > idx) {
-        UndoCommand* cmd = muse::takeLast(m_macroList);
         m_stateList.pop_back();
-        cmd->cleanup(true);
-        delete cmd;
+        deleteMacro(muse::takeLast(m_macroList), true);
     }
     m_currentIndex = idx;
 }
 
+//---------------------------------------------------------
+//   deleteMacro
+//---------------------------------------------------------
+
+void UndoStack::deleteMacro(UndoMacro* macro, bool undo)
+{
+    m_memoryUsage -= macro->cachedMemoryUsage();
+    macro->cleanup(undo);      // delete elements for which UndoCommand() holds ownership
+    delete macro;
+}
+
 //---------------------------------------------------------
 //   mergeCommands
 //---------------------------------------------------------
@@ -437,16 +479,22 @@ void UndoStack::mergeCommands(size_t startIdx)
 {
     assert(startIdx <= m_currentIndex);
 
+    // Evicted macros can't be merged into anymore
+    startIdx = std::max(startIdx, m_evictedCount);
     if (startIdx >= m_macroList.size()) {
         return;
     }
 
     UndoMacro* startMacro = m_macroList[startIdx];
+    m_memoryUsage -= startMacro->cachedMemoryUsage();
 
     for (size_t idx = startIdx + 1; idx < m_currentIndex; ++idx) {
         startMacro->append(std::move(*m_macroList[idx]));
     }
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
+
+    startMacro->updateMemoryUsage();
+    m_memoryUsage += startMacro->cachedMemoryUsage();
 }
 
 //---------------------------------------------------------
@@ -484,16 +532,20 @@ void UndoStack::endMacro(bool rollback)
     } else {
         // remove redo stack
         while (m_macroList.size() > m_currentIndex) {
-            UndoCommand* cmd = muse::takeLast(m_macroList);
             m_stateList.pop_back();
-            cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
-            delete cmd;
+            deleteMacro(muse::takeLast(m_macroList), false);
         }
+        m_activeCommand->updateMemoryUsage();
+        m_memoryUsage += m_activeCommand->cachedMemoryUsage();
         m_macroList.push_back(m_activeCommand);
         m_stateList.push_back(m_nextState++);
         ++m_currentIndex;
     }
     m_activeCommand = nullptr;
+
+    if (!rollback) {
+        evictToBudget();
+    }
 }
 
 //---------------------------------------------------------
@@ -508,10 +560,11 @@ void UndoStack::reopen()
 
     LOG_UNDO() << "curIdx: " << m_currentIndex << ", size: " << m_macroList.size();
     assert(m_activeCommand == nullptr);
-    assert(m_currentIndex > 0);
+    assert(canUndo());
     --m_currentIndex;
     m_activeCommand = muse::takeAt(m_macroList, m_currentIndex);
     m_stateList.erase(m_stateList.begin() + m_currentIndex);
+    m_memoryUsage -= m_activeCommand->cachedMemoryUsage();
     for (auto i : m_activeCommand->commands()) {
         LOG_UNDO() << "   " << i->name();
     }
@@ -532,7 +585,7 @@ void UndoStack::undo(EditData* ed)
             return;
         }
     }
-    if (m_currentIndex) {
+    if (canUndo()) {
         --m_currentIndex;
         assert(m_currentIndex < m_macroList.size());
         m_macroList[m_currentIndex]->undo(ed);
@@ -551,6 +604,52 @@ void UndoStack::redo(EditData* ed)
     }
 }
 
+//---------------------------------------------------------
+//   setMemoryBudget
+//---------------------------------------------------------
+
+void UndoStack::setMemoryBudget(size_t bytes)
+{
+    m_memoryBudget = bytes;
+    evictToBudget();
+}
+
+//---------------------------------------------------------
+//   memoryStats
+//---------------------------------------------------------
+
+UndoStack::MemoryStats UndoStack::memoryStats() const
+{
+    MemoryStats stats;
+    stats.budget = m_memoryBudget;
+    stats.usage = m_memoryUsage;
+    stats.macroCount = m_macroList.size();
+    stats.evictedMacroCount = m_evictedCount;
+    stats.coalescedCommandCount = m_coalescedCount;
+    return stats;
+}
+
+//---------------------------------------------------------
+//   evictToBudget
+//    the last done macro is kept, as it may still be
+//    reopened or merged with the next ones
+//---------------------------------------------------------
+
+void UndoStack::evictToBudget()
+{
+    if (m_memoryBudget == 0) {
+        return;
+    }
+
+    while (m_memoryUsage > m_memoryBudget && m_evictedCount + 1 < m_currentIndex) {
+        UndoMacro* macro = m_macroList[m_evictedCount++];
+        m_memoryUsage -= macro->cachedMemoryUsage();
+        macro->evict();
+        macro->updateMemoryUsage();
+        m_memoryUsage += macro->cachedMemoryUsage();
+    }
+}
+
 //---------------------------------------------------------
 //   UndoMacro
 //---------------------------------------------------------
@@ -647,6 +746,26 @@ void UndoMacro::append(UndoMacro&& other)
     }
 }
 
+size_t UndoMacro::memoryUsage() const
+{
+    return UndoCommand::memoryUsage() - sizeof(UndoCommand) + sizeof(UndoMacro)
+           + (m_undoSelectionInfo.elements.capacity() + m_redoSelectionInfo.elements.capacity()) * sizeof(EngravingItem*);
+}
+
+//---------------------------------------------------------
+//   evict
+//    drops the commands, keeping the macro as a named
+//    entry of the history that can't be undone anymore
+//---------------------------------------------------------
+
+void UndoMacro::evict()
+{
+    cleanup(true);
+    deleteChildren();
+    m_undoSelectionInfo = SelectionInfo();
+    m_redoSelectionInfo = SelectionInfo();
+}
+
 const InputState& UndoMacro::undoInputState() const
 {
     return m_undoInputState;
@@ -1111,6 +1230,20 @@ void RemoveElement::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   memoryUsage
+//    the removed subtree is kept alive by the command
+//---------------------------------------------------------
+
+size_t RemoveElement::memoryUsage() const
+{
+    size_t size = sizeof(RemoveElement);
+    if (element) {
+        element->scanElements(&size, [](void* data, EngravingItem*) { *static_cast<size_t*>(data) += sizeof(EngravingItem); }, true);
+    }
+    return size;
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -2801,6 +2934,27 @@ std::vector<EngravingObject*> ChangeProperty::objectItems() const
     return compoundObjects(element);
 }
 
+size_t ChangeProperty::memoryUsage() const
+{
+    return sizeof(ChangeProperty) + property.memoryUsage();
+}
+
+//---------------------------------------------------------
+//   ChangeProperty::canCoalesce
+//    undoing the first of two consecutive changes of the
+//    same property restores the value from before both
+//---------------------------------------------------------
+
+bool ChangeProperty::canCoalesce(const UndoCommand* next) const
+{
+    if (!isCoalescable() || next->type() != CommandType::ChangeProperty) {
+        return false;
+    }
+
+    const ChangeProperty* cp = static_cast<const ChangeProperty*>(next);
+    return cp->isCoalescable() && cp->element == element && cp->id == id;
+}
+
 //---------------------------------------------------------
 //   ChangeBracketProperty::flip
 //---------------------------------------------------------
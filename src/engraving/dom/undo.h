@@ -103,6 +103,7 @@ class UndoCommand
 protected:
     virtual void flip(EditData*) {}
     void appendChildren(UndoCommand*);
+    void deleteChildren();
 
 public:
     enum class Filter : unsigned char {
@@ -125,6 +126,13 @@ public:
     const std::list<UndoCommand*>& commands() const { return childList; }
     virtual std::vector<EngravingObject*> objectItems() const { return {}; }
     virtual void cleanup(bool undo);
+
+    //! NOTE Estimated memory held by the command and its children
+    virtual size_t memoryUsage() const;
+
+    //! NOTE Whether \p next, performed right after this command, is undone by undoing this one,
+    //! so that \p next doesn't need to be recorded
+    virtual bool canCoalesce(const UndoCommand* /* next */) const { return false; }
 // #ifndef QT_NO_DEBUG
     virtual const char* name() const { return "UndoCommand"; }
 // #endif
@@ -177,6 +185,12 @@ public:
     ChangesInfo changesInfo(bool undo = false) const;
     const TranslatableString& actionName() const;
 
+    size_t memoryUsage() const override;
+    size_t cachedMemoryUsage() const { return m_memoryUsage; }
+    void updateMemoryUsage() { m_memoryUsage = memoryUsage(); }
+
+    void evict();
+
     static bool canRecordSelectedElement(const EngravingItem* e);
 
     UNDO_NAME("UndoMacro")
@@ -190,6 +204,8 @@ private:
 
     Score* m_score = nullptr;
 
+    size_t m_memoryUsage = 0;
+
     static void fillSelectionInfo(SelectionInfo&, const Selection&);
     static void applySelectionInfo(const SelectionInfo&, Selection&);
 };
@@ -197,6 +213,14 @@ private:
 class UndoStack
 {
 public:
+    struct MemoryStats {
+        size_t budget = 0;
+        size_t usage = 0;
+        size_t macroCount = 0;
+        size_t evictedMacroCount = 0;
+        size_t coalescedCommandCount = 0;
+    };
+
     UndoStack();
     ~UndoStack();
 
@@ -212,7 +236,7 @@ public:
     void pushWithoutPerforming(UndoCommand*);
     void pop();
 
-    bool canUndo() const { return m_currentIndex > 0; }
+    bool canUndo() const { return m_currentIndex > m_evictedCount; }
     bool canRedo() const { return m_currentIndex < m_macroList.size(); }
     bool isClean() const { return m_cleanState == m_stateList[m_currentIndex]; }
 
@@ -221,8 +245,8 @@ public:
 
     UndoMacro* activeCommand() const { return m_activeCommand; }
 
-    UndoMacro* last() const { return m_currentIndex > 0 ? m_macroList[m_currentIndex - 1] : nullptr; }
-    UndoMacro* prev() const { return m_currentIndex > 1 ? m_macroList[m_currentIndex - 2] : nullptr; }
+    UndoMacro* last() const { return canUndo() ? m_macroList[m_currentIndex - 1] : nullptr; }
+    UndoMacro* prev() const { return m_currentIndex > m_evictedCount + 1 ? m_macroList[m_currentIndex - 2] : nullptr; }
     UndoMacro* next() const { return canRedo() ? m_macroList[m_currentIndex] : nullptr; }
 
     /// Returns the command that led to the state with the given `idx`.
@@ -240,8 +264,15 @@ public:
     void mergeCommands(size_t startIdx);
     void cleanRedoStack() { remove(m_currentIndex); }
 
+    //! NOTE When the history takes more than \p bytes, the oldest macros are evicted:
+    //! they keep their place and name in the history, but can no longer be undone. 0 means no limit
+    void setMemoryBudget(size_t bytes);
+    MemoryStats memoryStats() const;
+
 private:
     void remove(size_t idx);
+    void deleteMacro(UndoMacro* macro, bool undo);
+    void evictToBudget();
 
     UndoMacro* m_activeCommand = nullptr;
     std::vector<UndoMacro*> m_macroList;
@@ -250,6 +281,11 @@ private:
     int m_cleanState = 0;
     size_t m_currentIndex = 0;
     bool m_isLocked = false;
+
+    size_t m_memoryBudget = 0;
+    size_t m_memoryUsage = 0;
+    size_t m_evictedCount = 0;
+    size_t m_coalescedCount = 0;
 };
 
 class InsertPart : public UndoCommand
@@ -707,6 +743,7 @@ public:
     void undo(EditData*) override;
     void redo(EditData*) override;
     void cleanup(bool) override;
+    size_t memoryUsage() const override;
     const char* name() const override;
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
@@ -1209,6 +1246,12 @@ public:
 
     std::vector<EngravingObject*> objectItems() const override;
 
+    size_t memoryUsage() const override;
+    bool canCoalesce(const UndoCommand* next) const override;
+
+    //! NOTE Whether the command only sets the property, the subclasses also change other state
+    virtual bool isCoalescable() const { return true; }
+
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override
     {
         return f == UndoCommand::Filter::ChangePropertyLinked && muse::contains(target->linkList(), element);
@@ -1229,6 +1272,8 @@ public:
         : ChangeProperty(nullptr, i, v, ps), staff(s), level(l) {}
     UNDO_NAME("ChangeBracketProperty")
     UNDO_CHANGED_OBJECTS({ staff })
+
+    bool isCoalescable() const override { return false; }
 };
 
 class ChangeTextLineProperty : public ChangeProperty
@@ -1241,6 +1286,8 @@ public:
     ChangeTextLineProperty(EngravingObject* e, PropertyValue v)
         : ChangeProperty(e, Pid::SYSTEM_FLAG, v, PropertyFlags::NOSTYLE) {}
     UNDO_NAME("ChangeTextLineProperty")
+
+    bool isCoalescable() const override { return false; }
 };
 
 class ChangeMetaText : public UndoCommand
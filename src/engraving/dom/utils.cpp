@@ -77,19 +77,15 @@ Measure* Score::tick2measure(const Fraction& tick) const
         return firstMeasure();
     }
 
-    Measure* lm = 0;
-    for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-        if (tick < m->tick()) {
-            assert(lm);
-            return lm;
-        }
-        lm = m;
+    Measure* m = m_measures.measureAtTick(tick);
+    if (!m) {
+        return 0;
     }
     // check last measure
-    if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
-        return lm;
+    if (m->nextMeasure() || tick <= m->endTick()) {
+        return m;
     }
-    LOGD("tick2measure %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
+    LOGD("tick2measure %d (max %d) not found", tick.ticks(), m->tick().ticks());
     return 0;
 }
 
@@ -107,21 +103,17 @@ Measure* Score::tick2measureMM(const Fraction& t) const
         tick = Fraction(0, 1);
     }
 
-    Measure* lm = 0;
-
-    for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
-        if (tick < m->tick()) {
-            assert(lm);
-            return lm;
-        }
-        lm = m;
+    Measure* m = tick2measure(tick);
+    if (!m) {
+        LOGD("tick2measureMM %d not found", tick.ticks());
+        return 0;
     }
-    // check last measure
-    if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
-        return lm;
+
+    Measure* mmRest = m->coveringMMRestOrThis();
+    if (mmRest && mmRest != m && tick >= mmRest->tick() && tick <= mmRest->endTick()) {
+        return mmRest;
     }
-    LOGD("tick2measureMM %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
-    return 0;
+    return m;
 }
 
 //---------------------------------------------------------
@@ -130,12 +122,9 @@ Measure* Score::tick2measureMM(const Fraction& t) const
 
 MeasureBase* Score::tick2measureBase(const Fraction& tick) const
 {
-    for (MeasureBase* mb = first(); mb; mb = mb->next()) {
-        Fraction st = mb->tick();
-        Fraction l  = mb->ticks();
-        if (tick >= st && tick < (st + l)) {
-            return mb;
-        }
+    Measure* m = m_measures.measureAtTick(tick);
+    if (m && tick >= m->tick() && tick < m->endTick()) {
+        return m;
     }
 //      LOGD("tick2measureBase %d not found", tick);
     return 0;
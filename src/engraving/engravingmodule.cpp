@@ -64,6 +64,7 @@
 #include "devtools/engravingelementsprovider.h"
 #include "devtools/engravingelementsmodel.h"
 #include "devtools/corruptscoredevtoolsmodel.h"
+#include "devtools/undostackdevtoolsmodel.h"
 #include "devtools/drawdata/diagnosticdrawprovider.h"
 #endif
 
@@ -158,6 +159,7 @@ void EngravingModule::registerUiTypes()
 #ifdef MUE_BUILD_ENGRAVING_DEVTOOLS
     qmlRegisterType<EngravingElementsModel>("MuseScore.Engraving", 1, 0, "EngravingElementsModel");
     qmlRegisterType<CorruptScoreDevToolsModel>("MuseScore.Engraving", 1, 0, "CorruptScoreDevToolsModel");
+    qmlRegisterType<UndoStackDevToolsModel>("MuseScore.Engraving", 1, 0, "UndoStackDevToolsModel");
 #endif
 }
 
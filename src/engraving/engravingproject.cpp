@@ -56,7 +56,7 @@ std::shared_ptr<EngravingProject> EngravingProject::create(const MStyle& style,
 }
 
 EngravingProject::EngravingProject(const modularity::ContextPtr& iocCtx)
-    : muse::Injectable(iocCtx)
+    : muse::Injectable(iocCtx), m_allocatorArena(std::make_unique<muse::ObjectArena>("engraving"))
 {
     muse::ObjectAllocator::used();
 }
@@ -64,6 +64,7 @@ EngravingProject::EngravingProject(const modularity::ContextPtr& iocCtx)
 EngravingProject::~EngravingProject()
 {
     delete m_masterScore;
+    m_allocatorArena.reset();
 
     muse::ObjectAllocator::unused();
 
@@ -74,6 +75,7 @@ EngravingProject::~EngravingProject()
 
 void EngravingProject::init(const MStyle& style)
 {
+    muse::ObjectArena::Scope arenaScope(m_allocatorArena.get());
     m_masterScore = new MasterScore(iocContext(), style, weak_from_this());
 }
 
@@ -140,21 +142,27 @@ MasterScore* EngravingProject::masterScore() const
     return m_masterScore;
 }
 
+muse::ObjectArena* EngravingProject::allocatorArena() const
+{
+    return m_allocatorArena.get();
+}
+
 Ret EngravingProject::loadMscz(const MscReader& msc, SettingsCompat& settingsCompat, bool ignoreVersionError)
 {
     TRACEFUNC;
 
     MScore::setError(MsError::MS_NO_ERROR);
+    muse::ObjectArena::Scope arenaScope(m_allocatorArena.get());
     MscLoader loader;
     return loader.loadMscz(m_masterScore, msc, settingsCompat, ignoreVersionError);
 }
 
-bool EngravingProject::writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail)
+bool EngravingProject::writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail, MscExcerptsCache* excerptsCache)
 {
     TRACEFUNC;
 
     MscSaver saver(iocContext());
-    return saver.writeMscz(m_masterScore, writer, onlySelection, createThumbnail);
+    return saver.writeMscz(m_masterScore, writer, onlySelection, createThumbnail, excerptsCache);
 }
 
 bool EngravingProject::isCorruptedUponLoading() const
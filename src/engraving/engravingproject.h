@@ -43,9 +43,14 @@
 //! we need to strive to ensure that there is work with the project everywhere;
 //! accordingly, only the project should create and load the master score.
 
+namespace muse {
+class ObjectArena;
+}
+
 namespace mu::engraving {
 class MasterScore;
 class MStyle;
+struct MscExcerptsCache;
 
 class EngravingProject : public std::enable_shared_from_this<EngravingProject>, public muse::Injectable
 {
@@ -67,10 +72,11 @@ public:
     bool readOnly() const;
 
     MasterScore* masterScore() const;
+    muse::ObjectArena* allocatorArena() const;
     muse::Ret setupMasterScore(bool forceMode);
 
     muse::Ret loadMscz(const MscReader& msc, SettingsCompat& settingsCompat, bool ignoreVersionError);
-    bool writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail);
+    bool writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail, MscExcerptsCache* excerptsCache = nullptr);
 
     bool isCorruptedUponLoading() const;
     muse::Ret checkCorrupted() const;
@@ -86,6 +92,10 @@ private:
 
     MasterScore* m_masterScore = nullptr;
 
+    //! NOTE The engraving objects of the project are allocated in this arena (when the custom allocator is used),
+    //! so the memory is given back when the project is closed
+    std::unique_ptr<muse::ObjectArena> m_allocatorArena;
+
     bool m_isCorruptedUponLoading = false;
 };
 
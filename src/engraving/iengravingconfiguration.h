@@ -129,6 +129,9 @@ public:
     virtual bool doNotSaveEIDsForBackCompat() const = 0;
     virtual void setDoNotSaveEIDsForBackCompat(bool doNotSave) = 0;
 
+    /// in bytes, 0 means unlimited
+    virtual size_t undoMemoryBudget() const = 0;
+
     /// these configurations will be removed after solving https://github.com/musescore/MuseScore/issues/14294
     virtual bool guitarProImportExperimental() const = 0;
     virtual bool experimentalGuitarBendImport() const = 0;
@@ -28,12 +28,21 @@ using namespace mu::engraving;
 
 EID EIDRegister::newEIDForItem(const EngravingObject* item)
 {
+    std::lock_guard lock(m_mutex);
+
     EID eid = EID::newUnique();
-    registerItemEID(eid, const_cast<EngravingObject*>(item));
+    doRegisterItemEID(eid, item);
     return eid;
 }
 
 void EIDRegister::registerItemEID(const EID& eid, const EngravingObject* item)
+{
+    std::lock_guard lock(m_mutex);
+
+    doRegisterItemEID(eid, item);
+}
+
+void EIDRegister::doRegisterItemEID(const EID& eid, const EngravingObject* item)
 {
     IF_ASSERT_FAILED(eid.isValid() && item) {
         return;
@@ -52,6 +61,8 @@ void EIDRegister::registerItemEID(const EID& eid, const EngravingObject* item)
 
 EngravingObject* EIDRegister::itemFromEID(const EID& eid) const
 {
+    std::lock_guard lock(m_mutex);
+
     auto iter = m_eidToItem.find(eid);
     IF_ASSERT_FAILED(iter != m_eidToItem.end()) {
         return nullptr;
@@ -61,6 +72,8 @@ EngravingObject* EIDRegister::itemFromEID(const EID& eid) const
 
 EID EIDRegister::EIDFromItem(const EngravingObject* item) const
 {
+    std::lock_guard lock(m_mutex);
+
     auto iter = m_itemToEid.find(const_cast<EngravingObject*>(item));
     return iter == m_itemToEid.end() ? EID::invalid() : iter->second;
 }
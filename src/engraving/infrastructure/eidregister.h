@@ -22,6 +22,7 @@
 #pragma once
 
 #include <cstdint>
+#include <mutex>
 #include <unordered_map>
 
 #include "eid.h"
@@ -44,6 +45,10 @@ public:
 private:
     EIDRegister(const EIDRegister&) = delete;
 
+    void doRegisterItemEID(const EID& eid, const EngravingObject* item);
+
+    //! NOTE: Shared by all the scores of a project, whose excerpts may be saved concurrently
+    mutable std::mutex m_mutex;
     std::unordered_map<EID, EngravingObject*> m_eidToItem;
     std::unordered_map<EngravingObject*, EID> m_itemToEid;
 };
@@ -38,6 +38,15 @@ using namespace muse::io;
 using namespace mu;
 using namespace mu::engraving;
 
+//! NOTE The stored entries of a mapped zip are views of the mapping, and keep it alive.
+//! The data that outlives the reader (the images in imageStore, Score::audio(), the thumbnail of the project meta)
+//! is copied, so that it doesn't keep the whole file mapped
+static ByteArray ownedData(ByteArray data)
+{
+    data.data(); // detaches a view, the data inflated by the reader is already owned
+    return data;
+}
+
 MscReader::MscReader(const Params& params)
     : m_params(params)
 {
@@ -203,12 +212,12 @@ ByteArray MscReader::readChordListFile() const
 
 ByteArray MscReader::readThumbnailFile() const
 {
-    return fileData(u"Thumbnails/thumbnail.png");
+    return ownedData(fileData(u"Thumbnails/thumbnail.png"));
 }
 
 ByteArray MscReader::readImageFile(const String& fileName) const
 {
-    return fileData(u"Pictures/" + fileName);
+    return ownedData(fileData(u"Pictures/" + fileName));
 }
 
 std::vector<String> MscReader::imageFileNames() const
@@ -230,7 +239,7 @@ std::vector<String> MscReader::imageFileNames() const
 
 ByteArray MscReader::readAudioFile() const
 {
-    return fileData(u"audio.ogg");
+    return ownedData(fileData(u"audio.ogg"));
 }
 
 ByteArray MscReader::readAudioSettingsJsonFile(const muse::io::path_t& pathPrefix) const
@@ -250,9 +259,6 @@ ByteArray MscReader::readViewSettingsJsonFile(const muse::io::path_t& pathPrefix
 MscReader::ZipFileReader::~ZipFileReader()
 {
     delete m_zip;
-    if (m_selfDeviceOwner) {
-        delete m_device;
-    }
 }
 
 Ret MscReader::ZipFileReader::open(IODevice* device, const path_t& filePath)
@@ -264,8 +270,14 @@ Ret MscReader::ZipFileReader::open(IODevice* device, const path_t& filePath)
             return make_ret(Err::FileNotFound, filePath);
         }
 
-        m_device = new File(filePath);
-        m_selfDeviceOwner = true;
+        //! NOTE The file is mapped, so the entries are read without copying through a device
+        m_zip = new ZipReader(filePath, ZipReader::Mode::Mapped);
+        if (!m_zip->isOpened()) {
+            LOGE() << "failed open file: " << filePath;
+            return make_ret(Err::FileOpenError, filePath);
+        }
+
+        return true;
     }
 
     if (!m_device->isOpen()) {
@@ -293,7 +305,7 @@ void MscReader::ZipFileReader::close()
 
 bool MscReader::ZipFileReader::isOpened() const
 {
-    return m_device ? m_device->isOpen() : false;
+    return m_zip ? m_zip->isOpened() : false;
 }
 
 bool MscReader::ZipFileReader::isContainer() const
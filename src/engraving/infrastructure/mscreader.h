@@ -102,7 +102,6 @@ private:
         muse::ByteArray fileData(const muse::String& fileName) const override;
     private:
         muse::io::IODevice* m_device = nullptr;
-        bool m_selfDeviceOwner = false;
         muse::ZipReader* m_zip = nullptr;
     };
 
@@ -78,7 +78,10 @@ void MscWriter::close()
 {
     if (m_writer) {
         if (m_writer->isOpened()) {
-            writeMeta();
+            //! NOTE The meta is written when the snapshot is
+            if (!m_params.snapshot) {
+                writeMeta();
+            }
             m_writer->close();
         }
 
@@ -101,6 +104,11 @@ bool MscWriter::hasError() const
 MscWriter::IWriter* MscWriter::writer() const
 {
     if (!m_writer) {
+        if (m_params.snapshot) {
+            m_writer = new SnapshotWriter(m_params.snapshot);
+            return m_writer;
+        }
+
         switch (m_params.mode) {
         case MscIoMode::Zip:
             m_writer = new ZipFileWriter();
@@ -203,6 +211,19 @@ void MscWriter::writeViewSettingsJsonFile(const ByteArray& data, const muse::io:
     addFileData(pathPrefix.toString() + u"viewsettings.json", data);
 }
 
+bool MscWriter::writeSnapshot(const Snapshot& snapshot)
+{
+    TRACEFUNC;
+
+    for (const auto& file : snapshot.files) {
+        if (!addFileData(file.first, file.second)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void MscWriter::writeMeta()
 {
     if (m_meta.isWritten) {
@@ -469,3 +490,35 @@ bool MscWriter::XmlFileWriter::addFileData(const String& fileName, const ByteArr
 
     return true;
 }
+
+MscWriter::SnapshotWriter::SnapshotWriter(Snapshot* snapshot)
+    : m_snapshot(snapshot)
+{
+}
+
+Ret MscWriter::SnapshotWriter::open(io::IODevice*, const path_t&)
+{
+    m_isOpened = true;
+    return make_ok();
+}
+
+void MscWriter::SnapshotWriter::close()
+{
+    m_isOpened = false;
+}
+
+bool MscWriter::SnapshotWriter::isOpened() const
+{
+    return m_isOpened;
+}
+
+bool MscWriter::SnapshotWriter::hasError() const
+{
+    return false;
+}
+
+bool MscWriter::SnapshotWriter::addFileData(const String& fileName, const ByteArray& data)
+{
+    m_snapshot->files.emplace_back(fileName, data);
+    return true;
+}
@@ -22,7 +22,10 @@
 #ifndef MU_ENGRAVING_MSCWRITER_H
 #define MU_ENGRAVING_MSCWRITER_H
 
+#include <vector>
+
 #include "types/string.h"
+#include "types/bytearray.h"
 #include "types/ret.h"
 #include "io/path.h"
 #include "io/iodevice.h"
@@ -38,12 +41,20 @@ class MscWriter
 {
 public:
 
+    //! NOTE The files of a project serialized in memory, in the order of writing,
+    //! to be compressed and written later by writeSnapshot (possibly on another thread)
+    struct Snapshot
+    {
+        std::vector<std::pair<muse::String, muse::ByteArray> > files;
+    };
+
     struct Params
     {
         muse::io::IODevice* device = nullptr;
         muse::io::path_t filePath;
         muse::String mainFileName;
         MscIoMode mode = MscIoMode::Zip;
+        Snapshot* snapshot = nullptr; // if set, the files are only collected in it
     };
 
     MscWriter() = default;
@@ -69,6 +80,8 @@ public:
     void writeAudioSettingsJsonFile(const muse::ByteArray& data, const muse::io::path_t& pathPrefix = "");
     void writeViewSettingsJsonFile(const muse::ByteArray& data, const muse::io::path_t& pathPrefix = "");
 
+    bool writeSnapshot(const Snapshot& snapshot);
+
 private:
 
     struct IWriter {
@@ -122,6 +135,19 @@ private:
         muse::TextStream* m_stream = nullptr;
     };
 
+    struct SnapshotWriter : public IWriter
+    {
+        SnapshotWriter(Snapshot* snapshot);
+        muse::Ret open(muse::io::IODevice* device, const muse::io::path_t& filePath) override;
+        void close() override;
+        bool isOpened() const override;
+        bool hasError() const override;
+        bool addFileData(const muse::String& fileName, const muse::ByteArray& data) override;
+    private:
+        Snapshot* m_snapshot = nullptr;
+        bool m_isOpened = false;
+    };
+
     struct Meta {
         std::vector<muse::String> files;
         bool isWritten = false;
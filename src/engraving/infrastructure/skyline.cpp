@@ -100,9 +100,8 @@ void SkylineLine::add(const Shape& s)
 
 SkylineLine SkylineLine::getFilteredCopy(std::function<bool(const ShapeElement&)> filterOut) const
 {
-    SkylineLine newSkylineLine(*this);
-
-    newSkylineLine.m_shape.clear();
+    SkylineLine newSkylineLine(m_isNorth);
+    newSkylineLine.m_staffLineEdges = m_staffLineEdges;
 
     for (const ShapeElement& shapeEl : m_shape.elements()) {
         if (filterOut(shapeEl)) {
@@ -140,6 +139,7 @@ void SkylineLine::add(const ShapeElement& r)
     }
 
     m_shape.add(r);
+    invalidateIndex();
 }
 
 double SkylineLine::staffLinesTopAtX(double x) const
@@ -187,6 +187,35 @@ void SkylineLine::clear()
 {
     m_staffLineEdges.clear();
     m_shape.clear();
+    invalidateIndex();
+}
+
+//-------------------------------------------------------------------
+//   shouldUseIndex
+//    The index pays off once built, so it's used whenever it's available;
+//    otherwise only if both sides are big enough to amortize building it
+//    (e.g. not for the single item shapes checked by autoplace)
+//-------------------------------------------------------------------
+
+static constexpr size_t INDEX_MIN_SIZE = 16;
+
+bool SkylineLine::shouldUseIndex(size_t otherSize) const
+{
+    if (m_indexValid) {
+        return true;
+    }
+
+    return m_shape.size() >= INDEX_MIN_SIZE && otherSize >= INDEX_MIN_SIZE;
+}
+
+const SkylineIndex& SkylineLine::index() const
+{
+    if (!m_indexValid) {
+        m_index.build(m_shape.elements());
+        m_indexValid = true;
+    }
+
+    return m_index;
 }
 
 //-------------------------------------------------------------------
@@ -202,27 +231,56 @@ double Skyline::minDistance(const Skyline& s, double minHorizontalClearance) con
 
 double SkylineLine::minDistance(const SkylineLine& sl, double minHorizontalClearance) const
 {
+    if (m_shape.empty() || sl.m_shape.empty()) {
+        return 0.0;
+    }
+
+    // index the bigger side, unless only the other one is already indexed
+    bool indexThis = m_indexValid || (!sl.m_indexValid && m_shape.size() >= sl.m_shape.size());
+    if (indexThis && shouldUseIndex(sl.m_shape.size())) {
+        return mu::engraving::minVerticalDistance(index(), sl.m_shape, minHorizontalClearance);
+    }
+    if (!indexThis && sl.shouldUseIndex(m_shape.size())) {
+        return mu::engraving::minVerticalDistance(m_shape, sl.index(), minHorizontalClearance);
+    }
+
     return m_shape.minVerticalDistance(sl.m_shape, minHorizontalClearance);
 }
 
 double SkylineLine::minDistanceToShapeAbove(const Shape& shapeAbove, double minHorizontalClearance) const
 {
-    return shapeAbove.minVerticalDistance(m_shape, minHorizontalClearance);
+    if (m_shape.empty() || shapeAbove.empty() || !shouldUseIndex(shapeAbove.size())) {
+        return shapeAbove.minVerticalDistance(m_shape, minHorizontalClearance);
+    }
+
+    return mu::engraving::minVerticalDistance(shapeAbove, index(), minHorizontalClearance);
 }
 
 double SkylineLine::minDistanceToShapeBelow(const Shape& shapeBelow, double minHorizontalClearance) const
 {
-    return m_shape.minVerticalDistance(shapeBelow, minHorizontalClearance);
+    if (m_shape.empty() || shapeBelow.empty() || !shouldUseIndex(shapeBelow.size())) {
+        return m_shape.minVerticalDistance(shapeBelow, minHorizontalClearance);
+    }
+
+    return mu::engraving::minVerticalDistance(index(), shapeBelow, minHorizontalClearance);
 }
 
 double SkylineLine::verticalClearanceAbove(const Shape& shapeAbove) const
 {
-    return shapeAbove.verticalClearance(m_shape);
+    if (m_shape.empty() || shapeAbove.empty() || !shouldUseIndex(shapeAbove.size())) {
+        return shapeAbove.verticalClearance(m_shape);
+    }
+
+    return mu::engraving::verticalClearance(shapeAbove, index(), 0.0);
 }
 
 double SkylineLine::verticalClaranceBelow(const Shape& shapeBelow) const
 {
-    return m_shape.verticalClearance(shapeBelow);
+    if (m_shape.empty() || shapeBelow.empty() || !shouldUseIndex(shapeBelow.size())) {
+        return m_shape.verticalClearance(shapeBelow);
+    }
+
+    return mu::engraving::verticalClearance(index(), shapeBelow, 0.0);
 }
 
 void Skyline::paint(Painter& painter, double lineWidth) const // DEBUG only
@@ -268,6 +326,7 @@ bool SkylineLine::valid() const
 SkylineLine& SkylineLine::translateY(double y)
 {
     m_shape.translateY(y);
+    invalidateIndex();
     return *this;
 }
 
@@ -29,6 +29,7 @@
 
 #include "draw/types/geometry.h"
 #include "shape.h"
+#include "skylineindex.h"
 
 namespace muse::draw {
 class Painter;
@@ -52,7 +53,11 @@ public:
     void add(const Shape& s);
 
     template<typename Predicate>
-    inline bool remove_if(Predicate p) { return m_shape.remove_if(p); }
+    inline bool remove_if(Predicate p)
+    {
+        invalidateIndex();
+        return m_shape.remove_if(p);
+    }
     SkylineLine getFilteredCopy(std::function<bool(const ShapeElement&)> filterOut) const;
 
     void clear();
@@ -74,16 +79,28 @@ public:
     bool isNorth() const { return m_isNorth; }
 
     const std::vector<ShapeElement>& elements() const { return m_shape.elements(); }
-    std::vector<ShapeElement>& elements() { return m_shape.elements(); }
+    std::vector<ShapeElement>& elements()
+    {
+        invalidateIndex();
+        return m_shape.elements();
+    }
 
 private:
     double staffLinesTopAtX(double x) const;
     double staffLinesBottomAtX(double x) const;
 
+    bool shouldUseIndex(size_t otherSize) const;
+    const SkylineIndex& index() const;
+    void invalidateIndex() { m_indexValid = false; }
+
 private:
     const bool m_isNorth;
     Shape m_shape;
 
+    // Built on demand for the vertical distance queries, see shouldUseIndex()
+    mutable SkylineIndex m_index;
+    mutable bool m_indexValid = false;
+
     struct StaffLineEdge {
         double top = 0.0;
         double bottom = 0.0;
@@ -0,0 +1,220 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "skylineindex.h"
+
+#include <algorithm>
+#include <cfloat>
+
+using namespace mu::engraving;
+
+void SkylineIndex::build(const std::vector<ShapeElement>& elements)
+{
+    std::vector<const ShapeElement*> sorted;
+    sorted.reserve(elements.size());
+    for (const ShapeElement& element : elements) {
+        if (isIndexable(element)) {
+            sorted.push_back(&element);
+        }
+    }
+
+    std::sort(sorted.begin(), sorted.end(), [](const ShapeElement* e1, const ShapeElement* e2) {
+        return e1->left() < e2->left();
+    });
+
+    m_lefts.clear();
+    m_lefts.reserve(sorted.size());
+
+    m_leafCount = 1;
+    while (m_leafCount < sorted.size()) {
+        m_leafCount *= 2;
+    }
+
+    m_nodes.assign(2 * m_leafCount, Node { -DBL_MAX, DBL_MAX, -DBL_MAX });
+
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const ShapeElement* element = sorted[i];
+        m_lefts.push_back(element->left());
+        m_nodes[m_leafCount + i] = Node { element->right(), element->top(), element->bottom() };
+    }
+
+    for (size_t node = m_leafCount - 1; node > 0; --node) {
+        const Node& left = m_nodes[2 * node];
+        const Node& right = m_nodes[2 * node + 1];
+        m_nodes[node] = Node { std::max(left.maxRight, right.maxRight),
+                               std::min(left.minTop, right.minTop),
+                               std::max(left.maxBottom, right.maxBottom) };
+    }
+}
+
+void SkylineIndex::clear()
+{
+    m_lefts.clear();
+    m_nodes.clear();
+    m_leafCount = 0;
+}
+
+size_t SkylineIndex::prefixSize(double leftBefore) const
+{
+    auto end = std::partition_point(m_lefts.begin(), m_lefts.end(), [leftBefore](double left) {
+        return left < leftBefore;
+    });
+
+    return static_cast<size_t>(end - m_lefts.begin());
+}
+
+double SkylineIndex::maxBottom(double leftBefore, double rightAfter, double clearance) const
+{
+    double result = -DBL_MAX;
+    size_t end = prefixSize(leftBefore);
+    if (end > 0) {
+        findMaxBottom(1, 0, m_leafCount, end, rightAfter, clearance, result);
+    }
+
+    return result;
+}
+
+double SkylineIndex::minTop(double leftBefore, double rightAfter, double clearance) const
+{
+    double result = DBL_MAX;
+    size_t end = prefixSize(leftBefore);
+    if (end > 0) {
+        findMinTop(1, 0, m_leafCount, end, rightAfter, clearance, result);
+    }
+
+    return result;
+}
+
+// The aggregates of a node bound all of its elements, so a node is skipped if none of them
+// can reach rightAfter (x + clearance is monotonic in x) or improve the result found so far
+void SkylineIndex::findMaxBottom(size_t node, size_t lo, size_t hi, size_t end, double rightAfter, double clearance,
+                                 double& result) const
+{
+    const Node& n = m_nodes[node];
+    if (lo >= end || n.maxBottom <= result || !(n.maxRight + clearance > rightAfter)) {
+        return;
+    }
+
+    if (hi - lo == 1) {
+        result = n.maxBottom;
+        return;
+    }
+
+    size_t mid = (lo + hi) / 2;
+    if (m_nodes[2 * node + 1].maxBottom > m_nodes[2 * node].maxBottom) {
+        findMaxBottom(2 * node + 1, mid, hi, end, rightAfter, clearance, result);
+        findMaxBottom(2 * node, lo, mid, end, rightAfter, clearance, result);
+    } else {
+        findMaxBottom(2 * node, lo, mid, end, rightAfter, clearance, result);
+        findMaxBottom(2 * node + 1, mid, hi, end, rightAfter, clearance, result);
+    }
+}
+
+void SkylineIndex::findMinTop(size_t node, size_t lo, size_t hi, size_t end, double rightAfter, double clearance,
+                              double& result) const
+{
+    const Node& n = m_nodes[node];
+    if (lo >= end || n.minTop >= result || !(n.maxRight + clearance > rightAfter)) {
+        return;
+    }
+
+    if (hi - lo == 1) {
+        result = n.minTop;
+        return;
+    }
+
+    size_t mid = (lo + hi) / 2;
+    if (m_nodes[2 * node + 1].minTop < m_nodes[2 * node].minTop) {
+        findMinTop(2 * node + 1, mid, hi, end, rightAfter, clearance, result);
+        findMinTop(2 * node, lo, mid, end, rightAfter, clearance, result);
+    } else {
+        findMinTop(2 * node, lo, mid, end, rightAfter, clearance, result);
+        findMinTop(2 * node + 1, mid, hi, end, rightAfter, clearance, result);
+    }
+}
+
+//-------------------------------------------------------------------
+//   minVerticalDistance / verticalClearance
+//    Same results as Shape::minVerticalDistance() and Shape::verticalClearance(),
+//    bit for bit: a - b is monotonic in both a and b, so the extreme distance
+//    of an element is reached with the extreme top / bottom it overlaps.
+//-------------------------------------------------------------------
+
+double mu::engraving::minVerticalDistance(const SkylineIndex& above, const Shape& below, double minHorizontalClearance)
+{
+    double dist = -DBL_MAX;
+    for (const RectF& r2 : below.elements()) {
+        if (!SkylineIndex::isIndexable(r2)) {
+            continue;
+        }
+        double bottom = above.maxBottom(r2.right() + minHorizontalClearance, r2.left(), minHorizontalClearance);
+        if (bottom != -DBL_MAX) {
+            dist = std::max(dist, bottom - r2.top());
+        }
+    }
+    return dist;
+}
+
+double mu::engraving::minVerticalDistance(const Shape& above, const SkylineIndex& below, double minHorizontalClearance)
+{
+    double dist = -DBL_MAX;
+    for (const RectF& r1 : above.elements()) {
+        if (!SkylineIndex::isIndexable(r1)) {
+            continue;
+        }
+        double top = below.minTop(r1.right() + minHorizontalClearance, r1.left(), minHorizontalClearance);
+        if (top != DBL_MAX) {
+            dist = std::max(dist, r1.bottom() - top);
+        }
+    }
+    return dist;
+}
+
+double mu::engraving::verticalClearance(const SkylineIndex& above, const Shape& below, double minHorizontalClearance)
+{
+    double dist = DBL_MAX;
+    for (const RectF& r2 : below.elements()) {
+        if (!SkylineIndex::isIndexable(r2)) {
+            continue;
+        }
+        double bottom = above.maxBottom(r2.right() + minHorizontalClearance, r2.left(), minHorizontalClearance);
+        if (bottom != -DBL_MAX) {
+            dist = std::min(dist, r2.top() - bottom);
+        }
+    }
+    return dist;
+}
+
+double mu::engraving::verticalClearance(const Shape& above, const SkylineIndex& below, double minHorizontalClearance)
+{
+    double dist = DBL_MAX;
+    for (const RectF& r1 : above.elements()) {
+        if (!SkylineIndex::isIndexable(r1)) {
+            continue;
+        }
+        double top = below.minTop(r1.right() + minHorizontalClearance, r1.left(), minHorizontalClearance);
+        if (top != DBL_MAX) {
+            dist = std::min(dist, top - r1.bottom());
+        }
+    }
+    return dist;
+}
@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "shape.h"
+
+namespace mu::engraving {
+//---------------------------------------------------------
+//   SkylineIndex
+//    Segment tree over the elements of a skyline, sorted by their left edge.
+//    Finds the highest top / the lowest bottom of the elements overlapping
+//    a horizontal range without visiting the elements out of that range.
+//    Elements ignored by the vertical distance functions of Shape
+//    (zero width or non-positive height) are not indexed.
+//---------------------------------------------------------
+
+class SkylineIndex
+{
+public:
+    void build(const std::vector<ShapeElement>& elements);
+    void clear();
+
+    bool empty() const { return m_lefts.empty(); }
+    size_t size() const { return m_lefts.size(); }
+
+    // Over the elements with left < leftBefore && right + clearance > rightAfter,
+    // i.e. the same arithmetic as mu::engraving::intersects().
+    // Returns -DBL_MAX / DBL_MAX if there are no such elements
+    double maxBottom(double leftBefore, double rightAfter, double clearance) const;
+    double minTop(double leftBefore, double rightAfter, double clearance) const;
+
+    static bool isIndexable(const RectF& r) { return r.height() > 0.0 && r.left() != r.right(); }
+
+private:
+    struct Node {
+        double maxRight;
+        double minTop;
+        double maxBottom;
+    };
+
+    size_t prefixSize(double leftBefore) const;
+    void findMaxBottom(size_t node, size_t lo, size_t hi, size_t end, double rightAfter, double clearance, double& result) const;
+    void findMinTop(size_t node, size_t lo, size_t hi, size_t end, double rightAfter, double clearance, double& result) const;
+
+    std::vector<double> m_lefts;
+    std::vector<Node> m_nodes;
+    size_t m_leafCount = 0;
+};
+
+double minVerticalDistance(const SkylineIndex& above, const Shape& below, double minHorizontalClearance);
+double minVerticalDistance(const Shape& above, const SkylineIndex& below, double minHorizontalClearance);
+double verticalClearance(const SkylineIndex& above, const Shape& below, double minHorizontalClearance);
+double verticalClearance(const Shape& above, const SkylineIndex& below, double minHorizontalClearance);
+}
@@ -56,6 +56,8 @@ static const Settings::Key DYNAMICS_APPLY_TO_ALL_VOICES("engraving", "score/dyna
 
 static const Settings::Key DO_NOT_SAVE_EIDS_FOR_BACK_COMPAT("engraving", "engraving/compat/doNotSaveEIDsForBackCompat");
 
+static const Settings::Key UNDO_MEMORY_BUDGET_MB("engraving", "engraving/undo/memoryBudgetMB");
+
 struct VoiceColor {
     Settings::Key key;
     Color color;
@@ -159,6 +161,10 @@ void EngravingConfiguration::init()
     settings()->setDescription(DO_NOT_SAVE_EIDS_FOR_BACK_COMPAT, muse::trc("engraving", "Do not save EIDs"));
     settings()->setCanBeManuallyEdited(DO_NOT_SAVE_EIDS_FOR_BACK_COMPAT, false);
 
+    settings()->setDefaultValue(UNDO_MEMORY_BUDGET_MB, Val(0));
+    settings()->setDescription(UNDO_MEMORY_BUDGET_MB, muse::trc("engraving", "Undo history memory limit (MB, 0 for unlimited)"));
+    settings()->setCanBeManuallyEdited(UNDO_MEMORY_BUDGET_MB, true, Val(0), Val(16384));
+
     setExperimentalGuitarBendImport(guitarProImportExperimental());
 }
 
@@ -436,6 +442,11 @@ void EngravingConfiguration::setDoNotSaveEIDsForBackCompat(bool doNotSave)
     settings()->setSharedValue(DO_NOT_SAVE_EIDS_FOR_BACK_COMPAT, Val(doNotSave));
 }
 
+size_t EngravingConfiguration::undoMemoryBudget() const
+{
+    return static_cast<size_t>(std::max(settings()->value(UNDO_MEMORY_BUDGET_MB).toInt(), 0)) * 1024 * 1024;
+}
+
 bool EngravingConfiguration::guitarProImportExperimental() const
 {
     return guitarProConfiguration() ? guitarProConfiguration()->experimental() : false;
@@ -112,6 +112,8 @@ public:
     bool doNotSaveEIDsForBackCompat() const override;
     void setDoNotSaveEIDsForBackCompat(bool doNotSave) override;
 
+    size_t undoMemoryBudget() const override;
+
     bool guitarProImportExperimental() const override;
     bool experimentalGuitarBendImport() const override;
     void setExperimentalGuitarBendImport(bool enabled) override;
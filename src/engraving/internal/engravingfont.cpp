@@ -21,9 +21,15 @@
  */
 #include "engravingfont.h"
 
+#include <chrono>
+#include <cstring>
+
 #include "serialization/json.h"
 #include "io/file.h"
 #include "io/fileinfo.h"
+#include "io/mappedfile.h"
+#include "io/dir.h"
+#include "realfn.h"
 #include "draw/painter.h"
 #include "types/symnames.h"
 
@@ -92,10 +98,19 @@ double EngravingFont::textEnclosureThickness()
 
 void EngravingFont::ensureLoad()
 {
+    TRACEFUNC;
+
+    std::lock_guard lock(m_mutex);
+
     if (m_loaded) {
         return;
     }
 
+    load(cacheFilePath());
+}
+
+void EngravingFont::load(const path_t& cachePath)
+{
     if (-1 == fontProvider()->addSymbolFont(String::fromStdString(m_family), m_fontPath)) {
         LOGE() << "fatal error: cannot load internal font: " << m_fontPath;
         return;
@@ -107,6 +122,26 @@ void EngravingFont::ensureLoad()
     m_font.setNoFontMerging(true);
     m_font.setHinting(Font::Hinting::PreferVerticalHinting);
 
+    const uint64_t hash = sourceHash();
+    if (!loadCache(cachePath, hash)) {
+        if (!loadMetadata()) {
+            return;
+        }
+
+        saveCache(cachePath, hash);
+    }
+
+    loadComposedGlyphs();
+
+    m_engravingDefaults.insert({ Sid::musicalTextFont, String(u"%1 Text").arg(String::fromStdString(m_family)) });
+
+    m_loaded = true;
+}
+
+bool EngravingFont::loadMetadata()
+{
+    TRACEFUNC;
+
     for (size_t id = 0; id < m_symbols.size(); ++id) {
         Smufl::Code code = Smufl::code(static_cast<SymId>(id));
         if (!code.isValid()) {
@@ -119,22 +154,21 @@ void EngravingFont::ensureLoad()
     File metadataFile(FileInfo(m_fontPath).path() + u"/metadata.json");
     if (!metadataFile.open(IODevice::ReadOnly)) {
         LOGE() << "Failed to open glyph metadata file: " << metadataFile.filePath();
-        return;
+        return false;
     }
 
     std::string error;
     JsonObject metadataJson = JsonDocument::fromJson(metadataFile.readAll(), &error).rootObject();
     if (!error.empty()) {
         LOGE() << "Json parse error in " << metadataFile.filePath() << ", error: " << error;
-        return;
+        return false;
     }
 
     loadGlyphsWithAnchors(metadataJson.value("glyphsWithAnchors").toObject());
-    loadComposedGlyphs();
     loadStylisticAlternates(metadataJson.value("glyphsWithAlternates").toObject());
     loadEngravingDefaults(metadataJson.value("engravingDefaults").toObject());
 
-    m_loaded = true;
+    return true;
 }
 
 void EngravingFont::loadGlyphsWithAnchors(const JsonObject& glyphsWithAnchors)
@@ -792,8 +826,6 @@ void EngravingFont::loadEngravingDefaults(const JsonObject& engravingDefaultsObj
 
         applyEngravingDefault(key, engravingDefaultsObject.value(key).toDouble());
     }
-
-    m_engravingDefaults.insert({ Sid::musicalTextFont, String(u"%1 Text").arg(String::fromStdString(m_family)) });
 }
 
 void EngravingFont::computeMetrics(EngravingFont::Sym& sym, const Smufl::Code& code)
@@ -810,6 +842,214 @@ void EngravingFont::computeMetrics(EngravingFont::Sym& sym, const Smufl::Code& c
     }
 }
 
+// =============================================
+// Cache
+// =============================================
+
+namespace {
+//! NOTE Increase on any change of the layout below
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr char CACHE_MAGIC[4] = { 'M', 'S', 'F', 'C' };
+constexpr size_t ANCHOR_COUNT = static_cast<size_t>(SmuflAnchorId::opticalCenter) + 1;
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t sourceHash = 0;
+    uint32_t symbolCount = 0;
+    uint32_t defaultCount = 0;
+    double textEnclosureThickness = 0.0;
+};
+
+struct CacheSymbol {
+    uint32_t code = 0;
+    uint32_t anchorMask = 0;
+    double bbox[4] = {};
+    double advance = 0.0;
+    double anchors[ANCHOR_COUNT][2] = {};
+};
+
+struct CacheDefault {
+    int32_t sid = 0;
+    int32_t isBool = 0;
+    double value = 0.0;
+};
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+}
+
+path_t EngravingFont::cacheFilePath() const
+{
+    if (!globalConfiguration()) {
+        return path_t();
+    }
+
+    return globalConfiguration()->userAppDataPath() + "/engravingfonts/" + m_name.c_str() + ".cache";
+}
+
+uint64_t EngravingFont::sourceHash() const
+{
+    TRACEFUNC;
+
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    const uint32_t layout[] = { CACHE_VERSION, static_cast<uint32_t>(m_symbols.size()), static_cast<uint32_t>(Sid::STYLES) };
+    hash = fnv1a(hash, layout, sizeof(layout));
+    hash = fnv1a(hash, &DPI_F, sizeof(DPI_F));
+
+    //! NOTE The builtin fonts are resources (qrc), so they are read through the file system, not mapped
+    for (const path_t& path : { m_fontPath, path_t(FileInfo(m_fontPath).path() + u"/metadata.json") }) {
+        ByteArray data;
+        if (File::readFile(path, data)) {
+            const uint64_t size = data.size();
+            hash = fnv1a(hash, &size, sizeof(size));
+            hash = fnv1a(hash, data.constData(), data.size());
+        }
+    }
+
+    return hash;
+}
+
+bool EngravingFont::loadCache(const path_t& path, uint64_t sourceHash)
+{
+    TRACEFUNC;
+
+    if (path.empty()) {
+        return false;
+    }
+
+    MappedFile file(path);
+    if (!file.open() || file.size() < sizeof(CacheHeader)) {
+        return false;
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+        || header.version != CACHE_VERSION
+        || header.sourceHash != sourceHash
+        || header.symbolCount != m_symbols.size()) {
+        LOGI() << "Outdated engraving font cache: " << path;
+        return false;
+    }
+
+    const size_t expectedSize = sizeof(CacheHeader) + header.symbolCount * sizeof(CacheSymbol)
+                                + header.defaultCount * sizeof(CacheDefault);
+    if (file.size() != expectedSize) {
+        LOGW() << "Corrupted engraving font cache: " << path;
+        return false;
+    }
+
+    const uint8_t* symbolsData = file.data() + sizeof(CacheHeader);
+    for (size_t id = 0; id < m_symbols.size(); ++id) {
+        CacheSymbol cached;
+        std::memcpy(&cached, symbolsData + id * sizeof(CacheSymbol), sizeof(cached));
+
+        Sym& sym = m_symbols[id];
+        sym.code = cached.code;
+        sym.bbox = RectF(cached.bbox[0], cached.bbox[1], cached.bbox[2], cached.bbox[3]);
+        sym.advance = cached.advance;
+
+        for (size_t a = 0; a < ANCHOR_COUNT; ++a) {
+            if (cached.anchorMask & (1u << a)) {
+                sym.smuflAnchors[static_cast<SmuflAnchorId>(a)] = PointF(cached.anchors[a][0], cached.anchors[a][1]);
+            }
+        }
+    }
+
+    const uint8_t* defaultsData = symbolsData + header.symbolCount * sizeof(CacheSymbol);
+    for (size_t i = 0; i < header.defaultCount; ++i) {
+        CacheDefault cached;
+        std::memcpy(&cached, defaultsData + i * sizeof(CacheDefault), sizeof(cached));
+
+        const Sid sid = static_cast<Sid>(cached.sid);
+        if (cached.isBool) {
+            m_engravingDefaults.insert({ sid, !RealIsNull(cached.value) });
+        } else {
+            m_engravingDefaults.insert({ sid, cached.value });
+        }
+    }
+
+    m_textEnclosureThickness = header.textEnclosureThickness;
+
+    return true;
+}
+
+void EngravingFont::saveCache(const path_t& path, uint64_t sourceHash) const
+{
+    TRACEFUNC;
+
+    if (path.empty()) {
+        return;
+    }
+
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.sourceHash = sourceHash;
+    header.symbolCount = static_cast<uint32_t>(m_symbols.size());
+    header.defaultCount = static_cast<uint32_t>(m_engravingDefaults.size());
+    header.textEnclosureThickness = m_textEnclosureThickness;
+
+    ByteArray data;
+    data.reserve(sizeof(CacheHeader) + header.symbolCount * sizeof(CacheSymbol) + header.defaultCount * sizeof(CacheDefault));
+    data.push_back(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+
+    for (const Sym& sym : m_symbols) {
+        CacheSymbol cached;
+        cached.code = static_cast<uint32_t>(sym.code);
+        cached.bbox[0] = sym.bbox.x();
+        cached.bbox[1] = sym.bbox.y();
+        cached.bbox[2] = sym.bbox.width();
+        cached.bbox[3] = sym.bbox.height();
+        cached.advance = sym.advance;
+
+        for (const auto& anchor : sym.smuflAnchors) {
+            const size_t a = static_cast<size_t>(anchor.first);
+            cached.anchorMask |= (1u << a);
+            cached.anchors[a][0] = anchor.second.x();
+            cached.anchors[a][1] = anchor.second.y();
+        }
+
+        data.push_back(reinterpret_cast<const uint8_t*>(&cached), sizeof(cached));
+    }
+
+    for (const auto& pair : m_engravingDefaults) {
+        CacheDefault cached;
+        cached.sid = static_cast<int32_t>(pair.first);
+        if (pair.second.type() == P_TYPE::BOOL) {
+            cached.isBool = 1;
+            cached.value = pair.second.value<bool>() ? 1.0 : 0.0;
+        } else {
+            cached.value = pair.second.value<double>();
+        }
+
+        data.push_back(reinterpret_cast<const uint8_t*>(&cached), sizeof(cached));
+    }
+
+    //! NOTE Written aside and moved, so that another process never maps a partially written cache
+    const std::string tmpSuffix = std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    const path_t tmpPath = path + "." + tmpSuffix.c_str();
+    Dir::mkpath(FileInfo(path).path());
+    if (!File::writeFile(tmpPath, data)) {
+        LOGW() << "Failed to write engraving font cache: " << tmpPath;
+        return;
+    }
+
+    if (!fileSystem()->move(tmpPath, path, true)) {
+        File::remove(tmpPath);
+    }
+}
+
 // =============================================
 // Symbol properties
 // =============================================
@@ -914,6 +1154,8 @@ Shape EngravingFont::shapeWithCutouts(SymId id, double mag)
 
 Shape EngravingFont::shapeWithCutouts(SymId id, const SizeF& mag)
 {
+    std::lock_guard lock(m_mutex);
+
     Shape& shape = sym(id).shapeWithCutouts;
     if (shape.empty()) {
         constructShapeWithCutouts(shape, id);
@@ -1063,10 +1305,11 @@ void EngravingFont::draw(SymId id, Painter* painter, const SizeF& mag, const Poi
     }
 
     painter->save();
-    double size = 20.0 * MScore::pixelRatio;
-    m_font.setPointSizeF(size);
+    //! NOTE The pages may be painted concurrently, so the shared font is not changed
+    Font font = m_font;
+    font.setPointSizeF(20.0 * MScore::pixelRatio);
     painter->scale(mag.width(), mag.height());
-    painter->setFont(m_font);
+    painter->setFont(font);
     if (angle != 0) {
         const double _width = sym.bbox.width() / 2;
         const double _height = sym.bbox.height() / 2;
@@ -22,10 +22,19 @@
 #ifndef MU_ENGRAVING_ENGRAVINGFONT_H
 #define MU_ENGRAVING_ENGRAVINGFONT_H
 
+#include <mutex>
 #include <unordered_map>
 
+#include "muse_framework_config.h"
+
+#ifdef MUSE_ENABLE_UNIT_TESTS
+#include <gtest/gtest_prod.h>
+#endif
+
 #include "iengravingfont.h"
 #include "modularity/ioc.h"
+#include "global/iglobalconfiguration.h"
+#include "io/ifilesystem.h"
 #include "draw/ifontprovider.h"
 #include "draw/types/geometry.h"
 #include "iengravingfontsprovider.h"
@@ -53,6 +62,8 @@ class EngravingFont : public IEngravingFont, public muse::Injectable
 {
     muse::Inject<muse::draw::IFontProvider> fontProvider = { this };
     muse::Inject<IEngravingFontsProvider> engravingFonts = { this };
+    muse::Inject<muse::IGlobalConfiguration> globalConfiguration = { this };
+    muse::GlobalInject<muse::io::IFileSystem> fileSystem;
 public:
     EngravingFont(const std::string& name, const std::string& family, const muse::io::path_t& filePath,
                   const muse::modularity::ContextPtr& iocCtx);
@@ -99,6 +110,11 @@ private:
 
     friend class SymbolFonts;
 
+#ifdef MUSE_ENABLE_UNIT_TESTS
+    FRIEND_TEST(Engraving_EngravingFontTests, CacheRoundTrip);
+    FRIEND_TEST(Engraving_EngravingFontTests, CacheInvalidation);
+#endif
+
     struct Sym {
         char32_t code;
         RectF bbox;
@@ -119,12 +135,22 @@ private:
         }
     };
 
+    //! NOTE Without the cache if the path is empty
+    void load(const muse::io::path_t& cachePath);
+    bool loadMetadata();
     void loadGlyphsWithAnchors(const muse::JsonObject& glyphsWithAnchors);
     void loadComposedGlyphs();
     void loadStylisticAlternates(const muse::JsonObject& glyphsWithAlternatesObject);
     void loadEngravingDefaults(const muse::JsonObject& engravingDefaultsObject);
     void computeMetrics(Sym& sym, const Smufl::Code& code);
 
+    //! NOTE The metrics, anchors and engraving defaults are cached in a binary file per font,
+    //! so that the next loads only map it instead of parsing the metadata and querying every glyph
+    muse::io::path_t cacheFilePath() const;
+    uint64_t sourceHash() const;
+    bool loadCache(const muse::io::path_t& path, uint64_t sourceHash);
+    void saveCache(const muse::io::path_t& path, uint64_t sourceHash) const;
+
     void constructShapeWithCutouts(Shape& shape, SymId id);
 
     Sym& sym(SymId id);
@@ -132,9 +158,12 @@ private:
 
     bool useFallbackFont(SymId id) const;
 
+    //! NOTE: The font is shared between all the scores, which may be painted or saved concurrently:
+    //! loading and the lazily built shapes with cutouts are guarded, the rest is immutable once loaded
+    std::mutex m_mutex;
     bool m_loaded = false;
     std::vector<Sym> m_symbols;
-    mutable muse::draw::Font m_font;
+    muse::draw::Font m_font;
 
     std::string m_name;
     std::string m_family;
@@ -74,12 +74,15 @@ std::vector<IEngravingFontPtr> EngravingFontsProvider::fonts() const
 
 void EngravingFontsProvider::setFallbackFont(const std::string& name)
 {
+    std::lock_guard lock(m_fallbackMutex);
     m_fallback.name = name;
     m_fallback.font = nullptr;
 }
 
 std::shared_ptr<EngravingFont> EngravingFontsProvider::doFallbackFont() const
 {
+    std::lock_guard lock(m_fallbackMutex);
+
     if (!m_fallback.font) {
         m_fallback.font = doFontByName(m_fallback.name);
         IF_ASSERT_FAILED(m_fallback.font) {
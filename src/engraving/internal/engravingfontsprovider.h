@@ -23,6 +23,7 @@
 #ifndef MU_ENGRAVING_ENGRAVINGFONTSPROVIDER_H
 #define MU_ENGRAVING_ENGRAVINGFONTSPROVIDER_H
 
+#include <mutex>
 #include <vector>
 
 #include "iengravingfontsprovider.h"
@@ -58,6 +59,7 @@ private:
         std::shared_ptr<EngravingFont> font;
     };
 
+    mutable std::mutex m_fallbackMutex;
     mutable Fallback m_fallback;
     std::vector<std::shared_ptr<EngravingFont> > m_symbolFonts;
 };
@@ -54,6 +54,37 @@ static bool soundFlagPlayable(const SoundFlag* flag)
     return false;
 }
 
+template<typename Map, typename Equal>
+static bool hasSameEntries(const Map& map, const int tickFrom, const int tickTo, const int offset1, const int offset2,
+                           const Equal& equal)
+{
+    auto it1 = muse::findLessOrEqual(map, tickFrom + offset1);
+    auto it2 = muse::findLessOrEqual(map, tickFrom + offset2);
+
+    // the state at the beginning of the range
+    if ((it1 == map.cend()) != (it2 == map.cend())) {
+        return false;
+    }
+
+    if (it1 != map.cend() && !equal(it1->second, it2->second)) {
+        return false;
+    }
+
+    // the changes within the range
+    it1 = map.upper_bound(tickFrom + offset1);
+    it2 = map.upper_bound(tickFrom + offset2);
+    auto end1 = map.upper_bound(tickTo + offset1);
+    auto end2 = map.upper_bound(tickTo + offset2);
+
+    for (; it1 != end1 && it2 != end2; ++it1, ++it2) {
+        if (it1->first - offset1 != it2->first - offset2 || !equal(it1->second, it2->second)) {
+            return false;
+        }
+    }
+
+    return it1 == end1 && it2 == end2;
+}
+
 static mu::engraving::DynamicType findNominalStartDynamicType(const Hairpin* hairpin)
 {
     return hairpin->dynamicTypeFrom();
@@ -289,6 +320,30 @@ bool PlaybackContext::hasSoundFlags() const
     return !m_soundFlagParamsByTrack.empty();
 }
 
+bool PlaybackContext::hasSameState(const int tickFrom, const int tickTo, const int tickPositionOffset1,
+                                   const int tickPositionOffset2) const
+{
+    if (tickPositionOffset1 == tickPositionOffset2) {
+        return true;
+    }
+
+    auto sameDynamic = [](const DynamicInfo& d1, const DynamicInfo& d2) {
+        return d1.level == d2.level;
+    };
+
+    for (const auto& pair : m_dynamicsByTrack) {
+        if (!hasSameEntries(pair.second, tickFrom, tickTo, tickPositionOffset1, tickPositionOffset2, sameDynamic)) {
+            return false;
+        }
+    }
+
+    auto samePlayTech = [](const ArticulationType t1, const ArticulationType t2) {
+        return t1 == t2;
+    };
+
+    return hasSameEntries(m_playTechniquesMap, tickFrom, tickTo, tickPositionOffset1, tickPositionOffset2, samePlayTech);
+}
+
 dynamic_level_t PlaybackContext::nominalDynamicLevel(const track_idx_t trackIdx, const int positionTick) const
 {
     auto dynamicsIt = m_dynamicsByTrack.find(trackIdx);
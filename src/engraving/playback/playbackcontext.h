@@ -55,6 +55,10 @@ public:
 
     bool hasSoundFlags() const;
 
+    //! NOTE Checks whether the nominal range [tickFrom, tickTo] resolves to the same dynamics
+    //! and playing techniques when played with each of the given offsets (i.e. in different repeats)
+    bool hasSameState(const int tickFrom, const int tickTo, const int tickPositionOffset1, const int tickPositionOffset2) const;
+
 private:
     struct DynamicInfo {
         muse::mpe::dynamic_level_t level = 0;
@@ -33,8 +33,11 @@
 #include "dom/segment.h"
 #include "dom/tempo.h"
 #include "dom/tie.h"
+#include "dom/spanner.h"
 #include "dom/tremolotwochord.h"
 
+#include "concurrency/taskscheduler.h"
+
 #include "log.h"
 
 #include <limits>
@@ -60,6 +63,50 @@ static const Harmony* findChordSymbol(const EngravingItem* item)
     return nullptr;
 }
 
+//! NOTE The first and the last measures of a repeat depend on the neighbouring repeats (e.g. partial ties)
+static bool isStrictlyInsideRepeat(const RepeatSegment* repeatSegment, const int tickFrom, const int tickTo)
+{
+    return tickFrom > repeatSegment->tick && tickTo < repeatSegment->tick + repeatSegment->len();
+}
+
+static PlaybackEvent shiftedEvent(const PlaybackEvent& event, const timestamp_t shift)
+{
+    if (std::holds_alternative<muse::mpe::RestEvent>(event)) {
+        ArrangementContext arrangementCtx = std::get<muse::mpe::RestEvent>(event).arrangementCtx();
+        arrangementCtx.nominalTimestamp += shift;
+        arrangementCtx.actualTimestamp += shift;
+
+        return muse::mpe::RestEvent(std::move(arrangementCtx));
+    }
+
+    const muse::mpe::NoteEvent& noteEvent = std::get<muse::mpe::NoteEvent>(event);
+
+    ArrangementContext arrangementCtx = noteEvent.arrangementCtx();
+    arrangementCtx.nominalTimestamp += shift;
+    arrangementCtx.actualTimestamp += shift;
+
+    PitchContext pitchCtx = noteEvent.pitchCtx();
+    ExpressionContext expressionCtx = noteEvent.expressionCtx();
+
+    for (auto& pair : expressionCtx.articulations) {
+        pair.second.meta.timestamp += shift;
+    }
+
+    return muse::mpe::NoteEvent(std::move(arrangementCtx), std::move(pitchCtx), std::move(expressionCtx));
+}
+
+static void appendEvents(PlaybackEventsMap& destination, const PlaybackEventsMap& source, const timestamp_t shift)
+{
+    for (const auto& pair : source) {
+        PlaybackEventList& events = destination[pair.first + shift];
+        events.reserve(events.size() + pair.second.size());
+
+        for (const PlaybackEvent& event : pair.second) {
+            events.push_back(shift == 0 ? event : shiftedEvent(event, shift));
+        }
+    }
+}
+
 void PlaybackModel::load(Score* score)
 {
     TRACEFUNC;
@@ -83,20 +130,33 @@ void PlaybackModel::load(Score* score)
 
         clearExpiredTracks();
         clearExpiredContexts(trackRange.trackFrom, trackRange.trackTo);
-        clearExpiredEvents(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo);
+        TimestampWindows changedWindows = clearExpiredEvents(tickRange.tickFrom, tickRange.tickTo,
+                                                             trackRange.trackFrom, trackRange.trackTo);
 
         InstrumentTrackIdSet oldTracks = existingTrackIdSet();
 
         ChangedTrackIdSet trackChanges;
         update(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo, &trackChanges);
 
-        notifyAboutChanges(oldTracks, trackChanges);
+        notifyAboutChanges(oldTracks, trackChanges, changedWindows);
     });
 
-    update(0, m_score->lastMeasure()->endTick().ticks(), 0, m_score->ntracks());
+    //! NOTE Announce the tracks as soon as their events are ready,
+    //! so that their setup can start while the other parts are still being rendered
+    InstrumentTrackIdSet addedTracks;
+    auto addTrack = [this, &addedTracks](const InstrumentTrackId& trackId) {
+        if (addedTracks.insert(trackId).second) {
+            m_trackAdded.send(trackId);
+        }
+    };
+
+    update(0, m_score->lastMeasure()->endTick().ticks(), 0, m_score->ntracks(), nullptr, addTrack);
+
+    m_tracksWithChangedDynamics.clear();
+    m_tracksWithChangedParams.clear();
 
     for (const auto& pair : m_playbackDataMap) {
-        m_trackAdded.send(pair.first);
+        addTrack(pair.first);
     }
 
     m_dataChanged.notify();
@@ -127,6 +187,9 @@ void PlaybackModel::reload()
         pair.second.mainStream.send(pair.second.originEvents, pair.second.dynamics, pair.second.params);
     }
 
+    m_tracksWithChangedDynamics.clear();
+    m_tracksWithChangedParams.clear();
+
     m_dataChanged.notify();
 }
 
@@ -295,11 +358,11 @@ muse::async::Channel<InstrumentTrackId> PlaybackModel::trackRemoved() const
 }
 
 void PlaybackModel::update(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                           ChangedTrackIdSet* trackChanges)
+                           ChangedTrackIdSet* trackChanges, const OnTrackRendered& onTrackRendered)
 {
     updateSetupData();
     updateContext(trackFrom, trackTo);
-    updateEvents(tickFrom, tickTo, trackFrom, trackTo, trackChanges);
+    updateEvents(tickFrom, tickTo, trackFrom, trackTo, trackChanges, onTrackRendered);
 }
 
 void PlaybackModel::updateSetupData()
@@ -347,43 +410,24 @@ void PlaybackModel::updateContext(const InstrumentTrackId& trackId)
     ctx->update(trackId.partId, m_score, m_expandRepeats);
 
     PlaybackData& trackData = m_playbackDataMap[trackId];
-    trackData.dynamics = ctx->dynamicLevelLayers(m_score);
-    trackData.params = ctx->playbackParamLayers(m_score);
-}
-
-void PlaybackModel::processSegment(const int tickPositionOffset, const Segment* segment, const std::set<staff_idx_t>& staffIdxSet,
-                                   bool isFirstChordRestSegmentOfMeasure, ChangedTrackIdSet* trackChanges)
-{
-    for (const EngravingItem* item : segment->annotations()) {
-        if (!item || !item->part()) {
-            continue;
-        }
 
-        const Harmony* chordSymbol = findChordSymbol(item);
-        if (!chordSymbol) {
-            continue;
-        }
-
-        staff_idx_t staffIdx = item->staffIdx();
-        if (staffIdxSet.find(staffIdx) == staffIdxSet.cend()) {
-            continue;
-        }
-
-        InstrumentTrackId trackId = chordSymbolsTrackId(item->part()->id());
-
-        ArticulationsProfilePtr profile = defaultActiculationProfile(trackId);
-        if (!profile) {
-            LOGE() << "unsupported instrument family: " << item->part()->id();
-            continue;
-        }
-
-        if (chordSymbol->play()) {
-            m_renderer.renderChordSymbol(chordSymbol, tickPositionOffset, profile,
-                                         m_playbackDataMap[trackId].originEvents);
-        }
+    DynamicLevelLayers dynamics = ctx->dynamicLevelLayers(m_score);
+    if (trackData.dynamics != dynamics) {
+        trackData.dynamics = std::move(dynamics);
+        m_tracksWithChangedDynamics.insert(trackId);
+    }
 
-        collectChangesTracks(trackId, trackChanges);
+    PlaybackParamLayers params = ctx->playbackParamLayers(m_score);
+    if (trackData.params != params) {
+        trackData.params = std::move(params);
+        m_tracksWithChangedParams.insert(trackId);
     }
+}
+
+void PlaybackModel::processSegment(PartRenderingJob& job, TrackEventsMap& result, const int tickPositionOffset, const Segment* segment,
+                                   const std::set<staff_idx_t>& staffIdxSet, bool isFirstChordRestSegmentOfMeasure) const
+{
+    processChordSymbols(job, result, tickPositionOffset, segment, staffIdxSet);
 
     if (segment->isTimeTickType()) {
         return; // optimization: search only for annotations
@@ -410,7 +454,7 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
                 const MeasureRepeat* measureRepeat = toMeasureRepeat(item);
                 const Measure* currentMeasure = measureRepeat->measure();
 
-                processMeasureRepeat(tickPositionOffset, measureRepeat, currentMeasure, staffIdx, trackChanges);
+                processMeasureRepeat(job, result, tickPositionOffset, measureRepeat, currentMeasure, staffIdx);
 
                 continue;
             } else if (item->voice() == 0) {
@@ -419,27 +463,62 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
                 if (currentMeasure->measureRepeatCount(staffIdx) > 0) {
                     const MeasureRepeat* measureRepeat = currentMeasure->measureRepeatElement(staffIdx);
 
-                    processMeasureRepeat(tickPositionOffset, measureRepeat, currentMeasure, staffIdx, trackChanges);
+                    processMeasureRepeat(job, result, tickPositionOffset, measureRepeat, currentMeasure, staffIdx);
                     continue;
                 }
             }
         }
 
-        ArticulationsProfilePtr profile = defaultActiculationProfile(trackId);
-        if (!profile) {
+        auto profileIt = job.profiles.find(trackId);
+        auto ctxIt = job.contexts.find(trackId);
+        if (profileIt == job.profiles.cend() || !profileIt->second || ctxIt == job.contexts.cend()) {
             LOGE() << "unsupported instrument family: " << item->part()->id();
             continue;
         }
 
-        const PlaybackContextPtr ctx = playbackCtx(trackId);
-        m_renderer.render(item, tickPositionOffset, std::move(profile), ctx, m_playbackDataMap[trackId].originEvents);
+        m_renderer.render(item, tickPositionOffset, profileIt->second, ctxIt->second, result[trackId]);
 
-        collectChangesTracks(trackId, trackChanges);
+        job.changedTracks.insert(trackId);
     }
 }
 
-void PlaybackModel::processMeasureRepeat(const int tickPositionOffset, const MeasureRepeat* measureRepeat, const Measure* currentMeasure,
-                                         const staff_idx_t staffIdx, ChangedTrackIdSet* trackChanges)
+void PlaybackModel::processChordSymbols(PartRenderingJob& job, TrackEventsMap& result, const int tickPositionOffset,
+                                        const Segment* segment, const std::set<staff_idx_t>& staffIdxSet) const
+{
+    for (const EngravingItem* item : segment->annotations()) {
+        if (!item || !item->part()) {
+            continue;
+        }
+
+        const Harmony* chordSymbol = findChordSymbol(item);
+        if (!chordSymbol) {
+            continue;
+        }
+
+        staff_idx_t staffIdx = item->staffIdx();
+        if (staffIdxSet.find(staffIdx) == staffIdxSet.cend()) {
+            continue;
+        }
+
+        InstrumentTrackId trackId = chordSymbolsTrackId(item->part()->id());
+
+        auto profileIt = job.profiles.find(trackId);
+        if (profileIt == job.profiles.cend() || !profileIt->second) {
+            LOGE() << "unsupported instrument family: " << item->part()->id();
+            continue;
+        }
+
+        if (chordSymbol->play()) {
+            m_renderer.renderChordSymbol(chordSymbol, tickPositionOffset, profileIt->second, result[trackId]);
+        }
+
+        job.changedTracks.insert(trackId);
+    }
+}
+
+void PlaybackModel::processMeasureRepeat(PartRenderingJob& job, TrackEventsMap& result, const int tickPositionOffset,
+                                         const MeasureRepeat* measureRepeat, const Measure* currentMeasure,
+                                         const staff_idx_t staffIdx) const
 {
     if (!measureRepeat || !currentMeasure) {
         return;
@@ -471,12 +550,12 @@ void PlaybackModel::processMeasureRepeat(const int tickPositionOffset, const Mea
             chordRestSegmentNum++;
         }
 
-        processSegment(tickFrom, seg, staffToProcessIdxSet, chordRestSegmentNum == 0, trackChanges);
+        processSegment(job, result, tickFrom, seg, staffToProcessIdxSet, chordRestSegmentNum == 0);
     }
 }
 
 void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                                 ChangedTrackIdSet* trackChanges)
+                                 ChangedTrackIdSet* trackChanges, const OnTrackRendered& onTrackRendered)
 {
     TRACEFUNC;
 
@@ -484,9 +563,95 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
         return staff.isPrimaryStaff(); // skip linked staves
     });
 
-    const ArticulationsProfilePtr metronomeProfile = defaultActiculationProfile(METRONOME_TRACK_ID);
+    const RepeatList& repeats = repeatList();
 
-    for (const RepeatSegment* repeatSegment : repeatList()) {
+    std::vector<PartRenderingJob> jobs = makePartRenderingJobs(staffToProcessIdxSet);
+
+    //! NOTE Build the lazily updated lookups before the parts are rendered concurrently
+    m_score->spannerMap().ensureUpdated();
+
+    if (jobs.size() < 2) {
+        for (PartRenderingJob& job : jobs) {
+            renderPartEvents(job, tickFrom, tickTo, repeats);
+            publishPartEvents(job, trackChanges, onTrackRendered);
+        }
+
+        renderMetronomeEvents(tickFrom, tickTo, repeats, trackChanges);
+        return;
+    }
+
+    std::vector<std::future<void> > results;
+    results.reserve(jobs.size());
+
+    for (PartRenderingJob& job : jobs) {
+        results.push_back(muse::sharedTaskScheduler()->submit([this, &job, tickFrom, tickTo, &repeats]() {
+            renderPartEvents(job, tickFrom, tickTo, repeats);
+        }));
+    }
+
+    renderMetronomeEvents(tickFrom, tickTo, repeats, trackChanges);
+
+    //! NOTE Publish the parts in the score order, each one as soon as it's rendered
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        results.at(i).wait();
+        publishPartEvents(jobs.at(i), trackChanges, onTrackRendered);
+    }
+}
+
+std::vector<PlaybackModel::PartRenderingJob> PlaybackModel::makePartRenderingJobs(const std::set<staff_idx_t>& staffIdxSet)
+{
+    std::vector<PartRenderingJob> jobs;
+
+    for (const Part* part : m_score->parts()) {
+        PartRenderingJob job;
+
+        for (const Staff* staff : part->staves()) {
+            if (muse::contains(staffIdxSet, staff->idx())) {
+                job.staffIdxSet.insert(staff->idx());
+            }
+        }
+
+        if (job.staffIdxSet.empty()) {
+            continue;
+        }
+
+        InstrumentTrackIdSet trackIdSet = part->instrumentTrackIdSet();
+        trackIdSet.insert(chordSymbolsTrackId(part->id()));
+
+        //! NOTE Resolve everything the rendering needs from the model beforehand,
+        //! so that the job doesn't touch the model
+        for (const InstrumentTrackId& trackId : trackIdSet) {
+            ArticulationsProfilePtr profile = defaultActiculationProfile(trackId);
+            if (!profile) {
+                continue;
+            }
+
+            job.profiles.emplace(trackId, std::move(profile));
+            job.contexts.emplace(trackId, playbackCtx(trackId));
+        }
+
+        jobs.push_back(std::move(job));
+    }
+
+    return jobs;
+}
+
+void PlaybackModel::renderPartEvents(PartRenderingJob& job, const int tickFrom, const int tickTo, const RepeatList& repeats) const
+{
+    //! NOTE Count how many times every measure is played,
+    //! so that the rendered events are kept only for the measures played again later
+    std::unordered_map<const Measure*, size_t> occurrences;
+    if (repeats.size() > 1) {
+        for (const RepeatSegment* repeatSegment : repeats) {
+            for (const Measure* measure : repeatSegment->measureList()) {
+                ++occurrences[measure];
+            }
+        }
+    }
+
+    std::unordered_map<const Measure*, MeasureEventsBlock> blocks;
+
+    for (const RepeatSegment* repeatSegment : repeats) {
         int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
         int repeatStartTick = repeatSegment->tick;
         int repeatEndTick = repeatStartTick + repeatSegment->len();
@@ -503,34 +668,287 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                 continue;
             }
 
-            int chordRestSegmentNum = -1;
+            auto occurrenceIt = occurrences.find(measure);
+            if (occurrenceIt != occurrences.end()) {
+                bool isLastOccurrence = --occurrenceIt->second == 0;
 
-            for (const Segment* segment = measure->first(); segment; segment = segment->next()) {
-                if (!segment->isChordRestType() && !segment->isTimeTickType()) {
+                if (renderRepeatedMeasureEvents(job, blocks, repeatSegment, measure, tickFrom, tickTo, isLastOccurrence)) {
                     continue;
                 }
+            }
+
+            renderMeasureEvents(job, job.events, tickPositionOffset, measure, tickFrom, tickTo);
+        }
+    }
+}
+
+void PlaybackModel::renderMeasureEvents(PartRenderingJob& job, TrackEventsMap& result, const int tickPositionOffset,
+                                        const Measure* measure, const int tickFrom, const int tickTo, bool chordSymbolsOnly) const
+{
+    int chordRestSegmentNum = -1;
+
+    for (const Segment* segment = measure->first(); segment; segment = segment->next()) {
+        if (!segment->isChordRestType() && !segment->isTimeTickType()) {
+            continue;
+        }
+
+        int segmentStartTick = segment->tick().ticks();
+        int segmentEndTick = segmentStartTick + segment->ticks().ticks();
+
+        if (segmentStartTick > tickTo || segmentEndTick <= tickFrom) {
+            continue;
+        }
+
+        if (segment->isChordRestType()) {
+            chordRestSegmentNum++;
+        }
+
+        if (chordSymbolsOnly) {
+            processChordSymbols(job, result, tickPositionOffset, segment, job.staffIdxSet);
+        } else {
+            processSegment(job, result, tickPositionOffset, segment, job.staffIdxSet, chordRestSegmentNum == 0);
+        }
+    }
+}
+
+bool PlaybackModel::renderRepeatedMeasureEvents(PartRenderingJob& job, std::unordered_map<const Measure*, MeasureEventsBlock>& blocks,
+                                                const RepeatSegment* repeatSegment, const Measure* measure, const int tickFrom,
+                                                const int tickTo, bool isLastOccurrence) const
+{
+    const int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
+    const int measureStartTick = measure->tick().ticks();
+
+    auto blockIt = blocks.find(measure);
+    if (blockIt != blocks.end()) {
+        const MeasureEventsBlock& block = blockIt->second;
+        if (!canReuseMeasureEvents(job, block, repeatSegment, measure)) {
+            return false;
+        }
+
+        timestamp_t shift = timestampFromTicks(m_score, measureStartTick + tickPositionOffset)
+                            - timestampFromTicks(m_score, measureStartTick + block.tickPositionOffset);
+
+        for (const auto& pair : block.events) {
+            appendEvents(job.events[pair.first], pair.second, shift);
+        }
+
+        //! NOTE A chord symbol sounds until the next one, which may be in another repeat,
+        //! so the chord symbols are rendered for every repeat
+        renderMeasureEvents(job, job.events, tickPositionOffset, measure, tickFrom, tickTo, /*chordSymbolsOnly*/ true);
+
+        if (isLastOccurrence) {
+            blocks.erase(blockIt);
+        }
+
+        return true;
+    }
 
-                int segmentStartTick = segment->tick().ticks();
-                int segmentEndTick = segmentStartTick + segment->ticks().ticks();
+    if (isLastOccurrence) {
+        return false;
+    }
+
+    for (const staff_idx_t staffIdx : job.staffIdxSet) {
+        if (measure->measureRepeatCount(staffIdx) > 0) {
+            return false; // the events come from the other measures
+        }
+    }
+
+    MeasureEventsBlock block;
+    block.tickPositionOffset = tickPositionOffset;
+    block.dependencyBoundaries = measureDependencyBoundaries(measure, job.staffIdxSet);
+
+    if (!isStrictlyInsideRepeat(repeatSegment, block.dependencyBoundaries.tickFrom, block.dependencyBoundaries.tickTo)) {
+        return false;
+    }
+
+    renderMeasureEvents(job, block.events, tickPositionOffset, measure, tickFrom, tickTo);
+
+    for (auto it = block.events.begin(); it != block.events.end();) {
+        appendEvents(job.events[it->first], it->second, 0);
+
+        if (isChordSymbolsTrack(it->first)) {
+            it = block.events.erase(it); // rendered for every repeat, see above
+        } else {
+            ++it;
+        }
+    }
+
+    blocks.emplace(measure, std::move(block));
+
+    return true;
+}
 
-                if (segmentStartTick > tickTo || segmentEndTick <= tickFrom) {
+bool PlaybackModel::canReuseMeasureEvents(const PartRenderingJob& job, const MeasureEventsBlock& block,
+                                          const RepeatSegment* repeatSegment, const Measure* measure) const
+{
+    const TickBoundaries& boundaries = block.dependencyBoundaries;
+    if (!isStrictlyInsideRepeat(repeatSegment, boundaries.tickFrom, boundaries.tickTo)) {
+        return false;
+    }
+
+    const int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
+
+    for (const auto& pair : job.contexts) {
+        if (!pair.second->hasSameState(boundaries.tickFrom, boundaries.tickTo, block.tickPositionOffset, tickPositionOffset)) {
+            return false;
+        }
+    }
+
+    //! NOTE The timestamps are rounded to microseconds,
+    //! so make sure that shifting them gives exactly the same timestamps as rendering them again
+    const int measureStartTick = measure->tick().ticks();
+    const timestamp_t shift = timestampFromTicks(m_score, measureStartTick + tickPositionOffset)
+                              - timestampFromTicks(m_score, measureStartTick + block.tickPositionOffset);
+
+    auto isShiftExact = [this, &block, tickPositionOffset, shift](int tick) {
+        return timestampFromTicks(m_score, tick + tickPositionOffset)
+               - timestampFromTicks(m_score, tick + block.tickPositionOffset) == shift;
+    };
+
+    const Measure* firstMeasure = measure;
+    while (firstMeasure->prevMeasure() && firstMeasure->tick().ticks() > boundaries.tickFrom) {
+        firstMeasure = firstMeasure->prevMeasure();
+    }
+
+    for (const Measure* m = firstMeasure; m && m->tick().ticks() <= boundaries.tickTo; m = m->nextMeasure()) {
+        for (const Segment* segment = m->first(SegmentType::ChordRest); segment; segment = segment->next(SegmentType::ChordRest)) {
+            if (!isShiftExact(segment->tick().ticks())) {
+                return false;
+            }
+        }
+
+        if (!isShiftExact(m->endTick().ticks())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+PlaybackModel::TickBoundaries PlaybackModel::measureDependencyBoundaries(const Measure* measure,
+                                                                         const std::set<staff_idx_t>& staffIdxSet) const
+{
+    const int measureStartTick = measure->tick().ticks();
+    const int measureEndTick = measure->endTick().ticks();
+
+    TickBoundaries result;
+    result.tickFrom = measureStartTick;
+    result.tickTo = measureEndTick;
+
+    auto applyTiedNotes = [&result](const Chord* chord) {
+        for (const Note* note : chord->notes()) {
+            const Note* firstTiedNote = note->firstTiedNote();
+            const Note* lastTiedNote = note->lastTiedNote();
+
+            if (firstTiedNote) {
+                result.tickFrom = std::min(result.tickFrom, firstTiedNote->tick().ticks());
+            }
+
+            if (lastTiedNote) {
+                result.tickTo = std::max(result.tickTo, lastTiedNote->chord()->endTick().ticks());
+            }
+        }
+    };
+
+    for (const Segment* segment = measure->first(SegmentType::ChordRest); segment; segment = segment->next(SegmentType::ChordRest)) {
+        for (const staff_idx_t staffIdx : staffIdxSet) {
+            for (track_idx_t track = staff2track(staffIdx); track < staff2track(staffIdx + 1); ++track) {
+                const EngravingItem* item = segment->element(track);
+                if (!item || !item->isChord()) {
                     continue;
                 }
 
-                if (segment->isChordRestType()) {
-                    chordRestSegmentNum++;
+                const Chord* chord = toChord(item);
+                applyTiedNotes(chord);
+
+                for (const Chord* graceChord : chord->graceNotes()) {
+                    applyTiedNotes(graceChord);
                 }
 
-                processSegment(tickPositionOffset, segment, staffToProcessIdxSet, chordRestSegmentNum == 0, trackChanges);
+                if (const TremoloTwoChord* tremolo = chord->tremoloTwoChord()) {
+                    if (tremolo->chord1() && tremolo->chord2()) {
+                        result.tickFrom = std::min(result.tickFrom, tremolo->chord1()->tick().ticks());
+                        result.tickTo = std::max(result.tickTo, tremolo->chord2()->endTick().ticks());
+                    }
+                }
+            }
+        }
+    }
+
+    //! NOTE The system spanners (e.g. tempo changes) only affect the time, which is checked separately,
+    //! and the hairpins are taken into account by the playback context
+    const auto intervals = m_score->spannerMap().findOverlapping(measureStartTick, measureEndTick);
+    for (const auto& interval : intervals) {
+        const Spanner* spanner = interval.value;
+        if (spanner->systemFlag() || spanner->isHairpin() || !muse::contains(staffIdxSet, spanner->staffIdx())) {
+            continue;
+        }
+
+        result.tickFrom = std::min(result.tickFrom, spanner->tick().ticks());
+        result.tickTo = std::max(result.tickTo, spanner->tick2().ticks());
+    }
+
+    return result;
+}
+
+void PlaybackModel::renderMetronomeEvents(const int tickFrom, const int tickTo, const RepeatList& repeats,
+                                          ChangedTrackIdSet* trackChanges)
+{
+    const ArticulationsProfilePtr metronomeProfile = defaultActiculationProfile(METRONOME_TRACK_ID);
+    PlaybackEventsMap& metronomeEvents = m_playbackDataMap[METRONOME_TRACK_ID].originEvents;
+
+    for (const RepeatSegment* repeatSegment : repeats) {
+        int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
+        int repeatStartTick = repeatSegment->tick;
+        int repeatEndTick = repeatStartTick + repeatSegment->len();
+
+        if (repeatStartTick > tickTo || repeatEndTick <= tickFrom) {
+            continue;
+        }
+
+        for (const Measure* measure : repeatSegment->measureList()) {
+            int measureStartTick = measure->tick().ticks();
+            int measureEndTick = measure->endTick().ticks();
+
+            if (measureStartTick > tickTo || measureEndTick <= tickFrom) {
+                continue;
             }
 
             m_renderer.renderMetronome(m_score, measureStartTick, measureEndTick, tickPositionOffset,
-                                       metronomeProfile, m_playbackDataMap[METRONOME_TRACK_ID].originEvents);
+                                       metronomeProfile, metronomeEvents);
             collectChangesTracks(METRONOME_TRACK_ID, trackChanges);
         }
     }
 }
 
+void PlaybackModel::publishPartEvents(PartRenderingJob& job, ChangedTrackIdSet* trackChanges, const OnTrackRendered& onTrackRendered)
+{
+    for (auto& pair : job.events) {
+        PlaybackEventsMap& originEvents = m_playbackDataMap[pair.first].originEvents;
+
+        if (originEvents.empty()) {
+            originEvents = std::move(pair.second);
+            continue;
+        }
+
+        for (auto& timestampEvents : pair.second) {
+            PlaybackEventList& events = originEvents[timestampEvents.first];
+            events.insert(events.end(), std::make_move_iterator(timestampEvents.second.begin()),
+                          std::make_move_iterator(timestampEvents.second.end()));
+        }
+    }
+
+    for (const InstrumentTrackId& trackId : job.changedTracks) {
+        collectChangesTracks(trackId, trackChanges);
+
+        if (onTrackRendered) {
+            onTrackRendered(trackId);
+        }
+    }
+
+    job.events.clear();
+}
+
 bool PlaybackModel::hasToReloadTracks(const ScoreChangesRange& changesRange) const
 {
     static const std::unordered_set<ElementType> REQUIRED_TYPES = {
@@ -698,22 +1116,25 @@ void mu::engraving::PlaybackModel::removeEventsFromRange(const track_idx_t track
     removeTrackEvents(METRONOME_TRACK_ID, timestampFrom, timestampTo);
 }
 
-void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo)
+PlaybackModel::TimestampWindows PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom,
+                                                                  const track_idx_t trackTo)
 {
     TRACEFUNC;
 
+    TimestampWindows result;
+
     if (!m_score) {
-        return;
+        return result;
     }
 
     const Measure* lastMeasure = m_score->lastMeasure();
     if (!lastMeasure) {
-        return;
+        return result;
     }
 
     if (tickFrom == 0 && lastMeasure->endTick().ticks() == tickTo) {
         removeEventsFromRange(trackFrom, trackTo);
-        return;
+        return result;
     }
 
     for (const RepeatSegment* repeatSegment : repeatList()) {
@@ -734,7 +1155,10 @@ void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, con
         timestamp_t removeEventsTo = timestampFromTicks(m_score, removeEventsToTick + tickPositionOffset);
 
         removeEventsFromRange(trackFrom, trackTo, removeEventsFrom, removeEventsTo);
+        result.emplace_back(removeEventsFrom, removeEventsTo);
     }
+
+    return result;
 }
 
 void PlaybackModel::collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result)
@@ -746,7 +1170,8 @@ void PlaybackModel::collectChangesTracks(const InstrumentTrackId& trackId, Chang
     result->insert(trackId);
 }
 
-void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, const InstrumentTrackIdSet& changedTracks)
+void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, const InstrumentTrackIdSet& changedTracks,
+                                       const TimestampWindows& changedWindows)
 {
     for (const InstrumentTrackId& trackId : changedTracks) {
         auto search = m_playbackDataMap.find(trackId);
@@ -755,9 +1180,17 @@ void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, co
             continue;
         }
 
-        search->second.mainStream.send(search->second.originEvents, search->second.dynamics, search->second.params);
+        //! NOTE Send the whole track only if all its events have been re-rendered
+        if (changedWindows.empty() || !muse::contains(oldTracks, trackId)) {
+            search->second.mainStream.send(search->second.originEvents, search->second.dynamics, search->second.params);
+        } else {
+            search->second.mainStreamPatches.send(makeMainStreamPatch(trackId, changedWindows));
+        }
     }
 
+    m_tracksWithChangedDynamics.clear();
+    m_tracksWithChangedParams.clear();
+
     for (auto it = m_playbackDataMap.cbegin(); it != m_playbackDataMap.cend(); ++it) {
         if (!muse::contains(oldTracks, it->first)) {
             m_trackAdded.send(it->first);
@@ -769,6 +1202,30 @@ void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, co
     }
 }
 
+muse::mpe::MainStreamPatch PlaybackModel::makeMainStreamPatch(const InstrumentTrackId& trackId,
+                                                               const TimestampWindows& changedWindows) const
+{
+    const PlaybackData& trackPlaybackData = m_playbackDataMap.at(trackId);
+
+    MainStreamPatch result;
+    result.windows.reserve(changedWindows.size());
+
+    for (const auto& window : changedWindows) {
+        auto bounds = windowBounds(trackPlaybackData.originEvents, window.first, window.second);
+        result.windows.push_back(PlaybackEventsWindow { window.first, window.second, PlaybackEventsMap(bounds.first, bounds.second) });
+    }
+
+    if (muse::contains(m_tracksWithChangedDynamics, trackId)) {
+        result.dynamics = trackPlaybackData.dynamics;
+    }
+
+    if (muse::contains(m_tracksWithChangedParams, trackId)) {
+        result.params = trackPlaybackData.params;
+    }
+
+    return result;
+}
+
 void PlaybackModel::removeTrackEvents(const InstrumentTrackId& trackId, const muse::mpe::timestamp_t timestampFrom,
                                       const muse::mpe::timestamp_t timestampTo)
 {
@@ -789,21 +1246,8 @@ void PlaybackModel::removeTrackEvents(const InstrumentTrackId& trackId, const mu
         return;
     }
 
-    PlaybackEventsMap::const_iterator lowerBound;
-
-    if (timestampFrom == 0) {
-        //!Note Some events might be started RIGHT before the "official" start of the track
-        //!     Need to make sure that we don't miss those events
-        lowerBound = trackPlaybackData.originEvents.begin();
-    } else {
-        lowerBound = trackPlaybackData.originEvents.lower_bound(timestampFrom);
-    }
-
-    auto upperBound = trackPlaybackData.originEvents.upper_bound(timestampTo);
-
-    for (auto it = lowerBound; it != upperBound && it != trackPlaybackData.originEvents.end();) {
-        it = trackPlaybackData.originEvents.erase(it);
-    }
+    auto bounds = windowBounds(trackPlaybackData.originEvents, timestampFrom, timestampTo);
+    trackPlaybackData.originEvents.erase(bounds.first, bounds.second);
 }
 
 PlaybackModel::TrackBoundaries PlaybackModel::trackBoundaries(const ScoreChangesRange& changesRange) const
@@ -25,7 +25,9 @@
 
 #include <unordered_map>
 #include <map>
+#include <set>
 #include <functional>
+#include <vector>
 
 #include "async/asyncable.h"
 #include "async/channel.h"
@@ -47,6 +49,7 @@ class EngravingItem;
 class Segment;
 class Instrument;
 class RepeatList;
+class RepeatSegment;
 
 class PlaybackModel : public muse::Injectable, public muse::async::Asyncable
 {
@@ -89,6 +92,7 @@ private:
     static const InstrumentTrackId CHORD_SYMBOLS_TRACK_ID;
 
     using ChangedTrackIdSet = InstrumentTrackIdSet;
+    using TimestampWindows = std::vector<std::pair<muse::mpe::timestamp_t, muse::mpe::timestamp_t> >;
 
     struct TickBoundaries
     {
@@ -102,22 +106,63 @@ private:
         track_idx_t trackTo = muse::nidx;
     };
 
+    using TrackEventsMap = std::unordered_map<InstrumentTrackId, muse::mpe::PlaybackEventsMap>;
+
+    //! NOTE The events of a part are rendered independently of the other parts:
+    //! the job only reads the score and writes into its own events
+    struct PartRenderingJob
+    {
+        std::set<staff_idx_t> staffIdxSet;
+        std::unordered_map<InstrumentTrackId, muse::mpe::ArticulationsProfilePtr> profiles;
+        std::unordered_map<InstrumentTrackId, PlaybackContextPtr> contexts;
+
+        TrackEventsMap events;
+        ChangedTrackIdSet changedTracks;
+    };
+
+    //! NOTE The events of a measure rendered in one repeat,
+    //! the later repeats of the measure get a copy shifted in time instead of rendering it again
+    struct MeasureEventsBlock
+    {
+        int tickPositionOffset = 0;
+        TickBoundaries dependencyBoundaries;
+        TrackEventsMap events;
+    };
+
+    using OnTrackRendered = std::function<void (const InstrumentTrackId&)>;
+
     InstrumentTrackId idKey(const EngravingItem* item) const;
     InstrumentTrackId idKey(const std::vector<const EngravingItem*>& items) const;
     InstrumentTrackId idKey(const ID& partId, const String& instrumentId) const;
 
     void update(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                ChangedTrackIdSet* trackChanges = nullptr);
+                ChangedTrackIdSet* trackChanges = nullptr, const OnTrackRendered& onTrackRendered = nullptr);
     void updateSetupData();
     void updateContext(const track_idx_t trackFrom, const track_idx_t trackTo);
     void updateContext(const InstrumentTrackId& trackId);
     void updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
-                      ChangedTrackIdSet* trackChanges = nullptr);
-
-    void processSegment(const int tickPositionOffset, const Segment* segment, const std::set<staff_idx_t>& staffIdxSet,
-                        bool isFirstChordRestSegmentOfMeasure, ChangedTrackIdSet* trackChanges);
-    void processMeasureRepeat(const int tickPositionOffset, const MeasureRepeat* measureRepeat, const Measure* currentMeasure,
-                              const staff_idx_t staffIdx, ChangedTrackIdSet* trackChanges);
+                      ChangedTrackIdSet* trackChanges = nullptr, const OnTrackRendered& onTrackRendered = nullptr);
+
+    std::vector<PartRenderingJob> makePartRenderingJobs(const std::set<staff_idx_t>& staffIdxSet);
+    void renderPartEvents(PartRenderingJob& job, const int tickFrom, const int tickTo, const RepeatList& repeats) const;
+    void renderMetronomeEvents(const int tickFrom, const int tickTo, const RepeatList& repeats, ChangedTrackIdSet* trackChanges);
+    void publishPartEvents(PartRenderingJob& job, ChangedTrackIdSet* trackChanges, const OnTrackRendered& onTrackRendered);
+
+    void renderMeasureEvents(PartRenderingJob& job, TrackEventsMap& result, const int tickPositionOffset, const Measure* measure,
+                             const int tickFrom, const int tickTo, bool chordSymbolsOnly = false) const;
+    bool renderRepeatedMeasureEvents(PartRenderingJob& job, std::unordered_map<const Measure*, MeasureEventsBlock>& blocks,
+                                     const RepeatSegment* repeatSegment, const Measure* measure, const int tickFrom, const int tickTo,
+                                     bool isLastOccurrence) const;
+    bool canReuseMeasureEvents(const PartRenderingJob& job, const MeasureEventsBlock& block, const RepeatSegment* repeatSegment,
+                               const Measure* measure) const;
+    TickBoundaries measureDependencyBoundaries(const Measure* measure, const std::set<staff_idx_t>& staffIdxSet) const;
+
+    void processSegment(PartRenderingJob& job, TrackEventsMap& result, const int tickPositionOffset, const Segment* segment,
+                        const std::set<staff_idx_t>& staffIdxSet, bool isFirstChordRestSegmentOfMeasure) const;
+    void processChordSymbols(PartRenderingJob& job, TrackEventsMap& result, const int tickPositionOffset, const Segment* segment,
+                             const std::set<staff_idx_t>& staffIdxSet) const;
+    void processMeasureRepeat(PartRenderingJob& job, TrackEventsMap& result, const int tickPositionOffset,
+                              const MeasureRepeat* measureRepeat, const Measure* currentMeasure, const staff_idx_t staffIdx) const;
 
     bool hasToReloadTracks(const ScoreChangesRange& changesRange) const;
     bool hasToReloadScore(const ScoreChangesRange& changesRange) const;
@@ -125,9 +170,11 @@ private:
     bool containsTrack(const InstrumentTrackId& trackId) const;
     void clearExpiredTracks();
     void clearExpiredContexts(const track_idx_t trackFrom, const track_idx_t trackTo);
-    void clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo);
+    TimestampWindows clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo);
     void collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result);
-    void notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, const InstrumentTrackIdSet& changedTracks);
+    void notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, const InstrumentTrackIdSet& changedTracks,
+                            const TimestampWindows& changedWindows);
+    muse::mpe::MainStreamPatch makeMainStreamPatch(const InstrumentTrackId& trackId, const TimestampWindows& changedWindows) const;
 
     void removeEventsFromRange(const track_idx_t trackFrom, const track_idx_t trackTo, const muse::mpe::timestamp_t timestampFrom = -1,
                                const muse::mpe::timestamp_t timestampTo = -1);
@@ -158,6 +205,9 @@ private:
     std::unordered_map<InstrumentTrackId, PlaybackContextPtr> m_playbackCtxMap;
     std::unordered_map<InstrumentTrackId, muse::mpe::PlaybackData> m_playbackDataMap;
 
+    InstrumentTrackIdSet m_tracksWithChangedDynamics;
+    InstrumentTrackIdSet m_tracksWithChangedParams;
+
     muse::async::Notification m_dataChanged;
     muse::async::Channel<InstrumentTrackId> m_trackAdded;
     muse::async::Channel<InstrumentTrackId> m_trackRemoved;
@@ -21,10 +21,13 @@
  */
 #include "paint.h"
 
+#include <optional>
+
 #include "draw/painter.h"
 #include "dom/score.h"
 #include "dom/page.h"
 #include "dom/engravingitem.h"
+#include "dom/mscore.h"
 
 #include "tdraw.h"
 #include "debugpaint.h"
@@ -67,9 +70,15 @@ void Paint::paintScore(Painter* painter, Score* score, const IScoreRenderer::Pai
     }
 
     // Setup score draw system
-    mu::engraving::MScore::pixelRatio = mu::engraving::DPI / DEVICE_DPI;
-    score->setPrinting(opt.isPrinting);
-    mu::engraving::MScore::pdfPrinting = opt.isPrinting;
+    std::optional<PrintStateGuard> printState;
+    if (opt.isPrinting) {
+        //! NOTE Pages may be printed concurrently, see PrintStateGuard
+        printState.emplace(score, PrintStateGuard::State { mu::engraving::DPI / DEVICE_DPI });
+    } else {
+        mu::engraving::MScore::pixelRatio = mu::engraving::DPI / DEVICE_DPI;
+        score->setPrinting(false);
+        mu::engraving::MScore::pdfPrinting = false;
+    }
 
     // Setup page counts
     int fromPage = opt.fromPage >= 0 ? opt.fromPage : 0;
@@ -49,6 +49,8 @@ public:
         return 0;
     }
 
+    const Location& lastLinkedElementLocation() const { return _lastLinkedElementLoc; }
+
 private:
     int _lastLocalIndex = -1;
     Location _lastLinkedElementLoc = Location::absolute();
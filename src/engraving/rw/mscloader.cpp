@@ -172,9 +172,7 @@ Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, Se
             excerptStyleBuf.open(IODevice::ReadOnly);
             partScore->style().read(&excerptStyleBuf);
 
-            ByteArray excerptData = mscReader.readExcerptFile(excerptFileName);
-
-            XmlReader xml(excerptData);
+            XmlReader xml(mscReader.readExcerptFile(excerptFileName));
             xml.setDocName(excerptFileName);
 
             ReadInOutData partReadInData;
@@ -21,12 +21,19 @@
  */
 #include "mscsaver.h"
 
+#include <algorithm>
+#include <future>
+#include <optional>
+
 #include "global/io/buffer.h"
+#include "global/containers.h"
+#include "global/concurrency/taskscheduler.h"
 
 #include "dom/masterscore.h"
 #include "dom/excerpt.h"
 #include "dom/imageStore.h"
 #include "dom/audio.h"
+#include "dom/part.h"
 
 #include "rwregister.h"
 #include "inoutdata.h"
@@ -39,7 +46,94 @@ using namespace muse::io;
 using namespace mu::engraving;
 using namespace mu::engraving::rw;
 
-bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySelection, bool doCreateThumbnail)
+void MscExcerptsCache::invalidate(const ScoreChangesRange& range)
+{
+    //! NOTE The style changes and the changes without items may affect all the excerpts
+    if (range.changedItems.empty() || !range.changedStyleIdSet.empty()) {
+        clear();
+        return;
+    }
+
+    for (const auto& item : range.changedItems) {
+        invalidate(item.first->score());
+    }
+}
+
+namespace {
+struct SerializedExcerpt {
+    ByteArray styleData;
+    ByteArray scoreData;
+    write::WriteContext contextBefore;
+    write::WriteContext contextAfter;
+};
+}
+
+static SerializedExcerpt serializeExcerpt(Score* partScore, const write::WriteContext& contextBefore)
+{
+    TRACEFUNC;
+
+    SerializedExcerpt result { ByteArray(), ByteArray(), contextBefore, contextBefore };
+
+    // Write excerpt style
+    {
+        Buffer styleBuf(&result.styleData);
+        styleBuf.open(IODevice::WriteOnly);
+        partScore->style().write(&styleBuf);
+    }
+
+    // Write excerpt
+    {
+        Buffer excerptBuf(&result.scoreData);
+        excerptBuf.open(IODevice::ReadWrite);
+
+        WriteInOutData excerptWriteInOutData(partScore);
+        excerptWriteInOutData.ctx = contextBefore;
+        RWRegister::writer(partScore->iocContext())->writeScore(partScore, &excerptBuf, false, &excerptWriteInOutData);
+        result.contextAfter = excerptWriteInOutData.ctx;
+    }
+
+    return result;
+}
+
+//! NOTE With multimeasure rests and hidden parts, the writer relayouts the score
+//! inside an undo command, that must not run concurrently with the other excerpts
+static bool canSerializeConcurrently(const Score* partScore)
+{
+    if (!partScore->style().styleB(Sid::createMultiMeasureRests)) {
+        return true;
+    }
+
+    const std::vector<Part*>& parts = partScore->parts();
+    return std::all_of(parts.begin(), parts.end(), [](const Part* part) { return part->show(); });
+}
+
+//! NOTE Each excerpt continues the context of the previous one, but only the links indexer state can differ
+//! and it affects the output only at the first link of the excerpt: if its location is equal to the last one
+//! of the previous excerpt, the local index continues, otherwise it restarts from zero.
+//! So the excerpt serialized concurrently from a reset indexer is valid, unless the locations coincide
+static bool isSerializedFromContext(const SerializedExcerpt& excerpt, const write::WriteContext& contextBefore)
+{
+    write::WriteContext actual = contextBefore;
+    actual.setLinksIndexer(LinksIndexer());
+    write::WriteContext speculative = excerpt.contextBefore;
+    speculative.setLinksIndexer(LinksIndexer());
+    if (actual != speculative) {
+        return false;
+    }
+
+    const LinksIndexer& actualIndexer = contextBefore.linksIndexer();
+    const LinksIndexer& speculativeIndexer = excerpt.contextBefore.linksIndexer();
+    const std::optional<Location>& firstLocation = excerpt.contextAfter.firstIndexedLocation();
+    if (actualIndexer == speculativeIndexer || !firstLocation) {
+        return true;
+    }
+
+    return actualIndexer.lastLinkedElementLocation() != *firstLocation
+           && speculativeIndexer.lastLinkedElementLocation() != *firstLocation;
+}
+
+bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySelection, bool doCreateThumbnail,
+                         MscExcerptsCache* excerptsCache)
 {
     TRACEFUNC;
 
@@ -74,40 +168,7 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
     // Write Excerpts
     {
         if (!onlySelection) {
-            const std::vector<Excerpt*>& excerpts = score->excerpts();
-
-            for (size_t excerptIndex = 0; excerptIndex < excerpts.size(); ++excerptIndex) {
-                Excerpt* excerpt = excerpts.at(excerptIndex);
-
-                Score* partScore = excerpt->excerptScore();
-                IF_ASSERT_FAILED(partScore && partScore != score) {
-                    continue;
-                }
-
-                excerpt->updateFileName(excerptIndex);
-
-                // Write excerpt style
-                {
-                    ByteArray excerptStyleData;
-                    Buffer styleStyleBuf(&excerptStyleData);
-                    styleStyleBuf.open(IODevice::WriteOnly);
-                    partScore->style().write(&styleStyleBuf);
-
-                    mscWriter.addExcerptStyleFile(excerpt->fileName(), excerptStyleData);
-                }
-
-                // Write excerpt
-                {
-                    ByteArray excerptData;
-                    Buffer excerptBuf(&excerptData);
-                    excerptBuf.open(IODevice::ReadWrite);
-
-                    RWRegister::writer(partScore->iocContext())->writeScore(
-                        excerpt->excerptScore(), &excerptBuf, onlySelection, &masterWriteOutData);
-
-                    mscWriter.addExcerptFile(excerpt->fileName(), excerptData);
-                }
-            }
+            writeExcerpts(score, mscWriter, masterWriteOutData.ctx, excerptsCache);
         }
     }
 
@@ -157,6 +218,122 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
     return true;
 }
 
+void MscSaver::writeExcerpts(MasterScore* score, MscWriter& mscWriter, write::WriteContext& ctx, MscExcerptsCache* excerptsCache)
+{
+    TRACEFUNC;
+
+    const std::vector<Excerpt*>& excerpts = score->excerpts();
+
+    std::vector<Score*> partScores(excerpts.size(), nullptr);
+    for (size_t excerptIndex = 0; excerptIndex < excerpts.size(); ++excerptIndex) {
+        Excerpt* excerpt = excerpts.at(excerptIndex);
+
+        Score* partScore = excerpt->excerptScore();
+        IF_ASSERT_FAILED(partScore && partScore != score) {
+            continue;
+        }
+
+        excerpt->updateFileName(excerptIndex);
+        partScores[excerptIndex] = partScore;
+    }
+
+    auto cachedEntry = [excerptsCache, &excerpts](size_t excerptIndex, const Score* partScore) -> const MscExcerptsCache::Entry* {
+        if (!excerptsCache) {
+            return nullptr;
+        }
+
+        auto it = excerptsCache->entries.find(partScore);
+        if (it == excerptsCache->entries.end() || it->second.fileName != excerpts.at(excerptIndex)->fileName()) {
+            return nullptr;
+        }
+
+        return &it->second;
+    };
+
+    //! NOTE The excerpts are serialized concurrently from the context of the master score,
+    //! then added in order; an excerpt whose output would differ is serialized again in place
+    std::vector<size_t> concurrentExcerpts;
+    for (size_t excerptIndex = 0; excerptIndex < partScores.size(); ++excerptIndex) {
+        const Score* partScore = partScores.at(excerptIndex);
+        if (!partScore) {
+            continue;
+        }
+
+        if (!canSerializeConcurrently(partScore)) {
+            concurrentExcerpts.clear();
+            break;
+        }
+
+        if (!cachedEntry(excerptIndex, partScore)) {
+            concurrentExcerpts.push_back(excerptIndex);
+        }
+    }
+
+    std::vector<std::future<SerializedExcerpt> > serializedExcerpts(partScores.size());
+    if (concurrentExcerpts.size() > 1) {
+        write::WriteContext contextBefore = ctx;
+        contextBefore.setLinksIndexer(LinksIndexer());
+
+        for (size_t excerptIndex : concurrentExcerpts) {
+            serializedExcerpts[excerptIndex] = muse::sharedTaskScheduler()->submit(serializeExcerpt, partScores.at(excerptIndex),
+                                                                                   contextBefore);
+        }
+    }
+
+    for (size_t excerptIndex = 0; excerptIndex < partScores.size(); ++excerptIndex) {
+        Score* partScore = partScores.at(excerptIndex);
+        if (!partScore) {
+            continue;
+        }
+
+        const String& fileName = excerpts.at(excerptIndex)->fileName();
+
+        if (const MscExcerptsCache::Entry* entry = cachedEntry(excerptIndex, partScore)) {
+            if (entry->contextBefore == ctx) {
+                mscWriter.addExcerptStyleFile(fileName, entry->styleData);
+                mscWriter.addExcerptFile(fileName, entry->scoreData);
+                ctx = entry->contextAfter;
+                continue;
+            }
+        }
+
+        std::optional<SerializedExcerpt> excerpt;
+        if (serializedExcerpts.at(excerptIndex).valid()) {
+            SerializedExcerpt serialized = serializedExcerpts.at(excerptIndex).get();
+            if (isSerializedFromContext(serialized, ctx)) {
+                if (!serialized.contextAfter.firstIndexedLocation()) {
+                    serialized.contextAfter.setLinksIndexer(ctx.linksIndexer());
+                }
+                serialized.contextBefore = ctx;
+                excerpt = std::move(serialized);
+            }
+        }
+
+        if (!excerpt) {
+            excerpt = serializeExcerpt(partScore, ctx);
+        }
+
+        mscWriter.addExcerptStyleFile(fileName, excerpt->styleData);
+        mscWriter.addExcerptFile(fileName, excerpt->scoreData);
+        ctx = excerpt->contextAfter;
+
+        if (excerptsCache) {
+            excerptsCache->entries.insert_or_assign(partScore, MscExcerptsCache::Entry {
+                fileName, excerpt->styleData, excerpt->scoreData, excerpt->contextBefore, excerpt->contextAfter
+            });
+        }
+    }
+
+    //! NOTE Drop the removed excerpts
+    if (excerptsCache) {
+        muse::remove_if(excerptsCache->entries, [&excerpts](const auto& entry) {
+            return std::none_of(excerpts.begin(), excerpts.end(), [&entry](const Excerpt* e) {
+                return e->excerptScore() == entry.first;
+            });
+        });
+    }
+}
+
 bool MscSaver::exportPart(Score* partScore, MscWriter& mscWriter)
 {
     // Write excerpt style as main
@@ -22,14 +22,38 @@
 #ifndef MU_ENGRAVING_MSCSAVER_H
 #define MU_ENGRAVING_MSCSAVER_H
 
+#include <map>
+
 #include "global/modularity/ioc.h"
 #include "draw/iimageprovider.h"
 
+#include "../dom/types.h"
 #include "../infrastructure/mscwriter.h"
+#include "write/writecontext.h"
 
 namespace mu::engraving {
 class MasterScore;
 class Score;
+
+//! NOTE The excerpts serialized by a previous save, reused by the next one.
+//! The owner removes the entries of the changed excerpts; an entry is also
+//! ignored if the context differs, since the links are written relative to it
+struct MscExcerptsCache {
+    struct Entry {
+        muse::String fileName;
+        muse::ByteArray styleData;
+        muse::ByteArray scoreData;
+        write::WriteContext contextBefore;
+        write::WriteContext contextAfter;
+    };
+
+    std::map<const Score*, Entry> entries;
+
+    void invalidate(const Score* score) { entries.erase(score); }
+    void invalidate(const ScoreChangesRange& range);
+    void clear() { entries.clear(); }
+};
+
 class MscSaver : public muse::Injectable
 {
     muse::Inject<muse::draw::IImageProvider> imageProvider = { this };
@@ -37,9 +61,13 @@ public:
     MscSaver(const muse::modularity::ContextPtr& iocCtx)
         : muse::Injectable(iocCtx) {}
 
-    bool writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySelection, bool doCreateThumbnail);
+    bool writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySelection, bool doCreateThumbnail,
+                   MscExcerptsCache* excerptsCache = nullptr);
 
     bool exportPart(Score* partScore, MscWriter& mscWriter);
+
+private:
+    void writeExcerpts(MasterScore* score, MscWriter& mscWriter, write::WriteContext& ctx, MscExcerptsCache* excerptsCache);
 };
 }
 
@@ -28,9 +28,19 @@ using namespace mu::engraving::write;
 
 int WriteContext::assignLocalIndex(const Location& mainElementLocation)
 {
+    if (!m_firstIndexedLocation) {
+        m_firstIndexedLocation = mainElementLocation;
+    }
+
     return m_linksIndexer.assignLocalIndex(mainElementLocation);
 }
 
+void WriteContext::setLinksIndexer(const LinksIndexer& indexer)
+{
+    m_linksIndexer = indexer;
+    m_firstIndexedLocation.reset();
+}
+
 void WriteContext::setLidLocalIndex(int lid, int localIndex)
 {
     m_lidLocalIndices.insert({ lid, localIndex });
@@ -24,6 +24,7 @@
 #define MU_ENGRAVING_WRITECONTEXT_H
 
 #include <map>
+#include <optional>
 
 #include "containers.h"
 #include "../linksindexer.h"
@@ -47,6 +48,17 @@ public:
     void setLidLocalIndex(int lid, int localIndex);
     int lidLocalIndex(int lid) const;
 
+    const LinksIndexer& linksIndexer() const { return m_linksIndexer; }
+    void setLinksIndexer(const LinksIndexer& indexer);
+
+    //! NOTE The location passed to the first assignLocalIndex since the last setLinksIndexer,
+    //! it's the only place where the output depends on the indexer state at the start
+    const std::optional<Location>& firstIndexedLocation() const { return m_firstIndexedLocation; }
+
+    //! NOTE The midi mapping of the master score is checked once per save, not for every excerpt
+    bool midiMappingChecked() const { return m_midiMappingChecked; }
+    void setMidiMappingChecked(bool v) { m_midiMappingChecked = v; }
+
     Fraction curTick() const { return _curTick; }
     void setCurTick(const Fraction& v) { _curTick   = v; }
     void incCurTick(const Fraction& v) { _curTick += v; }
@@ -87,6 +99,7 @@ public:
                && _writeTrack == c._writeTrack
                && _writePosition == c._writePosition
                && _filter == c._filter
+               && m_midiMappingChecked == c.m_midiMappingChecked
                && m_linksIndexer == c.m_linksIndexer
                && m_lidLocalIndices == c.m_lidLocalIndices;
     }
@@ -110,7 +123,10 @@ private:
 
     SelectionFilter _filter;
 
+    bool m_midiMappingChecked = false;
+
     LinksIndexer m_linksIndexer;
+    std::optional<Location> m_firstIndexedLocation;
     std::map<int, int> m_lidLocalIndices;
 };
 }
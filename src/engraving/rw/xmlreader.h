@@ -39,6 +39,8 @@ public:
     XmlReader() = default;
     XmlReader(const muse::ByteArray& d)
         : XmlStreamReader(d) {}
+    XmlReader(muse::ByteArray&& d)
+        : XmlStreamReader(std::move(d)) {}
     XmlReader(muse::io::IODevice* d)
         : XmlStreamReader(d) {}
 
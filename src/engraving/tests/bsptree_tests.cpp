@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include "containers.h"
+
 #include "dom/bsp.h"
 #include "dom/page.h"
 
@@ -37,6 +39,40 @@ class Engraving_BspTreeTests : public ::testing::Test
 {
 };
 
+static void bspInsert(void* bspTree, EngravingItem* e)
+{
+    static_cast<BspTree*>(bspTree)->insert(e);
+}
+
+static void collectItems(void* items, EngravingItem* e)
+{
+    static_cast<std::vector<EngravingItem*>*>(items)->push_back(e);
+}
+
+static std::set<EngravingItem*> itemsBruteForce(const std::vector<EngravingItem*>& all, const RectF& rect)
+{
+    std::set<EngravingItem*> result;
+    for (EngravingItem* e : all) {
+        if (e->pageBoundingRect().intersects(rect)) {
+            result.insert(e);
+        }
+    }
+    return result;
+}
+
+static std::vector<RectF> queryRects(const RectF& pageRect, int columns, int rows)
+{
+    std::vector<RectF> rects;
+    const double w = pageRect.width() / columns;
+    const double h = pageRect.height() / rows;
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < columns; ++col) {
+            rects.emplace_back(pageRect.left() + col * w, pageRect.top() + row * h, w, h);
+        }
+    }
+    return rects;
+}
+
 /**
  * @brief PlaybackModelTests_NearestNeighbor
  * @details Check that BspTree::nearestNeighbor returns the expected note when passing it a certain position
@@ -86,3 +122,105 @@ TEST_F(Engraving_BspTreeTests, NearestNeighbor)
         EXPECT_EQ(nn, singleNote);
     }
 }
+
+/**
+ * @brief Engraving_BspTreeTests_Items
+ * @details Check that BspTree::items and BspTree::visitItems find the same items as a linear scan
+ */
+TEST_F(Engraving_BspTreeTests, Items)
+{
+    Score* score = ScoreRW::readScore(BSPTREE_DATA_DIR + u"nearest_neighbor.mscx");
+    ASSERT_TRUE(score);
+
+    Page* page = score->pages().at(0);
+    ASSERT_TRUE(page);
+
+    // [GIVEN] A BspTree containing all the items of the page
+    std::vector<EngravingItem*> all;
+    page->scanElements(&all, collectItems, false);
+
+    BspTree bsp;
+    bsp.initialize(page->pageBoundingRect(), static_cast<int>(all.size()));
+    page->scanElements(&bsp, bspInsert, false);
+    EXPECT_EQ(bsp.size(), all.size());
+
+    for (const RectF& rect : queryRects(page->pageBoundingRect(), 8, 12)) {
+        // [WHEN] Querying a part of the page
+        std::vector<EngravingItem*> found = bsp.items(rect);
+        std::set<EngravingItem*> visited;
+        bsp.visitItems(rect, [&visited](EngravingItem* e) { visited.insert(e); });
+
+        // [THEN] The same items are found as by checking every item
+        std::set<EngravingItem*> expected = itemsBruteForce(all, rect);
+        EXPECT_EQ(std::set<EngravingItem*>(found.begin(), found.end()), expected);
+        EXPECT_EQ(found.size(), expected.size());
+        EXPECT_EQ(visited, expected);
+    }
+
+    delete score;
+}
+
+/**
+ * @brief Engraving_BspTreeTests_UpdateAndRemove
+ * @details Check that moved, removed and late inserted items are found where they are
+ */
+TEST_F(Engraving_BspTreeTests, UpdateAndRemove)
+{
+    Score* score = ScoreRW::readScore(BSPTREE_DATA_DIR + u"nearest_neighbor.mscx");
+    ASSERT_TRUE(score);
+
+    Page* page = score->pages().at(0);
+    ASSERT_TRUE(page);
+
+    std::vector<EngravingItem*> notes;
+    for (EngravingItem* elem : page->elements()) {
+        if (elem->isNote()) {
+            notes.push_back(elem);
+        }
+    }
+    ASSERT_GE(notes.size(), 2u);
+
+    // [GIVEN] A built BspTree containing all the notes but the last one
+    BspTree bsp;
+    bsp.initialize(page->pageBoundingRect(), static_cast<int>(notes.size()));
+    for (size_t i = 0; i + 1 < notes.size(); ++i) {
+        bsp.insert(notes[i]);
+    }
+
+    EngravingItem* moved = notes.front();
+    const RectF oldRect = moved->pageBoundingRect();
+    EXPECT_TRUE(muse::contains(bsp.items(oldRect), moved));
+
+    // [WHEN] A note is moved far away and the tree is updated
+    const PointF offset(0.0, page->pageBoundingRect().height() * 2);
+    moved->move(offset);
+    EXPECT_TRUE(bsp.update(moved));
+
+    // [THEN] It is found at its new position only
+    EXPECT_TRUE(muse::contains(bsp.items(moved->pageBoundingRect()), moved));
+    EXPECT_FALSE(muse::contains(bsp.items(oldRect), moved));
+    EXPECT_EQ(bsp.nearestNeighbor(moved->pageBoundingRect().center()), moved);
+
+    moved->move(-offset);
+    EXPECT_TRUE(bsp.update(moved));
+    EXPECT_TRUE(muse::contains(bsp.items(oldRect), moved));
+
+    // [WHEN] An item is inserted after the tree has been built
+    EngravingItem* inserted = notes.back();
+    EXPECT_FALSE(bsp.update(inserted));
+    bsp.insert(inserted);
+
+    // [THEN] It is found
+    EXPECT_TRUE(muse::contains(bsp.items(inserted->pageBoundingRect()), inserted));
+
+    // [WHEN] An item is removed
+    bsp.remove(moved);
+
+    // [THEN] It is not found anymore
+    EXPECT_FALSE(muse::contains(bsp.items(oldRect), moved));
+    EXPECT_NE(bsp.nearestNeighbor(oldRect.center()), moved);
+    EXPECT_FALSE(bsp.update(moved));
+    EXPECT_EQ(bsp.size(), notes.size() - 1);
+
+    delete score;
+}
@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "io/file.h"
+
+#include "engraving/internal/engravingfont.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace muse;
+using namespace muse::io;
+
+static const path_t LELAND_PATH(":/fonts/leland/Leland.otf");
+static const path_t BRAVURA_PATH(":/fonts/bravura/Bravura.otf");
+
+namespace mu::engraving {
+class Engraving_EngravingFontTests : public ::testing::Test
+{
+};
+
+TEST_F(Engraving_EngravingFontTests, CacheRoundTrip)
+{
+    const path_t cachePath("EngravingFontTests_CacheRoundTrip.cache");
+    File::remove(cachePath);
+
+    //! GIVEN The font loaded from its metadata
+    EngravingFont reference("Leland", "Leland", LELAND_PATH, muse::modularity::globalCtx());
+    reference.load(path_t());
+    ASSERT_TRUE(reference.m_loaded);
+
+    //! DO Load it again, which writes the cache
+    EngravingFont writer("Leland", "Leland", LELAND_PATH, muse::modularity::globalCtx());
+    writer.load(cachePath);
+    ASSERT_TRUE(File::exists(cachePath));
+
+    //! DO Load it from the cache
+    EngravingFont cached("Leland", "Leland", LELAND_PATH, muse::modularity::globalCtx());
+    ASSERT_TRUE(cached.loadCache(cachePath, cached.sourceHash()));
+    cached.load(cachePath);
+    ASSERT_TRUE(cached.m_loaded);
+
+    //! CHECK Everything read from the metadata is restored
+    for (size_t i = 0; i < reference.m_symbols.size(); ++i) {
+        const SymId id = static_cast<SymId>(i);
+        EXPECT_EQ(cached.symCode(id), reference.symCode(id));
+        EXPECT_EQ(cached.bbox(id, 1.0), reference.bbox(id, 1.0));
+        EXPECT_DOUBLE_EQ(cached.advance(id, 1.0), reference.advance(id, 1.0));
+        EXPECT_EQ(cached.m_symbols[i].smuflAnchors, reference.m_symbols[i].smuflAnchors);
+    }
+
+    EXPECT_EQ(cached.engravingDefaults(), reference.engravingDefaults());
+    EXPECT_DOUBLE_EQ(cached.textEnclosureThickness(), reference.textEnclosureThickness());
+
+    File::remove(cachePath);
+}
+
+TEST_F(Engraving_EngravingFontTests, CacheInvalidation)
+{
+    const path_t cachePath("EngravingFontTests_CacheInvalidation.cache");
+    File::remove(cachePath);
+
+    EngravingFont leland("Leland", "Leland", LELAND_PATH, muse::modularity::globalCtx());
+    EngravingFont bravura("Bravura", "Bravura", BRAVURA_PATH, muse::modularity::globalCtx());
+
+    //! CHECK The hash depends on the font files, which are resources
+    const uint64_t lelandHash = leland.sourceHash();
+    EXPECT_EQ(lelandHash, leland.sourceHash());
+    EXPECT_NE(lelandHash, bravura.sourceHash());
+
+    //! GIVEN The cache of Leland
+    leland.load(cachePath);
+    ASSERT_TRUE(File::exists(cachePath));
+
+    //! CHECK It isn't used for another font
+    EngravingFont other("Bravura", "Bravura", BRAVURA_PATH, muse::modularity::globalCtx());
+    EXPECT_FALSE(other.loadCache(cachePath, other.sourceHash()));
+
+    //! CHECK Nor for a changed font
+    EngravingFont changed("Leland", "Leland", LELAND_PATH, muse::modularity::globalCtx());
+    EXPECT_FALSE(changed.loadCache(cachePath, lelandHash + 1));
+
+    //! CHECK Nor if it's truncated
+    ByteArray data;
+    ASSERT_TRUE(File::readFile(cachePath, data));
+    data.truncate(data.size() / 2);
+    ASSERT_TRUE(File::writeFile(cachePath, data));
+
+    EngravingFont truncated("Leland", "Leland", LELAND_PATH, muse::modularity::globalCtx());
+    EXPECT_FALSE(truncated.loadCache(cachePath, lelandHash));
+
+    File::remove(cachePath);
+}
+}
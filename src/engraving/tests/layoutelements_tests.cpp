@@ -22,11 +22,18 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "dom/chord.h"
 #include "dom/lyrics.h"
 #include "dom/masterscore.h"
 #include "dom/measure.h"
 #include "dom/page.h"
 #include "dom/rest.h"
+#include "dom/segment.h"
 #include "dom/staff.h"
 #include "dom/system.h"
 #include "dom/tuplet.h"
@@ -164,3 +171,67 @@ TEST_F(Engraving_LayoutElementsTests, tstLayoutCrossStaffArp)
 
     delete score;
 }
+
+//---------------------------------------------------------
+//   layoutSnapshot
+//    The positions of all the items of the score, in spatiums,
+//    independent of the item instances (layout may recreate them)
+//---------------------------------------------------------
+
+static void collectItem(void* data, EngravingItem* e)
+{
+    static_cast<std::vector<EngravingItem*>*>(data)->push_back(e);
+}
+
+static std::vector<std::string> layoutSnapshot(Score* score)
+{
+    std::vector<EngravingItem*> items;
+    score->scanElements(&items, collectItem, /* all */ false);
+
+    std::vector<std::string> result;
+    for (const EngravingItem* e : items) {
+        const PointF pos = e->pagePos() / score->style().spatium();
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), "%s tick %d track %zu (%.2f, %.2f)",
+                      e->typeName(), e->tick().ticks(), e->track(), pos.x(), pos.y());
+        result.push_back(buf);
+    }
+
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+//---------------------------------------------------------
+//   tstPartialLayout
+//    Test that the layout of a range after a command gives the same result as the layout of the whole score,
+//    e.g. the chord symbols aligned with the one pushed up by a high note go back down once the note is deleted
+//---------------------------------------------------------
+
+TEST_F(Engraving_LayoutElementsTests, tstPartialLayout)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"partial_layout.mscx");
+    ASSERT_TRUE(score);
+
+    // the high note in the second measure pushes its chord symbol up
+    Measure* m = score->firstMeasure()->nextMeasure();
+    ASSERT_TRUE(m);
+    Segment* s = m->first(SegmentType::ChordRest);
+    ASSERT_TRUE(s && s->element(0) && s->element(0)->isChord());
+    Note* note = toChord(s->element(0))->upNote();
+
+    // delete it, the score is laid out from the second measure
+    score->startCmd(TranslatableString::untranslatable("Engraving layout elements tests"));
+    score->deleteItem(note);
+    score->endCmd();
+
+    std::vector<std::string> partialLayout = layoutSnapshot(score);
+
+    score->doLayout();
+
+    std::vector<std::string> fullLayout = layoutSnapshot(score);
+
+    EXPECT_EQ(partialLayout, fullLayout);
+
+    delete score;
+}
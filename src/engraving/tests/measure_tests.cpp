@@ -606,3 +606,66 @@ TEST_F(Engraving_MeasureTests, measureSplit) {
 
     EXPECT_TRUE(ScoreComp::saveCompareScore(score, u"measureSplit.mscx", MEASURE_DATA_DIR + u"measureSplit-ref.mscx"));
 }
+
+static MasterScore* createLongScore(int measures)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+    if (!score) {
+        return nullptr;
+    }
+
+    score->startCmd(TranslatableString::untranslatable("Engraving measure tests"));
+    score->appendMeasures(measures - static_cast<int>(score->nmeasures()));
+    score->endCmd();
+
+    return score;
+}
+
+static Measure* tick2measureLinear(const Score* score, const Fraction& tick)
+{
+    Measure* lm = nullptr;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        if (tick < m->tick()) {
+            return lm;
+        }
+        lm = m;
+    }
+    return (lm && tick <= lm->endTick()) ? lm : nullptr;
+}
+
+TEST_F(Engraving_MeasureTests, tick2measureIndex)
+{
+    MasterScore* score = createLongScore(200);
+    ASSERT_TRUE(score);
+    EXPECT_EQ(score->nmeasures(), 200u);
+
+    auto checkAllTicks = [score]() {
+        for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            Fraction middle = m->tick() + m->ticks() / 2;
+            EXPECT_EQ(score->tick2measure(m->tick()), m);
+            EXPECT_EQ(score->tick2measure(middle), tick2measureLinear(score, middle));
+            EXPECT_EQ(score->tick2measureBase(middle), m);
+            EXPECT_EQ(score->tick2measureMM(middle), m);
+        }
+        Measure* last = score->lastMeasure();
+        EXPECT_EQ(score->tick2measure(last->endTick()), last);
+        EXPECT_EQ(score->tick2measureBase(last->endTick()), nullptr);
+        EXPECT_EQ(score->tick2measure(last->endTick() + Fraction(1, 4)), nullptr);
+    };
+
+    checkAllTicks();
+
+    // [WHEN] The measure list changes, the index must follow
+    score->startCmd(TranslatableString::untranslatable("Engraving measure tests"));
+    Measure* m = score->tick2measure(Fraction(100, 1));
+    score->insertMeasure(m);
+    score->endCmd();
+    EXPECT_EQ(score->nmeasures(), 201u);
+    checkAllTicks();
+
+    score->undoRedo(true, nullptr);
+    EXPECT_EQ(score->nmeasures(), 200u);
+    checkAllTicks();
+
+    delete score;
+}
@@ -95,6 +95,8 @@ public:
     MOCK_METHOD(bool, doNotSaveEIDsForBackCompat, (), (const, override));
     MOCK_METHOD(void, setDoNotSaveEIDsForBackCompat, (bool), (override));
 
+    MOCK_METHOD(size_t, undoMemoryBudget, (), (const, override));
+
     MOCK_METHOD(bool, guitarProImportExperimental, (), (const, override));
     MOCK_METHOD(bool, experimentalGuitarBendImport, (), (const, override));
     MOCK_METHOD(void, setExperimentalGuitarBendImport, (bool), (override));
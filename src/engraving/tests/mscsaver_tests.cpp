@@ -0,0 +1,266 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "async/asyncable.h"
+#include "global/io/buffer.h"
+
+#include "dom/excerpt.h"
+#include "dom/masterscore.h"
+#include "dom/segment.h"
+#include "infrastructure/mscreader.h"
+#include "infrastructure/mscwriter.h"
+#include "rw/inoutdata.h"
+#include "rw/mscsaver.h"
+#include "rw/rwregister.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace muse;
+using namespace muse::io;
+using namespace mu::engraving;
+
+static const String MSCSAVER_DATA_DIR(u"midimapping_data/");
+
+class Engraving_MscSaverTests : public ::testing::Test, public muse::async::Asyncable
+{
+public:
+};
+
+//! NOTE A score with a part for each of its 16 instruments
+static MasterScore* readManyPartsScore()
+{
+    MasterScore* score = ScoreRW::readScore(MSCSAVER_DATA_DIR + u"test1withDrums.mscx");
+    if (!score) {
+        return nullptr;
+    }
+
+    for (Excerpt* excerpt : Excerpt::createExcerptsFromParts(score->parts(), score)) {
+        score->initAndAddExcerpt(excerpt, true);
+    }
+
+    return score;
+}
+
+static ByteArray saveMscz(MasterScore* score, MscExcerptsCache* excerptsCache = nullptr)
+{
+    ByteArray msczData;
+    Buffer buf(&msczData);
+
+    MscWriter::Params params;
+    params.device = &buf;
+    params.filePath = "score.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscWriter writer(params);
+    writer.open();
+
+    MscSaver saver(score->iocContext());
+    saver.writeMscz(score, writer, false, false, excerptsCache);
+    writer.close();
+
+    return msczData;
+}
+
+//! NOTE Like the autosave: the files are collected in a snapshot, then written from it
+static ByteArray saveMscxFromSnapshot(MasterScore* score, MscExcerptsCache* excerptsCache)
+{
+    MscWriter::Snapshot snapshot;
+
+    MscWriter::Params snapshotParams;
+    snapshotParams.filePath = "score.mscx";
+    snapshotParams.mode = MscIoMode::XmlFile;
+    snapshotParams.snapshot = &snapshot;
+
+    MscWriter snapshotWriter(snapshotParams);
+    snapshotWriter.open();
+
+    MscSaver saver(score->iocContext());
+    saver.writeMscz(score, snapshotWriter, false, false, excerptsCache);
+    snapshotWriter.close();
+
+    ByteArray mscxData;
+    Buffer buf(&mscxData);
+
+    MscWriter::Params params;
+    params.device = &buf;
+    params.filePath = "score.mscx";
+    params.mode = MscIoMode::XmlFile;
+
+    MscWriter writer(params);
+    writer.open();
+    writer.writeSnapshot(snapshot);
+    writer.close();
+
+    return mscxData;
+}
+
+//! NOTE The single file format, so that the output has no time stamps
+static ByteArray saveMscx(MasterScore* score)
+{
+    ByteArray mscxData;
+    Buffer buf(&mscxData);
+
+    MscWriter::Params params;
+    params.device = &buf;
+    params.filePath = "score.mscx";
+    params.mode = MscIoMode::XmlFile;
+
+    MscWriter writer(params);
+    writer.open();
+
+    MscSaver saver(score->iocContext());
+    saver.writeMscz(score, writer, false, false);
+    writer.close();
+
+    return mscxData;
+}
+
+static std::vector<ByteArray> readExcerptFiles(MasterScore* score, ByteArray msczData)
+{
+    Buffer buf(&msczData);
+
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = "score.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    reader.open();
+
+    std::vector<ByteArray> result;
+    for (const Excerpt* excerpt : score->excerpts()) {
+        result.push_back(reader.readExcerptFile(excerpt->fileName()));
+    }
+
+    return result;
+}
+
+//! NOTE Each excerpt is written continuing the context of the previous one
+static std::vector<ByteArray> writeExcerptsSequentially(MasterScore* score)
+{
+    rw::IWriterPtr writer = rw::RWRegister::writer(score->iocContext());
+    rw::WriteInOutData inout(score);
+
+    ByteArray scoreData;
+    Buffer scoreBuf(&scoreData);
+    scoreBuf.open(IODevice::ReadWrite);
+    writer->writeScore(score, &scoreBuf, false, &inout);
+
+    std::vector<ByteArray> result;
+    for (const Excerpt* excerpt : score->excerpts()) {
+        ByteArray excerptData;
+        Buffer excerptBuf(&excerptData);
+        excerptBuf.open(IODevice::ReadWrite);
+        writer->writeScore(excerpt->excerptScore(), &excerptBuf, false, &inout);
+        result.push_back(excerptData);
+    }
+
+    return result;
+}
+
+TEST_F(Engraving_MscSaverTests, Excerpts_SameAsSequential)
+{
+    //! GIVEN A score with many parts
+    MasterScore* score = readManyPartsScore();
+    ASSERT_TRUE(score);
+    ASSERT_GT(score->excerpts().size(), 1);
+
+    //! DO Save it
+    ByteArray msczData = saveMscz(score);
+
+    //! CHECK The excerpts are the same as written one after another
+    std::vector<ByteArray> excerptFiles = readExcerptFiles(score, msczData);
+    std::vector<ByteArray> expectedFiles = writeExcerptsSequentially(score);
+    ASSERT_EQ(excerptFiles.size(), expectedFiles.size());
+    for (size_t i = 0; i < expectedFiles.size(); ++i) {
+        EXPECT_EQ(excerptFiles.at(i), expectedFiles.at(i));
+    }
+
+    //! CHECK The excerpts reused from the cache are the same too
+    MscExcerptsCache excerptsCache;
+    saveMscz(score, &excerptsCache);
+    excerptsCache.invalidate(score->excerpts().front()->excerptScore());
+
+    excerptFiles = readExcerptFiles(score, saveMscz(score, &excerptsCache));
+    ASSERT_EQ(excerptFiles.size(), expectedFiles.size());
+    for (size_t i = 0; i < expectedFiles.size(); ++i) {
+        EXPECT_EQ(excerptFiles.at(i), expectedFiles.at(i));
+    }
+
+    delete score;
+}
+
+TEST_F(Engraving_MscSaverTests, Snapshot_SameAsDirectSave)
+{
+    //! GIVEN A score with many parts, saved once through the cache
+    MasterScore* score = readManyPartsScore();
+    ASSERT_TRUE(score);
+    ASSERT_GT(score->excerpts().size(), 1);
+
+    Score* partScore = score->excerpts().front()->excerptScore();
+    ASSERT_TRUE(partScore);
+
+    MscExcerptsCache excerptsCache;
+    EXPECT_EQ(saveMscxFromSnapshot(score, &excerptsCache), saveMscx(score));
+
+    //! NOTE The cache is invalidated like the project does it
+    score->changesChannel().onReceive(this, [&excerptsCache](const ScoreChangesRange& range) {
+        excerptsCache.invalidate(range);
+    });
+
+    //! DO An undoable change in the master score
+    EngravingItem* item = score->firstSegment(SegmentType::ChordRest)->element(0);
+    ASSERT_TRUE(item);
+
+    score->startCmd(TranslatableString::untranslatable("MscSaver tests"));
+    item->undoChangeProperty(Pid::VISIBLE, false);
+    score->endCmd();
+
+    //! CHECK The snapshot is the same as the direct save
+    EXPECT_EQ(saveMscxFromSnapshot(score, &excerptsCache), saveMscx(score));
+
+    //! DO An undoable change in a part only
+    EngravingItem* partItem = partScore->firstSegment(SegmentType::ChordRest)->element(0);
+    ASSERT_TRUE(partItem);
+
+    partScore->startCmd(TranslatableString::untranslatable("MscSaver tests"));
+    partItem->undoChangeProperty(Pid::OFFSET, PointF(0.0, 10.0));
+    partScore->endCmd();
+
+    //! CHECK The snapshot is the same as the direct save
+    EXPECT_EQ(saveMscxFromSnapshot(score, &excerptsCache), saveMscx(score));
+
+    //! DO A change outside of the undo stack
+    partScore->setMetaTag(u"workTitle", u"MscSaver tests");
+
+    //! CHECK The stale excerpt would be written
+    MscExcerptsCache staleCache = excerptsCache;
+    EXPECT_NE(saveMscxFromSnapshot(score, &staleCache), saveMscx(score));
+
+    //! CHECK The snapshot is the same as the direct save, once the cache is cleared like in markAsUnsaved
+    excerptsCache.clear();
+    EXPECT_EQ(saveMscxFromSnapshot(score, &excerptsCache), saveMscx(score));
+
+    delete score;
+}
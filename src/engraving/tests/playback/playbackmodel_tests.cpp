@@ -330,6 +330,70 @@ TEST_F(Engraving_PlaybackModelTests, Da_Capo_Al_Fine)
     EXPECT_EQ(result.size(), expectedSize);
 }
 
+/**
+ * @brief PlaybackModelTests_Repeated_Measures
+ * @details In this case we're building up a playback model of a simple score - Violin, 4/4, 120bpm, Treble Cleff, 5 measures
+ *          Measures 1-4 are repeated, measure 3 is marked by "p", which is carried over to the beginning of the second repeat.
+ *          The second repeat of a measure reuses the events of the first one (shifted in time) when its dynamics stay the same,
+ *          so the events of both repeats must match what rendering every repeat separately gives
+ */
+TEST_F(Engraving_PlaybackModelTests, Repeated_Measures)
+{
+    // [GIVEN] Simple piece of score (Violin, 4/4, 120 bpm, Treble Cleff)
+    Score* score = ScoreRW::readScore(PLAYBACK_MODEL_TEST_FILES_DIR + "repeated_measures/repeated_measures.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->parts().size(), 1);
+
+    const Part* part = score->parts().at(0);
+    ASSERT_TRUE(part);
+
+    // [WHEN] The articulation profiles repository will be returning profiles for StringsArticulation family
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    // [WHEN] The playback model requested to be loaded
+    PlaybackModel model(modularity::globalCtx());
+    model.profilesRepository.set(m_repositoryMock);
+    model.load(score);
+
+    const PlaybackEventsMap& result = model.resolveTrackPlaybackData(part->id(), part->instrumentId()).originEvents;
+
+    // [THEN] 4 quarter notes on every measure * 9 measures which should be played
+    ASSERT_EQ(result.size(), 36);
+
+    constexpr timestamp_t MEASURE_DURATION = 4 * QUARTER_NOTE_DURATION;
+    constexpr timestamp_t REPEAT_DURATION = 4 * MEASURE_DURATION;
+
+    constexpr dynamic_level_t natural = dynamicLevelFromType(mpe::DynamicType::Natural);
+    constexpr dynamic_level_t piano = dynamicLevelFromType(mpe::DynamicType::p);
+
+    for (timestamp_t timestamp = 0; timestamp < REPEAT_DURATION; timestamp += QUARTER_NOTE_DURATION) {
+        ASSERT_TRUE(muse::contains(result, timestamp));
+        ASSERT_TRUE(muse::contains(result, timestamp + REPEAT_DURATION));
+
+        const PlaybackEventList& firstRepeatEvents = result.at(timestamp);
+        const PlaybackEventList& secondRepeatEvents = result.at(timestamp + REPEAT_DURATION);
+        ASSERT_EQ(firstRepeatEvents.size(), 1);
+        ASSERT_EQ(secondRepeatEvents.size(), 1);
+
+        const mpe::NoteEvent& firstRepeatNote = std::get<mpe::NoteEvent>(firstRepeatEvents.front());
+        const mpe::NoteEvent& secondRepeatNote = std::get<mpe::NoteEvent>(secondRepeatEvents.front());
+
+        // [THEN] The notes are the same in both repeats, only shifted in time
+        EXPECT_EQ(secondRepeatNote.arrangementCtx().nominalTimestamp, timestamp + REPEAT_DURATION);
+        EXPECT_EQ(secondRepeatNote.arrangementCtx().actualTimestamp,
+                  firstRepeatNote.arrangementCtx().actualTimestamp + REPEAT_DURATION);
+        EXPECT_EQ(secondRepeatNote.arrangementCtx().nominalDuration, firstRepeatNote.arrangementCtx().nominalDuration);
+        EXPECT_EQ(secondRepeatNote.arrangementCtx().actualDuration, firstRepeatNote.arrangementCtx().actualDuration);
+        EXPECT_EQ(secondRepeatNote.pitchCtx(), firstRepeatNote.pitchCtx());
+
+        // [THEN] "p" applies from measure 3 of the first repeat up to the end
+        bool isBeforePiano = timestamp < 2 * MEASURE_DURATION;
+        EXPECT_EQ(firstRepeatNote.expressionCtx().nominalDynamicLevel, isBeforePiano ? natural : piano);
+        EXPECT_EQ(secondRepeatNote.expressionCtx().nominalDynamicLevel, piano);
+    }
+}
+
 /**
  * @brief PlaybackModelTests_Dal_Segno_Al_Coda
  * @details In this case we're building up a playback model of a simple score - Violin, 4/4, 120bpm, Treble Cleff, 6 measures
@@ -847,10 +911,22 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     PlaybackData result = model.resolveTrackPlaybackData(part->id(), part->instrumentId());
     EXPECT_EQ(result.originEvents.size(), expectedChangedEventsCount);
 
-    // [THEN] Updated events map will match our expectations
-    result.mainStream.onReceive(this, [expectedChangedEventsCount](const PlaybackEventsMap& updatedEvents, const DynamicLevelLayers&,
-                                                                   const PlaybackParamLayers&) {
-        EXPECT_EQ(updatedEvents.size(), expectedChangedEventsCount);
+    // [THEN] Only the changed windows are sent, and the patched events map will match the model
+    PlaybackEventsMap patchedEvents = result.originEvents;
+    int receivedPatchesCount = 0;
+
+    result.mainStreamPatches.onReceive(this, [&](const MainStreamPatch& patch) {
+        EXPECT_FALSE(patch.windows.empty());
+
+        for (const PlaybackEventsWindow& window : patch.windows) {
+            applyWindow(patchedEvents, window);
+        }
+
+        const PlaybackData& actualData = model.resolveTrackPlaybackData(part->id(), part->instrumentId());
+        EXPECT_EQ(patchedEvents.size(), expectedChangedEventsCount);
+        EXPECT_TRUE(patchedEvents == actualData.originEvents);
+
+        ++receivedPatchesCount;
     });
 
     // [WHEN] Score has been changed: the range starts ouside the repeat and ends inside it
@@ -872,6 +948,8 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     range.changedTypes = { ElementType::PEDAL };
 
     score->changesChannel().send(range);
+
+    EXPECT_EQ(receivedPatchesCount, 2);
 }
 
 /**
@@ -1223,7 +1301,7 @@ TEST_F(Engraving_PlaybackModelTests, Playback_Setup_Data_MultiInstrument)
         PLAYBACK_MODEL_TEST_FILES_DIR + "playback_setup_instruments/playback_setup_instruments.mscx");
 
     ASSERT_TRUE(score);
-    ASSERT_EQ(score->parts().size(), 12);
+    ASSERT_EQ(score->parts().size(), 12u);
 
     constexpr bool supportsSND = true; // supports single note dynamics
 
@@ -1270,3 +1348,44 @@ TEST_F(Engraving_PlaybackModelTests, Playback_Setup_Data_MultiInstrument)
         }
     }
 }
+
+/**
+ * @brief PlaybackModelTests_Load_AddsEveryTrackOnce
+ * @details The parts are rendered concurrently and each track is announced as soon as its events are ready,
+ *          every instrument track must still be announced exactly once
+ */
+TEST_F(Engraving_PlaybackModelTests, Load_AddsEveryTrackOnce)
+{
+    // [GIVEN] A score with 12 parts
+    Score* score = ScoreRW::readScore(
+        PLAYBACK_MODEL_TEST_FILES_DIR + "playback_setup_instruments/playback_setup_instruments.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->parts().size(), 12u);
+
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    PlaybackModel model(modularity::globalCtx());
+    model.profilesRepository.set(m_repositoryMock);
+
+    std::vector<InstrumentTrackId> addedTracks;
+    model.trackAdded().onReceive(this, [&addedTracks](const InstrumentTrackId& trackId) {
+        addedTracks.push_back(trackId);
+    });
+
+    // [WHEN] The playback model requested to be loaded
+    model.load(score);
+
+    // [THEN] Every track of the model is announced once
+    InstrumentTrackIdSet existingTracks = model.existingTrackIdSet();
+    EXPECT_EQ(addedTracks.size(), existingTracks.size());
+    EXPECT_EQ(InstrumentTrackIdSet(addedTracks.begin(), addedTracks.end()), existingTracks);
+
+    for (const Part* part : score->parts()) {
+        for (const InstrumentTrackId& trackId : part->instrumentTrackIdSet()) {
+            EXPECT_TRUE(muse::contains(existingTracks, trackId));
+        }
+    }
+
+    EXPECT_TRUE(muse::contains(existingTracks, model.metronomeTrackId()));
+}
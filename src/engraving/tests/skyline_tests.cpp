@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <utility>
+
+#include "global/io/dir.h"
+
+#include "dom/masterscore.h"
+#include "dom/page.h"
+#include "dom/system.h"
+#include "infrastructure/skyline.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String VTEST_SCORES_DIR(u"/../../../vtest/scores");
+
+class Engraving_SkylineTests : public ::testing::Test
+{
+};
+
+static Shape toShape(const SkylineLine& skylineLine)
+{
+    Shape shape;
+    for (const ShapeElement& element : skylineLine.elements()) {
+        shape.add(element);
+    }
+    return shape;
+}
+
+//! NOTE: The indexed queries of SkylineLine must give exactly the same results as the plain Shape ones
+static void checkEquivalence(const SkylineLine& above, const SkylineLine& below, double minHorizontalClearance)
+{
+    Shape aboveShape = toShape(above);
+    Shape belowShape = toShape(below);
+
+    EXPECT_EQ(above.minDistance(below, minHorizontalClearance),
+              aboveShape.minVerticalDistance(belowShape, minHorizontalClearance));
+    EXPECT_EQ(below.minDistanceToShapeAbove(aboveShape, minHorizontalClearance),
+              aboveShape.minVerticalDistance(belowShape, minHorizontalClearance));
+    EXPECT_EQ(above.minDistanceToShapeBelow(belowShape, minHorizontalClearance),
+              aboveShape.minVerticalDistance(belowShape, minHorizontalClearance));
+    EXPECT_EQ(below.verticalClearanceAbove(aboveShape), aboveShape.verticalClearance(belowShape));
+    EXPECT_EQ(above.verticalClaranceBelow(belowShape), aboveShape.verticalClearance(belowShape));
+}
+
+/**
+ * @brief Engraving_SkylineTests_RandomShapes_Equivalence
+ * @details Compares the indexed skyline queries with the plain Shape ones on random shapes,
+ *          including zero-width and zero-height rectangles
+ */
+TEST_F(Engraving_SkylineTests, RandomShapes_Equivalence)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> xDist(-50.0, 500.0);
+    std::uniform_real_distribution<double> yDist(-30.0, 30.0);
+    std::uniform_real_distribution<double> widthDist(-2.0, 60.0);
+    std::uniform_real_distribution<double> heightDist(-1.0, 10.0);
+
+    auto fill = [&](SkylineLine& skylineLine, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            double width = generator() % 10 == 0 ? 0.0 : widthDist(generator);
+            double height = generator() % 10 == 0 ? 0.0 : heightDist(generator);
+            skylineLine.add(RectF(xDist(generator), yDist(generator), width, height), nullptr);
+        }
+    };
+
+    for (size_t i = 0; i < 500; ++i) {
+        SkylineLine above(false);
+        SkylineLine below(true);
+        fill(above, generator() % 200);
+        fill(below, generator() % 200);
+
+        checkEquivalence(above, below, 0.0);
+        checkEquivalence(above, below, 1.7);
+    }
+}
+
+/**
+ * @brief Engraving_SkylineTests_VTestScores_Equivalence
+ * @details Lays out the vtest scores and compares the indexed skyline queries
+ *          with the plain Shape ones for every pair of adjacent staves
+ */
+TEST_F(Engraving_SkylineTests, VTestScores_Equivalence)
+{
+    muse::RetVal<muse::io::paths_t> files = muse::io::Dir::scanFiles(ScoreRW::rootPath() + VTEST_SCORES_DIR,
+                                                                      { "*.mscx", "*.mscz" },
+                                                                      muse::io::ScanMode::FilesInCurrentDir);
+    ASSERT_TRUE(files.ret);
+    ASSERT_FALSE(files.val.empty());
+
+    for (const muse::io::path_t& file : files.val) {
+        MasterScore* score = ScoreRW::readScore(file.toString(), true);
+        if (!score) {
+            continue;
+        }
+
+        double minHorizontalClearance = score->style().styleMM(Sid::skylineMinHorizontalClearance);
+
+        for (const Page* page : score->pages()) {
+            for (System* system : page->systems()) {
+                for (size_t si = 0; si + 1 < system->staves().size(); ++si) {
+                    const SkylineLine& above = std::as_const(*system->staff(si)).skyline().south();
+                    const SkylineLine& below = std::as_const(*system->staff(si + 1)).skyline().north();
+
+                    checkEquivalence(above, below, 0.0);
+                    checkEquivalence(above, below, minHorizontalClearance);
+                }
+            }
+        }
+
+        delete score;
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dom/chord.h"
+#include "dom/masterscore.h"
+#include "dom/note.h"
+#include "dom/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_UndoTests : public ::testing::Test
+{
+};
+
+static Note* firstNote(Score* score)
+{
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        EngravingItem* e = s->element(0);
+        if (e && e->isChord()) {
+            return toChord(e)->upNote();
+        }
+    }
+    return nullptr;
+}
+
+static void changeColor(MasterScore* score, Note* note, const Color& color)
+{
+    score->startCmd(TranslatableString::untranslatable("Engraving undo tests"));
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(color));
+    score->endCmd();
+}
+
+/**
+ * @brief Engraving_UndoTests_CoalescePropertyChanges
+ * @details Check that consecutive changes of the same property are recorded once, and still undo to the original value
+ */
+TEST_F(Engraving_UndoTests, CoalescePropertyChanges)
+{
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+
+    Note* note = firstNote(score);
+    ASSERT_TRUE(note);
+
+    const Color original = note->color();
+    UndoStack* undoStack = score->undoStack();
+    const size_t coalesced = undoStack->memoryStats().coalescedCommandCount;
+
+    // [WHEN] The same property is changed several times within one command
+    score->startCmd(TranslatableString::untranslatable("Engraving undo tests"));
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(Color::RED));
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(Color::GREEN));
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(Color::BLUE));
+    score->endCmd();
+
+    // [THEN] Only the first change is recorded
+    EXPECT_EQ(undoStack->memoryStats().coalescedCommandCount, coalesced + 2);
+    EXPECT_EQ(note->color(), Color::BLUE);
+
+    // [THEN] Undo and redo go between the original and the last value
+    score->undoRedo(true, nullptr);
+    EXPECT_EQ(note->color(), original);
+
+    score->undoRedo(false, nullptr);
+    EXPECT_EQ(note->color(), Color::BLUE);
+
+    delete score;
+}
+
+/**
+ * @brief Engraving_UndoTests_MemoryBudget
+ * @details Check that the oldest commands are evicted when the undo history exceeds its memory budget
+ */
+TEST_F(Engraving_UndoTests, MemoryBudget)
+{
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+
+    Note* note = firstNote(score);
+    ASSERT_TRUE(note);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setMemoryBudget(0);
+
+    // [GIVEN] Three commands in the history, without memory limit
+    const size_t startIdx = undoStack->currentIndex();
+    changeColor(score, note, Color::RED);
+    changeColor(score, note, Color::GREEN);
+    changeColor(score, note, Color::BLUE);
+
+    UndoStack::MemoryStats stats = undoStack->memoryStats();
+    EXPECT_GT(stats.usage, 0u);
+    EXPECT_EQ(stats.evictedMacroCount, 0u);
+
+    // [WHEN] The budget is lowered below the size of the history
+    undoStack->setMemoryBudget(1);
+
+    // [THEN] All but the last command are evicted, and keep their place in the history
+    stats = undoStack->memoryStats();
+    EXPECT_EQ(stats.evictedMacroCount, startIdx + 2);
+    EXPECT_EQ(stats.macroCount, startIdx + 3);
+    EXPECT_EQ(undoStack->currentIndex(), startIdx + 3);
+    EXPECT_TRUE(undoStack->lastAtIndex(startIdx + 1));
+
+    // [THEN] Only the last command can be undone
+    EXPECT_TRUE(undoStack->canUndo());
+    score->undoRedo(true, nullptr);
+    EXPECT_EQ(note->color(), Color::GREEN);
+    EXPECT_FALSE(undoStack->canUndo());
+
+    score->undoRedo(true, nullptr);
+    EXPECT_EQ(note->color(), Color::GREEN);
+
+    score->undoRedo(false, nullptr);
+    EXPECT_EQ(note->color(), Color::BLUE);
+
+    delete score;
+}
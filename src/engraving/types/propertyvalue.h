@@ -318,6 +318,9 @@ public:
     bool isValid() const;
 
     P_TYPE type() const;
+
+    //! NOTE Approximate heap footprint of the value, for memory accounting
+    size_t memoryUsage() const { return m_data ? m_data->memoryUsage() : 0; }
     bool isEnum() const { return m_data ? m_data->isEnum() : false; }
 
     template<typename T>
@@ -453,6 +456,8 @@ private:
 
         virtual bool isEnum() const = 0;
         virtual int enumToInt() const = 0;
+
+        virtual size_t memoryUsage() const = 0;
     };
 
     template<typename T>
@@ -483,6 +488,17 @@ private:
                 return -1;
             }
         }
+
+        size_t memoryUsage() const override
+        {
+            if constexpr (std::is_same<T, String>::value) {
+                return sizeof(*this) + v.size() * sizeof(char16_t);
+            } else if constexpr (std::is_same<T, std::vector<int> >::value) {
+                return sizeof(*this) + v.capacity() * sizeof(int);
+            } else {
+                return sizeof(*this);
+            }
+        }
     };
 
     template<typename T>
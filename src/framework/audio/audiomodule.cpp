@@ -249,6 +249,11 @@ void AudioModule::onDestroy()
 
 void AudioModule::setupAudioDriver(const IApplication::RunMode& mode)
 {
+    //! NOTE: The driver callback wakes up the worker when the buffer needs refilling
+    m_audioBuffer->setOnNeedsRefill([this]() {
+        m_audioWorker->wakeup();
+    });
+
     IAudioDriver::Spec requiredSpec;
     requiredSpec.sampleRate = m_configuration->sampleRate();
     requiredSpec.format = IAudioDriver::Format::AudioF32;
@@ -300,11 +305,6 @@ void AudioModule::setupAudioWorker(const IAudioDriver::Spec& activeSpec)
         m_audioEngine->setSampleRate(activeSpec.sampleRate);
         m_audioEngine->setReadBufferSize(activeSpec.samples);
 
-        m_audioEngine->setOnReadBufferChanged([this](const samples_t samples, const sample_rate_t rate) {
-            msecs_t interval = m_configuration->audioWorkerInterval(samples, rate);
-            m_audioWorker->setInterval(interval);
-        });
-
         auto fluidResolver = std::make_shared<FluidResolver>(iocContext());
         m_synthResolver->registerResolver(AudioSourceType::Fluid, fluidResolver);
         m_synthResolver->init(m_configuration->defaultAudioInputParams());
@@ -318,6 +318,5 @@ void AudioModule::setupAudioWorker(const IAudioDriver::Spec& activeSpec)
         m_audioBuffer->forward();
     };
 
-    msecs_t interval = m_configuration->audioWorkerInterval(activeSpec.samples, activeSpec.sampleRate);
-    m_audioWorker->run(workerSetup, workerLoopBody, interval);
+    m_audioWorker->run(workerSetup, workerLoopBody);
 }
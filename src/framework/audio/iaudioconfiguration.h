@@ -52,7 +52,6 @@ public:
     virtual void setDriverBufferSize(unsigned int size) = 0;
     virtual async::Notification driverBufferSizeChanged() const = 0;
 
-    virtual msecs_t audioWorkerInterval(const samples_t bufferSize, const samples_t sampleRate) const = 0;
     virtual samples_t minSamplesToReserve(RenderMode mode) const = 0;
 
     virtual samples_t samplesToPreallocate() const = 0;
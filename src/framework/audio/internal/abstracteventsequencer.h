@@ -23,8 +23,10 @@
 #ifndef MUSE_AUDIO_ABSTRACTEVENTSEQUENCER_H
 #define MUSE_AUDIO_ABSTRACTEVENTSEQUENCER_H
 
+#include <algorithm>
 #include <map>
 #include <set>
+#include <vector>
 
 #include "global/async/asyncable.h"
 #include "mpe/events.h"
@@ -41,12 +43,87 @@ public:
     using EventSequence = std::set<EventType>;
     using EventSequenceMap = std::map<msecs_t, EventSequence>;
 
-    typedef typename EventSequenceMap::const_iterator SequenceIterator;
-    typedef typename EventSequence::const_iterator EventIterator;
+    struct TimedEvent {
+        msecs_t timestamp = 0;
+        EventType event;
+    };
+
+    //! NOTE Sorted by timestamp, then by std::less<EventType>, without duplicates
+    using EventArray = std::vector<TimedEvent>;
+
+    //! NOTE Caller-owned flat storage for the events of a single audio block.
+    //! It is reserved in advance, so that filling it on the audio thread doesn't allocate
+    class EventBuffer
+    {
+    public:
+        static constexpr size_t DEFAULT_SEQUENCES_CAPACITY = 256;
+        static constexpr size_t DEFAULT_EVENTS_CAPACITY = 2048;
+
+        struct Sequence {
+            msecs_t timestamp = 0;
+            size_t eventsBegin = 0;
+            size_t eventsEnd = 0;
+        };
+
+        using EventIterator = typename std::vector<EventType>::const_iterator;
+
+        void reserve(size_t sequencesCapacity = DEFAULT_SEQUENCES_CAPACITY, size_t eventsCapacity = DEFAULT_EVENTS_CAPACITY)
+        {
+            m_sequences.reserve(sequencesCapacity);
+            m_events.reserve(eventsCapacity);
+        }
+
+        void clear()
+        {
+            m_sequences.clear();
+            m_events.clear();
+        }
+
+        size_t sequencesCount() const
+        {
+            return m_sequences.size();
+        }
+
+        const Sequence& sequence(size_t idx) const
+        {
+            return m_sequences[idx];
+        }
+
+        EventIterator eventsBegin(const Sequence& sequence) const
+        {
+            return m_events.cbegin() + sequence.eventsBegin;
+        }
+
+        EventIterator eventsEnd(const Sequence& sequence) const
+        {
+            return m_events.cbegin() + sequence.eventsEnd;
+        }
+
+        //! NOTE Continues the last sequence if it isn't older than the given timestamp
+        void beginSequence(const msecs_t timestamp)
+        {
+            if (!m_sequences.empty() && m_sequences.back().timestamp >= timestamp) {
+                return;
+            }
+
+            m_sequences.push_back(Sequence { timestamp, m_events.size(), m_events.size() });
+        }
+
+        void addEvent(const EventType& event)
+        {
+            m_events.push_back(event);
+            m_sequences.back().eventsEnd = m_events.size();
+        }
+
+    private:
+        std::vector<Sequence> m_sequences;
+        std::vector<EventType> m_events;
+    };
 
     virtual ~AbstractEventSequencer()
     {
         m_playbackData.mainStream.resetOnReceive(this);
+        m_playbackData.mainStreamPatches.resetOnReceive(this);
         m_playbackData.offStream.resetOnReceive(this);
     }
 
@@ -69,6 +146,17 @@ public:
             }
         });
 
+        m_playbackData.mainStreamPatches.onReceive(this, [this](const mpe::MainStreamPatch& patch) {
+            if (m_isActive && !m_shouldUpdateMainStreamEvents) {
+                applyMainStreamPatch(patch);
+                return;
+            }
+
+            //! NOTE The main stream will be rebuilt on activation anyway
+            applyPatchToPlaybackData(patch);
+            m_shouldUpdateMainStreamEvents = true;
+        });
+
         m_playbackData.offStream.onReceive(this, [this](const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) {
             updateOffStreamEvents(events, params);
         });
@@ -151,29 +239,43 @@ public:
         return mpe::dynamicLevelFromType(muse::mpe::DynamicType::Natural);
     }
 
-    EventSequenceMap movePlaybackForward(const msecs_t nextMsecs)
+    //! NOTE Fills the caller-owned buffer with the event sequences of the next audio block.
+    //! The sequencer storage and the buffer are flat arrays, so there are no allocations as long as the buffer capacity suffices
+    void movePlaybackForward(const msecs_t nextMsecs, EventBuffer& result)
     {
         ONLY_AUDIO_WORKER_THREAD;
 
-        EventSequenceMap result;
+        result.clear();
 
         if (!m_isActive) {
-            result.emplace(0, EventSequence());
+            result.beginSequence(0);
             handleOffStream(result, nextMsecs);
-            return result;
+            return;
         }
 
         // Empty sequence means to continue the previous sequence
-        result.emplace(m_playbackPosition, EventSequence());
+        result.beginSequence(m_playbackPosition);
 
-        if (m_currentMainSequenceIt == m_mainStreamEvents.cend()) {
-            return result;
+        if (m_mainSequenceCursor == m_mainStreamEvents.size()) {
+            return;
         }
 
         m_playbackPosition += nextMsecs;
 
         handleMainStream(result);
-        handleDynamicChanges(result);
+    }
+
+    EventSequenceMap movePlaybackForward(const msecs_t nextMsecs)
+    {
+        EventBuffer buffer;
+        movePlaybackForward(nextMsecs, buffer);
+
+        EventSequenceMap result;
+
+        for (size_t i = 0; i < buffer.sequencesCount(); ++i) {
+            const typename EventBuffer::Sequence& sequence = buffer.sequence(i);
+            result[sequence.timestamp].insert(buffer.eventsBegin(sequence), buffer.eventsEnd(sequence));
+        }
 
         return result;
     }
@@ -183,83 +285,188 @@ protected:
     virtual void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                         const mpe::PlaybackParamLayers& params) = 0;
 
+    //! NOTE Rebuilds the whole main stream by default,
+    //! sequencers able to re-render a single time window should override it
+    virtual void applyMainStreamPatch(const mpe::MainStreamPatch& patch)
+    {
+        applyPatchToPlaybackData(patch);
+        updateMainStreamEvents(m_playbackData.originEvents, m_playbackData.dynamics, m_playbackData.params);
+    }
+
+    void applyPatchToPlaybackData(const mpe::MainStreamPatch& patch)
+    {
+        for (const mpe::PlaybackEventsWindow& window : patch.windows) {
+            mpe::applyWindow(m_playbackData.originEvents, window);
+        }
+
+        if (patch.dynamics) {
+            m_playbackData.dynamics = patch.dynamics.value();
+        }
+
+        if (patch.params) {
+            m_playbackData.params = patch.params.value();
+        }
+    }
+
     void resetAllIterators()
     {
         updateMainSequenceIterator();
-        updateOffSequenceIterator();
         updateDynamicChangesIterator();
     }
 
     void updateMainSequenceIterator()
     {
-        m_currentMainSequenceIt = m_mainStreamEvents.lower_bound(m_playbackPosition);
+        m_mainSequenceCursor = lowerBound(m_mainStreamEvents, m_playbackPosition) - m_mainStreamEvents.cbegin();
     }
 
-    void updateOffSequenceIterator()
+    void updateDynamicChangesIterator()
     {
-        m_currentOffSequenceIt = m_offStreamEvents.cbegin();
+        m_dynamicsCursor = lowerBound(m_dynamicEvents, m_playbackPosition) - m_dynamicEvents.cbegin();
     }
 
-    void updateDynamicChangesIterator()
+    static typename EventArray::const_iterator lowerBound(const EventArray& events, const msecs_t timestamp)
     {
-        m_currentDynamicsIt = m_dynamicEvents.lower_bound(m_playbackPosition);
+        return std::lower_bound(events.cbegin(), events.cend(), timestamp, [](const TimedEvent& event, const msecs_t value) {
+            return event.timestamp < value;
+        });
+    }
+
+    static typename EventArray::const_iterator upperBound(const EventArray& events, const msecs_t timestamp)
+    {
+        return std::upper_bound(events.cbegin(), events.cend(), timestamp, [](const msecs_t value, const TimedEvent& event) {
+            return value < event.timestamp;
+        });
     }
 
-    void handleOffStream(EventSequenceMap& result, const msecs_t nextMsecs)
+    static void assignEvents(EventArray& destination, const EventSequenceMap& source)
     {
-        if (m_offStreamEvents.empty() || m_currentOffSequenceIt == m_offStreamEvents.cend()) {
+        destination.clear();
+
+        for (const auto& pair : source) {
+            for (const EventType& event : pair.second) {
+                destination.push_back(TimedEvent { pair.first, event });
+            }
+        }
+    }
+
+    //! NOTE Replaces the events within [from, to] with the source events falling into this range
+    static void replaceEvents(EventArray& destination, const msecs_t from, const msecs_t to, const EventSequenceMap& source)
+    {
+        EventArray replacement;
+
+        for (auto it = source.lower_bound(from); it != source.cend() && it->first <= to; ++it) {
+            for (const EventType& event : it->second) {
+                replacement.push_back(TimedEvent { it->first, event });
+            }
+        }
+
+        auto position = destination.erase(lowerBound(destination, from), upperBound(destination, to));
+        destination.insert(position, replacement.cbegin(), replacement.cend());
+    }
+
+    void handleOffStream(EventBuffer& result, const msecs_t nextMsecs)
+    {
+        if (m_offStreamEvents.empty()) {
             return;
         }
 
-        if (m_currentOffSequenceIt->first <= nextMsecs) {
-            while (m_currentOffSequenceIt != m_offStreamEvents.end()
-                   && m_currentOffSequenceIt->first <= nextMsecs) {
-                result.insert_or_assign(m_currentOffSequenceIt->first, std::move(m_currentOffSequenceIt->second));
-                m_currentOffSequenceIt = m_offStreamEvents.erase(m_currentOffSequenceIt);
+        const msecs_t firstTimestamp = m_offStreamEvents.front().timestamp;
+
+        if (firstTimestamp <= nextMsecs) {
+            auto end = upperBound(m_offStreamEvents, nextMsecs);
+
+            for (auto it = m_offStreamEvents.cbegin(); it != end; ++it) {
+                result.beginSequence(it->timestamp);
+                result.addEvent(it->event);
             }
+
+            m_offStreamEvents.erase(m_offStreamEvents.cbegin(), end);
         } else {
-            auto node = m_offStreamEvents.extract(m_currentOffSequenceIt);
-            node.key() -= nextMsecs;
-            m_offStreamEvents.insert(std::move(node));
-            updateOffSequenceIterator();
+            for (TimedEvent& event : m_offStreamEvents) {
+                if (event.timestamp != firstTimestamp) {
+                    break;
+                }
+
+                event.timestamp -= nextMsecs;
+            }
         }
     }
 
-    void handleMainStream(EventSequenceMap& result)
+    //! NOTE Merges the main stream and the dynamic changes into sequences ordered as std::set would order them
+    void handleMainStream(EventBuffer& result)
     {
-        while (m_currentMainSequenceIt != m_mainStreamEvents.end()
-               && m_currentMainSequenceIt->first <= m_playbackPosition) {
-            EventSequence& sequence = result[m_currentMainSequenceIt->first];
-            sequence.insert(m_currentMainSequenceIt->second.cbegin(),
-                            m_currentMainSequenceIt->second.cend());
-            m_currentMainSequenceIt = std::next(m_currentMainSequenceIt);
+        static const std::less<EventType> less;
+
+        while (true) {
+            const bool hasMainEvents = m_mainSequenceCursor < m_mainStreamEvents.size()
+                                       && m_mainStreamEvents[m_mainSequenceCursor].timestamp <= m_playbackPosition;
+            const bool hasDynamicEvents = m_dynamicsCursor < m_dynamicEvents.size()
+                                          && m_dynamicEvents[m_dynamicsCursor].timestamp <= m_playbackPosition;
+
+            if (!hasMainEvents && !hasDynamicEvents) {
+                break;
+            }
+
+            msecs_t timestamp = 0;
+            if (hasMainEvents && hasDynamicEvents) {
+                timestamp = std::min(m_mainStreamEvents[m_mainSequenceCursor].timestamp, m_dynamicEvents[m_dynamicsCursor].timestamp);
+            } else {
+                timestamp = hasMainEvents ? m_mainStreamEvents[m_mainSequenceCursor].timestamp
+                            : m_dynamicEvents[m_dynamicsCursor].timestamp;
+            }
+
+            result.beginSequence(timestamp);
+
+            const size_t mainEnd = sequenceEnd(m_mainStreamEvents, m_mainSequenceCursor, timestamp);
+            const size_t dynamicsEnd = sequenceEnd(m_dynamicEvents, m_dynamicsCursor, timestamp);
+
+            while (m_mainSequenceCursor < mainEnd || m_dynamicsCursor < dynamicsEnd) {
+                if (m_dynamicsCursor == dynamicsEnd) {
+                    result.addEvent(m_mainStreamEvents[m_mainSequenceCursor++].event);
+                    continue;
+                }
+
+                if (m_mainSequenceCursor == mainEnd) {
+                    result.addEvent(m_dynamicEvents[m_dynamicsCursor++].event);
+                    continue;
+                }
+
+                const EventType& mainEvent = m_mainStreamEvents[m_mainSequenceCursor].event;
+                const EventType& dynamicEvent = m_dynamicEvents[m_dynamicsCursor].event;
+
+                if (less(dynamicEvent, mainEvent)) {
+                    result.addEvent(dynamicEvent);
+                    ++m_dynamicsCursor;
+                    continue;
+                }
+
+                result.addEvent(mainEvent);
+                ++m_mainSequenceCursor;
+
+                if (!less(mainEvent, dynamicEvent)) {
+                    ++m_dynamicsCursor;
+                }
+            }
         }
     }
 
-    void handleDynamicChanges(EventSequenceMap& result)
+    static size_t sequenceEnd(const EventArray& events, size_t cursor, const msecs_t timestamp)
     {
-        if (m_dynamicEvents.empty()) {
-            return;
+        while (cursor < events.size() && events[cursor].timestamp == timestamp) {
+            ++cursor;
         }
 
-        while (m_currentDynamicsIt != m_dynamicEvents.end()
-               && m_currentDynamicsIt->first <= m_playbackPosition) {
-            EventSequence& sequence = result[m_currentDynamicsIt->first];
-            sequence.insert(m_currentDynamicsIt->second.cbegin(),
-                            m_currentDynamicsIt->second.cend());
-            m_currentDynamicsIt = std::next(m_currentDynamicsIt);
-        }
+        return cursor;
     }
 
     mutable msecs_t m_playbackPosition = 0;
 
-    SequenceIterator m_currentMainSequenceIt;
-    SequenceIterator m_currentOffSequenceIt;
-    SequenceIterator m_currentDynamicsIt;
+    size_t m_mainSequenceCursor = 0;
+    size_t m_dynamicsCursor = 0;
 
-    EventSequenceMap m_mainStreamEvents;
-    EventSequenceMap m_offStreamEvents;
-    EventSequenceMap m_dynamicEvents;
+    EventArray m_mainStreamEvents;
+    EventArray m_offStreamEvents;
+    EventArray m_dynamicEvents;
 
     mpe::PlaybackData m_playbackData;
 
@@ -161,6 +161,11 @@ void AudioBuffer::setRenderStep(const samples_t renderStep)
     m_renderStep = renderStep;
 }
 
+void AudioBuffer::setOnNeedsRefill(const OnNeedsRefill& func)
+{
+    m_onNeedsRefill = func;
+}
+
 void AudioBuffer::forward()
 {
     if (!m_source) {
@@ -169,9 +174,10 @@ void AudioBuffer::forward()
 
     const auto currentWriteIdx = m_writeIndex.load(std::memory_order_relaxed);
     const auto currentReadIdx = m_readIndex.load(std::memory_order_acquire);
+    const samples_t minSamplesToReserve = m_minSamplesToReserve.load(std::memory_order_relaxed);
     size_t nextWriteIdx = currentWriteIdx;
 
-    while (reservedFrames(nextWriteIdx, currentReadIdx) < m_minSamplesToReserve) {
+    while (reservedFrames(nextWriteIdx, currentReadIdx) < minSamplesToReserve) {
         samples_t renderStep = m_renderStep;
         samples_t samplesToRender = renderStep * m_audioChannelsCount;
 
@@ -200,6 +206,9 @@ void AudioBuffer::pop(float* dest, size_t sampleCount)
     const auto currentWriteIdx = m_writeIndex.load(std::memory_order_acquire);
     if (currentReadIdx == currentWriteIdx) { // empty queue
         std::memcpy(dest, SILENT_FRAMES.data(), sampleCount * sizeof(float) * m_audioChannelsCount);
+        if (m_onNeedsRefill) {
+            m_onNeedsRefill();
+        }
         return;
     }
 
@@ -237,6 +246,14 @@ void AudioBuffer::pop(float* dest, size_t sampleCount)
     }
 
     m_readIndex.store(newReadIdx, std::memory_order_release);
+
+    if (m_onNeedsRefill) {
+        const size_t reserved = reservedFrames(currentWriteIdx, currentReadIdx);
+        const size_t reservedLeft = reserved > totalSampleCount ? reserved - totalSampleCount : 0;
+        if (reservedLeft < m_minSamplesToReserve.load(std::memory_order_relaxed)) {
+            m_onNeedsRefill();
+        }
+    }
 }
 
 void AudioBuffer::reset()
@@ -25,6 +25,7 @@
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <functional>
 
 #include "iaudiosource.h"
 #include "audiotypes.h"
@@ -54,6 +55,12 @@ public:
     void setMinSamplesPerChannelToReserve(const samples_t samplesPerChannel);
     void setRenderStep(const samples_t renderStep);
 
+    //! NOTE: Called from pop() when the reserve drops below the minimum, i.e. when forward() has work to do.
+    //! It's invoked from the audio driver callback, so it must be real-time safe.
+    //! Must be set before the driver is started
+    using OnNeedsRefill = std::function<void ()>;
+    void setOnNeedsRefill(const OnNeedsRefill& func);
+
     void forward();
     void pop(float* dest, size_t sampleCount);
 
@@ -68,10 +75,11 @@ private:
 
     samples_t m_samplesPerChannel = 0;
     audioch_t m_audioChannelsCount = 0;
-    samples_t m_minSamplesToReserve = 0;
+    std::atomic<samples_t> m_minSamplesToReserve = 0;
     samples_t m_renderStep = 0;
 
     IAudioSourcePtr m_source = nullptr;
+    OnNeedsRefill m_onNeedsRefill;
 };
 
 using AudioBufferPtr = std::shared_ptr<AudioBuffer>;
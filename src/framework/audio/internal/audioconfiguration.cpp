@@ -154,17 +154,6 @@ async::Notification AudioConfiguration::driverBufferSizeChanged() const
     return m_driverBufferSizeChanged;
 }
 
-msecs_t AudioConfiguration::audioWorkerInterval(const samples_t samples, const sample_rate_t sampleRate) const
-{
-    msecs_t interval = float(samples) / 4.f / float(sampleRate) * 1000.f;
-    interval = std::max(interval, msecs_t(1));
-
-    // Found experementaly on a slow laptop (2 core) running on battery power
-    interval = std::min(interval, msecs_t(10));
-
-    return interval;
-}
-
 samples_t AudioConfiguration::minSamplesToReserve(RenderMode mode) const
 {
     // Idle: render as little as possible for lower latency
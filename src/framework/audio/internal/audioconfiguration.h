@@ -55,7 +55,6 @@ public:
     void setDriverBufferSize(unsigned int size) override;
     async::Notification driverBufferSizeChanged() const override;
 
-    msecs_t audioWorkerInterval(const samples_t samples, const sample_rate_t sampleRate) const override;
     samples_t minSamplesToReserve(RenderMode mode) const override;
 
     samples_t samplesToPreallocate() const override;
@@ -31,18 +31,15 @@
 #include <emscripten/html5.h>
 #endif
 
-#ifdef Q_OS_WIN
-#include "global/platform/win/waitabletimer.h"
-#endif
-
 #include "log.h"
 
 using namespace muse::audio;
 
-static uint64_t toWinTime(const msecs_t msecs)
-{
-    return msecs * 10000;
-}
+//! NOTE: The worker is woken up by the driver callback when the buffer needs refilling
+//! and by queued events; the timeout is just a safety net, so that it can't get stuck
+static constexpr msecs_t MAX_SLEEP_MSECS = 100;
+
+static constexpr size_t EVENT_QUEUE_CAPACITY = 1024;
 
 std::thread::id AudioThread::ID;
 
@@ -53,12 +50,10 @@ AudioThread::~AudioThread()
     }
 }
 
-void AudioThread::run(const Runnable& onStart, const Runnable& loopBody, const msecs_t interval)
+void AudioThread::run(const Runnable& onStart, const Runnable& loopBody)
 {
     m_onStart = onStart;
     m_mainLoopBody = loopBody;
-    m_intervalMsecs = interval;
-    m_intervalInWinTime = toWinTime(interval);
 
 #ifndef Q_OS_WASM
     m_running = true;
@@ -77,18 +72,11 @@ void AudioThread::run(const Runnable& onStart, const Runnable& loopBody, const m
 #endif
 }
 
-void AudioThread::setInterval(const msecs_t interval)
-{
-    ONLY_AUDIO_WORKER_THREAD;
-
-    m_intervalMsecs = interval;
-    m_intervalInWinTime = toWinTime(interval);
-}
-
 void AudioThread::stop(const Runnable& onFinished)
 {
     m_onFinished = onFinished;
     m_running = false;
+    m_wakeup.notify();
     if (m_thread) {
         m_thread->join();
     }
@@ -99,24 +87,26 @@ bool AudioThread::isRunning() const
     return m_running;
 }
 
+void AudioThread::wakeup()
+{
+    m_wakeup.notify();
+}
+
 void AudioThread::main()
 {
     runtime::setThreadName("audio_worker");
 
     AudioThread::ID = std::this_thread::get_id();
 
+    //! NOTE Keeps the messages from the main thread off the mutex
+    async::useLockFreeQueue(EVENT_QUEUE_CAPACITY, [this]() {
+        m_wakeup.notify();
+    });
+
     if (m_onStart) {
         m_onStart();
     }
 
-#ifdef Q_OS_WIN
-    WaitableTimer timer;
-    bool timerValid = timer.init();
-    if (timerValid) {
-        LOGI() << "Waitable timer successfully created, interval: " << m_intervalMsecs << " ms";
-    }
-#endif
-
     while (m_running) {
         async::processEvents();
 
@@ -124,15 +114,12 @@ void AudioThread::main()
             m_mainLoopBody();
         }
 
-#ifdef Q_OS_WIN
-        if (!timerValid || !timer.setAndWait(m_intervalInWinTime)) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(m_intervalMsecs));
-        }
-#else
-        std::this_thread::sleep_for(std::chrono::milliseconds(m_intervalMsecs));
-#endif
+        m_wakeup.wait(MAX_SLEEP_MSECS);
     }
 
+    //! NOTE The callback refers to this object, which may be gone before the last events are queued
+    async::onEventsQueued(nullptr);
+
     if (m_onFinished) {
         m_onFinished();
     }
@@ -28,6 +28,8 @@
 #include <atomic>
 #include <functional>
 
+#include "global/concurrency/wakeupsignal.h"
+
 #include "audiotypes.h"
 
 namespace muse::audio {
@@ -41,22 +43,24 @@ public:
 
     using Runnable = std::function<void ()>;
 
-    void run(const Runnable& onStart, const Runnable& loopBody, const msecs_t interval = 1);
-    void setInterval(const msecs_t interval);
+    void run(const Runnable& onStart, const Runnable& loopBody);
     void stop(const Runnable& onFinished = nullptr);
     bool isRunning() const;
 
+    //! NOTE: Makes the thread run the loop body as soon as possible.
+    //! Safe to call from any thread, including the audio driver callback
+    void wakeup();
+
 private:
     void main();
 
     Runnable m_onStart = nullptr;
     Runnable m_mainLoopBody = nullptr;
     Runnable m_onFinished = nullptr;
-    msecs_t m_intervalMsecs = 0;
-    uint64_t m_intervalInWinTime = 0;
 
     std::unique_ptr<std::thread> m_thread = nullptr;
     std::atomic<bool> m_running = false;
+    WakeupSignal m_wakeup;
 };
 using AudioThreadPtr = std::shared_ptr<AudioThread>;
 }
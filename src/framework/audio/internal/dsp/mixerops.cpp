@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mixerops.h"
+
+#include <algorithm>
+
+#include "simdtypes.h"
+
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+// scalar
+
+static void accumulateScalar(const float* src, float* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+static void accumulateScaledScalar(const float* src, float gain, float* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+static void applyGainsScalar(float* buffer, const float* gains, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                             float* squaredSums)
+{
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+        float squaredSum = 0.f;
+        float gain = gains[audioChNum];
+
+        for (samples_t s = 0; s < samplesPerChannel; ++s) {
+            size_t idx = s * audioChannelsCount + audioChNum;
+
+            float resultSample = buffer[idx] * gain;
+            buffer[idx] = resultSample;
+            squaredSum += resultSample * resultSample;
+        }
+
+        squaredSums[audioChNum] = squaredSum;
+    }
+}
+
+// simd
+
+static void accumulateSimd(const float* src, float* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        simd::store(dst + i, simd::load(dst + i) + simd::load(src + i));
+    }
+
+    accumulateScalar(src + i, dst + i, count - i);
+}
+
+static void accumulateScaledSimd(const float* src, float gain, float* dst, size_t count)
+{
+    const simd::float_x4 gain_x4(gain);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        simd::store(dst + i, simd::load(dst + i) + simd::load(src + i) * gain_x4);
+    }
+
+    accumulateScaledScalar(src + i, gain, dst + i, count - i);
+}
+
+static void applyGainsSimd(float* buffer, const float* gains, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                           float* squaredSums)
+{
+    // The gains must repeat within a vector of 4 samples
+    if (audioChannelsCount == 0 || audioChannelsCount > 4 || 4 % audioChannelsCount != 0) {
+        applyGainsScalar(buffer, gains, audioChannelsCount, samplesPerChannel, squaredSums);
+        return;
+    }
+
+    const simd::float_x4 gain_x4(gains[0 % audioChannelsCount], gains[1 % audioChannelsCount],
+                                 gains[2 % audioChannelsCount], gains[3 % audioChannelsCount]);
+    simd::float_x4 squaredSum_x4(0.f);
+
+    const size_t count = samplesPerChannel * audioChannelsCount;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        simd::float_x4 result = simd::load(buffer + i) * gain_x4;
+        simd::store(buffer + i, result);
+        squaredSum_x4 = squaredSum_x4 + result * result;
+    }
+
+    std::fill(squaredSums, squaredSums + audioChannelsCount, 0.f);
+
+    for (size_t lane = 0; lane < 4; ++lane) {
+        squaredSums[lane % audioChannelsCount] += squaredSum_x4[lane];
+    }
+
+    // i is a multiple of 4, so the tail starts at channel 0
+    for (; i < count; ++i) {
+        audioch_t audioChNum = static_cast<audioch_t>(i % audioChannelsCount);
+        float resultSample = buffer[i] * gains[audioChNum];
+        buffer[i] = resultSample;
+        squaredSums[audioChNum] += resultSample * resultSample;
+    }
+}
+
+const MixerOps& muse::audio::dsp::scalarMixerOps()
+{
+    static const MixerOps ops { accumulateScalar, accumulateScaledScalar, applyGainsScalar };
+    return ops;
+}
+
+const MixerOps& muse::audio::dsp::simdMixerOps()
+{
+#if defined(MUSE_AUDIO_SIMD_SSE2) || defined(MUSE_AUDIO_SIMD_NEON)
+    static const MixerOps ops { accumulateSimd, accumulateScaledSimd, applyGainsSimd };
+    return ops;
+#else
+    return scalarMixerOps();
+#endif
+}
+
+bool muse::audio::dsp::isSimdSupported()
+{
+#if defined(MUSE_AUDIO_SIMD_SSE2) || defined(MUSE_AUDIO_SIMD_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+
+const MixerOps& muse::audio::dsp::mixerOps()
+{
+    return simdMixerOps();
+}
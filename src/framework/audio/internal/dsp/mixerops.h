@@ -0,0 +1,60 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_MIXEROPS_H
+#define MUSE_AUDIO_MIXEROPS_H
+
+#include <cstddef>
+
+#include "../../audiotypes.h"
+
+namespace muse::audio::dsp {
+//! Upper bound for per-channel stack arrays passed to the kernels
+static constexpr audioch_t MAX_MIXER_AUDIO_CHANNELS = 32;
+
+//! Kernels used by the mixer on interleaved buffers.
+//! The implementation is selected at compile time, see mixerOps()
+struct MixerOps {
+    //! dst[i] += src[i]
+    void (*accumulate)(const float* src, float* dst, size_t count) = nullptr;
+
+    //! dst[i] += src[i] * gain
+    void (*accumulateScaled)(const float* src, float gain, float* dst, size_t count) = nullptr;
+
+    //! Multiplies each sample by the gain of its channel,
+    //! and writes the sum of the squared results of each channel to squaredSums
+    void (*applyGains)(float* buffer, const float* gains, audioch_t audioChannelsCount, samples_t samplesPerChannel,
+                       float* squaredSums) = nullptr;
+};
+
+const MixerOps& scalarMixerOps();
+const MixerOps& simdMixerOps();
+
+//! NOTE SSE2 is part of the x86-64 baseline and NEON of the AArch64 one,
+//! so the SIMD version is used whenever it's compiled in; there is nothing to check at runtime
+bool isSimdSupported();
+
+//! The SIMD version if it's compiled in, the scalar one otherwise
+const MixerOps& mixerOps();
+}
+
+#endif // MUSE_AUDIO_MIXEROPS_H
@@ -36,8 +36,10 @@
 
 #if defined(__SSE2__) || (defined(_M_AMD64) || defined(_M_X64))
 #include "simdtypes_sse2.h"
+#define MUSE_AUDIO_SIMD_SSE2
 #elif defined(__arm64__) || defined(__aarch64__) || defined(_M_ARM64)
 #include "simdtypes_neon.h"
+#define MUSE_AUDIO_SIMD_NEON
 #else
 #include "simdtypes_scalar.h"
 #endif
@@ -47,7 +49,7 @@
   Aligned memory allocation for simd vectors.
  */
 
-namespace muse::audio::fx::simd {
+namespace muse::audio::dsp::simd {
 /// reserve aligned memory. Needs to be freed with aligned_free()
 inline void* aligned_malloc(size_t required_bytes, size_t alignment)
 {
@@ -88,6 +90,6 @@ inline void aligned_delete(cls* obj)
         aligned_free((void*)obj);
     }
 }
-} // namespace muse::audio::fx
+} // namespace muse::audio::dsp::simd
 
 #endif // MUSE_AUDIO_SIMDTYPES_H
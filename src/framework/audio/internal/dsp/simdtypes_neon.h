@@ -37,7 +37,7 @@
   Neon version of SIMD types.
  */
 
-namespace muse::audio::fx::simd {
+namespace muse::audio::dsp::simd {
 struct float_x4
 {
     float32x4_t s;
@@ -139,6 +139,18 @@ __finl float_x4 __vecc operator*(float_x4 a, float_x4 b)
 {
     return vmulq_f32(a.s, b.s);
 }
-} // namespace muse::audio::fx
+
+/// unaligned load of 4 floats
+__finl float_x4 __vecc load(const float* src)
+{
+    return vld1q_f32(src);
+}
+
+/// unaligned store of 4 floats
+__finl void __vecc store(float* dst, float_x4 a)
+{
+    vst1q_f32(dst, a.s);
+}
+} // namespace muse::audio::dsp::simd
 
 #endif // MUSE_AUDIO_SIMDTYPES_NEON_H
@@ -34,7 +34,7 @@
 #define __vecc
 #endif
 
-namespace muse::audio::fx::simd {
+namespace muse::audio::dsp::simd {
 struct float_x4
 {
     float v[4];
@@ -83,6 +83,21 @@ __finl float_x4 __vecc operator*(float_x4 a, float_x4 b)
 {
     return { a[0] * b[0], a[1] * b[1], a[2] * b[2], a[3] * b[3] };
 }
-} // namespace muse::audio::fx
+
+/// unaligned load of 4 floats
+__finl float_x4 __vecc load(const float* src)
+{
+    return { src[0], src[1], src[2], src[3] };
+}
+
+/// unaligned store of 4 floats
+__finl void __vecc store(float* dst, float_x4 a)
+{
+    dst[0] = a[0];
+    dst[1] = a[1];
+    dst[2] = a[2];
+    dst[3] = a[3];
+}
+} // namespace muse::audio::dsp::simd
 
 #endif // MUSE_AUDIO_SIMDTYPES_SCALAR_H
@@ -37,7 +37,7 @@
 SSE2 simd types
 */
 
-namespace muse::audio::fx::simd {
+namespace muse::audio::dsp::simd {
 // this is jumping through some hoops to get the same level of support
 // for clang and msvc. With clang, the sse2 types are built-in and have
 // some arithmetic operators defined.
@@ -134,6 +134,18 @@ __finl float_x4 __vecc operator*(float_x4 a, float_x4 b)
 {
     return _mm_mul_ps(a.s, b.s);
 }
-} // namespace muse::audio::fx
+
+/// unaligned load of 4 floats
+__finl float_x4 __vecc load(const float* src)
+{
+    return _mm_loadu_ps(src);
+}
+
+/// unaligned store of 4 floats
+__finl void __vecc store(float* dst, float_x4 a)
+{
+    _mm_storeu_ps(dst, a.s);
+}
+} // namespace muse::audio::dsp::simd
 
 #endif // MUSE_AUDIO_SIMDTYPES_SSE2_H
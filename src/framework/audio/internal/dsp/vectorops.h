@@ -35,7 +35,7 @@
 // inside add().
 //
 
-namespace muse::audio::fx {
+namespace muse::audio::dsp {
 namespace vo {
 inline void* allocate(int32_t bytes)
 {
@@ -52,7 +52,7 @@ public:
             return false;
         }
 
-        prepareOutputBuffer(totalSamplesNumber);
+        prepareOutputBuffer(m_format.samplesPerChannel);
 
         return true;
     }
@@ -67,6 +67,9 @@ public:
         return m_format;
     }
 
+    //! NOTE: encode() is called repeatedly with consecutive blocks of at most
+    //! format().samplesPerChannel samples per channel, flush() finishes the stream.
+    //! Returns the number of encoded samples per channel, 0 on failure
     virtual size_t encode(samples_t samplesPerChannel, const float* input) = 0;
     virtual size_t flush() = 0;
 
@@ -76,7 +79,7 @@ public:
     }
 
 protected:
-    virtual size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const = 0;
+    virtual size_t requiredOutputBufferSize(samples_t samplesPerChannel) const = 0;
 
     virtual void prepareWriting()
     {
@@ -107,9 +110,9 @@ protected:
         return true;
     }
 
-    virtual void prepareOutputBuffer(const samples_t totalSamplesNumber)
+    virtual void prepareOutputBuffer(const samples_t samplesPerChannel)
     {
-        m_outputBuffer.resize(requiredOutputBufferSize(totalSamplesNumber));
+        m_outputBuffer.resize(requiredOutputBufferSize(samplesPerChannel));
     }
 
     virtual void closeDestination()
@@ -81,54 +81,60 @@ private:
     }
 };
 
-size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
+void WavEncoder::writeHeader()
 {
-    if (!m_fileStream.is_open()) {
-        return 0;
-    }
-
     WavHeader header;
     header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
     header.bitsPerSample = 32;
     header.code = 3; // IEEE_FLOAT = 3, PCM = 1
     header.audioChannelsNumber = m_format.audioChannelsNumber;
     header.sampleRate = m_format.sampleRate;
-    header.samplesPerChannel = samplesPerChannel;
+    header.samplesPerChannel = static_cast<uint32_t>(m_samplesPerChannel);
 
     header.write(m_fileStream);
+}
 
-    int total = header.samplesPerChannel;
-    int progressStep = (total * 5) / 100; // every 5%
-    QVector<samples_t> progressValues;
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel;) {
-        progressValues << sampleIdx;
-        sampleIdx += progressStep;
+size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
+{
+    if (!m_fileStream.is_open()) {
+        return 0;
     }
 
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel; ++sampleIdx) {
-        for (audioch_t audioChNum = 0; audioChNum < m_format.audioChannelsNumber; ++audioChNum) {
-            int idx = sampleIdx * m_format.audioChannelsNumber + audioChNum;
-            m_fileStream.write(reinterpret_cast<const char*>(input + idx), 4);
-        }
+    //! NOTE: the header is written with a zero length first and is rewritten in flush(),
+    //! when the total number of samples is known
+    if (m_fileStream.tellp() == 0) {
+        writeHeader();
+    }
 
-        if (progressValues.contains(sampleIdx)) {
-            m_progress.progress(sampleIdx, total, "");
-        }
+    size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
+    m_fileStream.write(reinterpret_cast<const char*>(input), samplesNumber * sizeof(float));
+
+    if (!m_fileStream.good()) {
+        return 0;
     }
 
-    return samplesPerChannel * m_format.audioChannelsNumber;
+    m_samplesPerChannel += samplesPerChannel;
+
+    return samplesPerChannel;
 }
 
 size_t WavEncoder::flush()
 {
-    NOT_SUPPORTED;
+    if (!m_fileStream.is_open()) {
+        return 0;
+    }
+
+    m_fileStream.seekp(0, std::ios_base::beg);
+    writeHeader();
+    m_fileStream.seekp(0, std::ios_base::end);
+    m_fileStream.flush();
 
     return 0;
 }
 
-size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t WavEncoder::requiredOutputBufferSize(samples_t /*samplesPerChannel*/) const
 {
-    return totalSamplesNumber;
+    return 0;
 }
 
 bool WavEncoder::openDestination(const io::path_t& path)
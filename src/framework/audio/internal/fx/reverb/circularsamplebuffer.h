@@ -25,7 +25,7 @@
 
 #include <cassert>
 
-#include "vectorops.h"
+#include "internal/dsp/vectorops.h"
 
 /*
  * Utility buffer class for delay-based effects
@@ -126,21 +126,21 @@ public:
     void writeBlock(int startOffset, int n, const SampleT* sourceBlock)
     {
         splitBlockOffsetFunction(startOffset, n, [=](int bufferOff, int sampleOff, int n) {
-            vo::copy(&sourceBlock[sampleOff], &m_buffer[bufferOff], n);
+            dsp::vo::copy(&sourceBlock[sampleOff], &m_buffer[bufferOff], n);
         });
     }
 
     void readBlockWithGain(int startOffset, int n, SampleT* targetBlock, float gainFactor) const
     {
         splitBlockOffsetFunction(startOffset, n, [=](int bufferOff, int sampleOff, int n) {
-            vo::constantMultiply(&m_buffer[bufferOff], gainFactor, &targetBlock[sampleOff], n);
+            dsp::vo::constantMultiply(&m_buffer[bufferOff], gainFactor, &targetBlock[sampleOff], n);
         });
     }
 
     void readAddBlockWithGain(int startOffset, int n, SampleT* targetBlock, float gainFactor) const
     {
         splitBlockOffsetFunction(startOffset, n, [=](int bufferOff, int sampleOff, int n) {
-            vo::constantMultiplyAndAdd(&m_buffer[bufferOff], gainFactor, &targetBlock[sampleOff], n);
+            dsp::vo::constantMultiplyAndAdd(&m_buffer[bufferOff], gainFactor, &targetBlock[sampleOff], n);
         });
     }
 
@@ -34,7 +34,7 @@
 #include "reverbfilters.h"
 #include "reverbmatrices.h"
 #include "sampledelay.h"
-#include "simdtypes.h"
+#include "internal/dsp/simdtypes.h"
 
 namespace muse::audio::fx {
 float fromDecibel(float dB)
@@ -89,7 +89,7 @@ public:
     {
         assert(channel < num_channels);
         assert(data[channel]);
-        vo::copy(input, data[channel], num_samples);
+        dsp::vo::copy(input, data[channel], num_samples);
     }
 
     void assignSamples(const SamplesFloat& rhs)
@@ -98,14 +98,14 @@ public:
         assert(num_samples == rhs.num_samples);
         for (int ch = 0; ch < num_channels; ch++) {
             assert(data[ch]);
-            vo::copy(rhs.getPtr(ch), getPtr(ch), num_samples);
+            dsp::vo::copy(rhs.getPtr(ch), getPtr(ch), num_samples);
         }
     }
 
     void zeroOut()
     {
         for (int ch = 0; ch < num_channels; ch++) {
-            vo::setToZero(data[ch], num_samples);
+            dsp::vo::setToZero(data[ch], num_samples);
         }
     }
 
@@ -120,14 +120,14 @@ private:
         if (data[channel]) {
             dealloc(channel);
         }
-        data[channel] = (float*)simd::aligned_malloc(samples * sizeof(float), 64);
+        data[channel] = (float*)dsp::simd::aligned_malloc(samples * sizeof(float), 64);
     }
 
     void dealloc(int32_t channel)
     {
         assert(channel < num_channels);
         if (data[channel]) {
-            simd::aligned_free(data[channel]);
+            dsp::simd::aligned_free(data[channel]);
             data[channel] = nullptr;
         }
     }
@@ -199,11 +199,11 @@ static inline float _sqrt_sign(float x)
 struct ReverbProcessor::impl
 {
     // members requiring alignment first
-    IirBiquadFilter::Coeffs<simd::float_x4> damping_cf1_x4[max_num_delays / 4];
-    IirBiquadFilter::Coeffs<simd::float_x4> damping_cf2_x4[max_num_delays / 4];
-    IirBiquadFilter::DF2State<simd::float_x4> damping_state1_x4[max_num_delays / 4];
-    IirBiquadFilter::DF2State<simd::float_x4> damping_state2_x4[max_num_delays / 4];
-    reverbfilters::OnePoleFilter<simd::float_x4> ag_filter_x4[max_num_delays / 4];
+    IirBiquadFilter::Coeffs<dsp::simd::float_x4> damping_cf1_x4[max_num_delays / 4];
+    IirBiquadFilter::Coeffs<dsp::simd::float_x4> damping_cf2_x4[max_num_delays / 4];
+    IirBiquadFilter::DF2State<dsp::simd::float_x4> damping_state1_x4[max_num_delays / 4];
+    IirBiquadFilter::DF2State<dsp::simd::float_x4> damping_state2_x4[max_num_delays / 4];
+    reverbfilters::OnePoleFilter<dsp::simd::float_x4> ag_filter_x4[max_num_delays / 4];
 
     AllPassModulatedDelay modDelay[max_num_delays];
     AllPassDispersion disp_ap;
@@ -235,7 +235,7 @@ struct ReverbProcessor::impl
 ReverbProcessor::ReverbProcessor(const AudioFxParams& params, audioch_t audioChannelsCount)
     : m_params(params)
 {
-    d = simd::aligned_new<impl>(64);
+    d = dsp::simd::aligned_new<impl>(64);
 
     m_processor.allocateParameters(NumParams);
     m_processor.setupParameter(Quality, "Quality", { 1.f, 4.f }, 4);
@@ -292,7 +292,7 @@ ReverbProcessor::ReverbProcessor(const AudioFxParams& params, audioch_t audioCha
 
 ReverbProcessor::~ReverbProcessor()
 {
-    simd::aligned_delete(d);
+    dsp::simd::aligned_delete(d);
     deleteSignalBuffers();
 }
 
@@ -667,7 +667,7 @@ void ReverbProcessor::_processLines(float** signalPtr, int32_t numSamples)
         for (int ch = 0; ch < 2; ++ch) {
             d->er_fir[ch].processBlock(work_ptr[ch], er_ptr[ch], numSamples);
             // add to late feedback input (work buffer)
-            vo::constantMultiplyAndAdd(er_ptr[ch], m_erToLateGain, work_ptr[ch], numSamples);
+            dsp::vo::constantMultiplyAndAdd(er_ptr[ch], m_erToLateGain, work_ptr[ch], numSamples);
         }
 
         if (velvet_input) {
@@ -722,7 +722,7 @@ void ReverbProcessor::_processLines(float** signalPtr, int32_t numSamples)
             float mat_in[num_lines];
             for (int i = 0; i < num_lines; i += 4) {
                 int j = i >> 2;
-                simd::float_x4 s = { d->modDelay[i].readSample(), d->modDelay[i + 1].readSample(),
+                dsp::simd::float_x4 s = { d->modDelay[i].readSample(), d->modDelay[i + 1].readSample(),
                                      d->modDelay[i + 2].readSample(), d->modDelay[i + 3].readSample() };
 
                 s = d->ag_filter_x4[j].processSample(s);
@@ -752,16 +752,16 @@ void ReverbProcessor::_processLines(float** signalPtr, int32_t numSamples)
         }
 
         // stereo late reverb sum
-        vo::subtract(delay_out_ptr[0], delay_out_ptr[3], work_ptr[0], numSamples); // a[0] - a[3]
-        vo::subtract(delay_out_ptr[2], delay_out_ptr[1], work_ptr[1], numSamples); // a[2] - a[1]
+        dsp::vo::subtract(delay_out_ptr[0], delay_out_ptr[3], work_ptr[0], numSamples); // a[0] - a[3]
+        dsp::vo::subtract(delay_out_ptr[2], delay_out_ptr[1], work_ptr[1], numSamples); // a[2] - a[1]
         for (int i = 4; i < num_lines; i += 4) {
-            vo::add(work_ptr[0], delay_out_ptr[i], work_ptr[0], numSamples);    // + a[j + 0]
-            vo::subtract(work_ptr[0], delay_out_ptr[i + 3], work_ptr[0], numSamples); // - a[j + 3]
-            vo::add(work_ptr[1], delay_out_ptr[i + 2], work_ptr[1], numSamples); // + a[j + 2]
-            vo::subtract(work_ptr[1], delay_out_ptr[i + 1], work_ptr[1], numSamples); // - a[j + 1]
+            dsp::vo::add(work_ptr[0], delay_out_ptr[i], work_ptr[0], numSamples);    // + a[j + 0]
+            dsp::vo::subtract(work_ptr[0], delay_out_ptr[i + 3], work_ptr[0], numSamples); // - a[j + 3]
+            dsp::vo::add(work_ptr[1], delay_out_ptr[i + 2], work_ptr[1], numSamples); // + a[j + 2]
+            dsp::vo::subtract(work_ptr[1], delay_out_ptr[i + 1], work_ptr[1], numSamples); // - a[j + 1]
         }
-        vo::add(work_ptr[0], work_ptr[1], late_ptr[0], numSamples);  // a[0] - a[1] + a[2] - a[3] ...
-        vo::subtract(work_ptr[0], work_ptr[1], late_ptr[1], numSamples); // a[0] + a[1] - a[2] - a[3] ...
+        dsp::vo::add(work_ptr[0], work_ptr[1], late_ptr[0], numSamples);  // a[0] - a[1] + a[2] - a[3] ...
+        dsp::vo::subtract(work_ptr[0], work_ptr[1], late_ptr[1], numSamples); // a[0] + a[1] - a[2] - a[3] ...
 
         apply_smooth_gain(d->late_gain_smooth, late_ptr, late_ptr, 2, numSamples);
     } else {
@@ -772,7 +772,7 @@ void ReverbProcessor::_processLines(float** signalPtr, int32_t numSamples)
     if (!er_muted) {
         apply_smooth_gain(d->er_gain_smooth, er_ptr, er_ptr, 2, numSamples);
         for (int ch = 0; ch < 2; ++ch) {
-            vo::add(late_ptr[ch], er_ptr[ch], late_ptr[ch], numSamples);
+            dsp::vo::add(late_ptr[ch], er_ptr[ch], late_ptr[ch], numSamples);
         }
     }
 
@@ -782,10 +782,10 @@ void ReverbProcessor::_processLines(float** signalPtr, int32_t numSamples)
     auto stereo_2 = _sqrt_sign(0.5f * (1 - stereoSpreadFact));
 
     d->work_buffer.assignSamples(d->late_buffer);
-    vo::constantMultiply(work_ptr[0], stereo_1, late_ptr[0], numSamples);
-    vo::constantMultiplyAndAdd(work_ptr[1], stereo_2, late_ptr[0], numSamples);
-    vo::constantMultiply(work_ptr[1], stereo_1, late_ptr[1], numSamples);
-    vo::constantMultiplyAndAdd(work_ptr[0], stereo_2, late_ptr[1], numSamples);
+    dsp::vo::constantMultiply(work_ptr[0], stereo_1, late_ptr[0], numSamples);
+    dsp::vo::constantMultiplyAndAdd(work_ptr[1], stereo_2, late_ptr[0], numSamples);
+    dsp::vo::constantMultiply(work_ptr[1], stereo_1, late_ptr[1], numSamples);
+    dsp::vo::constantMultiplyAndAdd(work_ptr[0], stereo_2, late_ptr[1], numSamples);
 
     // filtering
     if (!RealIsNull(getParameter(PeakGain))) {
@@ -804,8 +804,8 @@ void ReverbProcessor::_processLines(float** signalPtr, int32_t numSamples)
 
     // output mix
     apply_smooth_gain(d->dry_gain_smooth, signal_in, work_ptr, 2, numSamples);
-    vo::add(work_ptr[0], late_ptr[0], signal_out[0], numSamples);
-    vo::add(work_ptr[1], late_ptr[1], signal_out[1], numSamples);
+    dsp::vo::add(work_ptr[0], late_ptr[0], signal_out[0], numSamples);
+    dsp::vo::add(work_ptr[1], late_ptr[1], signal_out[1], numSamples);
 }
 
 void ReverbProcessor::Processor::allocateParameters(int num)
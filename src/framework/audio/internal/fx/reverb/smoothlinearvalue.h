@@ -23,7 +23,7 @@
 #ifndef MUSE_AUDIO_SMOOTHLINEARVALUE_H
 #define MUSE_AUDIO_SMOOTHLINEARVALUE_H
 
-#include "vectorops.h"
+#include "internal/dsp/vectorops.h"
 
 namespace muse::audio::fx {
 template<typename ValueT, int _initialSteps = 1024, typename StepT = double>
@@ -186,7 +186,7 @@ inline void apply_smooth_gain(SmoothLinearValue<float>& smooth_value, float** s_
 {
     if (smooth_value.isAtTargetValue()) {
         for (int ch = 0; ch < num_channels; ++ch) {
-            vo::constantMultiply(s_in[ch], smooth_value.getTargetValue(), s_out[ch], num_s);
+            dsp::vo::constantMultiply(s_in[ch], smooth_value.getTargetValue(), s_out[ch], num_s);
         }
     } else {
         for (int i = 0; i < num_s; ++i) {
@@ -38,8 +38,8 @@ using namespace muse;
 using namespace muse::audio;
 using namespace muse::audio::soundtrack;
 
-static constexpr int PREPARE_STEP = 0;
-static constexpr int ENCODE_STEP = 1;
+// The number of render blocks which can be buffered between rendering and encoding
+static constexpr size_t RING_BLOCKS_COUNT = 32;
 
 static encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType type)
 {
@@ -64,25 +64,29 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(format.samplesPerChannel * format.audioChannelsNumber);
+    m_totalSamplesPerChannel = (totalDuration / 1000000.f) * format.sampleRate;
     m_renderStep = format.samplesPerChannel;
 
+    m_ringBlockSize = format.samplesPerChannel * format.audioChannelsNumber;
+    m_ringBuffer.resize(RING_BLOCKS_COUNT * m_ringBlockSize);
+    m_ringBlockSamples.resize(RING_BLOCKS_COUNT, 0);
+
     m_encoderPtr = createEncoder(format.type);
 
     if (!m_encoderPtr) {
         return;
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
-    m_encoderPtr->progress().progressChanged().onReceive(this, [this](int64_t current, int64_t total, std::string) {
-        sendStepProgress(ENCODE_STEP, current, total);
-    });
+    m_encoderPtr->init(destination, format, m_totalSamplesPerChannel);
 }
 
 SoundTrackWriter::~SoundTrackWriter()
 {
+    if (m_encoderThread.joinable()) {
+        abort();
+        m_encoderThread.join();
+    }
+
     if (m_encoderPtr) {
         m_encoderPtr->deinit();
     }
@@ -101,7 +105,25 @@ Ret SoundTrackWriter::write()
     m_source->setSampleRate(m_encoderPtr->format().sampleRate);
     m_source->setIsActive(true);
 
+    m_encoderThread = std::thread([this]() {
+        encodeAudioData();
+    });
+
+    auto finishEncoding = [this]() {
+        {
+            std::lock_guard lock(m_ringMutex);
+            m_renderFinished = true;
+        }
+        m_ringBlockWritten.notify_all();
+
+        if (m_encoderThread.joinable()) {
+            m_encoderThread.join();
+        }
+    };
+
     DEFER {
+        finishEncoding();
+
         m_encoderPtr->flush();
 
         audioEngine()->setMode(RenderMode::IdleMode);
@@ -117,22 +139,30 @@ Ret SoundTrackWriter::write()
         return ret;
     }
 
-    size_t bytes = m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data());
+    finishEncoding();
 
     if (m_isAborted) {
         return make_ret(Ret::Code::Cancel);
     }
 
-    if (bytes == 0) {
+    if (m_encodeFailed) {
         return make_ret(Err::ErrorEncode);
     }
 
+    sendProgress();
+
     return muse::make_ok();
 }
 
 void SoundTrackWriter::abort()
 {
-    m_isAborted = true;
+    {
+        std::lock_guard lock(m_ringMutex);
+        m_isAborted = true;
+    }
+
+    m_ringBlockWritten.notify_all();
+    m_ringBlockRead.notify_all();
 }
 
 Progress SoundTrackWriter::progress()
@@ -144,29 +174,30 @@ Ret SoundTrackWriter::generateAudioData()
 {
     TRACEFUNC;
 
-    const size_t inputBufferMaxOffset = m_inputBuffer.size();
-    size_t inputBufferOffset = 0;
+    samples_t renderedSamples = 0;
 
-    sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+    sendProgress();
 
-    while (inputBufferOffset < inputBufferMaxOffset && !m_isAborted) {
-        m_source->process(m_intermBuffer.data(), m_renderStep);
+    while (renderedSamples < m_totalSamplesPerChannel && !m_isAborted && !m_encodeFailed) {
+        float* block = acquireBlockForWriting();
+        if (!block) {
+            break;
+        }
 
-        size_t samplesToCopy = std::min(m_intermBuffer.size(), inputBufferMaxOffset - inputBufferOffset);
+        m_source->process(block, m_renderStep);
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        samples_t samples = std::min(m_renderStep, m_totalSamplesPerChannel - renderedSamples);
+        commitWrittenBlock(samples);
 
-        inputBufferOffset += samplesToCopy;
-        sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+        renderedSamples += samples;
+        sendProgress();
     }
 
     if (m_isAborted) {
         return make_ret(Ret::Code::Cancel);
     }
 
-    if (inputBufferOffset == 0) {
+    if (renderedSamples == 0) {
         LOGI() << "No audio to export";
         return make_ret(Err::NoAudioToExport);
     }
@@ -174,10 +205,85 @@ Ret SoundTrackWriter::generateAudioData()
     return muse::make_ok();
 }
 
-void SoundTrackWriter::sendStepProgress(int step, int64_t current, int64_t total)
+void SoundTrackWriter::encodeAudioData()
+{
+    samples_t samples = 0;
+
+    while (const float* block = acquireBlockForReading(samples)) {
+        size_t encoded = m_encoderPtr->encode(samples, block);
+        releaseReadBlock();
+
+        if (encoded == 0) {
+            LOGE() << "Failed to encode audio block";
+            {
+                std::lock_guard lock(m_ringMutex);
+                m_encodeFailed = true;
+            }
+            m_ringBlockRead.notify_all();
+            break;
+        }
+
+        m_encodedSamplesPerChannel += samples;
+    }
+}
+
+float* SoundTrackWriter::acquireBlockForWriting()
+{
+    std::unique_lock lock(m_ringMutex);
+    m_ringBlockRead.wait(lock, [this]() {
+        return m_ringWriteIdx - m_ringReadIdx < RING_BLOCKS_COUNT || m_isAborted || m_encodeFailed;
+    });
+
+    if (m_isAborted || m_encodeFailed) {
+        return nullptr;
+    }
+
+    return m_ringBuffer.data() + (m_ringWriteIdx % RING_BLOCKS_COUNT) * m_ringBlockSize;
+}
+
+void SoundTrackWriter::commitWrittenBlock(samples_t samplesPerChannel)
+{
+    {
+        std::lock_guard lock(m_ringMutex);
+        m_ringBlockSamples[m_ringWriteIdx % RING_BLOCKS_COUNT] = samplesPerChannel;
+        ++m_ringWriteIdx;
+    }
+
+    m_ringBlockWritten.notify_one();
+}
+
+const float* SoundTrackWriter::acquireBlockForReading(samples_t& samplesPerChannel)
+{
+    std::unique_lock lock(m_ringMutex);
+    m_ringBlockWritten.wait(lock, [this]() {
+        return m_ringReadIdx < m_ringWriteIdx || m_renderFinished || m_isAborted;
+    });
+
+    if (m_isAborted || m_ringReadIdx == m_ringWriteIdx) {
+        return nullptr;
+    }
+
+    size_t blockIdx = m_ringReadIdx % RING_BLOCKS_COUNT;
+    samplesPerChannel = m_ringBlockSamples[blockIdx];
+
+    return m_ringBuffer.data() + blockIdx * m_ringBlockSize;
+}
+
+void SoundTrackWriter::releaseReadBlock()
+{
+    {
+        std::lock_guard lock(m_ringMutex);
+        ++m_ringReadIdx;
+    }
+
+    m_ringBlockRead.notify_one();
+}
+
+void SoundTrackWriter::sendProgress()
 {
-    int stepRange = step == PREPARE_STEP ? 80 : 20;
-    int stepProgressStart = step == PREPARE_STEP ? 0 : 80;
-    int stepCurrentProgress = stepProgressStart + ((current * 100 / total) * stepRange) / 100;
-    m_progress.progress(stepCurrentProgress, 100, "");
+    //! NOTE: the encoder lags behind the renderer by at most RING_BLOCKS_COUNT blocks,
+    //! so the number of encoded samples is an accurate measure of the overall progress
+    int64_t total = std::max(m_totalSamplesPerChannel, samples_t(1));
+    int64_t current = std::min(static_cast<int64_t>(m_encodedSamplesPerChannel.load()), total);
+    m_progress.progress(current * 100 / total, 100, "");
 }
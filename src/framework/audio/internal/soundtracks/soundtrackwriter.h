@@ -24,6 +24,9 @@
 #define MUSE_AUDIO_SOUNDTRACKWRITER_H
 
 #include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 
 #include "global/async/asyncable.h"
 #include "global/modularity/ioc.h"
@@ -50,14 +53,35 @@ public:
 
 private:
     Ret generateAudioData();
+    void encodeAudioData();
 
-    void sendStepProgress(int step, int64_t current, int64_t total);
+    float* acquireBlockForWriting();
+    void commitWrittenBlock(samples_t samplesPerChannel);
+    const float* acquireBlockForReading(samples_t& samplesPerChannel);
+    void releaseReadBlock();
+
+    void sendProgress();
 
     IAudioSourcePtr m_source = nullptr;
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    // Bounded ring of render blocks between the render loop (producer)
+    // and the encoder thread (consumer), so that the memory usage
+    // doesn't depend on the duration of the track
+    std::vector<float> m_ringBuffer;
+    std::vector<samples_t> m_ringBlockSamples;
+    size_t m_ringBlockSize = 0;
+    size_t m_ringWriteIdx = 0;
+    size_t m_ringReadIdx = 0;
+    bool m_renderFinished = false;
+    std::mutex m_ringMutex;
+    std::condition_variable m_ringBlockWritten;
+    std::condition_variable m_ringBlockRead;
+
     samples_t m_renderStep = 0;
+    samples_t m_totalSamplesPerChannel = 0;
+    std::atomic<samples_t> m_encodedSamplesPerChannel = 0;
+    std::atomic<bool> m_encodeFailed = false;
+    std::thread m_encoderThread;
 
     encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
 
@@ -37,6 +37,25 @@ static constexpr note_idx_t MAX_SUPPORTED_NOTE = 108; // MIDI equivalent for C8
 static constexpr uint32_t CTRL_ON = 127;
 static constexpr uint32_t CTRL_OFF = 0;
 
+//! NOTE The time span covered by all the MIDI events rendered from the note
+static std::pair<timestamp_t, timestamp_t> renderedSpan(const mpe::NoteEvent& noteEvent)
+{
+    const mpe::ArrangementContext& arrangementCtx = noteEvent.arrangementCtx();
+    const timestamp_t noteTimestampTo = arrangementCtx.actualTimestamp + arrangementCtx.actualDuration;
+
+    timestamp_t from = arrangementCtx.actualTimestamp;
+    timestamp_t to = noteTimestampTo;
+
+    //! NOTE Pedals may start before the note, and sostenuto starts inside the note but lasts for the whole articulation
+    for (const auto& artPair : noteEvent.expressionCtx().articulations) {
+        const mpe::ArticulationMeta& meta = artPair.second.meta;
+        from = std::min(from, meta.timestamp);
+        to = std::max(to, std::max(meta.timestamp, noteTimestampTo) + meta.overallDuration);
+    }
+
+    return { from, to };
+}
+
 void FluidSequencer::init(const PlaybackSetupData& setupData, const std::optional<midi::Program>& programOverride,
                           bool useDynamicEvents)
 {
@@ -67,8 +86,9 @@ void FluidSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& events,
         m_onOffStreamFlushed();
     }
 
-    updatePlaybackEvents(m_offStreamEvents, events);
-    updateOffSequenceIterator();
+    EventSequenceMap offStreamEvents;
+    updatePlaybackEvents(offStreamEvents, events.cbegin(), events.cend());
+    assignEvents(m_offStreamEvents, offStreamEvents);
 }
 
 void FluidSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
@@ -81,15 +101,70 @@ void FluidSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events
         m_onMainStreamFlushed();
     }
 
-    updatePlaybackEvents(m_mainStreamEvents, events);
+    EventSequenceMap mainStreamEvents;
+    updatePlaybackEvents(mainStreamEvents, events.cbegin(), events.cend());
+    assignEvents(m_mainStreamEvents, mainStreamEvents);
     updateMainSequenceIterator();
 
+    m_maxRenderedLead = 0;
+    m_maxRenderedTail = 0;
+    updateRenderedSpanLimits(events.cbegin(), events.cend());
+
     if (m_useDynamicEvents) {
-        updateDynamicEvents(m_dynamicEvents, dynamics);
+        EventSequenceMap dynamicEvents;
+        updateDynamicEvents(dynamicEvents, dynamics);
+        assignEvents(m_dynamicEvents, dynamicEvents);
         updateDynamicChangesIterator();
     }
 }
 
+void FluidSequencer::applyMainStreamPatch(const mpe::MainStreamPatch& patch)
+{
+    if (m_onMainStreamFlushed) {
+        m_onMainStreamFlushed();
+    }
+
+    PlaybackEventsMap& originEvents = m_playbackData.originEvents;
+
+    for (const PlaybackEventsWindow& window : patch.windows) {
+        timestamp_t from = window.timestampFrom;
+        timestamp_t to = window.timestampTo;
+
+        //! NOTE The MIDI events of both the replaced and the new notes have to be re-rendered
+        auto replacedBounds = windowBounds(originEvents, window.timestampFrom, window.timestampTo);
+        expandToRenderedSpan(replacedBounds.first, replacedBounds.second, from, to);
+        expandToRenderedSpan(window.events.cbegin(), window.events.cend(), from, to);
+        updateRenderedSpanLimits(window.events.cbegin(), window.events.cend());
+
+        applyWindow(originEvents, window);
+
+        //! NOTE Only the notes within the span limits may render MIDI events into [from, to].
+        //! They form a contiguous range of notes, so overlapping sostenuto pedals get resolved as in the full rendering
+        EventSequenceMap rendered;
+        updatePlaybackEvents(rendered, originEvents.lower_bound(from - m_maxRenderedTail),
+                             originEvents.upper_bound(to + m_maxRenderedLead));
+
+        replaceEvents(m_mainStreamEvents, from, to, rendered);
+    }
+
+    updateMainSequenceIterator();
+
+    if (patch.dynamics) {
+        m_playbackData.dynamics = patch.dynamics.value();
+
+        if (m_useDynamicEvents) {
+            EventSequenceMap dynamicEvents;
+            updateDynamicEvents(dynamicEvents, m_playbackData.dynamics);
+            assignEvents(m_dynamicEvents, dynamicEvents);
+            updateDynamicChangesIterator();
+        }
+    }
+
+    if (patch.params) {
+        m_playbackData.params = patch.params.value();
+    }
+}
+
 muse::async::Channel<channel_t, Program> FluidSequencer::channelAdded() const
 {
     return m_channels.channelAdded;
@@ -105,12 +180,13 @@ int FluidSequencer::lastStaff() const
     return m_lastStaff;
 }
 
-void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes)
+void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, mpe::PlaybackEventsMap::const_iterator begin,
+                                          mpe::PlaybackEventsMap::const_iterator end)
 {
     SostenutoTimeAndDurations sostenutoTimeAndDurations;
 
-    for (const auto& pair : changes) {
-        for (const mpe::PlaybackEvent& event : pair.second) {
+    for (auto it = begin; it != end; ++it) {
+        for (const mpe::PlaybackEvent& event : it->second) {
             if (!std::holds_alternative<mpe::NoteEvent>(event)) {
                 continue;
             }
@@ -269,6 +345,37 @@ void FluidSequencer::appendSostenutoEvents(EventSequenceMap& destination, const
     }
 }
 
+void FluidSequencer::updateRenderedSpanLimits(mpe::PlaybackEventsMap::const_iterator begin, mpe::PlaybackEventsMap::const_iterator end)
+{
+    for (auto it = begin; it != end; ++it) {
+        for (const mpe::PlaybackEvent& event : it->second) {
+            if (!std::holds_alternative<mpe::NoteEvent>(event)) {
+                continue;
+            }
+
+            const std::pair<timestamp_t, timestamp_t> span = renderedSpan(std::get<mpe::NoteEvent>(event));
+            m_maxRenderedLead = std::max(m_maxRenderedLead, it->first - span.first);
+            m_maxRenderedTail = std::max(m_maxRenderedTail, span.second - it->first);
+        }
+    }
+}
+
+void FluidSequencer::expandToRenderedSpan(mpe::PlaybackEventsMap::const_iterator begin, mpe::PlaybackEventsMap::const_iterator end,
+                                          mpe::timestamp_t& from, mpe::timestamp_t& to) const
+{
+    for (auto it = begin; it != end; ++it) {
+        for (const mpe::PlaybackEvent& event : it->second) {
+            if (!std::holds_alternative<mpe::NoteEvent>(event)) {
+                continue;
+            }
+
+            const std::pair<timestamp_t, timestamp_t> span = renderedSpan(std::get<mpe::NoteEvent>(event));
+            from = std::min(from, span.first);
+            to = std::max(to, span.second);
+        }
+    }
+}
+
 channel_t FluidSequencer::channel(const mpe::NoteEvent& noteEvent) const
 {
     return m_channels.resolveChannelForEvent(noteEvent);
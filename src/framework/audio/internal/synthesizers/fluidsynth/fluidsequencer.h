@@ -48,8 +48,10 @@ private:
     void updateOffStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) override;
     void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                 const mpe::PlaybackParamLayers& params) override;
+    void applyMainStreamPatch(const mpe::MainStreamPatch& patch) override;
 
-    void updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes);
+    void updatePlaybackEvents(EventSequenceMap& destination, mpe::PlaybackEventsMap::const_iterator begin,
+                              mpe::PlaybackEventsMap::const_iterator end);
     void updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& changes);
 
     void appendControlChange(EventSequenceMap& destination, const mpe::timestamp_t timestamp, const int midiControlIdx,
@@ -68,9 +70,17 @@ private:
     int expressionLevel(const mpe::dynamic_level_t dynamicLevel) const;
     int pitchBendLevel(const mpe::pitch_level_t pitchLevel) const;
 
+    void updateRenderedSpanLimits(mpe::PlaybackEventsMap::const_iterator begin, mpe::PlaybackEventsMap::const_iterator end);
+    void expandToRenderedSpan(mpe::PlaybackEventsMap::const_iterator begin, mpe::PlaybackEventsMap::const_iterator end,
+                              mpe::timestamp_t& from, mpe::timestamp_t& to) const;
+
     mutable ChannelMap m_channels;
     bool m_useDynamicEvents = false;
     int m_lastStaff = -1;
+
+    //! NOTE How far the MIDI events rendered from a note may lie before/after the note's timestamp
+    mpe::duration_t m_maxRenderedLead = 0;
+    mpe::duration_t m_maxRenderedTail = 0;
 };
 }
 
@@ -63,6 +63,7 @@ FluidSynth::FluidSynth(const AudioSourceParams& params, const modularity::Contex
     : AbstractSynthesizer(params, iocCtx)
 {
     m_fluid = std::make_shared<Fluid>();
+    m_eventBuffer.reserve();
 
     init();
 }
@@ -412,15 +413,15 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
     }
 
     const msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
-    const FluidSequencer::EventSequenceMap sequences = m_sequencer.movePlaybackForward(nextMsecs);
+    m_sequencer.movePlaybackForward(nextMsecs, m_eventBuffer);
     samples_t sampleOffset = 0;
 
-    for (auto it = sequences.cbegin(); it != sequences.cend(); ++it) {
+    for (size_t i = 0; i < m_eventBuffer.sequencesCount(); ++i) {
+        const FluidSequencer::EventBuffer::Sequence& sequence = m_eventBuffer.sequence(i);
         samples_t durationInSamples = samplesPerChannel - sampleOffset;
 
-        auto nextIt = std::next(it);
-        if (nextIt != sequences.cend()) {
-            msecs_t duration = nextIt->first - it->first;
+        if (i + 1 < m_eventBuffer.sequencesCount()) {
+            msecs_t duration = m_eventBuffer.sequence(i + 1).timestamp - sequence.timestamp;
             durationInSamples = microSecsToSamples(duration, m_sampleRate);
         }
 
@@ -428,7 +429,8 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
             break;
         }
 
-        if (!processSequence(it->second, durationInSamples, buffer + sampleOffset * FLUID_AUDIO_CHANNELS_COUNT)) {
+        if (!processSequence(m_eventBuffer.eventsBegin(sequence), m_eventBuffer.eventsEnd(sequence), durationInSamples,
+                             buffer + sampleOffset * FLUID_AUDIO_CHANNELS_COUNT)) {
             return 0;
         }
 
@@ -438,14 +440,16 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
     return samplesPerChannel;
 }
 
-bool FluidSynth::processSequence(const FluidSequencer::EventSequence& sequence, const samples_t samples, float* buffer)
+bool FluidSynth::processSequence(FluidSequencer::EventBuffer::EventIterator eventsBegin,
+                                 FluidSequencer::EventBuffer::EventIterator eventsEnd,
+                                 const samples_t samples, float* buffer)
 {
-    if (!sequence.empty()) {
+    if (eventsBegin != eventsEnd) {
         m_tuning.reset();
     }
 
-    for (const FluidSequencer::EventType& event : sequence) {
-        handleEvent(std::get<midi::Event>(event));
+    for (auto it = eventsBegin; it != eventsEnd; ++it) {
+        handleEvent(std::get<midi::Event>(*it));
     }
 
     fluid_synth_tune_notes(m_fluid->synth, 0, 0, m_tuning.size(), m_tuning.keys.data(), m_tuning.pitches.data(), true);
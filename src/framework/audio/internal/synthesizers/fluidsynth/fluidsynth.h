@@ -102,7 +102,8 @@ private:
 
     void allNotesOff();
 
-    bool processSequence(const FluidSequencer::EventSequence& sequence, const samples_t samples, float* buffer);
+    bool processSequence(FluidSequencer::EventBuffer::EventIterator eventsBegin, FluidSequencer::EventBuffer::EventIterator eventsEnd,
+                         const samples_t samples, float* buffer);
     bool handleEvent(const midi::Event& event);
 
     void toggleExpressionController();
@@ -116,6 +117,7 @@ private:
     async::Channel<unsigned int> m_streamsCountChanged;
 
     FluidSequencer m_sequencer;
+    FluidSequencer::EventBuffer m_eventBuffer;
     std::set<io::path_t> m_sfontPaths;
     std::optional<midi::Program> m_preset;
 
@@ -74,13 +74,6 @@ void AudioEngine::deinit()
     }
 }
 
-void AudioEngine::setOnReadBufferChanged(const OnReadBufferChanged func)
-{
-    ONLY_AUDIO_MAIN_OR_WORKER_THREAD;
-
-    m_onReadBufferChanged = func;
-}
-
 sample_rate_t AudioEngine::sampleRate() const
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -104,10 +97,6 @@ void AudioEngine::setSampleRate(const sample_rate_t sampleRate)
 
     m_sampleRate = sampleRate;
     m_mixer->mixedSource()->setSampleRate(sampleRate);
-
-    if (m_onReadBufferChanged) {
-        m_onReadBufferChanged(m_readBufferSize, m_sampleRate);
-    }
 }
 
 void AudioEngine::setReadBufferSize(const uint16_t readBufferSize)
@@ -122,10 +111,6 @@ void AudioEngine::setReadBufferSize(const uint16_t readBufferSize)
 
     m_readBufferSize = readBufferSize;
     updateBufferConstraints();
-
-    if (m_onReadBufferChanged) {
-        m_onReadBufferChanged(m_readBufferSize, m_sampleRate);
-    }
 }
 
 void AudioEngine::setAudioChannelsCount(const audioch_t count)
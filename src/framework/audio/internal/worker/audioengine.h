@@ -48,9 +48,6 @@ public:
     Ret init(std::shared_ptr<AudioBuffer> bufferPtr, const RenderConstraints& consts);
     void deinit();
 
-    using OnReadBufferChanged = std::function<void (const samples_t, const sample_rate_t)>;
-    void setOnReadBufferChanged(const OnReadBufferChanged func);
-
     sample_rate_t sampleRate() const override;
 
     void setSampleRate(const sample_rate_t sampleRate) override;
@@ -78,8 +75,6 @@ private:
 
     RenderMode m_currentMode = RenderMode::Undefined;
     async::Notification m_modeChanges;
-
-    OnReadBufferChanged m_onReadBufferChanged;
 };
 }
 
@@ -21,10 +21,11 @@
  */
 #include "mixer.h"
 
-#include "concurrency/taskscheduler.h"
+#include "concurrency/forkjoinpool.h"
 
 #include "internal/audiosanitizer.h"
 #include "internal/dsp/audiomathutils.h"
+#include "internal/dsp/mixerops.h"
 #include "audioerrors.h"
 
 #include "log.h"
@@ -38,13 +39,13 @@ Mixer::Mixer(const modularity::ContextPtr& iocCtx)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    m_taskScheduler = std::make_unique<TaskScheduler>(static_cast<thread_pool_size_t>(configuration()->desiredAudioThreadNumber()));
+    m_workerPool = std::make_unique<ForkJoinPool>(configuration()->desiredAudioThreadNumber());
 
-    if (!m_taskScheduler->setThreadsPriority(ThreadPriority::High)) {
+    if (!m_workerPool->setThreadsPriority(ThreadPriority::High)) {
         LOGE() << "Unable to change audio threads priority";
     }
 
-    AudioSanitizer::setMixerThreads(m_taskScheduler->threadIdSet());
+    AudioSanitizer::setMixerThreads(m_workerPool->threadIdSet());
 
     m_minTrackCountForMultithreading = configuration()->minTrackCountForMultithreading();
 }
@@ -103,9 +104,14 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, ITrackAudioInpu
         }
     });
 
-    m_trackChannels.emplace(trackId, channel);
+    TrackChannelInfo info;
+    info.channel = channel;
+    info.buffer = std::vector<float>(configuration()->samplesToPreallocate() * configuration()->audioChannelsCount(), 0.f);
 
-    result.val = m_trackChannels[trackId];
+    auto it = m_trackChannels.emplace(trackId, std::move(info)).first;
+    m_tracksToProcess.reserve(m_trackChannels.size());
+
+    result.val = it->second.channel;
     result.ret = make_ret(Ret::Code::Ok);
 
     return result;
@@ -139,7 +145,7 @@ Ret Mixer::removeChannel(const TrackId trackId)
 
     auto search = m_trackChannels.find(trackId);
 
-    if (search != m_trackChannels.end() && search->second) {
+    if (search != m_trackChannels.end() && search->second.channel) {
         if (m_nonMutedTrackCount != 0) {
             m_nonMutedTrackCount--;
         }
@@ -170,8 +176,8 @@ void Mixer::setSampleRate(unsigned int sampleRate)
 
     AbstractAudioSource::setSampleRate(sampleRate);
 
-    for (auto& channel : m_trackChannels) {
-        channel.second->setSampleRate(sampleRate);
+    for (auto& pair : m_trackChannels) {
+        pair.second.channel->setSampleRate(sampleRate);
     }
 
     for (AuxChannelInfo& aux : m_auxChannelInfoList) {
@@ -206,27 +212,21 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
         return 0;
     }
 
-    TracksData tracksData;
-    processTrackChannels(outBufferSize, samplesPerChannel, tracksData);
+    processTrackChannels(outBufferSize, samplesPerChannel);
 
     prepareAuxBuffers(outBufferSize);
 
-    for (auto& pair : tracksData) {
-        auto channelIt = m_trackChannels.find(pair.first);
-        if (channelIt == m_trackChannels.cend()) {
-            continue;
-        }
-
-        const MixerChannelPtr& channel = channelIt->second;
+    for (const TrackChannelInfo* info : m_tracksToProcess) {
+        const MixerChannelPtr& channel = info->channel;
         if (!channel->isSilent()) {
             m_isSilence = false;
         } else if (m_isSilence) {
             continue;
         }
 
-        const std::vector<float>& trackBuffer = pair.second;
-        mixOutputFromChannel(outBuffer, trackBuffer.data(), samplesPerChannel);
-        writeTrackToAuxBuffers(trackBuffer.data(), channel->outputParams().auxSends, samplesPerChannel);
+        const float* trackBuffer = info->buffer.data();
+        mixOutputFromChannel(outBuffer, trackBuffer, samplesPerChannel);
+        writeTrackToAuxBuffers(trackBuffer, channel->outputParams().auxSends, samplesPerChannel);
     }
 
     if (m_masterParams.muted || samplesPerChannel == 0 || m_isSilence) {
@@ -246,60 +246,46 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     return samplesPerChannel;
 }
 
-void Mixer::processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData)
+void Mixer::processTrackChannels(size_t outBufferSize, size_t samplesPerChannel)
 {
-    auto processChannel = [outBufferSize, samplesPerChannel](MixerChannelPtr channel) -> std::vector<float> {
-        thread_local std::vector<float> buffer(outBufferSize, 0.f);
-        thread_local std::vector<float> silent_buffer(outBufferSize, 0.f);
-
-        if (buffer.size() < outBufferSize) {
-            buffer.resize(outBufferSize, 0.f);
-            silent_buffer.resize(outBufferSize, 0.f);
+    //! NOTE: no allocation should happen here in the normal case:
+    //! the track buffers are preallocated and only grow if the block size exceeds samplesToPreallocate
+    auto processChannel = [outBufferSize, samplesPerChannel](TrackChannelInfo* info) {
+        if (info->buffer.size() < outBufferSize) {
+            info->buffer.resize(outBufferSize, 0.f);
         }
 
-        buffer = silent_buffer;
+        std::fill(info->buffer.begin(), info->buffer.begin() + outBufferSize, 0.f);
 
-        if (channel) {
-            channel->process(buffer.data(), samplesPerChannel);
-        }
-
-        return buffer;
+        info->channel->process(info->buffer.data(), samplesPerChannel);
     };
 
     bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
 
-    if (useMultithreading()) {
-        std::map<TrackId, std::future<std::vector<float> > > futures;
-
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
+    m_tracksToProcess.clear();
 
-            if (pair.second->muted() && pair.second->isSilent()) {
-                pair.second->notifyNoAudioSignal();
-                continue;
-            }
+    for (auto& pair : m_trackChannels) {
+        const MixerChannelPtr& channel = pair.second.channel;
 
-            std::future<std::vector<float> > future = m_taskScheduler->submit(processChannel, pair.second);
-            futures.emplace(pair.first, std::move(future));
+        if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, channel->trackId())) {
+            continue;
         }
 
-        for (auto& pair : futures) {
-            outTracksData.emplace(pair.first, pair.second.get());
+        if (channel->muted() && channel->isSilent()) {
+            channel->notifyNoAudioSignal();
+            continue;
         }
-    } else {
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
 
-            if (pair.second->muted() && pair.second->isSilent()) {
-                pair.second->notifyNoAudioSignal();
-                continue;
-            }
+        m_tracksToProcess.push_back(&pair.second);
+    }
 
-            outTracksData.emplace(pair.first, processChannel(pair.second));
+    if (useMultithreading()) {
+        m_workerPool->parallelFor(m_tracksToProcess.size(), [this, &processChannel](size_t idx) {
+            processChannel(m_tracksToProcess[idx]);
+        });
+    } else {
+        for (TrackChannelInfo* info : m_tracksToProcess) {
+            processChannel(info);
         }
     }
 }
@@ -325,9 +311,9 @@ void Mixer::setIsActive(bool arg)
 
     AbstractAudioSource::setIsActive(arg);
 
-    for (auto& channel : m_trackChannels) {
-        if (!channel.second->muted()) {
-            channel.second->setIsActive(arg);
+    for (auto& pair : m_trackChannels) {
+        if (!pair.second.channel->muted()) {
+            pair.second.channel->setIsActive(arg);
         }
     }
 
@@ -451,15 +437,7 @@ void Mixer::mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsign
         return;
     }
 
-    for (samples_t s = 0; s < samplesCount; ++s) {
-        size_t samplePos = s * m_audioChannelsCount;
-
-        for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-            size_t idx = samplePos + audioChNum;
-            float sample = inBuffer[idx];
-            outBuffer[idx] += sample;
-        }
-    }
+    dsp::mixerOps().accumulate(inBuffer, outBuffer, samplesCount * m_audioChannelsCount);
 }
 
 void Mixer::prepareAuxBuffers(size_t outBufferSize)
@@ -496,17 +474,7 @@ void Mixer::writeTrackToAuxBuffers(const float* trackBuffer, const AuxSendsParam
             continue;
         }
 
-        float* auxBuffer = aux.buffer.data();
-        float signalAmount = auxSend.signalAmount;
-
-        for (samples_t s = 0; s < samplesPerChannel; ++s) {
-            size_t samplePos = s * m_audioChannelsCount;
-
-            for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-                size_t idx = samplePos + audioChNum;
-                auxBuffer[idx] += trackBuffer[idx] * signalAmount;
-            }
-        }
+        dsp::mixerOps().accumulateScaled(trackBuffer, auxSend.signalAmount, aux.buffer.data(), samplesPerChannel * m_audioChannelsCount);
 
         aux.receivedAudioSignal = true;
     }
@@ -534,25 +502,26 @@ void Mixer::completeOutput(float* buffer, samples_t samplesPerChannel)
         return;
     }
 
-    float totalSquaredSum = 0.f;
+    IF_ASSERT_FAILED(m_audioChannelsCount <= dsp::MAX_MIXER_AUDIO_CHANNELS) {
+        return;
+    }
+
     float volume = muse::db_to_linear(m_masterParams.volume);
+    gain_t gains[dsp::MAX_MIXER_AUDIO_CHANNELS];
+    float squaredSums[dsp::MAX_MIXER_AUDIO_CHANNELS];
 
     for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
-        gain_t totalGain = dsp::balanceGain(m_masterParams.balance, audioChNum) * volume;
+        gains[audioChNum] = dsp::balanceGain(m_masterParams.balance, audioChNum) * volume;
+    }
 
-        for (samples_t s = 0; s < samplesPerChannel; ++s) {
-            int idx = s * m_audioChannelsCount + audioChNum;
+    dsp::mixerOps().applyGains(buffer, gains, m_audioChannelsCount, samplesPerChannel, squaredSums);
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    float totalSquaredSum = 0.f;
 
-            float squaredSample = resultSample * resultSample;
-            totalSquaredSum += squaredSample;
-            singleChannelSquaredSum += squaredSample;
-        }
+    for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+        totalSquaredSum += squaredSums[audioChNum];
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesPerChannel);
+        float rms = dsp::samplesRootMeanSquare(squaredSums[audioChNum], samplesPerChannel);
         m_audioSignalNotifier.updateSignalValues(audioChNum, rms);
     }
 
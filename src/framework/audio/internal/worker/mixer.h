@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <map>
+#include <vector>
 
 #include "global/modularity/ioc.h"
 #include "global/async/asyncable.h"
@@ -38,7 +39,7 @@
 #include "iclock.h"
 
 namespace muse {
-class TaskScheduler;
+class ForkJoinPool;
 }
 
 namespace muse::audio {
@@ -79,9 +80,12 @@ public:
     void setIsActive(bool arg) override;
 
 private:
-    using TracksData = std::map<TrackId, std::vector<float> >;
+    struct TrackChannelInfo {
+        MixerChannelPtr channel;
+        std::vector<float> buffer;
+    };
 
-    void processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData);
+    void processTrackChannels(size_t outBufferSize, size_t samplesPerChannel);
     void mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsigned int samplesCount) const;
     void prepareAuxBuffers(size_t outBufferSize);
     void writeTrackToAuxBuffers(const float* trackBuffer, const AuxSendsParams& auxSends, samples_t samplesPerChannel);
@@ -94,7 +98,7 @@ private:
 
     msecs_t currentTime() const;
 
-    std::unique_ptr<TaskScheduler> m_taskScheduler;
+    std::unique_ptr<ForkJoinPool> m_workerPool;
 
     size_t m_minTrackCountForMultithreading = 0;
     size_t m_nonMutedTrackCount = 0;
@@ -103,7 +107,8 @@ private:
     async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
     std::vector<IFxProcessorPtr> m_masterFxProcessors = {};
 
-    std::map<TrackId, MixerChannelPtr> m_trackChannels = {};
+    std::map<TrackId, TrackChannelInfo> m_trackChannels = {};
+    std::vector<TrackChannelInfo*> m_tracksToProcess; // reused on every block, its capacity is reserved in addChannel
     std::unordered_set<TrackId> m_tracksToProcessWhenIdle;
 
     struct AuxChannelInfo {
@@ -24,6 +24,7 @@
 #include <algorithm>
 
 #include "internal/dsp/audiomathutils.h"
+#include "internal/dsp/mixerops.h"
 #include "internal/audiosanitizer.h"
 
 #include "log.h"
@@ -220,26 +221,27 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
 void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount)
 {
     unsigned int channelsCount = audioChannelsCount();
+
+    IF_ASSERT_FAILED(channelsCount <= dsp::MAX_MIXER_AUDIO_CHANNELS) {
+        return;
+    }
+
     float volume = muse::db_to_linear(m_params.volume);
-    float totalSquaredSum = 0.f;
+    gain_t gains[dsp::MAX_MIXER_AUDIO_CHANNELS];
+    float squaredSums[dsp::MAX_MIXER_AUDIO_CHANNELS];
 
     for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
-
-        gain_t totalGain = dsp::balanceGain(m_params.balance, audioChNum) * volume;
+        gains[audioChNum] = dsp::balanceGain(m_params.balance, audioChNum) * volume;
+    }
 
-        for (unsigned int s = 0; s < samplesCount; ++s) {
-            int idx = s * channelsCount + audioChNum;
+    dsp::mixerOps().applyGains(buffer, gains, static_cast<audioch_t>(channelsCount), samplesCount, squaredSums);
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    float totalSquaredSum = 0.f;
 
-            float squaredSample = resultSample * resultSample;
-            singleChannelSquaredSum += squaredSample;
-            totalSquaredSum += squaredSample;
-        }
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        totalSquaredSum += squaredSums[audioChNum];
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
+        float rms = dsp::samplesRootMeanSquare(squaredSums[audioChNum], samplesCount);
         m_audioSignalNotifier.updateSignalValues(audioChNum, rms);
     }
 
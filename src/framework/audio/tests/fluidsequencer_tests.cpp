@@ -0,0 +1,214 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "audio/internal/audiosanitizer.h"
+#include "audio/internal/synthesizers/fluidsynth/fluidsequencer.h"
+
+#include "utils/allocationcounter.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::tests;
+using namespace muse::mpe;
+
+class Audio_FluidSequencerTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+    }
+
+    static constexpr timestamp_t NOTE_STEP = 500000;
+    static constexpr duration_t NOTE_DURATION = 400000;
+
+    static ArticulationMap articulations(ArticulationType type, timestamp_t timestamp, duration_t duration)
+    {
+        ArticulationMap result;
+        result.emplace(type, ArticulationAppliedData(ArticulationMeta(type, {}, timestamp, duration), 0, HUNDRED_PERCENT));
+        result.preCalculateAverageData();
+
+        return result;
+    }
+
+    static NoteEvent noteEvent(timestamp_t timestamp, int pitchStep, ArticulationMap&& articulations = {})
+    {
+        ArrangementContext arrangementCtx;
+        arrangementCtx.nominalTimestamp = timestamp;
+        arrangementCtx.actualTimestamp = timestamp;
+        arrangementCtx.nominalDuration = NOTE_DURATION;
+        arrangementCtx.actualDuration = NOTE_DURATION;
+
+        PitchContext pitchCtx;
+        pitchCtx.nominalPitchLevel = pitchLevel(PitchClass::C, 4) + pitchStep * PITCH_LEVEL_STEP;
+
+        ExpressionContext expressionCtx;
+        expressionCtx.articulations = std::move(articulations);
+        expressionCtx.nominalDynamicLevel = dynamicLevelFromType(DynamicType::mf);
+        expressionCtx.velocityOverride = 0.6f;
+
+        return NoteEvent(std::move(arrangementCtx), std::move(pitchCtx), std::move(expressionCtx));
+    }
+
+    //! NOTE Notes every NOTE_STEP, some of them with pedals lasting for several notes
+    static PlaybackEventsMap scoreEvents(int notesCount)
+    {
+        PlaybackEventsMap result;
+
+        for (int i = 0; i < notesCount; ++i) {
+            timestamp_t timestamp = (i + 4) * NOTE_STEP;
+
+            if (i % 10 == 0) {
+                result[timestamp].emplace_back(noteEvent(timestamp, i % 12,
+                                                         articulations(ArticulationType::Pedal, timestamp - NOTE_STEP, 8 * NOTE_STEP)));
+            } else if (i % 7 == 0) {
+                result[timestamp].emplace_back(noteEvent(timestamp, i % 12,
+                                                         articulations(ArticulationType::LaissezVibrer, timestamp, 3 * NOTE_STEP)));
+            } else {
+                result[timestamp].emplace_back(noteEvent(timestamp, i % 12));
+            }
+        }
+
+        return result;
+    }
+
+    static FluidSequencer::EventSequenceMap allMainStreamEvents(FluidSequencer& sequencer)
+    {
+        sequencer.setPlaybackPosition(0);
+        return sequencer.movePlaybackForward(std::numeric_limits<int32_t>::max());
+    }
+};
+
+/**
+ * @brief Audio_FluidSequencerTests_MainStreamPatch
+ * @details Splicing a main stream patch into the sequencer must give the same MIDI events
+ *          as rebuilding the sequencer from the whole changed score
+ */
+TEST_F(Audio_FluidSequencerTests, MainStreamPatch)
+{
+    // [GIVEN] A score with some pedals
+    mpe::PlaybackData data;
+    data.setupData = PlaybackSetupData(SoundId::Piano, SoundCategory::Keyboards);
+    data.originEvents = scoreEvents(200);
+    data.dynamics[0] = { { 0, dynamicLevelFromType(DynamicType::mf) } };
+
+    FluidSequencer patchedSequencer;
+    patchedSequencer.init(data.setupData, std::nullopt, true);
+    patchedSequencer.load(data);
+    patchedSequencer.setActive(true);
+
+    // [GIVEN] Some notes have been changed, removed and added within a window, the dynamics have been changed too
+    const timestamp_t windowFrom = 50 * NOTE_STEP;
+    const timestamp_t windowTo = 62 * NOTE_STEP;
+
+    PlaybackEventsWindow window;
+    window.timestampFrom = windowFrom;
+    window.timestampTo = windowTo;
+
+    for (timestamp_t timestamp = windowFrom; timestamp <= windowTo; timestamp += NOTE_STEP) {
+        if (timestamp == windowFrom + 3 * NOTE_STEP) {
+            continue;
+        }
+
+        if (timestamp == windowFrom + 5 * NOTE_STEP) {
+            window.events[timestamp].emplace_back(noteEvent(timestamp, 3,
+                                                            articulations(ArticulationType::Pedal, timestamp, 9 * NOTE_STEP)));
+            continue;
+        }
+
+        window.events[timestamp].emplace_back(noteEvent(timestamp, -5));
+    }
+
+    MainStreamPatch patch;
+    patch.windows.push_back(window);
+    patch.dynamics = DynamicLevelLayers { { 0, { { 0, dynamicLevelFromType(DynamicType::mf) },
+                                                   { windowFrom, dynamicLevelFromType(DynamicType::ff) } } } };
+
+    // [WHEN] The patch is sent to the sequencer
+    data.mainStreamPatches.send(patch);
+
+    // [WHEN] Another sequencer is loaded with the whole changed score
+    mpe::PlaybackData changedData = data;
+    applyWindow(changedData.originEvents, window);
+    changedData.dynamics = patch.dynamics.value();
+
+    FluidSequencer reloadedSequencer;
+    reloadedSequencer.init(changedData.setupData, std::nullopt, true);
+    reloadedSequencer.load(changedData);
+    reloadedSequencer.setActive(true);
+
+    // [THEN] Both sequencers have the same data and produce the same MIDI events
+    EXPECT_TRUE(patchedSequencer.playbackData() == reloadedSequencer.playbackData());
+    EXPECT_TRUE(allMainStreamEvents(patchedSequencer) == allMainStreamEvents(reloadedSequencer));
+}
+
+/**
+ * @brief Audio_FluidSequencerTests_MovePlaybackForward_NoAllocations
+ * @details The events of each audio block are written into a preallocated buffer,
+ *          so playing the whole score back must not allocate on the audio thread
+ */
+TEST_F(Audio_FluidSequencerTests, MovePlaybackForward_NoAllocations)
+{
+    // [GIVEN] A score with some pedals and dynamics changes
+    mpe::PlaybackData data;
+    data.setupData = PlaybackSetupData(SoundId::Piano, SoundCategory::Keyboards);
+    data.originEvents = scoreEvents(200);
+
+    for (timestamp_t timestamp = 0; timestamp < 200 * NOTE_STEP; timestamp += 8 * NOTE_STEP) {
+        data.dynamics[0][timestamp] = timestamp % (16 * NOTE_STEP) ? dynamicLevelFromType(DynamicType::p)
+                                      : dynamicLevelFromType(DynamicType::f);
+    }
+
+    FluidSequencer sequencer;
+    sequencer.init(data.setupData, std::nullopt, true);
+    sequencer.load(data);
+    sequencer.setActive(true);
+
+    FluidSequencer::EventBuffer buffer;
+    buffer.reserve();
+
+    // [WHEN] The whole score is played back block by block (512 samples at 44.1 kHz)
+    constexpr msecs_t BLOCK_DURATION = 11610;
+    constexpr int BLOCKS_COUNT = 210 * NOTE_STEP / BLOCK_DURATION;
+
+    size_t eventsCount = 0;
+
+    startCountingAllocations();
+
+    for (int i = 0; i < BLOCKS_COUNT; ++i) {
+        sequencer.movePlaybackForward(BLOCK_DURATION, buffer);
+
+        for (size_t j = 0; j < buffer.sequencesCount(); ++j) {
+            const FluidSequencer::EventBuffer::Sequence& sequence = buffer.sequence(j);
+            eventsCount += sequence.eventsEnd - sequence.eventsBegin;
+        }
+    }
+
+    const size_t allocationsCount = stopCountingAllocations();
+
+    // [THEN] All the events have been dispatched without any allocation
+    EXPECT_GT(eventsCount, 400);
+    EXPECT_EQ(allocationsCount, 0);
+}
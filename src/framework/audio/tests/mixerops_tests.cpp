@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "audio/internal/dsp/mixerops.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+class Audio_MixerOpsTests : public ::testing::Test
+{
+public:
+    std::vector<float> randomSamples(size_t count)
+    {
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+        std::vector<float> result(count);
+        for (float& sample : result) {
+            sample = dist(m_random);
+        }
+
+        return result;
+    }
+
+private:
+    std::mt19937 m_random { 42 };
+};
+
+TEST_F(Audio_MixerOpsTests, SimdMatchesScalar)
+{
+    const dsp::MixerOps& scalar = dsp::scalarMixerOps();
+    const dsp::MixerOps& simd = dsp::simdMixerOps();
+
+    for (audioch_t channels : { 1, 2, 3, 4 }) {
+        // odd sizes to check the tails
+        for (samples_t samplesPerChannel : { 0, 1, 7, 128, 131 }) {
+            const size_t count = samplesPerChannel * channels;
+
+            std::vector<float> src = randomSamples(count);
+            std::vector<float> dst1 = randomSamples(count);
+            std::vector<float> dst2 = dst1;
+
+            // [WHEN] Summing a buffer into another one
+            scalar.accumulate(src.data(), dst1.data(), count);
+            simd.accumulate(src.data(), dst2.data(), count);
+
+            // [THEN] The results are identical
+            EXPECT_EQ(dst1, dst2);
+
+            // [WHEN] Summing a scaled buffer into another one
+            scalar.accumulateScaled(src.data(), 0.3f, dst1.data(), count);
+            simd.accumulateScaled(src.data(), 0.3f, dst2.data(), count);
+
+            // [THEN] The results are identical
+            EXPECT_EQ(dst1, dst2);
+
+            // [WHEN] Applying per channel gains
+            const float gains[] = { 0.5f, 0.7f, 1.1f, 0.2f };
+            float squaredSums1[4] = {};
+            float squaredSums2[4] = {};
+            scalar.applyGains(dst1.data(), gains, channels, samplesPerChannel, squaredSums1);
+            simd.applyGains(dst2.data(), gains, channels, samplesPerChannel, squaredSums2);
+
+            // [THEN] The samples are identical, the sums only differ by the summation order
+            EXPECT_EQ(dst1, dst2);
+            for (audioch_t ch = 0; ch < channels; ++ch) {
+                EXPECT_NEAR(squaredSums1[ch], squaredSums2[ch], 1e-4f * std::max(1.f, squaredSums1[ch]));
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "allocationcounter.h"
+
+#include <cstdlib>
+#include <new>
+
+static thread_local bool s_countAllocations = false;
+static thread_local size_t s_allocationsCount = 0;
+
+void* operator new(std::size_t size)
+{
+    if (s_countAllocations) {
+        ++s_allocationsCount;
+    }
+
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void muse::audio::tests::startCountingAllocations()
+{
+    s_allocationsCount = 0;
+    s_countAllocations = true;
+}
+
+size_t muse::audio::tests::stopCountingAllocations()
+{
+    s_countAllocations = false;
+    return s_allocationsCount;
+}
@@ -0,0 +1,34 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_ALLOCATIONCOUNTER_H
+#define MUSE_AUDIO_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+namespace muse::audio::tests {
+//! NOTE Counts the allocations made by the current thread between start and stop.
+//! It replaces the global operator new, so it's only linked into the executable of the tests using it
+void startCountingAllocations();
+size_t stopCountingAllocations();
+}
+
+#endif // MUSE_AUDIO_ALLOCATIONCOUNTER_H
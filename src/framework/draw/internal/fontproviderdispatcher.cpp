@@ -43,31 +43,37 @@ int FontProviderDispatcher::addSymbolFont(const muse::String& family, const io::
 
 double FontProviderDispatcher::lineSpacing(const muse::draw::Font& f) const
 {
+    std::lock_guard lock(m_mainFProviderMutex);
     return m_mainFProvider->lineSpacing(f);
 }
 
 double FontProviderDispatcher::xHeight(const muse::draw::Font& f) const
 {
+    std::lock_guard lock(m_mainFProviderMutex);
     return m_mainFProvider->xHeight(f);
 }
 
 double FontProviderDispatcher::height(const muse::draw::Font& f) const
 {
+    std::lock_guard lock(m_mainFProviderMutex);
     return m_mainFProvider->height(f);
 }
 
 double FontProviderDispatcher::ascent(const muse::draw::Font& f) const
 {
+    std::lock_guard lock(m_mainFProviderMutex);
     return m_mainFProvider->ascent(f);
 }
 
 double FontProviderDispatcher::capHeight(const muse::draw::Font& f) const
 {
+    std::lock_guard lock(m_mainFProviderMutex);
     return m_mainFProvider->capHeight(f);
 }
 
 double FontProviderDispatcher::descent(const muse::draw::Font& f) const
 {
+    std::lock_guard lock(m_mainFProviderMutex);
     return m_mainFProvider->descent(f);
 }
 
@@ -78,6 +84,7 @@ bool FontProviderDispatcher::inFont(const muse::draw::Font& f, muse::Char ch) co
 
 bool FontProviderDispatcher::inFontUcs4(const muse::draw::Font& f, char32_t ucs4) const
 {
+    std::lock_guard lock(m_mainFProviderMutex);
     bool ret = m_mainFProvider->inFontUcs4(f, ucs4);
     return ret;
 }
@@ -118,10 +125,12 @@ RectF FontProviderDispatcher::tightBoundingRect(const muse::draw::Font& f, const
 // Score symbols
 RectF FontProviderDispatcher::symBBox(const muse::draw::Font& f, char32_t ucs4, double dpi_f) const
 {
+    std::lock_guard lock(m_mainFProviderMutex);
     return m_mainFProvider->symBBox(f, ucs4, dpi_f);
 }
 
 double FontProviderDispatcher::symAdvance(const muse::draw::Font& f, char32_t ucs4, double dpi_f) const
 {
+    std::lock_guard lock(m_mainFProviderMutex);
     return m_mainFProvider->symAdvance(f, ucs4, dpi_f);
 }
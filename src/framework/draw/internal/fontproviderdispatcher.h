@@ -22,6 +22,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include "../ifontprovider.h"
 
@@ -60,6 +61,11 @@ public:
 
 private:
     std::shared_ptr<FontProvider> m_mainFProvider;
+
+    //! NOTE: FontProvider lazily loads and caches the font faces, while the metrics
+    //! may be requested from several threads (e.g. when the pages are painted concurrently).
+    //! QFontProvider doesn't need it, QFontMetricsF is thread-safe
+    mutable std::mutex m_mainFProviderMutex;
     std::shared_ptr<QFontProvider> m_qtFProvider;
 };
 }
@@ -21,6 +21,8 @@
  */
 #include "qpainterprovider.h"
 
+#include <QGuiApplication>
+#include <QImage>
 #include <QPainter>
 #include <QRawFont>
 #include <QTextLayout>
@@ -29,6 +31,7 @@
 #include <QPixmapCache>
 #include <QStaticText>
 #include <QPainterPath>
+#include <QThread>
 
 #include "draw/utils/drawlogger.h"
 #include "types/transform.h"
@@ -305,7 +308,8 @@ void QPainterProvider::drawTextWorkaround(const Font& f, const PointF& pos, cons
 
 void QPainterProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
 {
-    static QHash<char32_t, QString> cache;
+    //! NOTE Per thread, pages may be painted concurrently
+    thread_local QHash<char32_t, QString> cache;
     if (!cache.contains(ucs4Code)) {
         cache[ucs4Code] = QString::fromUcs4(&ucs4Code, 1);
     }
@@ -315,6 +319,13 @@ void QPainterProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
 
 void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
 {
+    //! NOTE QPixmap and QPixmapCache are only usable on the GUI thread,
+    //! the pages painted on other threads (e.g. exported concurrently) draw the image as is
+    if (QThread::currentThread() != qApp->thread()) {
+        m_painter->drawImage(QPointF(point.x(), point.y()), QImage::fromData(pm.data().toQByteArrayNoCopy()));
+        return;
+    }
+
     QString key = QString::number(pm.key());
     QPixmap pixmap;
     if (!QPixmapCache::find(key, &pixmap)) {
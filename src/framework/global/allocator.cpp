@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <new>
 #include <set>
 #include <sstream>
 
@@ -32,14 +33,156 @@
 
 using namespace muse;
 
-int ObjectAllocator::s_used = 0;
+std::atomic<int> ObjectAllocator::s_used = 0;
+std::atomic<ObjectAllocator::Policy> ObjectAllocator::s_policy = ObjectAllocator::Policy::ThreadCache;
 size_t ObjectAllocator::DEFAULT_BLOCK_SIZE(1024 * 256); // 256 kB
 
+static constexpr size_t BATCH_BYTES = 1024 * 16; // 16 kB
+static constexpr size_t MAX_BATCH_SIZE = 64;
+
+static std::atomic<size_t> s_allocatorsCount = 0;
+static std::atomic<uint64_t> s_arenasCount = 0;
+static thread_local ObjectArena* s_currentArena = nullptr;
+static thread_local bool s_threadCachesDestroyed = false;
+
+//! NOTE Guards the owners of the thread caches, so that a thread that exits after
+//! the allocators are destroyed (at static teardown) doesn't touch them.
+//! Leaked on purpose: it must outlive all the allocators and the threads
+static std::mutex& cacheOwnersMutex()
+{
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+}
+
 static inline size_t align(size_t n)
 {
     return (n + sizeof(intptr_t) - 1) & ~(sizeof(intptr_t) - 1);
 }
 
+template<typename T>
+static inline void increment(std::atomic<T>& counter, T n = 1)
+{
+    // only the owner thread writes, others just read the value
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// ============================================
+// Internal structures
+// ============================================
+
+/**
+ * A block is a header followed by `chunkCount` slots.
+ * Each slot starts with the pointer to its block, so that a chunk
+ * can be given back to its block (and pool) from any thread:
+ *
+ * | Block | Block* | chunk | Block* | chunk | ... |
+ */
+struct ObjectAllocator::Block {
+    Pool* pool = nullptr;
+    size_t chunkSize = 0;
+    size_t chunkCount = 0;
+
+    // guarded by the pool mutex
+    size_t usedCount = 0; // including the chunks held by thread caches
+    Chunk* free = nullptr;
+    Block* nextAvailable = nullptr;
+    bool available = false;
+
+    static constexpr size_t SLOT_HEADER_SIZE = sizeof(Block*);
+
+    static Block* of(const Chunk* chunk)
+    {
+        return *reinterpret_cast<Block* const*>(reinterpret_cast<const uint8_t*>(chunk) - SLOT_HEADER_SIZE);
+    }
+
+    static size_t headerSize()
+    {
+        return align(sizeof(Block));
+    }
+
+    Chunk* chunk(size_t i)
+    {
+        uint8_t* slot = reinterpret_cast<uint8_t*>(this) + headerSize() + i * (SLOT_HEADER_SIZE + chunkSize);
+        return reinterpret_cast<Chunk*>(slot + SLOT_HEADER_SIZE);
+    }
+
+    void reset()
+    {
+        free = nullptr;
+        for (size_t i = chunkCount; i > 0; --i) {
+            Chunk* c = chunk(i - 1);
+            c->next = free;
+            free = c;
+        }
+        usedCount = 0;
+    }
+};
+
+struct ObjectAllocator::Pool {
+    uint64_t arenaId = 0;
+    std::atomic<bool> released = false;
+
+    std::mutex mutex;
+    std::vector<Block*> blocks;
+    Block* available = nullptr; // list of the blocks with free chunks
+
+    void makeAvailable(Block* b)
+    {
+        if (!b->available) {
+            b->nextAvailable = available;
+            b->available = true;
+            available = b;
+        }
+    }
+
+    void rebuildAvailable()
+    {
+        available = nullptr;
+        for (Block* b : blocks) {
+            b->available = false;
+            if (b->free) {
+                makeAvailable(b);
+            }
+        }
+    }
+};
+
+struct ObjectAllocator::ThreadCache {
+    ObjectAllocator* owner = nullptr; // reset when the allocator is destroyed, guarded by cacheOwnersMutex()
+    uint64_t arenaId = 0;
+    Pool* pool = nullptr; // all cached chunks belong to this pool
+    Chunk* free = nullptr;
+    std::atomic<size_t> count = 0;
+
+    std::atomic<uint64_t> totalAllocatedCount = 0;
+    std::atomic<uint64_t> totalFreeCount = 0;
+};
+
+struct ObjectAllocator::ThreadCaches {
+    std::vector<ThreadCache*> caches; // by allocator index
+
+    ~ThreadCaches()
+    {
+        // objects deleted later on this thread (e.g. by static destructors) go to the pools directly
+        s_threadCachesDestroyed = true;
+
+        std::lock_guard lock(cacheOwnersMutex());
+
+        for (ThreadCache* cache : caches) {
+            if (!cache) {
+                continue;
+            }
+
+            if (cache->owner) {
+                cache->owner->retireCache(cache);
+            } else {
+                // the allocator is already destroyed, its memory is not given back anyway
+                delete cache;
+            }
+        }
+    }
+};
+
 // ============================================
 // ObjectAllocator
 // ============================================
@@ -57,15 +200,35 @@ void ObjectAllocator::unused()
 #endif
 }
 
+ObjectAllocator::Policy ObjectAllocator::policy()
+{
+    return s_policy;
+}
+
+void ObjectAllocator::setPolicy(Policy policy)
+{
+    s_policy = policy;
+}
+
 ObjectAllocator::ObjectAllocator(const char* module, const char* name, destroyer_t dtor)
-    : m_module(module), m_name(name), m_dtor(dtor)
+    : m_module(module), m_name(name), m_index(s_allocatorsCount++), m_dtor(dtor)
 {
+    m_defaultPool = createPool(nullptr);
+
     AllocatorsRegister::instance()->reg(this);
 }
 
 ObjectAllocator::~ObjectAllocator()
 {
     AllocatorsRegister::instance()->unreg(this);
+
+    // The threads that are still alive will just drop their caches on exit
+    std::lock_guard ownersLock(cacheOwnersMutex());
+    std::lock_guard lock(m_mutex);
+    for (ThreadCache* cache : m_caches) {
+        cache->owner = nullptr;
+    }
+    m_caches.clear();
 }
 
 const char* ObjectAllocator::module() const
@@ -78,113 +241,403 @@ const char* ObjectAllocator::name() const
     return m_name;
 }
 
+size_t ObjectAllocator::batchSize() const
+{
+    return std::clamp(BATCH_BYTES / m_chunkSize, size_t(1), MAX_BATCH_SIZE);
+}
+
 void* ObjectAllocator::alloc(size_t size)
 {
     size = align(size);
 
-    if (!m_chunkSize) {
-        m_chunkSize = size;
+    size_t chunkSize = 0;
+    if (!m_chunkSize.compare_exchange_strong(chunkSize, size)) {
+        assert(chunkSize == size);
     }
 
-    assert(m_chunkSize == size);
+    ObjectArena* arena = s_currentArena;
 
-    if (!m_free) {
-        Block b = allocateBlock(m_chunkSize);
-        m_blocks.push_back(b);
-        m_free = b.begin;
+    ThreadCache* cache = s_policy == Policy::ThreadCache ? threadCache() : nullptr;
+    if (!cache) {
+        return allocShared(poolOf(arena));
     }
 
-    // The return value is the current position of
-    // the allocation pointer:
-    Chunk* freeChunk = m_free;
+    if (!cache->pool || cache->arenaId != (arena ? arena->id() : 0)) {
+        switchCache(cache, arena);
+    }
 
-    // Advance (bump) the allocation pointer to the next chunk.
-    //
-    // When no chunks left, the `m_free` will be set to `nullptr`, and
-    // this will cause allocation of a new block on the next request:
-    m_free = m_free->next;
+    if (!cache->free) {
+        refill(cache);
+    }
 
-    m_statistic.totalAllocatedCount++;
+    // The return value is the head of the thread cache
+    Chunk* freeChunk = cache->free;
+    cache->free = freeChunk->next;
+    increment(cache->count, size_t(-1));
+    increment(cache->totalAllocatedCount);
 
     return freeChunk;
 }
 
-void ObjectAllocator::free(void* chunk)
+void ObjectAllocator::free(void* ptr)
 {
-    // The freed chunk's next pointer points to the
-    // current allocation pointer:
-    reinterpret_cast<Chunk*>(chunk)->next = m_free;
+    Chunk* chunk = reinterpret_cast<Chunk*>(ptr);
 
-    // And the allocation pointer is now set
-    // to the returned (free) chunk:
-    m_free = reinterpret_cast<Chunk*>(chunk);
+    ThreadCache* cache = s_policy == Policy::ThreadCache ? threadCache() : nullptr;
+    if (!cache) {
+        freeShared(chunk);
+        return;
+    }
 
-    m_statistic.totalFreeCount++;
+    Pool* pool = Block::of(chunk)->pool;
+
+    // The chunk may have been allocated by another thread or in another arena;
+    // an empty cache just adopts its pool
+    if (pool != cache->pool) {
+        if (cache->free || pool->released) {
+            freeShared(chunk);
+            return;
+        }
+
+        cache->pool = pool;
+        cache->arenaId = pool->arenaId;
+    }
+
+    chunk->next = cache->free;
+    cache->free = chunk;
+    increment(cache->count);
+    increment(cache->totalFreeCount);
+
+    // Give the surplus back, so that other threads can reuse it
+    const size_t batch = batchSize();
+    if (cache->count > 2 * batch) {
+        if (flush(cache, batch)) {
+            cache->pool = nullptr;
+            destroyPool(pool);
+        }
+    }
 }
 
-void ObjectAllocator::cleanup()
+ObjectAllocator::ThreadCache* ObjectAllocator::threadCache()
 {
-    if (m_blocks.empty()) {
-        return;
+    static thread_local ThreadCaches threadCaches;
+
+    if (s_threadCachesDestroyed) {
+        return nullptr;
+    }
+
+    std::vector<ThreadCache*>& caches = threadCaches.caches;
+    if (caches.size() <= m_index) {
+        caches.resize(m_index + 1);
+    }
+
+    ThreadCache*& cache = caches[m_index];
+    if (!cache) {
+        cache = new ThreadCache();
+        cache->owner = this;
+
+        std::lock_guard lock(m_mutex);
+        m_caches.push_back(cache);
+    }
+
+    return cache;
+}
+
+void ObjectAllocator::retireCache(ThreadCache* cache)
+{
+    Pool* pool = cache->pool;
+    if (flush(cache, cache->count)) {
+        destroyPool(pool);
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_caches.erase(std::remove(m_caches.begin(), m_caches.end(), cache), m_caches.end());
+    m_statistic.totalAllocatedCount += cache->totalAllocatedCount;
+    m_statistic.totalFreeCount += cache->totalFreeCount;
+    delete cache;
+}
+
+ObjectAllocator::Pool* ObjectAllocator::switchCache(ThreadCache* cache, ObjectArena* arena)
+{
+    Pool* pool = cache->pool;
+    if (flush(cache, cache->count)) {
+        destroyPool(pool);
+    }
+
+    cache->pool = poolOf(arena);
+    cache->arenaId = arena ? arena->id() : 0;
+
+    return cache->pool;
+}
+
+void ObjectAllocator::refill(ThreadCache* cache)
+{
+    Pool* pool = cache->pool;
+    const size_t batch = batchSize();
+
+    std::lock_guard lock(pool->mutex);
+
+    if (!pool->available) {
+        Block* b = allocateBlock(pool);
+        pool->blocks.push_back(b);
+        pool->makeAvailable(b);
+    }
+
+    // Take a batch of chunks from a single block
+    Block* b = pool->available;
+    size_t count = 0;
+    while (b->free && count < batch) {
+        Chunk* c = b->free;
+        b->free = c->next;
+        c->next = cache->free;
+        cache->free = c;
+        ++count;
+    }
+
+    b->usedCount += count;
+    increment(cache->count, count);
+
+    if (!b->free) {
+        pool->available = b->nextAvailable;
+        b->nextAvailable = nullptr;
+        b->available = false;
+    }
+}
+
+bool ObjectAllocator::flush(ThreadCache* cache, size_t count)
+{
+    if (!cache->free) {
+        return false;
+    }
+
+    Pool* pool = cache->pool;
+    bool hasEmptyBlocks = false;
+    size_t flushed = 0;
+
+    std::lock_guard lock(pool->mutex);
+
+    while (cache->free && flushed < count) {
+        Chunk* c = cache->free;
+        cache->free = c->next;
+        hasEmptyBlocks |= giveBack(pool, c);
+        ++flushed;
+    }
+
+    increment(cache->count, size_t(0) - flushed);
+
+    return hasEmptyBlocks && freeEmptyBlocks(pool);
+}
+
+void* ObjectAllocator::allocShared(Pool* pool)
+{
+    std::lock_guard lock(pool->mutex);
+
+    if (!pool->available) {
+        Block* b = allocateBlock(pool);
+        pool->blocks.push_back(b);
+        pool->makeAvailable(b);
+    }
+
+    Block* b = pool->available;
+    Chunk* freeChunk = b->free;
+    b->free = freeChunk->next;
+    b->usedCount++;
+
+    if (!b->free) {
+        pool->available = b->nextAvailable;
+        b->nextAvailable = nullptr;
+        b->available = false;
     }
 
-    std::set<Chunk*> freeChunks;
+    m_statistic.totalAllocatedCount++;
+
+    return freeChunk;
+}
+
+void ObjectAllocator::freeShared(Chunk* chunk)
+{
+    Pool* pool = Block::of(chunk)->pool;
+    bool dead = false;
     {
-        Chunk* free = m_free;
-        while (free) {
-            freeChunks.insert(free);
-            free = free->next;
+        std::lock_guard lock(pool->mutex);
+        dead = giveBack(pool, chunk) && freeEmptyBlocks(pool);
+    }
+
+    m_statistic.totalFreeCount++;
+
+    if (dead) {
+        destroyPool(pool);
+    }
+}
+
+bool ObjectAllocator::giveBack(Pool* pool, Chunk* chunk)
+{
+    Block* b = Block::of(chunk);
+    chunk->next = b->free;
+    b->free = chunk;
+    b->usedCount--;
+
+    pool->makeAvailable(b);
+
+    return b->usedCount == 0;
+}
+
+bool ObjectAllocator::freeEmptyBlocks(Pool* pool)
+{
+    if (!pool->released) {
+        return false;
+    }
+
+    auto isEmpty = [](Block* b) {
+        if (b->usedCount > 0) {
+            return false;
         }
+
+        b->~Block();
+        std::free(b);
+        return true;
+    };
+
+    const bool hadBlocks = !pool->blocks.empty();
+    pool->blocks.erase(std::remove_if(pool->blocks.begin(), pool->blocks.end(), isEmpty), pool->blocks.end());
+    pool->rebuildAvailable();
+
+    // Nobody can reach the pool anymore, the caller should destroy it
+    return hadBlocks && pool->blocks.empty();
+}
+
+ObjectAllocator::Pool* ObjectAllocator::createPool(const ObjectArena* arena)
+{
+    Pool* pool = new Pool();
+    pool->arenaId = arena ? arena->id() : 0;
+
+    std::lock_guard lock(m_mutex);
+    m_pools.push_back(pool);
+
+    return pool;
+}
+
+ObjectAllocator::Pool* ObjectAllocator::poolOf(ObjectArena* arena)
+{
+    return arena ? arena->pool(this) : m_defaultPool;
+}
+
+void ObjectAllocator::releasePool(Pool* pool)
+{
+    // The chunks cached by other threads get back on their next use of the allocator
+    ThreadCache* cache = threadCache();
+    if (cache && cache->pool == pool) {
+        flush(cache, cache->count);
+        cache->pool = nullptr;
     }
 
-    for (size_t bi = 0; bi < m_blocks.size(); ++bi) {
-        const Block& b = m_blocks.at(bi);
-        Chunk* chunk = b.begin;
-        for (size_t i = 0; i < b.chunkCount - 1; ++i) {
-            // if not free chunk, then destroy object
-            if (freeChunks.find(chunk) == freeChunks.cend()) {
-                m_dtor(reinterpret_cast<void*>(chunk));
-            }
+    bool dead = false;
+    {
+        std::lock_guard lock(pool->mutex);
+        pool->released = true;
+        dead = freeEmptyBlocks(pool) || pool->blocks.empty();
+    }
+
+    if (dead) {
+        destroyPool(pool);
+    }
+}
+
+void ObjectAllocator::destroyPool(Pool* pool)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_pools.erase(std::remove(m_pools.begin(), m_pools.end(), pool), m_pools.end());
+    }
+
+    delete pool;
+}
 
-            chunk->next = reinterpret_cast<Chunk*>(reinterpret_cast<uint8_t*>(chunk) + b.chunkSize);
-            chunk = chunk->next;
+void ObjectAllocator::cleanup()
+{
+    std::vector<Pool*> deadPools;
+
+    auto flushCaches = [this, &deadPools]() {
+        for (ThreadCache* cache : m_caches) {
+            Pool* pool = cache->pool;
+            if (flush(cache, cache->count)) {
+                deadPools.push_back(pool);
+            }
         }
+    };
 
-        if (freeChunks.find(chunk) == freeChunks.cend()) {
-            m_dtor(reinterpret_cast<void*>(chunk));
+    std::vector<Chunk*> aliveChunks;
+    {
+        std::lock_guard lock(m_mutex);
+
+        flushCaches();
+
+        for (Pool* pool : m_pools) {
+            std::lock_guard poolLock(pool->mutex);
+            for (Block* b : pool->blocks) {
+                std::set<Chunk*> freeChunks;
+                for (Chunk* free = b->free; free; free = free->next) {
+                    freeChunks.insert(free);
+                }
+
+                for (size_t i = 0; i < b->chunkCount; ++i) {
+                    Chunk* chunk = b->chunk(i);
+                    if (freeChunks.find(chunk) == freeChunks.cend()) {
+                        aliveChunks.push_back(chunk);
+                    }
+                }
+            }
         }
+    }
+
+    // The destructors may delete other objects, so they are called without the locks
+    for (Chunk* chunk : aliveChunks) {
+        m_dtor(reinterpret_cast<void*>(chunk));
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        flushCaches();
 
-        if (bi < (m_blocks.size() - 1)) {
-            chunk->next = m_blocks.at(bi + 1).begin;
-        } else {
-            chunk->next = nullptr;
+        for (Pool* pool : m_pools) {
+            std::lock_guard poolLock(pool->mutex);
+            for (Block* b : pool->blocks) {
+                b->reset();
+            }
+            pool->rebuildAvailable();
+
+            if (freeEmptyBlocks(pool)) {
+                deadPools.push_back(pool);
+            }
         }
     }
 
-    m_free = m_blocks.front().begin;
+    for (Pool* pool : deadPools) {
+        destroyPool(pool);
+    }
 }
 
-ObjectAllocator::Block ObjectAllocator::allocateBlock(size_t chunkSize) const
+ObjectAllocator::Block* ObjectAllocator::allocateBlock(Pool* pool) const
 {
+    const size_t chunkSize = m_chunkSize;
     size_t blockSize = std::max(DEFAULT_BLOCK_SIZE, chunkSize);
     size_t chunkCount = blockSize / chunkSize;
 
-    Block b;
-    b.begin = reinterpret_cast<Chunk*>(malloc(blockSize));
-    b.chunkCount = chunkCount;
-    b.chunkSize = chunkSize;
+    void* memory = malloc(Block::headerSize() + chunkCount * (Block::SLOT_HEADER_SIZE + chunkSize));
 
-    // Once the block is allocated, we need to chain all
-    // the chunks in this block:
-
-    Chunk* chunk = b.begin;
+    Block* b = new (memory) Block();
+    b->pool = pool;
+    b->chunkSize = chunkSize;
+    b->chunkCount = chunkCount;
 
-    for (size_t i = 0; i < chunkCount - 1; ++i) {
-        chunk->next = reinterpret_cast<Chunk*>(reinterpret_cast<uint8_t*>(chunk) + chunkSize);
-        chunk = chunk->next;
+    // Once the block is allocated, we need to chain all
+    // the chunks in this block, and point the slots to the block:
+    for (size_t i = 0; i < chunkCount; ++i) {
+        *(reinterpret_cast<Block**>(b->chunk(i)) - 1) = b;
     }
 
-    chunk->next = nullptr;
+    b->reset();
 
     return b;
 }
@@ -198,42 +651,124 @@ void* ObjectAllocator::not_supported(const char* info)
 
 ObjectAllocator::Info ObjectAllocator::stateInfo() const
 {
+    std::lock_guard lock(m_mutex);
+
     Info info;
     info.module = m_module;
     info.name = m_name;
     info.chunkSize = m_chunkSize;
-    info.blockCount = m_blocks.size();
     info.totalAllocatedCount = m_statistic.totalAllocatedCount;
     info.totalFreeCount = m_statistic.totalFreeCount;
 
-    for (const Block& b : m_blocks) {
-        info.totalChunks += b.chunkCount;
+    for (const ThreadCache* cache : m_caches) {
+        info.cachedChunks += cache->count.load(std::memory_order_relaxed);
+        info.totalAllocatedCount += cache->totalAllocatedCount.load(std::memory_order_relaxed);
+        info.totalFreeCount += cache->totalFreeCount.load(std::memory_order_relaxed);
     }
 
-    Chunk* free = m_free;
-    while (free) {
-        ++info.freeChunks;
-        free = free->next;
+    size_t usedChunks = 0;
+    for (Pool* pool : m_pools) {
+        std::lock_guard poolLock(pool->mutex);
+        info.blockCount += pool->blocks.size();
+        for (const Block* b : pool->blocks) {
+            info.totalChunks += b->chunkCount;
+            usedChunks += b->usedCount;
+        }
     }
 
+    // chunks held by thread caches are free
+    usedChunks -= std::min(usedChunks, info.cachedChunks);
+    info.freeChunks = info.totalChunks - usedChunks;
+
     return info;
 }
 
+// ============================================
+// ObjectArena
+// ============================================
+ObjectArena::ObjectArena(const std::string& name)
+    : m_name(name), m_id(++s_arenasCount)
+{
+}
+
+ObjectArena::~ObjectArena()
+{
+    release();
+}
+
+const std::string& ObjectArena::name() const
+{
+    return m_name;
+}
+
+uint64_t ObjectArena::id() const
+{
+    return m_id;
+}
+
+void ObjectArena::release()
+{
+    std::vector<std::pair<ObjectAllocator*, ObjectAllocator::Pool*> > pools;
+    {
+        std::lock_guard lock(m_mutex);
+        pools.swap(m_pools);
+    }
+
+    for (auto& [allocator, pool] : pools) {
+        allocator->releasePool(pool);
+    }
+}
+
+ObjectArena* ObjectArena::current()
+{
+    return s_currentArena;
+}
+
+ObjectAllocator::Pool* ObjectArena::pool(ObjectAllocator* allocator)
+{
+    std::lock_guard lock(m_mutex);
+
+    for (const auto& [a, pool] : m_pools) {
+        if (a == allocator) {
+            return pool;
+        }
+    }
+
+    ObjectAllocator::Pool* pool = allocator->createPool(this);
+    m_pools.emplace_back(allocator, pool);
+
+    return pool;
+}
+
+ObjectArena::Scope::Scope(ObjectArena* arena)
+    : m_prev(s_currentArena)
+{
+    s_currentArena = arena;
+}
+
+ObjectArena::Scope::~Scope()
+{
+    s_currentArena = m_prev;
+}
+
 // ============================================
 // AllocatorsRegister
 // ============================================
 void AllocatorsRegister::reg(ObjectAllocator* a)
 {
+    std::lock_guard lock(m_mutex);
     m_allocators.push_back(a);
 }
 
 void AllocatorsRegister::unreg(ObjectAllocator* a)
 {
+    std::lock_guard lock(m_mutex);
     m_allocators.remove(a);
 }
 
 void AllocatorsRegister::cleanupAll(const std::string& module)
 {
+    std::lock_guard lock(m_mutex);
     for (ObjectAllocator* a : m_allocators) {
         if (a->module() == module) {
             a->cleanup();
@@ -247,6 +782,8 @@ void AllocatorsRegister::cleanupAll(const std::string& module)
 
 void AllocatorsRegister::printStatistic(const std::string& title)
 {
+    std::lock_guard lock(m_mutex);
+
     std::stringstream stream;
     stream << "\n\n";
     stream << title << "\n";
@@ -281,12 +818,14 @@ void AllocatorsRegister::printStatistic(const std::string& title)
 
 void AllocatorsRegister::printState(const std::string& title)
 {
+    std::lock_guard lock(m_mutex);
+
     std::stringstream stream;
     stream << "\n\n";
     stream << title << "\n";
     stream << "allocators: " << m_allocators.size() << '\n';
     stream << TITLE("Object") << TITLE("blockCount") << TITLE("totalChunks") << TITLE("freeChunks") << TITLE("chunkSize")
-           << TITLE("allocatedBytes") << "\n";
+           << TITLE("cachedChunks") << TITLE("allocatedBytes") << "\n";
 
     uint64_t totalBytes = 0;
     for (ObjectAllocator* a : m_allocators) {
@@ -296,6 +835,7 @@ void AllocatorsRegister::printState(const std::string& title)
                << VALUE(info.totalChunks)
                << VALUE(info.freeChunks)
                << VALUE(info.chunkSize)
+               << VALUE(info.cachedChunks)
                << VALUE(info.allocatedBytes())
                << "\n";
 
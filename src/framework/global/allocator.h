@@ -22,9 +22,11 @@
 #ifndef MUSE_GLOBAL_ALLOCATOR_H
 #define MUSE_GLOBAL_ALLOCATOR_H
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <list>
+#include <mutex>
 #include <string>
 
 namespace muse {
@@ -59,6 +61,17 @@ public: \
     } \
 private:
 
+class ObjectArena;
+
+//! NOTE: Fixed-size chunk allocator, one per class (see OBJECT_ALLOCATOR)
+//!
+//! Chunks are carved out of blocks. Every thread keeps a small cache of free chunks per allocator,
+//! so most allocations and deallocations don't take any lock; a chunk may be freed on any thread,
+//! it just goes to the cache of that thread. Caches are refilled from (and flushed to) a pool
+//! of blocks in batches, under the lock of the pool.
+//!
+//! Blocks are grouped by arena (see ObjectArena), objects created outside of any arena
+//! go to the default pool of the allocator.
 class ObjectAllocator
 {
 public:
@@ -70,11 +83,22 @@ public:
 
     static size_t DEFAULT_BLOCK_SIZE;
 
+    enum class Policy {
+        ThreadCache,    // per thread caches of free chunks (default)
+        Shared          // every alloc/free goes to the pool, under its lock
+    };
+
+    static Policy policy();
+    static void setPolicy(Policy policy);
+
     const char* module() const;
     const char* name() const;
 
     void* alloc(size_t size);
     void free(void* ptr);
+
+    //! NOTE Destroys all objects that are still alive.
+    //! Must not be called while other threads use the allocator
     void cleanup();
 
     template<class T>
@@ -94,6 +118,7 @@ public:
         size_t blockCount = 0;
         size_t totalChunks = 0;
         size_t freeChunks = 0;
+        size_t cachedChunks = 0; // free, but held by thread caches
 
         uint64_t totalAllocatedCount = 0;
         uint64_t totalFreeCount = 0;
@@ -108,8 +133,9 @@ public:
     static void used();
     static void unused();
 
-    static int s_used;
+    static std::atomic<int> s_used;
 private:
+    friend class ObjectArena;
 
     struct Chunk {
         /**
@@ -122,28 +148,100 @@ private:
         Chunk* next = nullptr;
     };
 
-    struct Block {
-        Chunk* begin = nullptr;
-        size_t chunkCount = 0;
-        size_t chunkSize = 0;
-    };
+    struct Block;
+    struct Pool;
+    struct ThreadCache;
+    struct ThreadCaches;
+
+    Pool* createPool(const ObjectArena* arena);
+    Pool* poolOf(ObjectArena* arena);
+    void releasePool(Pool* pool);
+    void destroyPool(Pool* pool);
+
+    ThreadCache* threadCache();
+    void retireCache(ThreadCache* cache);
+    Pool* switchCache(ThreadCache* cache, ObjectArena* arena);
 
-    Block allocateBlock(size_t chunkSize) const;
+    void refill(ThreadCache* cache);
+    bool flush(ThreadCache* cache, size_t count);
+    void* allocShared(Pool* pool);
+    void freeShared(Chunk* chunk);
+
+    bool giveBack(Pool* pool, Chunk* chunk);
+    bool freeEmptyBlocks(Pool* pool);
+
+    Block* allocateBlock(Pool* pool) const;
+    size_t batchSize() const;
 
     const char* m_module = nullptr;
     const char* m_name = nullptr;
-    size_t m_chunkSize = 0;
+    const size_t m_index = 0;
+    std::atomic<size_t> m_chunkSize { 0 };
     destroyer_t m_dtor = nullptr;
-    Chunk* m_free = nullptr;
-    std::vector<Block> m_blocks;
+
+    //! NOTE Guards the lists of pools and caches, taken before the lock of a pool
+    mutable std::mutex m_mutex;
+    Pool* m_defaultPool = nullptr;
+    std::vector<Pool*> m_pools;
+    std::vector<ThreadCache*> m_caches;
 
     struct Statistic
     {
-        uint64_t totalAllocatedCount = 0;
-        uint64_t totalFreeCount = 0;
+        std::atomic<uint64_t> totalAllocatedCount { 0 };
+        std::atomic<uint64_t> totalFreeCount { 0 };
     };
 
+    // shared policy and retired caches
     Statistic m_statistic;
+
+    static std::atomic<Policy> s_policy;
+};
+
+//! NOTE Groups the blocks of the objects created by one owner (e.g. an engraving project),
+//! so that the memory can be given back in bulk once the owner is gone.
+//!
+//! Objects are created in the arena that is current for the calling thread (see Scope).
+//! On release, the blocks without alive objects are freed right away; a block that still has
+//! objects (leaks, or objects that outlived the owner) is freed as soon as its last object is deleted.
+class ObjectArena
+{
+public:
+    explicit ObjectArena(const std::string& name);
+    ~ObjectArena();
+
+    ObjectArena(const ObjectArena&) = delete;
+    ObjectArena& operator=(const ObjectArena&) = delete;
+
+    const std::string& name() const;
+    uint64_t id() const;
+
+    void release();
+
+    static ObjectArena* current();
+
+    class Scope
+    {
+    public:
+        explicit Scope(ObjectArena* arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ObjectArena* m_prev = nullptr;
+    };
+
+private:
+    friend class ObjectAllocator;
+
+    ObjectAllocator::Pool* pool(ObjectAllocator* allocator);
+
+    const std::string m_name;
+    const uint64_t m_id = 0;
+
+    std::mutex m_mutex;
+    std::vector<std::pair<ObjectAllocator*, ObjectAllocator::Pool*> > m_pools;
 };
 
 class AllocatorsRegister
@@ -165,6 +263,7 @@ public:
     void printState(const std::string& title);
 
 private:
+    std::mutex m_mutex;
     std::list<ObjectAllocator*> m_allocators;
 };
 }
@@ -34,6 +34,16 @@ inline void onMainThreadInvoke(const std::function<void(const std::function<void
 {
     kors::async::onMainThreadInvoke(f);
 }
+
+inline void onEventsQueued(const std::function<void()>& f)
+{
+    kors::async::onEventsQueued(f);
+}
+
+inline void useLockFreeQueue(size_t capacity, const std::function<void()>& onEventsQueued = nullptr)
+{
+    kors::async::useLockFreeQueue(capacity, onEventsQueued);
+}
 }
 
 #endif // MUSE_ASYNC_PROCESSEVENTS_H
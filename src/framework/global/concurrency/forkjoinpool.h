@@ -0,0 +1,252 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_GLOBAL_FORKJOINPOOL_H
+#define MUSE_GLOBAL_FORKJOINPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define MUSE_CPU_RELAX() _mm_pause()
+#else
+#define MUSE_CPU_RELAX() std::this_thread::yield()
+#endif
+
+#include "threadutils.h"
+#include "log.h"
+
+namespace muse {
+//! NOTE: A fork/join pool for real-time work, e.g. the audio mixer.
+//! Unlike TaskScheduler, dispatching a job doesn't allocate and doesn't take any lock:
+//! the job is published through atomics, the calling thread participates in the work
+//! and then spins until the workers finish.
+//! Idle workers spin for IDLE_SPIN_DURATION, then park on a condition variable;
+//! the dispatcher only takes the mutex to wake them up if some of them are parked,
+//! which only happens after an idle period.
+//! parallelFor must only be called from a single thread at a time.
+class ForkJoinPool
+{
+public:
+    explicit ForkJoinPool(size_t desiredThreadCount = 0)
+        : m_threadPoolSize(validateThreadPoolCapacity(desiredThreadCount)),
+        m_threadPool(std::make_unique<std::thread[]>(m_threadPoolSize))
+    {
+        m_isActive = true;
+        for (size_t i = 0; i < m_threadPoolSize; ++i) {
+            m_threadPool[i] = std::thread(&ForkJoinPool::th_workerLoop, this);
+        }
+
+        LOGD() << "Thread pool size: " << m_threadPoolSize;
+    }
+
+    ~ForkJoinPool()
+    {
+        {
+            std::lock_guard lock(m_parkMutex);
+            m_isActive = false;
+        }
+        m_parkCv.notify_all();
+
+        for (size_t i = 0; i < m_threadPoolSize; ++i) {
+            m_threadPool[i].join();
+        }
+    }
+
+    size_t threadPoolSize() const
+    {
+        return m_threadPoolSize;
+    }
+
+    std::set<std::thread::id> threadIdSet() const
+    {
+        std::set<std::thread::id> result;
+
+        for (size_t i = 0; i < m_threadPoolSize; ++i) {
+            result.insert(m_threadPool[i].get_id());
+        }
+
+        return result;
+    }
+
+    bool setThreadsPriority(ThreadPriority priority)
+    {
+        for (size_t i = 0; i < m_threadPoolSize; ++i) {
+            if (!muse::setThreadPriority(m_threadPool[i], priority)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //! Calls func(idx) for each idx in [0, count) on the pool threads and the calling thread,
+    //! returns when all of the calls are complete
+    template<typename FuncT>
+    void parallelFor(size_t count, const FuncT& func)
+    {
+        if (count == 0) {
+            return;
+        }
+
+        // Make sure that no worker is still looking at the previous job
+        m_isPublishing.store(true);
+        while (m_busyWorkers.load() != 0) {
+            MUSE_CPU_RELAX();
+        }
+
+        m_task = [](const void* ctx, size_t idx) {
+            (*static_cast<const FuncT*>(ctx))(idx);
+        };
+        m_taskCtx = &func;
+        m_taskCount = count;
+        m_nextIdx.store(0);
+        m_doneCount.store(0);
+
+        m_generation.fetch_add(1);
+        m_isPublishing.store(false);
+
+        if (m_parkedWorkers.load() != 0) {
+            std::lock_guard lock(m_parkMutex);
+            m_parkCv.notify_all();
+        }
+
+        runTasks();
+
+        while (m_doneCount.load(std::memory_order_acquire) < count) {
+            MUSE_CPU_RELAX();
+        }
+    }
+
+private:
+    //! NOTE The audio worker processes the blocks it's missing one after another,
+    //! so the next job mostly comes within the processing time of a block, or not before the next callback.
+    //! The workers only spin for about that long: spinning until the next callback would keep
+    //! a core busy per worker, while parking only costs a wake-up once the playback gets idle
+    static constexpr std::chrono::microseconds IDLE_SPIN_DURATION { 200 };
+    static constexpr int SPINS_PER_CLOCK_CHECK = 64;
+
+    using Task = void (*)(const void* ctx, size_t idx);
+
+    size_t validateThreadPoolCapacity(const size_t desiredThreadCount) const
+    {
+        size_t maxCapacity = std::thread::hardware_concurrency();
+
+        if (maxCapacity <= 1) {
+            return 1;
+        }
+
+        if (desiredThreadCount == 0) {
+            return maxCapacity / 2;
+        }
+
+        return desiredThreadCount;
+    }
+
+    void runTasks()
+    {
+        for (;;) {
+            size_t idx = m_nextIdx.fetch_add(1);
+            if (idx >= m_taskCount) {
+                return;
+            }
+
+            m_task(m_taskCtx, idx);
+            m_doneCount.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    void th_workerLoop()
+    {
+        using Clock = std::chrono::steady_clock;
+
+        uint64_t lastGeneration = m_generation.load();
+        Clock::time_point idleSince;
+        int idleIterations = 0;
+
+        while (m_isActive) {
+            m_busyWorkers.fetch_add(1);
+
+            if (!m_isPublishing.load()) {
+                uint64_t generation = m_generation.load();
+                if (generation != lastGeneration) {
+                    lastGeneration = generation;
+                    runTasks();
+                    m_busyWorkers.fetch_sub(1);
+                    idleIterations = 0;
+                    continue;
+                }
+            }
+
+            m_busyWorkers.fetch_sub(1);
+
+            if (idleIterations == 0) {
+                idleSince = Clock::now();
+            }
+
+            ++idleIterations;
+
+            if (idleIterations % SPINS_PER_CLOCK_CHECK != 0 || Clock::now() - idleSince < IDLE_SPIN_DURATION) {
+                MUSE_CPU_RELAX();
+                continue;
+            }
+
+            std::unique_lock lock(m_parkMutex);
+            m_parkedWorkers.fetch_add(1);
+            m_parkCv.wait(lock, [this, lastGeneration] {
+                return m_generation.load() != lastGeneration || !m_isActive;
+            });
+            m_parkedWorkers.fetch_sub(1);
+            idleIterations = 0;
+        }
+    }
+
+    std::atomic<bool> m_isActive = false;
+    std::atomic<bool> m_isPublishing = false;
+    std::atomic<uint64_t> m_generation = 0;
+    std::atomic<size_t> m_busyWorkers = 0;
+    std::atomic<size_t> m_parkedWorkers = 0;
+
+    Task m_task = nullptr;
+    const void* m_taskCtx = nullptr;
+    size_t m_taskCount = 0;
+    std::atomic<size_t> m_nextIdx = 0;
+    std::atomic<size_t> m_doneCount = 0;
+
+    std::mutex m_parkMutex;
+    std::condition_variable m_parkCv;
+
+    size_t m_threadPoolSize = 0;
+    std::unique_ptr<std::thread[]> m_threadPool = nullptr;
+};
+}
+
+#undef MUSE_CPU_RELAX
+
+#endif // MUSE_GLOBAL_FORKJOINPOOL_H
@@ -198,6 +198,11 @@ private:
     thread_pool_size_t m_threadPoolSize = 0;
     std::unique_ptr<std::thread[]> m_threadPool = nullptr;
 };
+
+//! NOTE The pool shared by the background work (rendering the playback events, saving the excerpts,
+//! compressing the saved files...), so that each of them doesn't keep its own threads.
+//! A task must not wait for other tasks of the pool
+TaskScheduler* sharedTaskScheduler();
 }
 
 #endif // MUSE_GLOBAL_TASKCHEDULER_H
@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "wakeupsignal.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#else
+#include <cerrno>
+#include <ctime>
+#include <semaphore.h>
+#endif
+
+#include "log.h"
+
+using namespace muse;
+
+#if defined(_WIN32)
+
+WakeupSignal::WakeupSignal()
+{
+    //! NOTE: auto-reset event: a successful wait consumes the notification
+    m_handle = ::CreateEventW(NULL, FALSE, FALSE, NULL);
+    if (!m_handle) {
+        LOGE() << "Failed to create event, error: " << ::GetLastError();
+    }
+}
+
+WakeupSignal::~WakeupSignal()
+{
+    if (m_handle) {
+        ::CloseHandle(static_cast<HANDLE>(m_handle));
+    }
+}
+
+void WakeupSignal::post()
+{
+    ::SetEvent(static_cast<HANDLE>(m_handle));
+}
+
+bool WakeupSignal::timedWait(uint64_t timeoutMsecs)
+{
+    return ::WaitForSingleObject(static_cast<HANDLE>(m_handle), static_cast<DWORD>(timeoutMsecs)) == WAIT_OBJECT_0;
+}
+
+#elif defined(__APPLE__)
+
+WakeupSignal::WakeupSignal()
+{
+    m_handle = dispatch_semaphore_create(0);
+}
+
+WakeupSignal::~WakeupSignal()
+{
+    if (m_handle) {
+        dispatch_release(static_cast<dispatch_semaphore_t>(m_handle));
+    }
+}
+
+void WakeupSignal::post()
+{
+    dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(m_handle));
+}
+
+bool WakeupSignal::timedWait(uint64_t timeoutMsecs)
+{
+    dispatch_time_t deadline = dispatch_time(DISPATCH_TIME_NOW, static_cast<int64_t>(timeoutMsecs) * NSEC_PER_MSEC);
+    return dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(m_handle), deadline) == 0;
+}
+
+#else
+
+WakeupSignal::WakeupSignal()
+{
+    sem_t* sem = new sem_t;
+    if (sem_init(sem, 0, 0) != 0) {
+        LOGE() << "Failed to create semaphore, error: " << errno;
+    }
+    m_handle = sem;
+}
+
+WakeupSignal::~WakeupSignal()
+{
+    sem_t* sem = static_cast<sem_t*>(m_handle);
+    sem_destroy(sem);
+    delete sem;
+}
+
+void WakeupSignal::post()
+{
+    sem_post(static_cast<sem_t*>(m_handle));
+}
+
+bool WakeupSignal::timedWait(uint64_t timeoutMsecs)
+{
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += static_cast<time_t>(timeoutMsecs / 1000);
+    deadline.tv_nsec += static_cast<long>(timeoutMsecs % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    sem_t* sem = static_cast<sem_t*>(m_handle);
+    while (sem_timedwait(sem, &deadline) != 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#endif
+
+void WakeupSignal::notify()
+{
+    //! NOTE: only the first notification after a wake-up touches the OS primitive
+    if (!m_notified.exchange(true, std::memory_order_acq_rel)) {
+        post();
+    }
+}
+
+bool WakeupSignal::wait(uint64_t timeoutMsecs)
+{
+    bool notified = timedWait(timeoutMsecs);
+
+    //! NOTE: re-arm before the caller handles the work, so that anything
+    //! signalled from now on wakes up the next wait()
+    m_notified.exchange(false, std::memory_order_acq_rel);
+
+    return notified;
+}
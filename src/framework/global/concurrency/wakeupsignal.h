@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_GLOBAL_WAKEUPSIGNAL_H
+#define MUSE_GLOBAL_WAKEUPSIGNAL_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace muse {
+//! NOTE: Lets a single consumer thread sleep until another thread has work for it.
+//! notify() is safe to call from a real-time thread (e.g. the audio driver callback):
+//! it doesn't take a lock and doesn't allocate; repeated notifications before
+//! the consumer wakes up are coalesced into one.
+//! It is backed by the OS semaphore primitive (futex on Linux, dispatch semaphore
+//! on macOS, event object on Windows), so wait() costs no CPU while sleeping.
+class WakeupSignal
+{
+public:
+    WakeupSignal();
+    ~WakeupSignal();
+
+    WakeupSignal(const WakeupSignal&) = delete;
+    WakeupSignal& operator=(const WakeupSignal&) = delete;
+
+    void notify();
+
+    //! NOTE: Returns false if the timeout has expired without a notification
+    bool wait(uint64_t timeoutMsecs);
+
+private:
+    void post();
+    bool timedWait(uint64_t timeoutMsecs);
+
+    std::atomic<bool> m_notified = false;
+    void* m_handle = nullptr;
+};
+}
+
+#endif // MUSE_GLOBAL_WAKEUPSIGNAL_H
@@ -23,8 +23,10 @@
 
 #include <ctime>
 #include <cstring>
+#include <map>
 #include <zlib.h>
 
+#include "global/io/buffer.h"
 #include "global/io/dir.h"
 
 #include "log.h"
@@ -372,8 +374,14 @@ LocalFileHeader CentralFileHeader::toLocalHeader() const
 struct ZipContainer::Impl {
     IODevice* device = nullptr;
 
+    //! NOTE If set, the archive is read from the mapping;
+    //! the device is a buffer over it, only used to scan the central directory
+    std::shared_ptr<const io::MappedFile> mappedFile;
+    std::unique_ptr<Buffer> mappedDevice;
+
     bool dirtyFileTree = true;
     std::vector<FileHeader> fileHeaders;
+    std::map<std::string, size_t> fileIndexes;
     ByteArray comment;
     uint start_of_directory = 0;
     ZipContainer::Status status = ZipContainer::NoError;
@@ -384,7 +392,7 @@ struct ZipContainer::Impl {
         Directory, File, Symlink
     };
 
-    void addEntry(EntryType type, const std::string& fileName, const ByteArray& contents);
+    void addEntry(EntryType type, const std::string& fileName, const ZipContainer::Entry& entry);
     bool writeToDevice(const uint8_t* data, size_t len);
     bool writeToDevice(const ByteArray& data);
 
@@ -393,6 +401,9 @@ struct ZipContainer::Impl {
 
     void scanFiles();
     ZipContainer::FileInfo fillFileInfo(size_t index) const;
+    void addFileHeader(const FileHeader& header);
+    const FileHeader* findFileHeader(const std::string& fileName) const;
+    bool readLocalData(const FileHeader& header, LocalFileHeader& localHeader, ByteArray& data) const;
 
     std::string fixFilePath(const ByteArray& path) const;
 };
@@ -484,7 +495,7 @@ void ZipContainer::Impl::scanFiles()
         }
 
         ZDEBUG("found file '%s'", header.file_name.data());
-        fileHeaders.push_back(header);
+        addFileHeader(header);
     }
 }
 
@@ -541,17 +552,63 @@ ZipContainer::FileInfo ZipContainer::Impl::fillFileInfo(size_t index) const
     return fileInfo;
 }
 
-void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, const ByteArray& contents)
+void ZipContainer::Impl::addFileHeader(const FileHeader& header)
 {
-    if (!(device->isOpen() || device->open(IODevice::WriteOnly))) {
-        status = ZipContainer::FileOpenError;
-        return;
+    // the first one wins, if there are duplicates
+    fileIndexes.emplace(fixFilePath(header.file_name), fileHeaders.size());
+    fileHeaders.push_back(header);
+}
+
+const FileHeader* ZipContainer::Impl::findFileHeader(const std::string& fileName) const
+{
+    auto it = fileIndexes.find(fileName);
+    if (it == fileIndexes.end()) {
+        return nullptr;
     }
-    device->seek(start_of_directory);
 
+    return &fileHeaders.at(it->second);
+}
+
+//! NOTE Reads the local header and the (compressed) data of the file;
+//! for a mapped archive the data is a view of the mapping
+bool ZipContainer::Impl::readLocalData(const FileHeader& header, LocalFileHeader& localHeader, ByteArray& data) const
+{
+    const size_t compressedSize = readUInt(header.h.compressed_size);
+    const size_t start = readUInt(header.h.offset_local_header);
+
+    if (mappedFile) {
+        const size_t size = mappedFile->size();
+        if (start + sizeof(LocalFileHeader) > size) {
+            LOGW("Zip: local header is out of the file");
+            return false;
+        }
+
+        std::memcpy(&localHeader, mappedFile->data() + start, sizeof(LocalFileHeader));
+        const size_t dataStart = start + sizeof(LocalFileHeader)
+                                 + readUShort(localHeader.file_name_length) + readUShort(localHeader.extra_field_length);
+        if (dataStart > size) {
+            LOGW("Zip: file data is out of the file");
+            return false;
+        }
+
+        data = ByteArray::fromRawData(mappedFile->data() + dataStart, std::min(compressedSize, size - dataStart), mappedFile);
+        return true;
+    }
+
+    device->seek(start);
+    device->read((uint8_t*)&localHeader, sizeof(LocalFileHeader));
+    uint skip = readUShort(localHeader.file_name_length) + readUShort(localHeader.extra_field_length);
+    device->seek(device->pos() + skip);
+
+    data = device->read(compressedSize);
+    return true;
+}
+
+ZipContainer::Entry ZipContainer::makeEntry(const ByteArray& contents, CompressionPolicy policy, const std::tm& lastModified)
+{
     // don't compress small files
-    ZipContainer::CompressionPolicy compression = compressionPolicy;
-    if (compressionPolicy == ZipContainer::AutoCompress) {
+    ZipContainer::CompressionPolicy compression = policy;
+    if (policy == ZipContainer::AutoCompress) {
         if (contents.size() < 64) {
             compression = ZipContainer::NeverCompress;
         } else {
@@ -559,40 +616,28 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
         }
     }
 
-    FileHeader header;
-    std::memset(&header.h, 0, sizeof(CentralFileHeader));
-    writeUInt(header.h.signature, 0x02014b50);
-
-    writeUShort(header.h.version_needed, ZIP_VERSION);
-    writeUInt(header.h.uncompressed_size, (uint)contents.size());
-
-    std::time_t t = std::time(0);   // get time now
-    std::tm now;
-#ifdef WIN32
-    localtime_s(&now, &t);
-#else
-    localtime_r(&t, &now);
-#endif
-    writeMSDosDate(header.h.last_mod_file, now);
-    ByteArray data = contents;
+    Entry entry;
+    entry.uncompressedSize = contents.size();
+    entry.lastModified = lastModified;
+    entry.data = contents;
     if (compression == ZipContainer::AlwaysCompress) {
-        writeUShort(header.h.compression_method, CompressionMethodDeflated);
+        entry.isCompressed = true;
 
         ulong len = (ulong)contents.size();
         // shamelessly copied form zlib
         len += (len >> 12) + (len >> 14) + 11;
         int res;
         do {
-            data.resize(len);
-            res = deflate((uint8_t*)data.data(), &len, (const uint8_t*)contents.constData(), (ulong)contents.size());
+            entry.data.resize(len);
+            res = deflate((uint8_t*)entry.data.data(), &len, (const uint8_t*)contents.constData(), (ulong)contents.size());
 
             switch (res) {
             case Z_OK:
-                data.resize(len);
+                entry.data.resize(len);
                 break;
             case Z_MEM_ERROR:
                 LOGW("Zip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
+                entry.data.resize(0);
                 break;
             case Z_BUF_ERROR:
                 len *= 2;
@@ -600,11 +645,47 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
             }
         } while (res == Z_BUF_ERROR);
     }
+
+    entry.crc = ::crc32(0, 0, 0);
+    entry.crc = ::crc32(entry.crc, (const uint8_t*)contents.constData(), (uint)contents.size());
+
+    return entry;
+}
+
+std::tm ZipContainer::currentTime()
+{
+    std::time_t t = std::time(0);   // get time now
+    std::tm now;
+#ifdef WIN32
+    localtime_s(&now, &t);
+#else
+    localtime_r(&t, &now);
+#endif
+    return now;
+}
+
+void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, const ZipContainer::Entry& entry)
+{
+    if (!(device->isOpen() || device->open(IODevice::WriteOnly))) {
+        status = ZipContainer::FileOpenError;
+        return;
+    }
+    device->seek(start_of_directory);
+
+    FileHeader header;
+    std::memset(&header.h, 0, sizeof(CentralFileHeader));
+    writeUInt(header.h.signature, 0x02014b50);
+
+    writeUShort(header.h.version_needed, ZIP_VERSION);
+    writeUInt(header.h.uncompressed_size, (uint)entry.uncompressedSize);
+
+    writeMSDosDate(header.h.last_mod_file, entry.lastModified);
+    if (entry.isCompressed) {
+        writeUShort(header.h.compression_method, CompressionMethodDeflated);
+    }
 // TODO add a check if data.size() > contents.size().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, (uint)data.size());
-    uint crc_32 = ::crc32(0, 0, 0);
-    crc_32 = ::crc32(crc_32, (const uint8_t*)contents.constData(), (uint)contents.size());
-    writeUInt(header.h.crc_32, crc_32);
+    writeUInt(header.h.compressed_size, (uint)entry.data.size());
+    writeUInt(header.h.crc_32, entry.crc);
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
     ushort general_purpose_bits = Utf8Names; // always use utf-8
@@ -648,14 +729,14 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
     writeUInt(header.h.external_file_attributes, mode << 16);
     writeUInt(header.h.offset_local_header, start_of_directory);
 
-    fileHeaders.push_back(header);
+    addFileHeader(header);
 
     bool ok = true;
 
     LocalFileHeader h = header.h.toLocalHeader();
     ok &= writeToDevice((const uint8_t*)&h, sizeof(LocalFileHeader));
     ok &= writeToDevice(header.file_name);
-    ok &= writeToDevice(data);
+    ok &= writeToDevice(entry.data);
 
     start_of_directory = (uint)device->pos();
     dirtyFileTree = true;
@@ -707,6 +788,15 @@ ZipContainer::ZipContainer(IODevice* device)
     assert(device);
 }
 
+ZipContainer::ZipContainer(std::shared_ptr<const io::MappedFile> file)
+    : p(new Impl(nullptr))
+{
+    assert(file);
+    p->mappedFile = std::move(file);
+    p->mappedDevice = std::make_unique<Buffer>(ByteArray::fromRawData(p->mappedFile->data(), p->mappedFile->size()));
+    p->device = p->mappedDevice.get();
+}
+
 ZipContainer::~ZipContainer()
 {
     close();
@@ -735,79 +825,68 @@ bool ZipContainer::fileExists(const std::string& fileName) const
 {
     p->scanFiles();
 
-    for (size_t i = 0; i < p->fileHeaders.size(); ++i) {
-        std::string currentFileName = p->fixFilePath(p->fileHeaders.at(i).file_name.constChar());
-        if (currentFileName == fileName) {
-            return true;
-        }
-    }
-
-    return false;
+    return p->findFileHeader(fileName) != nullptr;
 }
 
 ByteArray ZipContainer::fileData(const std::string& fileName) const
 {
-    p->scanFiles();
+    ByteArray data;
+    fileData(fileName, data);
+    return data;
+}
 
-    size_t i = 0;
-    for (i = 0; i < p->fileHeaders.size(); ++i) {
-        std::string currentFileName = p->fixFilePath(p->fileHeaders.at(i).file_name.constChar());
-        if (currentFileName == fileName) {
-            break;
-        }
-    }
+bool ZipContainer::fileData(const std::string& fileName, ByteArray& data) const
+{
+    p->scanFiles();
 
-    if (i == p->fileHeaders.size()) {
-        return ByteArray();
+    const FileHeader* header = p->findFileHeader(fileName);
+    if (!header) {
+        data.clear();
+        return false;
     }
 
-    FileHeader header = p->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
+    ushort version_needed = readUShort(header->h.version_needed);
     if (version_needed > ZIP_VERSION) {
         LOGW("Zip: .ZIP specification version %d implementation is needed to extract the data.", version_needed);
-        return ByteArray();
+        data.clear();
+        return false;
     }
 
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-
-    p->device->seek(start);
-    LocalFileHeader lh;
-    p->device->read((uint8_t*)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    p->device->seek(p->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
-
+    ushort general_purpose_bits = readUShort(header->h.general_purpose_bits);
     if ((general_purpose_bits & Encrypted) != 0) {
         LOGW("Zip: Unsupported encryption method is needed to extract the data.");
-        return ByteArray();
+        data.clear();
+        return false;
+    }
+
+    LocalFileHeader lh;
+    ByteArray compressed;
+    if (!p->readLocalData(*header, lh, compressed)) {
+        data.clear();
+        return false;
     }
 
-    ByteArray compressed = p->device->read(compressed_size);
+    const size_t uncompressed_size = readUInt(header->h.uncompressed_size);
+    const int compression_method = readUShort(lh.compression_method);
+
     if (compression_method == CompressionMethodStored) {
         // no compression
         compressed.truncate(uncompressed_size);
-        return compressed;
+        data = compressed;
+        return true;
     } else if (compression_method == CompressionMethodDeflated) {
         // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
-        ByteArray baunzip;
-        ulong len = std::max(uncompressed_size,  1);
+        ulong len = std::max(uncompressed_size, size_t(1));
         int res;
         do {
-            baunzip.resize(len);
-            res = inflate((uint8_t*)baunzip.data(), &len,
-                          (const uint8_t*)compressed.constData(), compressed_size);
+            data.resize(len);
+            res = inflate((uint8_t*)data.data(), &len,
+                          (const uint8_t*)compressed.constData(), (ulong)compressed.size());
 
             switch (res) {
             case Z_OK:
-                if ((size_t)len != baunzip.size()) {
-                    baunzip.resize(len);
+                if ((size_t)len != data.size()) {
+                    data.resize(len);
                 }
                 break;
             case Z_MEM_ERROR:
@@ -821,11 +900,12 @@ ByteArray ZipContainer::fileData(const std::string& fileName) const
                 break;
             }
         } while (res == Z_BUF_ERROR);
-        return baunzip;
+        return res == Z_OK;
     }
 
     LOGW("Zip: Unsupported compression method %d is needed to extract the data.", compression_method);
-    return ByteArray();
+    data.clear();
+    return false;
 }
 
 ZipContainer::Status ZipContainer::status() const
@@ -845,7 +925,12 @@ ZipContainer::CompressionPolicy ZipContainer::compressionPolicy() const
 
 void ZipContainer::addFile(const std::string& fileName, const ByteArray& data)
 {
-    p->addEntry(Impl::File, Dir::fromNativeSeparators(fileName).toStdString(), data);
+    p->addEntry(Impl::File, Dir::fromNativeSeparators(fileName).toStdString(), makeEntry(data, p->compressionPolicy, currentTime()));
+}
+
+void ZipContainer::addFile(const std::string& fileName, const Entry& entry)
+{
+    p->addEntry(Impl::File, Dir::fromNativeSeparators(fileName).toStdString(), entry);
 }
 
 void ZipContainer::addDirectory(const std::string& dirName)
@@ -855,7 +940,7 @@ void ZipContainer::addDirectory(const std::string& dirName)
     if (name.back() != '/') {
         name.push_back('/');
     }
-    p->addEntry(Impl::Directory, name, ByteArray());
+    p->addEntry(Impl::Directory, name, makeEntry(ByteArray(), p->compressionPolicy, currentTime()));
 }
 
 void ZipContainer::close()
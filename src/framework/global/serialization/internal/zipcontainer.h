@@ -23,15 +23,19 @@
 #define MUSE_GLOBAL_ZIPCONTAINER_H
 
 #include <ctime>
+#include <memory>
 #include <string>
 
 #include "io/iodevice.h"
+#include "io/mappedfile.h"
 
 namespace muse {
 class ZipContainer
 {
 public:
     explicit ZipContainer(io::IODevice* device);
+    //! NOTE Reads the archive from the mapped file instead of a device
+    explicit ZipContainer(std::shared_ptr<const io::MappedFile> file);
     ~ZipContainer();
 
     enum Status {
@@ -65,6 +69,9 @@ public:
 
     bool fileExists(const std::string& fileName) const;
     ByteArray fileData(const std::string& fileName) const;
+    //! NOTE Reads the file into the data, reusing its memory: a deflated file is inflated straight into it,
+    //! a stored file of a mapped archive is returned as a view of the mapping, without copying
+    bool fileData(const std::string& fileName, ByteArray& data) const;
 
     // Write
     enum CompressionPolicy {
@@ -76,7 +83,22 @@ public:
     void setCompressionPolicy(CompressionPolicy policy);
     CompressionPolicy compressionPolicy() const;
 
+    //! NOTE The compressed contents of a file with their checksum;
+    //! it doesn't depend on the container, so it can be made on any thread
+    struct Entry
+    {
+        ByteArray data;
+        size_t uncompressedSize = 0;
+        unsigned int crc = 0;
+        bool isCompressed = false;
+        std::tm lastModified;
+    };
+
+    static Entry makeEntry(const ByteArray& contents, CompressionPolicy policy, const std::tm& lastModified);
+    static std::tm currentTime();
+
     void addFile(const std::string& fileName, const ByteArray& data);
+    void addFile(const std::string& fileName, const Entry& entry);
     void addDirectory(const std::string& dirName);
 
 private:
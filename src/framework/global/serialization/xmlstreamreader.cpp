@@ -22,27 +22,678 @@
 #include "xmlstreamreader.h"
 
 #include <cstring>
+#include <string_view>
 
 #include "global/types/string.h"
-#ifdef SYSTEM_TINYXML
-#include <tinyxml2.h>
-#else
-#include "thirdparty/tinyxml/tinyxml2.h"
-#endif
 
 #include "log.h"
 
 using namespace muse;
 using namespace muse::io;
-using namespace tinyxml2;
+
+//! NOTE The reader is an incremental pull tokenizer: each readNext() scans only as far as the next token.
+//! The document lives in a single buffer owned by the reader. When reading from a device the buffer is
+//! allocated once for the whole device and filled chunk by chunk while the tokenizer advances, so it never
+//! moves and the AsciiStringView names, attributes and texts handed out point straight into it.
+//! Like tinyxml2 (which was used here before), the values are terminated and decoded in place,
+//! so they stay valid, and zero-terminated, for the lifetime of the reader.
+
+static constexpr size_t READ_CHUNK_SIZE = 64 * 1024;
+static constexpr size_t npos = std::string_view::npos;
+
+enum class XmlError {
+    NoError = 0,
+    EmptyDocument,
+    CanNotConvertText,
+    Parsing,
+    ParsingElement,
+    ParsingAttribute,
+    ParsingText,
+    ParsingCData,
+    ParsingComment,
+    ParsingDeclaration,
+    ParsingUnknown,
+    MismatchedElement,
+};
+
+static const char* errorName(XmlError err)
+{
+    switch (err) {
+    case XmlError::NoError: return "XML_SUCCESS";
+    case XmlError::EmptyDocument: return "XML_ERROR_EMPTY_DOCUMENT";
+    case XmlError::CanNotConvertText: return "XML_CAN_NOT_CONVERT_TEXT";
+    case XmlError::Parsing: return "XML_ERROR_PARSING";
+    case XmlError::ParsingElement: return "XML_ERROR_PARSING_ELEMENT";
+    case XmlError::ParsingAttribute: return "XML_ERROR_PARSING_ATTRIBUTE";
+    case XmlError::ParsingText: return "XML_ERROR_PARSING_TEXT";
+    case XmlError::ParsingCData: return "XML_ERROR_PARSING_CDATA";
+    case XmlError::ParsingComment: return "XML_ERROR_PARSING_COMMENT";
+    case XmlError::ParsingDeclaration: return "XML_ERROR_PARSING_DECLARATION";
+    case XmlError::ParsingUnknown: return "XML_ERROR_PARSING_UNKNOWN";
+    case XmlError::MismatchedElement: return "XML_ERROR_MISMATCHED_ELEMENT";
+    }
+    return "";
+}
+
+static inline bool isWhiteSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+static inline bool isNameStartChar(char c)
+{
+    const unsigned char u = static_cast<unsigned char>(c);
+    return u >= 128 || (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || u == ':' || u == '_';
+}
+
+static inline bool isNameChar(char c)
+{
+    return isNameStartChar(c) || (c >= '0' && c <= '9') || c == '.' || c == '-';
+}
+
+static size_t appendUtf8(char32_t ucs, char* out)
+{
+    if (ucs < 0x80) {
+        out[0] = static_cast<char>(ucs);
+        return 1;
+    } else if (ucs < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (ucs >> 6));
+        out[1] = static_cast<char>(0x80 | (ucs & 0x3F));
+        return 2;
+    } else if (ucs < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (ucs >> 12));
+        out[1] = static_cast<char>(0x80 | ((ucs >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (ucs & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (ucs >> 18));
+    out[1] = static_cast<char>(0x80 | ((ucs >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((ucs >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (ucs & 0x3F));
+    return 4;
+}
+
+//! Decodes `&#NNN;` or `&#xHHH;` starting at p (pointing to '&'), writes UTF-8 to out.
+//! Returns the number of consumed chars, or 0 if this is not a valid character reference
+static size_t parseCharacterRef(const char* p, const char* end, char* out, size_t* outLen)
+{
+    const char* semicolon = static_cast<const char*>(std::memchr(p, ';', end - p));
+    if (!semicolon || end - p < 4) {
+        return 0;
+    }
+
+    const bool hex = p[2] == 'x';
+    const char* digit = p + (hex ? 3 : 2);
+    if (digit == semicolon) {
+        return 0;
+    }
+
+    char32_t ucs = 0;
+    for (; digit < semicolon; ++digit) {
+        char c = *digit;
+        unsigned int v = 0;
+        if (c >= '0' && c <= '9') {
+            v = c - '0';
+        } else if (hex && c >= 'a' && c <= 'f') {
+            v = c - 'a' + 10;
+        } else if (hex && c >= 'A' && c <= 'F') {
+            v = c - 'A' + 10;
+        } else {
+            return 0;
+        }
+        ucs = ucs * (hex ? 16 : 10) + v;
+        if (ucs > 0x10FFFF) {
+            return 0;
+        }
+    }
+
+    *outLen = appendUtf8(ucs, out);
+    return static_cast<size_t>(semicolon - p) + 1;
+}
 
 struct XmlStreamReader::Xml {
-    XMLDocument doc;
-    XMLNode* node = nullptr;
-    XMLError err;
+    ByteArray buffer;
+    char* data = nullptr;
+    size_t size = 0;        // size of the document
+    size_t filled = 0;      // number of bytes read so far (less than size only while reading from a device)
+    IODevice* device = nullptr;
+
+    size_t pos = 0;
+    bool tagOpened = false; // the '<' at pos - 1 is consumed already
+    int64_t line = 1;
+    size_t lineStart = 0;
+
+    // current token
+    AsciiStringView name;
+    AsciiStringView value;
+    std::vector<std::pair<AsciiStringView, AsciiStringView> > attributes;
+    size_t bodyBegin = 0;
+    bool pendingEndElement = false;
+    int64_t tokenLine = 0;
+    int64_t tokenColumn = 0;
+
+    std::vector<AsciiStringView> elements;
+    bool hasNodes = false;
+    bool hasNonDeclarationNodes = false;
+
+    XmlError err = XmlError::NoError;
+    int64_t errLine = 0;
+    String errDetails;
     String customErr;
+
+    struct RawAttribute {
+        size_t nameBegin = 0;
+        size_t nameEnd = 0;
+        size_t valueBegin = 0;
+        size_t valueEnd = 0;
+    };
+    std::vector<RawAttribute> rawAttributes;
+
+    void reset()
+    {
+        buffer = ByteArray();
+        data = nullptr;
+        size = 0;
+        filled = 0;
+        device = nullptr;
+        pos = 0;
+        tagOpened = false;
+        line = 1;
+        lineStart = 0;
+        clearToken();
+        pendingEndElement = false;
+        tokenLine = 0;
+        tokenColumn = 0;
+        elements.clear();
+        hasNodes = false;
+        hasNonDeclarationNodes = false;
+        err = XmlError::NoError;
+        errLine = 0;
+        errDetails.clear();
+        customErr.clear();
+    }
+
+    void clearToken()
+    {
+        name = AsciiStringView();
+        value = AsciiStringView();
+        attributes.clear();
+        bodyBegin = 0;
+    }
+
+    void setBuffer(ByteArray&& buf, size_t filledSize)
+    {
+        buffer = std::move(buf);
+        data = reinterpret_cast<char*>(buffer.data());
+        size = buffer.size();
+        filled = filledSize;
+    }
+
+    // === input ===
+
+    bool fill()
+    {
+        if (!device || filled >= size) {
+            return false;
+        }
+
+        size_t len = std::min(READ_CHUNK_SIZE, size - filled);
+        size_t read = device->read(reinterpret_cast<uint8_t*>(data) + filled, len);
+        if (read == 0) {
+            // the device turned out to be shorter than it claimed
+            size = filled;
+            data[filled] = '\0';
+            device = nullptr;
+            return false;
+        }
+        filled += read;
+        return true;
+    }
+
+    bool available(size_t i)
+    {
+        while (i >= filled) {
+            if (!fill()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    char peek(size_t i)
+    {
+        return available(i) ? data[i] : '\0';
+    }
+
+    bool matches(size_t i, const char* str, size_t len)
+    {
+        return available(i + len - 1) && std::memcmp(data + i, str, len) == 0;
+    }
+
+    size_t find(char c, size_t from)
+    {
+        while (true) {
+            if (from < filled) {
+                const void* found = std::memchr(data + from, c, filled - from);
+                if (found) {
+                    return static_cast<const char*>(found) - data;
+                }
+                from = filled;
+            }
+            if (!fill()) {
+                return npos;
+            }
+        }
+    }
+
+    size_t find(const char* str, size_t len, size_t from)
+    {
+        while (true) {
+            if (from + len <= filled) {
+                size_t i = std::string_view(data + from, filled - from).find(std::string_view(str, len));
+                if (i != npos) {
+                    return from + i;
+                }
+                from = filled - len + 1;
+            }
+            if (!fill()) {
+                return npos;
+            }
+        }
+    }
+
+    size_t skipWhiteSpace(size_t i)
+    {
+        while (isWhiteSpace(peek(i))) {
+            ++i;
+        }
+        return i;
+    }
+
+    size_t skipName(size_t i)
+    {
+        if (!isNameStartChar(peek(i))) {
+            return i;
+        }
+        ++i;
+        while (isNameChar(peek(i))) {
+            ++i;
+        }
+        return i;
+    }
+
+    //! Moves the position to `to`, counting the lines on the way
+    void advance(size_t to)
+    {
+        const char* begin = data + pos;
+        const char* end = data + to;
+        while (true) {
+            const char* nl = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+            if (!nl) {
+                break;
+            }
+            ++line;
+            lineStart = nl - data + 1;
+            begin = nl + 1;
+        }
+        pos = to;
+    }
+
+    void markToken(size_t at)
+    {
+        tokenLine = line;
+        tokenColumn = static_cast<int64_t>(at - lineStart) + 1;
+    }
+
+    //! Terminates [begin, end) in place, normalizing newlines and, if requested, resolving
+    //! the predefined and the numeric character entities. The result is never longer than the source.
+    AsciiStringView decode(size_t begin, size_t end, bool entities)
+    {
+        char* p = data + begin;
+        char* const e = data + end;
+
+        while (p < e && *p != '\r' && *p != '\n' && !(entities && *p == '&')) {
+            ++p;
+        }
+
+        char* q = p;
+
+        while (p < e) {
+            const char c = *p;
+            if (c == '\r' || c == '\n') {
+                // CR-LF and LF-CR pairs and a single CR become LF
+                const char pair = c == '\r' ? '\n' : '\r';
+                p += (p + 1 < e && p[1] == pair) ? 2 : 1;
+                *q++ = '\n';
+            } else if (entities && c == '&') {
+                if (p + 1 < e && p[1] == '#') {
+                    char buf[4];
+                    size_t len = 0;
+                    size_t consumed = parseCharacterRef(p, e, buf, &len);
+                    if (consumed) {
+                        std::memcpy(q, buf, len);
+                        q += len;
+                        p += consumed;
+                    } else {
+                        *q++ = *p++;
+                    }
+                } else {
+                    struct Entity {
+                        const char* pattern;
+                        size_t length;
+                        char value;
+                    };
+                    static const Entity ENTITIES[] = {
+                        { "quot", 4, '\"' }, { "amp", 3, '&' }, { "apos", 4, '\'' }, { "lt", 2, '<' }, { "gt", 2, '>' }
+                    };
+
+                    bool found = false;
+                    for (const Entity& entity : ENTITIES) {
+                        if (p + entity.length + 1 < e && std::memcmp(p + 1, entity.pattern, entity.length) == 0
+                            && p[entity.length + 1] == ';') {
+                            *q++ = entity.value;
+                            p += entity.length + 2;
+                            found = true;
+                            break;
+                        }
+                    }
+
+                    if (!found) {
+                        *q++ = *p++;
+                    }
+                }
+            } else {
+                *q++ = *p++;
+            }
+        }
+
+        *q = '\0';
+        return AsciiStringView(data + begin, static_cast<size_t>(q - (data + begin)));
+    }
+
+    AsciiStringView terminate(size_t begin, size_t end)
+    {
+        data[end] = '\0';
+        return AsciiStringView(data + begin, end - begin);
+    }
+
+    TokenType setError(XmlError e, int64_t errLineNum, const String& details = String())
+    {
+        err = e;
+        errLine = errLineNum;
+        errDetails = details;
+        LOGE() << errorName(err) << " at line " << errLine;
+        return TokenType::Invalid;
+    }
+
+    // === tokens ===
+
+    TokenType readToken();
+    TokenType readTag();
+    TokenType readElement();
+    TokenType readEndElement(size_t from);
+    size_t findBodyEnd();
 };
 
+XmlStreamReader::TokenType XmlStreamReader::Xml::readToken()
+{
+    clearToken();
+
+    if (pendingEndElement) {
+        pendingEndElement = false;
+        name = elements.back();
+        elements.pop_back();
+        return TokenType::EndElement;
+    }
+
+    if (!tagOpened) {
+        const size_t start = pos;
+        const size_t p = skipWhiteSpace(pos);
+        advance(p);
+
+        if (!available(p)) {
+            if (!elements.empty()) {
+                return setError(XmlError::Parsing, line, u"XMLElement name=" + String::fromAscii(elements.back().ascii()));
+            }
+            if (!hasNodes) {
+                return setError(XmlError::EmptyDocument, line);
+            }
+            return TokenType::EndDocument;
+        }
+
+        hasNodes = true;
+
+        if (data[p] != '<') {
+            // Text, the leading whitespace counts
+            markToken(p);
+            hasNonDeclarationNodes = true;
+            const size_t lt = find('<', p);
+            if (lt == npos) {
+                return setError(XmlError::ParsingText, tokenLine);
+            }
+            advance(lt + 1);
+            tagOpened = true;
+            value = decode(start, lt, true);
+            return TokenType::Characters;
+        }
+
+        markToken(p);
+        advance(p + 1);
+    } else {
+        markToken(pos - 1);
+        hasNodes = true;
+    }
+
+    tagOpened = false;
+    return readTag();
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::readTag()
+{
+    // pos is just after '<'
+    if (matches(pos, "?", 1)) {
+        const size_t begin = pos + 1;
+        const size_t end = find("?>", 2, begin);
+        if (end == npos) {
+            return setError(XmlError::ParsingDeclaration, tokenLine);
+        }
+        advance(end + 2);
+
+        // Declarations are only expected at the start of the document, but there are MusicXML files
+        // with processing instructions in other places (from Sibelius, for example), so just skip them
+        if (hasNonDeclarationNodes || !elements.empty()) {
+            return readToken();
+        }
+
+        value = decode(begin, end, false);
+        return TokenType::StartDocument;
+    }
+
+    hasNonDeclarationNodes = true;
+
+    if (matches(pos, "!--", 3)) {
+        const size_t begin = pos + 3;
+        const size_t end = find("-->", 3, begin);
+        if (end == npos) {
+            return setError(XmlError::ParsingComment, tokenLine);
+        }
+        advance(end + 3);
+        value = decode(begin, end, false);
+        return TokenType::Comment;
+    }
+
+    if (matches(pos, "![CDATA[", 8)) {
+        const size_t begin = pos + 8;
+        const size_t end = find("]]>", 3, begin);
+        if (end == npos) {
+            return setError(XmlError::ParsingCData, tokenLine);
+        }
+        advance(end + 3);
+        value = decode(begin, end, false);
+        return TokenType::Characters;
+    }
+
+    if (matches(pos, "!", 1)) {
+        const size_t begin = pos + 1;
+        const size_t end = find('>', begin);
+        if (end == npos) {
+            return setError(XmlError::ParsingUnknown, tokenLine);
+        }
+        advance(end + 1);
+        value = decode(begin, end, false);
+        return TokenType::DTD;
+    }
+
+    const size_t p = skipWhiteSpace(pos);
+    if (peek(p) == '/') {
+        return readEndElement(p + 1);
+    }
+
+    return readElement();
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::readElement()
+{
+    const size_t nameBegin = skipWhiteSpace(pos);
+    const size_t nameEnd = skipName(nameBegin);
+    if (nameEnd == nameBegin) {
+        return setError(XmlError::Parsing, tokenLine);
+    }
+
+    rawAttributes.clear();
+
+    bool selfClosing = false;
+    size_t p = nameEnd;
+    while (true) {
+        p = skipWhiteSpace(p);
+        const char c = peek(p);
+        if (isNameStartChar(c)) {
+            RawAttribute a;
+            a.nameBegin = p;
+            a.nameEnd = skipName(p);
+            p = skipWhiteSpace(a.nameEnd);
+            if (peek(p) != '=') {
+                return setError(XmlError::ParsingAttribute, tokenLine);
+            }
+            p = skipWhiteSpace(p + 1);
+            const char quote = peek(p);
+            if (quote != '\"' && quote != '\'') {
+                return setError(XmlError::ParsingAttribute, tokenLine);
+            }
+            a.valueBegin = p + 1;
+            a.valueEnd = find(quote, a.valueBegin);
+            if (a.valueEnd == npos) {
+                return setError(XmlError::ParsingAttribute, tokenLine);
+            }
+            rawAttributes.push_back(a);
+            p = a.valueEnd + 1;
+        } else if (c == '>') {
+            ++p;
+            break;
+        } else if (c == '/' && peek(p + 1) == '>') {
+            selfClosing = true;
+            p += 2;
+            break;
+        } else {
+            return setError(XmlError::ParsingElement, tokenLine);
+        }
+    }
+
+    advance(p);
+
+    // The whole tag is scanned, so the delimiters may be overwritten now
+    name = terminate(nameBegin, nameEnd);
+    for (const RawAttribute& a : rawAttributes) {
+        AsciiStringView attrName = terminate(a.nameBegin, a.nameEnd);
+        for (const auto& prev : attributes) {
+            if (prev.first == attrName) {
+                return setError(XmlError::ParsingAttribute, tokenLine, u"XMLElement name=" + String::fromAscii(name.ascii()));
+            }
+        }
+        attributes.emplace_back(attrName, decode(a.valueBegin, a.valueEnd, true));
+    }
+
+    elements.push_back(name);
+    pendingEndElement = selfClosing;
+    bodyBegin = selfClosing ? npos : p;
+
+    return TokenType::StartElement;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::readEndElement(size_t from)
+{
+    const size_t nameBegin = skipWhiteSpace(from);
+    const size_t nameEnd = skipName(nameBegin);
+    if (nameEnd == nameBegin) {
+        return setError(XmlError::Parsing, tokenLine);
+    }
+
+    const size_t p = skipWhiteSpace(nameEnd);
+    if (peek(p) != '>') {
+        return setError(XmlError::ParsingElement, tokenLine);
+    }
+
+    advance(p + 1);
+    name = terminate(nameBegin, nameEnd);
+
+    if (elements.empty() || elements.back() != name) {
+        return setError(XmlError::MismatchedElement, tokenLine, u"XMLElement name=" + String::fromAscii(name.ascii()));
+    }
+
+    elements.pop_back();
+    return TokenType::EndElement;
+}
+
+size_t XmlStreamReader::Xml::findBodyEnd()
+{
+    // Looks ahead for the end tag of the current element without consuming anything
+    size_t p = bodyBegin;
+    int depth = 0;
+    while (true) {
+        const size_t lt = find('<', p);
+        if (lt == npos) {
+            return npos;
+        }
+
+        if (matches(lt + 1, "!--", 3)) {
+            p = find("-->", 3, lt + 4);
+        } else if (matches(lt + 1, "![CDATA[", 8)) {
+            p = find("]]>", 3, lt + 9);
+        } else if (matches(lt + 1, "?", 1)) {
+            p = find("?>", 2, lt + 2);
+        } else if (matches(lt + 1, "!", 1) || matches(lt + 1, "/", 1)) {
+            if (peek(lt + 1) == '/' && depth-- == 0) {
+                return lt;
+            }
+            p = find('>', lt + 2);
+        } else {
+            // start tag, attribute values may contain '>'
+            p = lt + 1;
+            char c = peek(p);
+            while (c != '>' && c != '\0') {
+                if (c == '\"' || c == '\'') {
+                    p = find(c, p + 1);
+                    if (p == npos) {
+                        return npos;
+                    }
+                }
+                c = peek(++p);
+            }
+            if (c == '\0') {
+                return npos;
+            }
+            if (data[p - 1] != '/') {
+                ++depth;
+            }
+        }
+
+        if (p == npos) {
+            return npos;
+        }
+        ++p;
+    }
+}
+
 XmlStreamReader::XmlStreamReader()
 {
     m_xml = new Xml();
@@ -51,8 +702,37 @@ XmlStreamReader::XmlStreamReader()
 XmlStreamReader::XmlStreamReader(IODevice* device)
 {
     m_xml = new Xml();
-    ByteArray data = device->readAll();
-    setData(data);
+
+    const size_t size = device->size() - device->pos();
+    if (size < 4) {
+        setData(device->readAll());
+        return;
+    }
+
+    ByteArray buffer(size);
+    size_t filled = device->read(buffer.data(), std::min(READ_CHUNK_SIZE, size));
+
+    UtfCodec::Encoding enc = UtfCodec::xmlEncoding(ByteArray::fromRawData(buffer.constData(), filled));
+    if (enc != UtfCodec::Encoding::UTF_8) {
+        // rare, so just convert the whole document
+        while (filled < size) {
+            size_t read = device->read(buffer.data() + filled, size - filled);
+            if (read == 0) {
+                break;
+            }
+            filled += read;
+        }
+        buffer.resize(filled);
+        setData(buffer);
+        return;
+    }
+
+    m_xml->setBuffer(std::move(buffer), filled);
+    m_xml->device = device;
+    if (std::memcmp(m_xml->data, "\xEF\xBB\xBF", 3) == 0) {
+        m_xml->pos = m_xml->lineStart = 3;
+    }
+    m_token = TokenType::NoToken;
 }
 
 XmlStreamReader::XmlStreamReader(const ByteArray& data)
@@ -61,6 +741,12 @@ XmlStreamReader::XmlStreamReader(const ByteArray& data)
     setData(data);
 }
 
+XmlStreamReader::XmlStreamReader(ByteArray&& data)
+{
+    m_xml = new Xml();
+    setData(std::move(data));
+}
+
 #ifndef NO_QT_SUPPORT
 XmlStreamReader::XmlStreamReader(const QByteArray& data)
 {
@@ -76,41 +762,48 @@ XmlStreamReader::~XmlStreamReader()
     delete m_xml;
 }
 
-void XmlStreamReader::setData(const ByteArray& data_)
+void XmlStreamReader::setData(const ByteArray& data)
 {
-    m_xml->doc.Clear();
-    m_xml->customErr.clear();
+    // a shallow copy, the data is copied when the buffer is taken for writing
+    setData(ByteArray(data));
+}
+
+void XmlStreamReader::setData(ByteArray&& data_)
+{
+    m_xml->reset();
     m_token = TokenType::Invalid;
 
     if (data_.size() < 4) {
-        m_xml->err = XML_ERROR_EMPTY_DOCUMENT;
-        LOGE() << m_xml->doc.ErrorIDToName(m_xml->err);
+        m_xml->err = XmlError::EmptyDocument;
+        LOGE() << errorName(m_xml->err);
         return;
     }
 
     UtfCodec::Encoding enc = UtfCodec::xmlEncoding(data_);
     if (enc == UtfCodec::Encoding::Unknown) {
-        m_xml->err = XML_CAN_NOT_CONVERT_TEXT;
+        m_xml->err = XmlError::CanNotConvertText;
         LOGE() << "unknown encoding";
         return;
     }
 
-    ByteArray data = data_; // no copy, implicit sharing
+    // The tokenizer terminates and decodes the values in place, so it needs its own buffer:
+    // the data is detached by setBuffer, unless nothing else refers to it
+    ByteArray data;
     if (enc == UtfCodec::Encoding::UTF_16LE) {
-        String u16 = String::fromUtf16LE(data_);
-        data = u16.toUtf8();
+        data = String::fromUtf16LE(data_).toUtf8();
     } else if (enc == UtfCodec::Encoding::UTF_16BE) {
-        String u16 = String::fromUtf16BE(data_);
-        data = u16.toUtf8();
+        data = String::fromUtf16BE(data_).toUtf8();
+    } else {
+        data = std::move(data_);
     }
 
-    m_xml->err = m_xml->doc.Parse(reinterpret_cast<const char*>(data.constData()), data.size());
-
-    if (m_xml->err == XML_SUCCESS) {
-        m_token = TokenType::NoToken;
-    } else {
-        LOGE() << m_xml->doc.ErrorIDToName(m_xml->err);
+    const size_t size = data.size();
+    m_xml->setBuffer(std::move(data), size);
+    if (size >= 3 && std::memcmp(m_xml->data, "\xEF\xBB\xBF", 3) == 0) {
+        m_xml->pos = m_xml->lineStart = 3;
     }
+
+    m_token = TokenType::NoToken;
 }
 
 bool XmlStreamReader::readNextStartElement()
@@ -130,73 +823,19 @@ bool XmlStreamReader::atEnd() const
     return m_token == TokenType::EndDocument || m_token == TokenType::Invalid;
 }
 
-static XmlStreamReader::TokenType resolveToken(XMLNode* n, bool isStartElement)
-{
-    if (n->ToElement()) {
-        return isStartElement ? XmlStreamReader::TokenType::StartElement : XmlStreamReader::TokenType::EndElement;
-    } else if (n->ToText()) {
-        return XmlStreamReader::TokenType::Characters;
-    } else if (n->ToComment()) {
-        return XmlStreamReader::TokenType::Comment;
-    } else if (n->ToDeclaration()) {
-        return XmlStreamReader::TokenType::StartDocument;
-    } else if (n->ToDocument()) {
-        return XmlStreamReader::TokenType::EndDocument;
-    } else if (n->ToUnknown()) {
-        return XmlStreamReader::TokenType::DTD;
-    }
-    return XmlStreamReader::TokenType::Unknown;
-}
-
-static std::pair<XMLNode*, XmlStreamReader::TokenType> resolveNode(XMLNode* currentNode, XmlStreamReader::TokenType currentToken)
-{
-    if (currentToken == XmlStreamReader::TokenType::StartElement) {
-        XMLNode* child = currentNode->FirstChild();
-        if (child) {
-            return { child, resolveToken(child, true) };
-        }
-
-        XMLNode* sibling = currentNode->NextSibling();
-        if (!sibling || sibling->ToElement() || sibling->ToText() || sibling->ToComment()) {
-            return { currentNode, XmlStreamReader::TokenType::EndElement };
-        }
-    }
-
-    XMLNode* sibling = currentNode->NextSibling();
-    if (sibling) {
-        return { sibling, resolveToken(sibling, true) };
-    }
-
-    XMLNode* parent = currentNode->Parent();
-    if (parent) {
-        return { parent, resolveToken(parent, false) };
-    }
-
-    return { nullptr, XmlStreamReader::TokenType::EndDocument };
-}
-
 XmlStreamReader::TokenType XmlStreamReader::readNext()
 {
     if (m_token == TokenType::Invalid) {
         return m_token;
     }
 
-    if (m_xml->err != XML_SUCCESS || m_token == EndDocument) {
-        m_xml->node = nullptr;
+    if (m_xml->err != XmlError::NoError || m_token == EndDocument) {
+        m_xml->clearToken();
         m_token = TokenType::Invalid;
         return m_token;
     }
 
-    if (!m_xml->node) {
-        m_xml->node = m_xml->doc.FirstChild();
-        m_token = m_xml->node->ToDeclaration() ? TokenType::StartDocument : resolveToken(m_xml->node, true);
-        return m_token;
-    }
-
-    std::pair<XMLNode*, XmlStreamReader::TokenType> p = resolveNode(m_xml->node, m_token);
-
-    m_xml->node = p.first;
-    m_token = p.second;
+    m_token = m_xml->readToken();
 
     if (m_token == XmlStreamReader::TokenType::DTD) {
         tryParseEntity(m_xml);
@@ -212,7 +851,7 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 {
     static const char* ENTITY = { "ENTITY" };
 
-    const char* str = xml->node->Value();
+    const char* str = xml->value.ascii();
     if (std::strncmp(str, ENTITY, 6) == 0) {
         // Syntax: '<!ENTITY [%] Name [SYSTEM|PUBLIC] "Value" [additional info] >'
         // the '<!' and '>' stripped away already from str
@@ -239,7 +878,7 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 
 String XmlStreamReader::nodeValue(Xml* xml) const
 {
-    String str = String::fromUtf8(xml->node->Value());
+    String str = String::fromUtf8(xml->value.ascii());
     if (!m_entities.empty()) {
         for (const auto& p : m_entities) {
             str.replace(p.first, p.second);
@@ -289,7 +928,7 @@ void XmlStreamReader::skipCurrentElement()
 
 AsciiStringView XmlStreamReader::name() const
 {
-    return (m_xml->node && m_xml->node->ToElement()) ? m_xml->node->Value() : AsciiStringView();
+    return m_xml->name;
 }
 
 bool XmlStreamReader::hasAttribute(const char* name) const
@@ -298,24 +937,17 @@ bool XmlStreamReader::hasAttribute(const char* name) const
         return false;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return false;
+    for (const auto& a : m_xml->attributes) {
+        if (a.first == name) {
+            return true;
+        }
     }
-    return e->FindAttribute(name) != nullptr;
+    return false;
 }
 
 String XmlStreamReader::attribute(const char* name) const
 {
-    if (m_token != TokenType::StartElement) {
-        return String();
-    }
-
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return String();
-    }
-    return String::fromUtf8(e->Attribute(name));
+    return String::fromUtf8(asciiAttribute(name).ascii());
 }
 
 String XmlStreamReader::attribute(const char* name, const String& def) const
@@ -329,11 +961,12 @@ AsciiStringView XmlStreamReader::asciiAttribute(const char* name) const
         return AsciiStringView();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return AsciiStringView();
+    for (const auto& a : m_xml->attributes) {
+        if (a.first == name) {
+            return a.second;
+        }
     }
-    return e->Attribute(name);
+    return AsciiStringView();
 }
 
 AsciiStringView XmlStreamReader::asciiAttribute(const char* name, const AsciiStringView& def) const
@@ -368,15 +1001,11 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
         return attrs;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return attrs;
-    }
-
-    for (const XMLAttribute* xa = e->FirstAttribute(); xa; xa = xa->Next()) {
+    attrs.reserve(m_xml->attributes.size());
+    for (const auto& xa : m_xml->attributes) {
         Attribute a;
-        a.name = xa->Name();
-        a.value = String::fromUtf8(xa->Value());
+        a.name = xa.first;
+        a.value = String::fromUtf8(xa.second.ascii());
         attrs.push_back(std::move(a));
     }
     return attrs;
@@ -384,23 +1013,22 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
 
 String XmlStreamReader::readBody() const
 {
-    if (m_xml->node) {
-        XMLPrinter printer;
-
-        const XMLElement* child = m_xml->node->FirstChildElement();
-        while (child) {
-            child->Accept(&printer);
-            child = child->NextSiblingElement();
-        }
+    if (m_token != TokenType::StartElement || m_xml->pendingEndElement) {
+        return String();
+    }
 
-        return String::fromStdString(printer.CStr());
+    const size_t end = m_xml->findBodyEnd();
+    if (end == npos) {
+        return String();
     }
-    return String();
+
+    String body = String::fromUtf8(ByteArray::fromRawData(m_xml->data + m_xml->bodyBegin, end - m_xml->bodyBegin));
+    return body.trimmed();
 }
 
 String XmlStreamReader::text() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
         return nodeValue(m_xml);
     }
     return String();
@@ -408,8 +1036,8 @@ String XmlStreamReader::text() const
 
 AsciiStringView XmlStreamReader::asciiText() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
-        return m_xml->node->Value();
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
+        return m_xml->value;
     }
     return AsciiStringView();
 }
@@ -424,6 +1052,7 @@ String XmlStreamReader::readText()
                 result = nodeValue(m_xml);
                 break;
             case EndElement:
+            case Invalid:
                 return result;
             case Comment:
                 break;
@@ -444,9 +1073,10 @@ AsciiStringView XmlStreamReader::readAsciiText()
         while (1) {
             switch (readNext()) {
             case Characters:
-                result = AsciiStringView(m_xml->node->Value());
+                result = m_xml->value;
                 break;
             case EndElement:
+            case Invalid:
                 return result;
             case Comment:
                 break;
@@ -474,16 +1104,12 @@ double XmlStreamReader::readDouble(bool* ok)
 
 int64_t XmlStreamReader::lineNumber() const
 {
-    int64_t lineNum = m_xml->doc.ErrorLineNum();
-    if (lineNum == 0 && m_xml->node) {
-        lineNum = m_xml->node->GetLineNum();
-    }
-    return lineNum;
+    return m_xml->err != XmlError::NoError ? m_xml->errLine : m_xml->tokenLine;
 }
 
 int64_t XmlStreamReader::columnNumber() const
 {
-    return 0;
+    return m_xml->err != XmlError::NoError ? 0 : m_xml->tokenColumn;
 }
 
 XmlStreamReader::Error XmlStreamReader::error() const
@@ -492,8 +1118,7 @@ XmlStreamReader::Error XmlStreamReader::error() const
         return CustomError;
     }
 
-    XMLError err = m_xml->doc.ErrorID();
-    if (err == XML_SUCCESS) {
+    if (m_xml->err == XmlError::NoError) {
         return NoError;
     }
 
@@ -510,7 +1135,16 @@ String XmlStreamReader::errorString() const
     if (!m_xml->customErr.empty()) {
         return m_xml->customErr;
     }
-    return String::fromUtf8(m_xml->doc.ErrorStr());
+
+    if (m_xml->err == XmlError::NoError) {
+        return String();
+    }
+
+    String str = String(u"Error=%1 Line number=%2").arg(String::fromAscii(errorName(m_xml->err))).arg(m_xml->errLine);
+    if (!m_xml->errDetails.empty()) {
+        str += u": " + m_xml->errDetails;
+    }
+    return str;
 }
 
 void XmlStreamReader::raiseError(const String& message)
@@ -68,6 +68,8 @@ public:
     XmlStreamReader();
     explicit XmlStreamReader(io::IODevice* device);
     explicit XmlStreamReader(const ByteArray& data);
+    //! NOTE Takes the data over, without a copy if nothing else refers to it
+    explicit XmlStreamReader(ByteArray&& data);
 #ifndef NO_QT_SUPPORT
     explicit XmlStreamReader(const QByteArray& data);
 #endif
@@ -77,6 +79,7 @@ public:
     XmlStreamReader& operator=(const XmlStreamReader&) = delete;
 
     void setData(const ByteArray& data);
+    void setData(ByteArray&& data);
 
     bool readNextStartElement();
     bool atEnd() const;
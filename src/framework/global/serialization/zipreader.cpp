@@ -23,8 +23,11 @@
 
 #include "global/io/file.h"
 #include "global/io/dir.h"
+#include "global/io/mappedfile.h"
 #include "internal/zipcontainer.h"
 
+#include "log.h"
+
 using namespace muse;
 using namespace muse::io;
 
@@ -33,12 +36,25 @@ struct ZipReader::Impl
     ZipContainer* zip = nullptr;
     IODevice* device = nullptr;
     bool isSelfDevice = false;
+    bool isMapped = false;
 };
 
-ZipReader::ZipReader(const io::path_t& filePath)
+ZipReader::ZipReader(const io::path_t& filePath, Mode mode)
     : m_filePath(filePath)
 {
     m_impl = new Impl();
+
+    if (mode == Mode::Mapped) {
+        std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(filePath);
+        if (file->open()) {
+            m_impl->zip = new ZipContainer(std::shared_ptr<const MappedFile>(file));
+            m_impl->isMapped = true;
+            return;
+        }
+
+        LOGW() << "failed map file, will be read: " << filePath;
+    }
+
     m_impl->device = new File(filePath);
     m_impl->isSelfDevice = true;
     if (m_impl->device->open(IODevice::ReadOnly)) {
@@ -72,9 +88,19 @@ bool ZipReader::exists() const
     return true;
 }
 
+bool ZipReader::isOpened() const
+{
+    if (m_impl->isMapped) {
+        return true;
+    }
+
+    return m_impl->device ? m_impl->device->isOpen() : false;
+}
+
 void ZipReader::close()
 {
     m_impl->zip->close();
+    m_impl->isMapped = false;
 }
 
 bool ZipReader::hasError() const
@@ -111,6 +137,11 @@ ByteArray ZipReader::fileData(const std::string& fileName) const
     return m_impl->zip->fileData(fileName);
 }
 
+bool ZipReader::fileData(const std::string& fileName, ByteArray& data) const
+{
+    return m_impl->zip->fileData(fileName, data);
+}
+
 // ===========================
 // ZipUnpack
 // ===========================
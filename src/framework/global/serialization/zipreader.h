@@ -44,17 +44,28 @@ public:
         bool isValid() const { return isDir || isFile || isSymLink; }
     };
 
-    explicit ZipReader(const io::path_t& filePath);
+    enum class Mode {
+        Device,
+        //! NOTE The file is mapped into memory: the central directory is read once,
+        //! the stored files are returned as views of the mapping (they keep it alive)
+        //! and the deflated ones are inflated straight from it
+        Mapped
+    };
+
+    explicit ZipReader(const io::path_t& filePath, Mode mode = Mode::Device);
     explicit ZipReader(io::IODevice* device);
     ~ZipReader();
 
     bool exists() const;
+    bool isOpened() const;
     void close();
     bool hasError() const;
 
     std::vector<FileInfo> fileInfoList() const;
     bool fileExists(const std::string& fileName) const;
     ByteArray fileData(const std::string& fileName) const;
+    //! NOTE Reads the file into the data, reusing its memory
+    bool fileData(const std::string& fileName, ByteArray& data) const;
 
 private:
     struct Impl;
@@ -21,17 +21,32 @@
  */
 #include "zipwriter.h"
 
+#include <deque>
+#include <future>
+
 #include "global/io/file.h"
+#include "global/concurrency/taskscheduler.h"
 #include "internal/zipcontainer.h"
 
 #include "log.h"
 
 using namespace muse;
 
+//! NOTE Files smaller than this are compressed in place, if there are no files waiting before them
+static constexpr size_t MIN_CONCURRENT_COMPRESS_SIZE = 16 * 1024;
+
 struct ZipWriter::Impl
 {
     ZipContainer* zip = nullptr;
     bool isClosed = false;
+
+    struct PendingFile {
+        std::string fileName;
+        std::future<ZipContainer::Entry> entry;
+    };
+
+    //! NOTE The files being compressed, in the order they were added
+    std::deque<PendingFile> pendingFiles;
 };
 
 ZipWriter::ZipWriter(const io::path_t& filePath)
@@ -65,8 +80,19 @@ ZipWriter::~ZipWriter()
     }
 }
 
-void ZipWriter::flush()
+void ZipWriter::flush(bool waitAll)
 {
+    //! NOTE The entries are written in the order the files were added,
+    //! so the archive doesn't depend on which compression finishes first
+    while (!m_impl->pendingFiles.empty()) {
+        Impl::PendingFile& file = m_impl->pendingFiles.front();
+        if (!waitAll && file.entry.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            break;
+        }
+
+        m_impl->zip->addFile(file.fileName, file.entry.get());
+        m_impl->pendingFiles.pop_front();
+    }
 }
 
 void ZipWriter::close()
@@ -75,9 +101,10 @@ void ZipWriter::close()
         return;
     }
 
+    flush(true);
+
     m_impl->zip->close();
     if (m_device) {
-        flush();
         m_device->close();
     }
 
@@ -91,6 +118,19 @@ bool ZipWriter::hasError() const
 
 void ZipWriter::addFile(const std::string& fileName, const ByteArray& data)
 {
-    m_impl->zip->addFile(fileName, data);
-    flush();
+    const ZipContainer::CompressionPolicy policy = m_impl->zip->compressionPolicy();
+    const std::tm lastModified = ZipContainer::currentTime();
+
+    if (m_impl->pendingFiles.empty() && data.size() < MIN_CONCURRENT_COMPRESS_SIZE) {
+        m_impl->zip->addFile(fileName, ZipContainer::makeEntry(data, policy, lastModified));
+        return;
+    }
+
+    std::future<ZipContainer::Entry> entry = sharedTaskScheduler()->submit([data, policy, lastModified]() {
+        return ZipContainer::makeEntry(data, policy, lastModified);
+    });
+
+    m_impl->pendingFiles.push_back({ fileName, std::move(entry) });
+
+    flush(false);
 }
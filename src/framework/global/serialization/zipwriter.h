@@ -41,7 +41,8 @@ public:
 
 private:
 
-    void flush();
+    //! NOTE Writes the compressed files, keeping the order they were added
+    void flush(bool waitAll);
 
     struct Impl;
     Impl* m_impl = nullptr;
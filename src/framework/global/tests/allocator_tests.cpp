@@ -21,8 +21,13 @@
  */
 #include <gtest/gtest.h>
 
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "allocator.h"
@@ -200,3 +205,210 @@ TEST_F(Global_AllocatorTests, Many_NewCleanup)
     EXPECT_EQ(info.totalChunks, 12); // DEFAULT_BLOCK_SIZE * 3
     EXPECT_EQ(info.freeChunks, 12);
 }
+
+TEST_F(Global_AllocatorTests, Concurrent_NewDelete)
+{
+    //! GIVEN several threads creating and destroying items at once (e.g. rendering several parts)
+    ObjectAllocator::DEFAULT_BLOCK_SIZE = sizeof(Item13) * 16;
+
+    constexpr size_t THREAD_COUNT = 4;
+    constexpr size_t ITEM_COUNT = 1000;
+
+    std::vector<std::vector<ItemBase*> > items(THREAD_COUNT);
+    std::vector<std::thread> threads;
+
+    //! DO Create Items concurrently, destroying every second one
+    for (size_t t = 0; t < THREAD_COUNT; ++t) {
+        threads.emplace_back([&items, t]() {
+            for (size_t i = 0; i < ITEM_COUNT; ++i) {
+                ItemBase* item = new ItemBase(static_cast<uint8_t>(i));
+                ItemBase* temp = new ItemBase(static_cast<uint8_t>(i));
+                delete temp;
+                items[t].push_back(item);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //! CHECK Every item got its own chunk
+    std::set<ItemBase*> uniqueItems;
+    for (const std::vector<ItemBase*>& threadItems : items) {
+        for (ItemBase* item : threadItems) {
+            EXPECT_TRUE(item->alive());
+            uniqueItems.insert(item);
+        }
+    }
+    EXPECT_EQ(uniqueItems.size(), THREAD_COUNT * ITEM_COUNT);
+
+    //! CHECK Allocator state
+    ObjectAllocator::Info info = ItemBase::allocator().stateInfo();
+    EXPECT_EQ(info.usedChunks(), THREAD_COUNT * ITEM_COUNT);
+
+    //! DO Destroy Items
+    for (const std::vector<ItemBase*>& threadItems : items) {
+        for (ItemBase* item : threadItems) {
+            delete item;
+        }
+    }
+
+    //! CHECK Allocator state
+    info = ItemBase::allocator().stateInfo();
+    EXPECT_EQ(info.usedChunks(), 0);
+}
+
+TEST_F(Global_AllocatorTests, CrossThread_Delete)
+{
+    //! GIVEN items created on one thread
+    ObjectAllocator::DEFAULT_BLOCK_SIZE = sizeof(Item3) * 16;
+
+    constexpr size_t ITEM_COUNT = 1000;
+
+    std::vector<ItemBase*> items;
+    std::thread producer([&items]() {
+        for (size_t i = 0; i < ITEM_COUNT; ++i) {
+            items.push_back(new Item3(static_cast<uint8_t>(i)));
+        }
+    });
+    producer.join();
+
+    ObjectAllocator::Info info = Item3::allocator().stateInfo();
+    const size_t totalChunks = info.totalChunks;
+    EXPECT_EQ(info.usedChunks(), ITEM_COUNT);
+
+    //! DO Destroy them on another thread
+    std::thread consumer([&items]() {
+        for (ItemBase* item : items) {
+            delete item;
+        }
+    });
+    consumer.join();
+
+    //! CHECK All chunks are free, and reused by the next items
+    info = Item3::allocator().stateInfo();
+    EXPECT_EQ(info.usedChunks(), 0);
+
+    items.clear();
+    for (size_t i = 0; i < ITEM_COUNT; ++i) {
+        items.push_back(new Item3(static_cast<uint8_t>(i)));
+    }
+
+    info = Item3::allocator().stateInfo();
+    EXPECT_EQ(info.totalChunks, totalChunks);
+
+    for (ItemBase* item : items) {
+        delete item;
+    }
+}
+
+TEST_F(Global_AllocatorTests, ThreadExit_AfterAllocatorDestroyed)
+{
+    //! GIVEN An allocator used by a thread that outlives it (e.g. a thread exiting at static teardown)
+    auto allocator = std::make_unique<ObjectAllocator>("test", "Temp", nullptr);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool allocatorUsed = false;
+    bool allocatorDestroyed = false;
+
+    std::thread worker([&]() {
+        void* ptr = allocator->alloc(sizeof(uint64_t));
+        allocator->free(ptr);
+
+        //! DO Wait until the allocator is destroyed, then exit
+        std::unique_lock lock(mutex);
+        allocatorUsed = true;
+        cv.notify_one();
+        cv.wait(lock, [&allocatorDestroyed]() { return allocatorDestroyed; });
+    });
+
+    {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&allocatorUsed]() { return allocatorUsed; });
+    }
+
+    //! CHECK The cache of the thread holds the free chunks
+    EXPECT_GT(allocator->stateInfo().cachedChunks, 0);
+
+    allocator.reset();
+
+    {
+        std::lock_guard lock(mutex);
+        allocatorDestroyed = true;
+    }
+    cv.notify_one();
+
+    //! CHECK The thread exits without touching the destroyed allocator (see the sanitizer builds)
+    worker.join();
+}
+
+TEST_F(Global_AllocatorTests, Arena_Release)
+{
+    //! GIVEN the default size of the allocator block is less than the size of all items
+    ObjectAllocator::DEFAULT_BLOCK_SIZE = sizeof(Item13) * 4;
+
+    ObjectAllocator::Info info = Item13::allocator().stateInfo();
+    const size_t blockCount = info.blockCount;
+
+    //! DO Create Items in an arena
+    std::vector<ItemBase*> items;
+    ObjectArena* arena = new ObjectArena("test");
+    {
+        ObjectArena::Scope scope(arena);
+        for (size_t i = 0; i < 10; ++i) {
+            items.push_back(new Item13(static_cast<uint8_t>(i)));
+        }
+    }
+
+    info = Item13::allocator().stateInfo();
+    EXPECT_EQ(info.blockCount, blockCount + 3);
+
+    //! DO Destroy all, but the last one, and release the arena
+    for (size_t i = 0; i < items.size() - 1; ++i) {
+        delete items.at(i);
+    }
+
+    delete arena;
+
+    //! CHECK Only the block of the alive item is left
+    ItemBase* last = items.back();
+    EXPECT_TRUE(last->alive());
+
+    info = Item13::allocator().stateInfo();
+    EXPECT_EQ(info.blockCount, blockCount + 1);
+    EXPECT_EQ(info.usedChunks(), 1);
+
+    //! DO Destroy the last one
+    delete last;
+
+    //! CHECK The arena memory is given back
+    info = Item13::allocator().stateInfo();
+    EXPECT_EQ(info.blockCount, blockCount);
+    EXPECT_EQ(info.usedChunks(), 0);
+}
+
+TEST_F(Global_AllocatorTests, SharedPolicy_NewDelete)
+{
+    //! GIVEN the shared policy
+    ObjectAllocator::setPolicy(ObjectAllocator::Policy::Shared);
+
+    //! DO Create Item
+    ItemBase* item = new Item8(1);
+
+    //! CHECK No chunk is held by the thread cache
+    ObjectAllocator::Info info = Item8::allocator().stateInfo();
+    EXPECT_EQ(info.usedChunks(), 1);
+    EXPECT_EQ(info.cachedChunks, 0);
+
+    //! DO Destroy Item
+    delete item;
+
+    //! CHECK
+    info = Item8::allocator().stateInfo();
+    EXPECT_EQ(info.usedChunks(), 0);
+    EXPECT_EQ(info.cachedChunks, 0);
+
+    ObjectAllocator::setPolicy(ObjectAllocator::Policy::ThreadCache);
+}
@@ -0,0 +1,272 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "global/thirdparty/kors_async/async/internal/lockfreequeue.h"
+#include "global/thirdparty/kors_async/async/internal/queuedinvoker.h"
+
+using namespace kors::async;
+
+class Global_Async_QueueTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_Async_QueueTests, InplaceFunctor)
+{
+    int calls = 0;
+
+    //! [GIVEN] A small callable and one that doesn't fit into the inline storage
+    auto small = [&calls]() { ++calls; };
+    std::array<int, 32> payload {};
+    payload[31] = 10;
+    auto big = [&calls, payload]() { calls += payload[31]; };
+
+    EXPECT_TRUE(LockFreeQueue::Functor::fitsInline<decltype(small)>());
+    EXPECT_FALSE(LockFreeQueue::Functor::fitsInline<decltype(big)>());
+
+    //! [WHEN] They are stored, moved and called
+    LockFreeQueue::Functor f1(small);
+    LockFreeQueue::Functor f2(big);
+    LockFreeQueue::Functor f3(std::move(f2));
+    f1();
+    f3();
+
+    //! [THEN] Both are called, the moved-from functor is empty
+    EXPECT_EQ(calls, 11);
+    EXPECT_FALSE(f2);
+}
+
+TEST_F(Global_Async_QueueTests, PushPop)
+{
+    //! [GIVEN] A queue, the capacity is rounded up to a power of two
+    LockFreeQueue queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+
+    //! [WHEN] It's filled up
+    std::vector<int> called;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush([&called, i]() { called.push_back(i); }));
+    }
+
+    //! [THEN] The next push fails
+    EXPECT_FALSE(queue.tryPush([]() {}));
+
+    //! [WHEN] Functors are popped
+    queue.callPending();
+
+    //! [THEN] They are called in order and the queue is empty
+    EXPECT_EQ(called, std::vector<int>({ 0, 1, 2, 3 }));
+    EXPECT_FALSE(queue.popAndCall());
+    EXPECT_TRUE(queue.tryPush([]() {}));
+}
+
+TEST_F(Global_Async_QueueTests, MultipleProducers)
+{
+    //! [GIVEN] A few producers pushing numbered events
+    constexpr int PRODUCERS = 4;
+    constexpr int EVENTS = 20000;
+
+    LockFreeQueue queue(256);
+    std::array<int, PRODUCERS> lastReceived;
+    lastReceived.fill(-1);
+    bool ordered = true;
+    int received = 0;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < EVENTS; ++i) {
+                auto f = [&, p, i]() {
+                    ordered = ordered && lastReceived[p] == i - 1;
+                    lastReceived[p] = i;
+                    ++received;
+                };
+                while (!queue.tryPush(f)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    //! [WHEN] The consumer pops them concurrently
+    while (received < PRODUCERS * EVENTS) {
+        queue.callPending();
+        std::this_thread::yield();
+    }
+
+    for (std::thread& th : producers) {
+        th.join();
+    }
+
+    //! [THEN] Every event is received once, in the order of its producer
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(received, PRODUCERS * EVENTS);
+}
+
+TEST_F(Global_Async_QueueTests, InvokerOverflowKeepsOrder)
+{
+    //! [GIVEN] A thread that receives events through a small lock-free queue
+    std::atomic<bool> ready = false;
+    std::atomic<bool> sent = false;
+    std::vector<int> called;
+
+    std::thread receiver([&]() {
+        QueuedInvoker::instance()->useLockFreeQueue(4, nullptr);
+        ready = true;
+        while (!sent) {
+            std::this_thread::yield();
+        }
+        QueuedInvoker::instance()->processEvents();
+        QueuedInvoker::instance()->processEvents();
+    });
+
+    while (!ready) {
+        std::this_thread::yield();
+    }
+
+    //! [WHEN] More events are sent than the queue can hold
+    for (int i = 0; i < 10; ++i) {
+        QueuedInvoker::instance()->invoke(receiver.get_id(), [&called, i]() { called.push_back(i); });
+    }
+    sent = true;
+    receiver.join();
+
+    //! [THEN] All of them are received, in order
+    EXPECT_EQ(called, std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+}
+
+TEST_F(Global_Async_QueueTests, InvokerOverflowWaitsForClaimedEvents)
+{
+    //! [GIVEN] A thread that receives events through a small lock-free queue
+    std::atomic<bool> ready = false;
+    std::atomic<bool> sent = false;
+    std::vector<int> called;
+
+    std::thread receiver([&]() {
+        QueuedInvoker::instance()->useLockFreeQueue(4, nullptr);
+        ready = true;
+        while (!sent) {
+            std::this_thread::yield();
+        }
+        QueuedInvoker::instance()->processEvents();
+    });
+
+    while (!ready) {
+        std::this_thread::yield();
+    }
+
+    //! [GIVEN] An event whose cell is claimed, but not published until it's released
+    std::atomic<bool> claimed = false;
+    std::atomic<bool> released = false;
+
+    struct SlowCopy {
+        std::atomic<bool>* claimed = nullptr;
+        std::atomic<bool>* released = nullptr;
+        std::vector<int>* called = nullptr;
+
+        SlowCopy(std::atomic<bool>* c, std::atomic<bool>* r, std::vector<int>* v)
+            : claimed(c), released(r), called(v) {}
+
+        SlowCopy(const SlowCopy& other)
+            : claimed(other.claimed), released(other.released), called(other.called)
+        {
+            *claimed = true;
+            while (!*released) {
+                std::this_thread::yield();
+            }
+        }
+
+        SlowCopy(SlowCopy&& other) noexcept = default;
+
+        void operator()() const { called->push_back(0); }
+    };
+
+    const SlowCopy slowEvent(&claimed, &released, &called);
+    std::thread slowProducer([&]() {
+        QueuedInvoker::instance()->invoke(receiver.get_id(), slowEvent);
+    });
+
+    while (!claimed) {
+        std::this_thread::yield();
+    }
+
+    //! [WHEN] Another producer fills the queue behind it and overflows
+    for (int i = 1; i < 6; ++i) {
+        QueuedInvoker::instance()->invoke(receiver.get_id(), [&called, i]() { called.push_back(i); });
+    }
+    sent = true;
+
+    //! [WHEN] The claimed event is published while the receiver processes the events
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    released = true;
+
+    slowProducer.join();
+    receiver.join();
+
+    //! [THEN] The events pushed before the overflowed ones are called before them
+    EXPECT_EQ(called, std::vector<int>({ 0, 1, 2, 3, 4, 5 }));
+}
+
+TEST_F(Global_Async_QueueTests, InvokerDetachesCallback)
+{
+    //! [GIVEN] A thread that is notified about its lock-free queued events
+    std::atomic<int> notified = 0;
+    std::atomic<int> step = 0;
+
+    std::thread receiver([&]() {
+        QueuedInvoker::instance()->useLockFreeQueue(4, [&notified]() { ++notified; });
+        step = 1;
+        while (step != 2) {
+            std::this_thread::yield();
+        }
+
+        //! [WHEN] It detaches the callback, like a finishing thread
+        QueuedInvoker::instance()->onEventsQueued(std::this_thread::get_id(), nullptr);
+        QueuedInvoker::instance()->processEvents();
+        step = 3;
+    });
+
+    while (step != 1) {
+        std::this_thread::yield();
+    }
+
+    QueuedInvoker::instance()->invoke(receiver.get_id(), []() {});
+    EXPECT_EQ(notified, 1);
+
+    step = 2;
+    while (step != 3) {
+        std::this_thread::yield();
+    }
+
+    //! [THEN] The next events don't call it
+    QueuedInvoker::instance()->invoke(receiver.get_id(), []() {});
+    EXPECT_EQ(notified, 1);
+
+    receiver.join();
+}
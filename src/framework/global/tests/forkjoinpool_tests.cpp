@@ -0,0 +1,168 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "concurrency/forkjoinpool.h"
+
+using namespace muse;
+
+class Global_ForkJoinPoolTests : public ::testing::Test
+{
+};
+
+//! NOTE Longer than the idle spin of the workers, so that they park
+static void waitUntilWorkersPark()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+TEST_F(Global_ForkJoinPoolTests, ForkJoin)
+{
+    ForkJoinPool pool(4);
+    EXPECT_EQ(pool.threadIdSet().size(), pool.threadPoolSize());
+
+    //! [GIVEN] A job writing to plain memory
+    constexpr size_t COUNT = 1000;
+    std::vector<int> results(COUNT, 0);
+    std::vector<std::thread::id> threads(COUNT);
+
+    //! [WHEN] It's run on the pool
+    pool.parallelFor(COUNT, [&](size_t idx) {
+        results[idx] += static_cast<int>(idx) + 1;
+        threads[idx] = std::this_thread::get_id();
+    });
+
+    //! [THEN] Every index has been called once, and all the writes are visible
+    for (size_t i = 0; i < COUNT; ++i) {
+        EXPECT_EQ(results[i], static_cast<int>(i) + 1);
+    }
+
+    //! [THEN] Only the pool threads and the calling thread took part
+    std::set<std::thread::id> allowed = pool.threadIdSet();
+    allowed.insert(std::this_thread::get_id());
+    for (const std::thread::id& id : threads) {
+        EXPECT_TRUE(allowed.count(id) != 0);
+    }
+
+    //! [THEN] An empty job returns at once
+    bool called = false;
+    pool.parallelFor(0, [&](size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST_F(Global_ForkJoinPoolTests, RepeatedBlocks)
+{
+    ForkJoinPool pool(3);
+
+    //! [GIVEN] Many jobs of different sizes, back to back, as for the audio blocks
+    constexpr int BLOCKS = 5000;
+    std::vector<int> results(32, 0);
+
+    for (int block = 0; block < BLOCKS; ++block) {
+        const size_t count = 1 + block % results.size();
+
+        //! [WHEN] One of them is run
+        pool.parallelFor(count, [&results, block](size_t idx) {
+            results[idx] = block;
+        });
+
+        //! [THEN] It's complete on return, nothing of a previous job is run again
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(results[i], block);
+        }
+
+        //! [WHEN] The pool gets idle from time to time, the workers are woken up again
+        if (block % 1000 == 999) {
+            waitUntilWorkersPark();
+        }
+    }
+}
+
+TEST_F(Global_ForkJoinPoolTests, ConcurrentCalls)
+{
+    ForkJoinPool pool(4);
+
+    //! [GIVEN] Jobs whose calls really overlap
+    constexpr size_t COUNT = 64;
+    std::atomic<int> running = 0;
+    std::atomic<int> maxRunning = 0;
+    std::atomic<size_t> calls = 0;
+
+    for (int block = 0; block < 20; ++block) {
+        pool.parallelFor(COUNT, [&](size_t) {
+            int now = running.fetch_add(1) + 1;
+            int max = maxRunning.load();
+            while (now > max && !maxRunning.compare_exchange_weak(max, now)) {
+            }
+
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            running.fetch_sub(1);
+            calls.fetch_add(1);
+        });
+
+        //! [THEN] No call is still running on return
+        EXPECT_EQ(running.load(), 0);
+    }
+
+    EXPECT_EQ(calls.load(), 20 * COUNT);
+    if (pool.threadPoolSize() > 1) {
+        EXPECT_GT(maxRunning.load(), 1);
+    }
+}
+
+TEST_F(Global_ForkJoinPoolTests, ShutdownWhileIdle)
+{
+    //! [GIVEN] A pool destroyed right away, while the workers are starting
+    {
+        ForkJoinPool pool(4);
+    }
+
+    //! [GIVEN] A pool destroyed while the workers spin after a job
+    {
+        ForkJoinPool pool(4);
+        std::atomic<size_t> calls = 0;
+        pool.parallelFor(16, [&calls](size_t) { calls.fetch_add(1); });
+        EXPECT_EQ(calls.load(), 16u);
+    }
+
+    //! [GIVEN] A pool destroyed while the workers are parked
+    {
+        ForkJoinPool pool(4);
+        std::atomic<size_t> calls = 0;
+        pool.parallelFor(16, [&calls](size_t) { calls.fetch_add(1); });
+        waitUntilWorkersPark();
+
+        //! [THEN] Parked workers still take jobs
+        pool.parallelFor(16, [&calls](size_t) { calls.fetch_add(1); });
+        EXPECT_EQ(calls.load(), 32u);
+
+        waitUntilWorkersPark();
+    }
+
+    //! [THEN] Every pool has joined its workers, nothing hangs
+}
@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "io/mappedfile.h"
+
+using namespace muse;
+using namespace muse::io;
+
+class Global_IO_MappedFileTests : public ::testing::Test
+{
+};
+
+static void createFile(const path_t& p, const std::string& content)
+{
+    std::ofstream f(p.c_str(), std::ios::binary | std::ios::trunc);
+    f << content;
+}
+
+TEST_F(Global_IO_MappedFileTests, Map)
+{
+    //! GIVEN Some file
+    const path_t filePath("MappedFileTests_Map.bin");
+    std::string ref = "Hello World!";
+    ref.push_back('\0');
+    ref += "after zero";
+    createFile(filePath, ref);
+
+    MappedFile file(filePath);
+    EXPECT_FALSE(file.isOpen());
+
+    //! DO Map it
+    ASSERT_TRUE(file.open());
+
+    //! CHECK The whole content is visible
+    EXPECT_TRUE(file.isOpen());
+    EXPECT_EQ(file.filePath(), filePath);
+    ASSERT_EQ(file.size(), ref.size());
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(file.data()), file.size()), ref);
+
+    //! DO Unmap it
+    file.close();
+
+    //! CHECK
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_EQ(file.data(), nullptr);
+    EXPECT_EQ(file.size(), 0);
+
+    std::remove(filePath.c_str());
+}
+
+TEST_F(Global_IO_MappedFileTests, Reopen)
+{
+    //! GIVEN A mapped file
+    const path_t filePath("MappedFileTests_Reopen.bin");
+    createFile(filePath, "first");
+
+    MappedFile file(filePath);
+    ASSERT_TRUE(file.open());
+    EXPECT_EQ(file.size(), 5);
+
+    //! DO Replace the file and map it again
+    std::remove(filePath.c_str());
+    createFile(filePath, "second one");
+    ASSERT_TRUE(file.open());
+
+    //! CHECK The new content is mapped
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(file.data()), file.size()), "second one");
+
+    file.close();
+    std::remove(filePath.c_str());
+}
+
+TEST_F(Global_IO_MappedFileTests, NotMapped)
+{
+    //! CHECK A missing file isn't mapped
+    MappedFile missing("MappedFileTests_Missing.bin");
+    EXPECT_FALSE(missing.open());
+    EXPECT_FALSE(missing.isOpen());
+
+    //! CHECK Nor is an empty one
+    const path_t emptyPath("MappedFileTests_Empty.bin");
+    createFile(emptyPath, std::string());
+
+    MappedFile empty(emptyPath);
+    EXPECT_FALSE(empty.open());
+    EXPECT_FALSE(empty.isOpen());
+    EXPECT_EQ(empty.size(), 0);
+
+    std::remove(emptyPath.c_str());
+}
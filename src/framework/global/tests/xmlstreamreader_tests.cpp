@@ -0,0 +1,311 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "io/buffer.h"
+#include "io/dir.h"
+#include "io/file.h"
+#include "serialization/xmlstreamreader.h"
+
+#ifdef SYSTEM_TINYXML
+#include <tinyxml2.h>
+#else
+#include "thirdparty/tinyxml/tinyxml2.h"
+#endif
+
+using namespace muse;
+using namespace muse::io;
+
+static const String VTEST_SCORES_DIR(u"/../../../../vtest/scores");
+
+class Global_Ser_XmlStreamReaderTests : public ::testing::Test
+{
+public:
+};
+
+static ByteArray toData(const std::string& str)
+{
+    return ByteArray(str.c_str(), str.size());
+}
+
+//! One line per token: type, name, text and attributes
+static std::vector<std::string> readTokens(XmlStreamReader& xml)
+{
+    std::vector<std::string> tokens;
+    while (xml.readNext() != XmlStreamReader::Invalid) {
+        std::string t = std::string(xml.tokenString()) + " " + std::string(xml.name()) + " " + std::string(xml.asciiText());
+        for (const XmlStreamReader::Attribute& a : xml.attributes()) {
+            t += " " + std::string(a.name) + "=" + a.value.toStdString();
+        }
+        tokens.push_back(t);
+    }
+    return tokens;
+}
+
+//! The token stream the reader produced when it walked a tinyxml2 DOM
+static std::vector<std::string> readDomTokens(const ByteArray& data)
+{
+    using namespace tinyxml2;
+
+    std::vector<std::string> tokens;
+
+    XMLDocument doc;
+    if (doc.Parse(data.constChar(), data.size()) != XML_SUCCESS) {
+        return tokens;
+    }
+
+    auto attributes = [](const XMLNode* n) {
+        std::string str;
+        for (const XMLAttribute* a = n->ToElement()->FirstAttribute(); a; a = a->Next()) {
+            str += std::string(" ") + a->Name() + "=" + a->Value();
+        }
+        return str;
+    };
+
+    std::function<void(const XMLNode*)> walk = [&](const XMLNode* n) {
+        for (; n; n = n->NextSibling()) {
+            if (n->ToElement()) {
+                tokens.push_back(std::string("StartElement ") + n->Value() + " " + attributes(n));
+                walk(n->FirstChild());
+                tokens.push_back(std::string("EndElement ") + n->Value() + " ");
+            } else if (n->ToText()) {
+                tokens.push_back(std::string("Characters  ") + n->Value());
+            } else if (n->ToComment()) {
+                tokens.push_back(std::string("Comment  ") + n->Value());
+            } else if (n->ToDeclaration()) {
+                tokens.push_back("StartDocument  ");
+            } else if (n->ToUnknown()) {
+                tokens.push_back("DTD  ");
+            }
+        }
+    };
+
+    walk(doc.FirstChild());
+    tokens.push_back("EndDocument  ");
+    return tokens;
+}
+
+static io::paths_t vtestScores()
+{
+    RetVal<io::paths_t> files = io::Dir::scanFiles(String::fromUtf8(muse_global_tests_DATA_ROOT) + VTEST_SCORES_DIR,
+                                                   { "*.mscx" }, io::ScanMode::FilesInCurrentDir);
+    return files.ret ? files.val : io::paths_t();
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Tokens)
+{
+    //! GIVEN A document with all kinds of nodes
+    ByteArray data = toData("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                            "<museScore version=\"4.50\">\n"
+                            "  <a x=\"1\" y='two'>text<b/><!-- c --><![CDATA[<raw>]]></a>\n"
+                            "  <c>  spaced  </c>\n"
+                            "</museScore>\n");
+
+    //! DO Read it
+    XmlStreamReader xml(data);
+    std::vector<std::string> tokens = readTokens(xml);
+
+    //! CHECK
+    std::vector<std::string> expected = {
+        "StartDocument  ",
+        "StartElement museScore  version=4.50",
+        "StartElement a  x=1 y=two",
+        "Characters  text",
+        "StartElement b ",
+        "EndElement b ",
+        "Comment   c ",
+        "Characters  <raw>",
+        "EndElement a ",
+        "StartElement c ",
+        "Characters    spaced  ",
+        "EndElement c ",
+        "EndElement museScore ",
+        "EndDocument  ",
+    };
+    EXPECT_EQ(tokens, expected);
+    EXPECT_FALSE(xml.isError());
+    EXPECT_TRUE(xml.atEnd());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, EntitiesAndNewlines)
+{
+    //! GIVEN Escaped attributes and text with Windows line endings
+    ByteArray data = toData("<a v=\"a&amp;b&#65;&#x42;&lt;&unknown;\">x&quot;\r\ny&apos;\rz</a>");
+
+    //! DO Read it
+    XmlStreamReader xml(data);
+
+    //! CHECK
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.asciiAttribute("v"), "a&bAB<&unknown;");
+    EXPECT_EQ(xml.attribute("v"), u"a&bAB<&unknown;");
+    EXPECT_EQ(xml.readText(), u"x\"\ny'\nz");
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Values)
+{
+    //! GIVEN A document with numeric values
+    ByteArray data = toData("<a i=\"12\" d=\"0.5\"><n>42</n><s>abc</s><d>1.5</d></a>");
+
+    //! DO Read it
+    XmlStreamReader xml(data);
+    ASSERT_TRUE(xml.readNextStartElement());
+
+    //! CHECK Attributes
+    EXPECT_EQ(xml.intAttribute("i"), 12);
+    EXPECT_EQ(xml.intAttribute("missing", 7), 7);
+    EXPECT_DOUBLE_EQ(xml.doubleAttribute("d"), 0.5);
+    EXPECT_TRUE(xml.hasAttribute("i"));
+    EXPECT_FALSE(xml.hasAttribute("n"));
+
+    //! CHECK Texts
+    ASSERT_TRUE(xml.readNextStartElement());
+    bool ok = false;
+    EXPECT_EQ(xml.readInt(&ok), 42);
+    EXPECT_TRUE(ok);
+
+    ASSERT_TRUE(xml.readNextStartElement());
+    AsciiStringView s = xml.readAsciiText();
+
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_DOUBLE_EQ(xml.readDouble(), 1.5);
+
+    //! CHECK The views stay valid and terminated while reading further
+    EXPECT_EQ(s, "abc");
+    EXPECT_EQ(std::strlen(s.ascii()), 3);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Device)
+{
+    //! GIVEN A document larger than a read chunk
+    std::string str = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<Score>\n";
+    for (int i = 0; i < 10000; ++i) {
+        str += "  <Chord id=\"" + std::to_string(i) + "\"><Note><pitch>" + std::to_string(i % 128) + "</pitch></Note></Chord>\n";
+    }
+    str += "</Score>\n";
+
+    ByteArray data = toData(str);
+    Buffer buf(&data);
+    buf.open(IODevice::ReadOnly);
+
+    //! DO Read it from the device and from the data
+    XmlStreamReader deviceXml(&buf);
+    XmlStreamReader dataXml(data);
+
+    //! CHECK
+    std::vector<std::string> tokens = readTokens(deviceXml);
+    EXPECT_EQ(tokens.size(), 2 + 7 * 10000 + 2);
+    EXPECT_EQ(tokens, readTokens(dataXml));
+    EXPECT_FALSE(deviceXml.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Error)
+{
+    //! GIVEN A document with a mismatched end tag
+    ByteArray data = toData("<a>\n<b>\n</a>\n");
+
+    //! DO Read it
+    XmlStreamReader xml(data);
+
+    //! CHECK The tokens before the error are delivered
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "b");
+
+    //! CHECK Then the reader stops
+    EXPECT_EQ(xml.readText(), u"");
+    EXPECT_EQ(xml.tokenType(), XmlStreamReader::Invalid);
+    EXPECT_TRUE(xml.atEnd());
+    EXPECT_EQ(xml.error(), XmlStreamReader::NotWellFormedError);
+    EXPECT_EQ(xml.lineNumber(), 3);
+
+    //! CHECK Not a document
+    XmlStreamReader empty(toData("  \n  "));
+    EXPECT_EQ(empty.readNext(), XmlStreamReader::Invalid);
+    EXPECT_TRUE(empty.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, ReadBody)
+{
+    //! GIVEN An element with children
+    ByteArray data = toData("<r><FretDiagram>\n"
+                            "  <string no=\"1\" s=\"a>b\"><dot>1</dot></string>\n"
+                            "  <barre/><!-- </FretDiagram> -->\n"
+                            "</FretDiagram><x/></r>");
+
+    //! DO Read the body
+    XmlStreamReader xml(data);
+    ASSERT_TRUE(xml.readNextStartElement());
+    ASSERT_TRUE(xml.readNextStartElement());
+    String body = xml.readBody();
+
+    //! CHECK
+    EXPECT_EQ(body, u"<string no=\"1\" s=\"a>b\"><dot>1</dot></string>\n  <barre/><!-- </FretDiagram> -->");
+
+    //! CHECK The body is not consumed
+    xml.skipCurrentElement();
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "x");
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, LineNumbers)
+{
+    //! GIVEN A document over several lines
+    ByteArray data = toData("<a>\n  <b/>\n\n    <c>t</c></a>");
+
+    //! DO Read it
+    XmlStreamReader xml(data);
+
+    //! CHECK
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.lineNumber(), 1);
+    EXPECT_EQ(xml.columnNumber(), 1);
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.lineNumber(), 2);
+    EXPECT_EQ(xml.columnNumber(), 3);
+    xml.skipCurrentElement();
+    ASSERT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.lineNumber(), 4);
+    EXPECT_EQ(xml.columnNumber(), 5);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, VTestScores_SameAsDom)
+{
+    io::paths_t files = vtestScores();
+    ASSERT_FALSE(files.empty());
+
+    for (const io::path_t& path : files) {
+        ByteArray data;
+        ASSERT_TRUE(File::readFile(path, data));
+
+        File file(path);
+        ASSERT_TRUE(file.open(IODevice::ReadOnly));
+        XmlStreamReader xml(&file);
+
+        EXPECT_EQ(readTokens(xml), readDomTokens(data)) << path.toStdString();
+        EXPECT_FALSE(xml.isError()) << path.toStdString();
+    }
+}
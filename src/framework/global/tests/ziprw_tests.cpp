@@ -55,3 +55,72 @@ TEST_F(Zip_RW_Tests, Write_And_Read)
 
     reader.close();
 }
+
+TEST_F(Zip_RW_Tests, Write_And_Read_Large_Files_In_Order)
+{
+    //! [GIVEN] A zip file
+    io::IODevice* device = new io::File("test_large.zip");
+    ZipWriter writer(device);
+
+    //! [WHEN] Writing small and large files, the large ones are compressed concurrently
+    std::vector<std::pair<std::string, ByteArray> > files;
+    for (int i = 0; i < 16; ++i) {
+        std::string content = "file " + std::to_string(i) + "\n";
+        const size_t repeats = i % 3 == 0 ? 1 : 20000 + i * 1000;
+        std::string data;
+        for (size_t r = 0; r < repeats; ++r) {
+            data += content;
+        }
+        files.push_back({ "folder/file" + std::to_string(i) + ".txt", ByteArray(data.c_str(), data.size()) });
+    }
+
+    for (const auto& file : files) {
+        writer.addFile(file.first, file.second);
+    }
+
+    writer.close();
+    EXPECT_FALSE(writer.hasError());
+
+    //! [THEN] The files are in the order they were added
+    ZipReader reader(device);
+    std::vector<ZipReader::FileInfo> infos = reader.fileInfoList();
+    ASSERT_EQ(infos.size(), files.size());
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        EXPECT_EQ(infos.at(i).filePath, files.at(i).first);
+        EXPECT_EQ(reader.fileData(files.at(i).first), files.at(i).second);
+    }
+
+    reader.close();
+}
+
+TEST_F(Zip_RW_Tests, Write_And_Read_Mapped)
+{
+    //! [GIVEN] A zip file
+    {
+        ZipWriter writer(io::path_t("test_mapped.zip"));
+        writer.addFile("file1.txt", "Hello World!");
+        writer.addFile("folder/file2.txt", "Hello World 2!");
+        writer.close();
+    }
+
+    //! [WHEN] Reading it mapped into memory
+    ZipReader reader(io::path_t("test_mapped.zip"), ZipReader::Mode::Mapped);
+    EXPECT_TRUE(reader.isOpened());
+
+    //! [THEN] The data can be read back
+    EXPECT_EQ(reader.fileData("file1.txt"), "Hello World!");
+
+    ByteArray data;
+    EXPECT_TRUE(reader.fileData("folder/file2.txt", data));
+    EXPECT_EQ(data, "Hello World 2!");
+
+    EXPECT_FALSE(reader.fileData("missing.txt", data));
+    EXPECT_TRUE(data.empty());
+
+    //! [THEN] The data outlives the reader
+    data = reader.fileData("file1.txt");
+    reader.close();
+    EXPECT_FALSE(reader.isOpened());
+    EXPECT_EQ(data, "Hello World!");
+}
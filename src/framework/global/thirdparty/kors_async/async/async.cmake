@@ -11,6 +11,7 @@ set (KORS_ASYNC_SRC
     ${CMAKE_CURRENT_LIST_DIR}/internal/abstractinvoker.h
     ${CMAKE_CURRENT_LIST_DIR}/internal/queuedinvoker.cpp
     ${CMAKE_CURRENT_LIST_DIR}/internal/queuedinvoker.h
+    ${CMAKE_CURRENT_LIST_DIR}/internal/lockfreequeue.h
     ${CMAKE_CURRENT_LIST_DIR}/internal/asyncimpl.cpp
     ${CMAKE_CURRENT_LIST_DIR}/internal/asyncimpl.h
 )
@@ -103,6 +103,16 @@ void AbstractInvoker::onMainThreadInvoke(const std::function<void(const std::fun
     QueuedInvoker::instance()->onMainThreadInvoke(f);
 }
 
+void AbstractInvoker::onEventsQueued(const std::function<void()>& f)
+{
+    QueuedInvoker::instance()->onEventsQueued(std::this_thread::get_id(), f);
+}
+
+void AbstractInvoker::useLockFreeQueue(size_t capacity, const std::function<void()>& onEventsQueued)
+{
+    QueuedInvoker::instance()->useLockFreeQueue(capacity, onEventsQueued);
+}
+
 bool AbstractInvoker::isConnected() const
 {
     for (auto it = m_callbacks.cbegin(); it != m_callbacks.cend(); ++it) {
@@ -97,6 +97,8 @@ public:
 
     static void processEvents();
     static void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
+    static void onEventsQueued(const std::function<void()>& f);
+    static void useLockFreeQueue(size_t capacity, const std::function<void()>& onEventsQueued);
 
 protected:
     explicit AbstractInvoker();
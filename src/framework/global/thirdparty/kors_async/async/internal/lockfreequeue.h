@@ -0,0 +1,267 @@
+/*
+MIT License
+
+Copyright (c) 2020 Igor Korsukov
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef KORS_ASYNC_LOCKFREEQUEUE_H
+#define KORS_ASYNC_LOCKFREEQUEUE_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace kors::async {
+//! NOTE A move-only `void()` callable with inline storage.
+//! Callables that fit into the buffer (e.g. a lambda capturing a few pointers)
+//! are stored without a heap allocation, bigger ones fall back to the heap.
+template<size_t Capacity>
+class InplaceFunctor
+{
+public:
+    InplaceFunctor() = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceFunctor> > >
+    InplaceFunctor(F&& f)
+    {
+        using Fn = std::decay_t<F>;
+        if constexpr (fitsInline<Fn>()) {
+            new (&m_storage) Fn(std::forward<F>(f));
+            m_ops = &inlineOps<Fn>;
+        } else {
+            new (&m_storage) Fn*(new Fn(std::forward<F>(f)));
+            m_ops = &heapOps<Fn>;
+        }
+    }
+
+    InplaceFunctor(InplaceFunctor&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    InplaceFunctor& operator=(InplaceFunctor&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunctor(const InplaceFunctor&) = delete;
+    InplaceFunctor& operator=(const InplaceFunctor&) = delete;
+
+    ~InplaceFunctor()
+    {
+        reset();
+    }
+
+    explicit operator bool() const
+    {
+        return m_ops != nullptr;
+    }
+
+    void operator()()
+    {
+        assert(m_ops);
+        m_ops->call(&m_storage);
+    }
+
+    void reset()
+    {
+        if (m_ops) {
+            m_ops->destroy(&m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+    template<typename F>
+    static constexpr bool fitsInline()
+    {
+        return sizeof(F) <= Capacity
+               && alignof(F) <= alignof(std::max_align_t)
+               && std::is_nothrow_move_constructible_v<F>;
+    }
+
+private:
+    struct Ops {
+        void (*call)(void* storage);
+        void (*move)(void* from, void* to);
+        void (*destroy)(void* storage);
+    };
+
+    template<typename F>
+    static constexpr Ops inlineOps = {
+        [](void* s) { (*static_cast<F*>(s))(); },
+        [](void* from, void* to) {
+            new (to) F(std::move(*static_cast<F*>(from)));
+            static_cast<F*>(from)->~F();
+        },
+        [](void* s) { static_cast<F*>(s)->~F(); }
+    };
+
+    template<typename F>
+    static constexpr Ops heapOps = {
+        [](void* s) { (**static_cast<F**>(s))(); },
+        [](void* from, void* to) { new (to) F*(*static_cast<F**>(from)); },
+        [](void* s) { delete *static_cast<F**>(s); }
+    };
+
+    void moveFrom(InplaceFunctor& other)
+    {
+        if (other.m_ops) {
+            other.m_ops->move(&other.m_storage, &m_storage);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[Capacity];
+    const Ops* m_ops = nullptr;
+};
+
+//! NOTE Bounded multi-producer single-consumer queue of callables (D. Vyukov's bounded queue).
+//! Push doesn't take a lock and, for small callables, doesn't allocate:
+//! a producer claims a cell with a CAS on the enqueue position and publishes it
+//! with the cell's sequence number. The consumer pops cells in order without any atomic RMW.
+//! Push fails when the queue is full, the caller decides what to do then.
+class LockFreeQueue
+{
+public:
+    //! NOTE The sequence + 40 bytes of (max-aligned) inline storage + the ops pointer make a 64 bytes cell
+    using Functor = InplaceFunctor<40>;
+
+    explicit LockFreeQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        m_mask = size - 1;
+        m_cells = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    size_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    // Any thread. `f` is left untouched if the queue is full
+    template<typename F>
+    bool tryPush(F&& f)
+    {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->functor = Functor(std::forward<F>(f));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only. Calls the next functor in place, returns false if the queue is empty
+    bool popAndCall()
+    {
+        Cell& cell = m_cells[m_dequeuePos & m_mask];
+        if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) {
+            return false; // empty, or the next push isn't published yet
+        }
+
+        const size_t pos = m_dequeuePos++;
+        Functor f = std::move(cell.functor);
+        cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+        if (f) {
+            f();
+        }
+
+        return true;
+    }
+
+    // Consumer thread only. Calls the functors pushed so far,
+    // the ones pushed meanwhile (e.g. by the functors themselves) are left for the next call.
+    // Stops at the first cell that is claimed by a producer, but not published yet
+    void callPending()
+    {
+        const size_t end = m_enqueuePos.load(std::memory_order_acquire);
+        while (m_dequeuePos != end && popAndCall()) {
+        }
+    }
+
+    // Consumer thread only. Calls every functor claimed before `end` (see enqueuePos()),
+    // waiting for the ones that are claimed, but not published yet:
+    // a producer publishes its cell right after claiming it, so the wait is short
+    void callUntil(size_t end)
+    {
+        while (m_dequeuePos != end) {
+            if (!popAndCall()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Any thread. The position the next push will claim
+    size_t enqueuePos() const
+    {
+        return m_enqueuePos.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence = 0;
+        Functor functor;
+    };
+
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_enqueuePos = 0;
+    alignas(CACHE_LINE_SIZE) size_t m_dequeuePos = 0;
+};
+}
+
+#endif // KORS_ASYNC_LOCKFREEQUEUE_H
@@ -31,7 +31,7 @@ QueuedInvoker* QueuedInvoker::instance()
     return &i;
 }
 
-void QueuedInvoker::invoke(const std::thread::id& callbackTh, const Functor& f, bool isAlwaysQueued)
+void QueuedInvoker::invokeQueued(const std::thread::id& callbackTh, Functor&& f, bool isAlwaysQueued)
 {
     if (m_onMainThreadInvoke) {
         if (callbackTh == m_mainThreadID) {
@@ -40,11 +40,35 @@ void QueuedInvoker::invoke(const std::thread::id& callbackTh, const Functor& f,
     }
 
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    m_queues[callbackTh].push(f);
+
+    if (LockFreeSlot* slot = lockFreeSlot(callbackTh)) {
+        //! NOTE Once an event has overflowed, the next ones go to the locked queue too,
+        //! until the consumer has drained it, so that the events keep their order
+        if (slot->overflowed.load(std::memory_order_acquire) || !slot->queue->tryPush(std::move(f))) {
+            m_queues[callbackTh].push(std::move(f));
+            slot->overflowed.store(true, std::memory_order_release);
+        }
+
+        slot->notify();
+        return;
+    }
+
+    m_queues[callbackTh].push(std::move(f));
+
+    // wake up the target thread, if it sleeps until it has events
+    auto it = m_onEventsQueued.find(callbackTh);
+    if (it != m_onEventsQueued.end() && it->second) {
+        it->second();
+    }
 }
 
 void QueuedInvoker::processEvents()
 {
+    if (LockFreeSlot* slot = lockFreeSlot(std::this_thread::get_id())) {
+        processLockFreeEvents(*slot);
+        return;
+    }
+
     Queue q;
     {
         std::lock_guard<std::recursive_mutex> lock(m_mutex);
@@ -62,8 +86,101 @@ void QueuedInvoker::processEvents()
     }
 }
 
+void QueuedInvoker::processLockFreeEvents(LockFreeSlot& slot)
+{
+    if (!slot.overflowed.load(std::memory_order_acquire)) {
+        slot.queue->callPending();
+        return;
+    }
+
+    //! NOTE Every event claimed in the lock-free queue before the overflowed ones were queued
+    //! is before the position seen here, so it is called first, even if its producer hasn't published it yet
+    Queue q;
+    size_t end = 0;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        auto n = m_queues.extract(slot.threadID);
+        if (!n.empty()) {
+            q = std::move(n.mapped());
+        }
+        end = slot.queue->enqueuePos();
+        slot.overflowed.store(false, std::memory_order_release);
+    }
+
+    slot.queue->callUntil(end);
+
+    while (!q.empty()) {
+        const auto& f = q.front();
+        if (f) {
+            f();
+        }
+        q.pop();
+    }
+}
+
 void QueuedInvoker::onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f)
 {
     m_onMainThreadInvoke = f;
     m_mainThreadID = std::this_thread::get_id();
 }
+
+void QueuedInvoker::onEventsQueued(const std::thread::id& th, const Functor& f)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    if (LockFreeSlot* slot = lockFreeSlot(th)) {
+        setOnEventsQueued(*slot, f);
+        return;
+    }
+
+    if (f) {
+        m_onEventsQueued[th] = f;
+    } else {
+        m_onEventsQueued.erase(th);
+    }
+}
+
+void QueuedInvoker::useLockFreeQueue(size_t capacity, const Functor& onEventsQueued)
+{
+    const std::thread::id th = std::this_thread::get_id();
+
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    //! NOTE The id of a finished thread may be reused
+    if (LockFreeSlot* slot = lockFreeSlot(th)) {
+        setOnEventsQueued(*slot, onEventsQueued);
+        return;
+    }
+
+    const size_t index = m_lockFreeSlotCount.load(std::memory_order_relaxed);
+    if (index >= MAX_LOCKFREE_THREADS) {
+        return;
+    }
+
+    LockFreeSlot& slot = m_lockFreeSlots[index];
+    slot.threadID = th;
+    slot.queue = std::make_unique<LockFreeQueue>(capacity);
+    setOnEventsQueued(slot, onEventsQueued);
+
+    //! NOTE Events queued before are waiting in the locked queue
+    auto it = m_queues.find(th);
+    if (it != m_queues.end() && !it->second.empty()) {
+        slot.overflowed.store(true, std::memory_order_relaxed);
+    }
+
+    //! NOTE Publishes the slot to the producers
+    m_lockFreeSlotCount.store(index + 1, std::memory_order_release);
+}
+
+void QueuedInvoker::setOnEventsQueued(LockFreeSlot& slot, const Functor& f)
+{
+    //! NOTE The producers call it without the lock, so the calls in progress are waited for before it's replaced:
+    //! a producer either sees it's unset, or is seen here (both are sequentially consistent)
+    slot.hasOnEventsQueued.store(false);
+    while (slot.onEventsQueuedCalls.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    slot.onEventsQueued = f;
+    slot.hasOnEventsQueued.store(bool(f));
+}
@@ -24,12 +24,17 @@ SOFTWARE.
 #ifndef KORS_ASYNC_QUEUEDINVOKER_H
 #define KORS_ASYNC_QUEUEDINVOKER_H
 
+#include <array>
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <queue>
 #include <map>
 #include <mutex>
 #include <thread>
 
+#include "lockfreequeue.h"
+
 namespace kors::async {
 class QueuedInvoker
 {
@@ -39,9 +44,29 @@ public:
 
     using Functor = std::function<void ()>;
 
-    void invoke(const std::thread::id& th, const Functor& f, bool isAlwaysQueued = false);
+    template<typename F>
+    void invoke(const std::thread::id& th, F&& f, bool isAlwaysQueued = false)
+    {
+        //! NOTE Fast path for the threads that opted in, no lock and (usually) no allocation
+        if (LockFreeSlot* slot = lockFreeSlot(th)) {
+            if (!slot->overflowed.load(std::memory_order_acquire) && slot->queue->tryPush(std::forward<F>(f))) {
+                slot->notify();
+                return;
+            }
+        }
+
+        invokeQueued(th, Functor(std::forward<F>(f)), isAlwaysQueued);
+    }
+
     void processEvents();
     void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
+    void onEventsQueued(const std::thread::id& th, const Functor& f);
+
+    //! NOTE Events for the calling thread will go through a bounded lock-free queue.
+    //! It's meant for real-time threads (e.g. the audio worker), the queue itself stays for the thread,
+    //! but its callback is replaced or detached (nullptr) by onEventsQueued, e.g. when the thread finishes.
+    //! If the queue is full, events fall back to the locked queue, keeping their order
+    void useLockFreeQueue(size_t capacity, const Functor& onEventsQueued);
 
 private:
 
@@ -49,8 +74,49 @@ private:
 
     using Queue = std::queue<Functor>;
 
+    struct LockFreeSlot {
+        std::thread::id threadID;
+        std::unique_ptr<LockFreeQueue> queue;
+        std::atomic<bool> overflowed = false;
+
+        //! NOTE Called by the producers without the lock, see setOnEventsQueued
+        Functor onEventsQueued;
+        std::atomic<bool> hasOnEventsQueued = false;
+        std::atomic<int> onEventsQueuedCalls = 0;
+
+        void notify()
+        {
+            onEventsQueuedCalls.fetch_add(1);
+            if (hasOnEventsQueued.load()) {
+                onEventsQueued();
+            }
+            onEventsQueuedCalls.fetch_sub(1);
+        }
+    };
+
+    static constexpr size_t MAX_LOCKFREE_THREADS = 8;
+
+    LockFreeSlot* lockFreeSlot(const std::thread::id& th)
+    {
+        const size_t count = m_lockFreeSlotCount.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            if (m_lockFreeSlots[i].threadID == th) {
+                return &m_lockFreeSlots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void invokeQueued(const std::thread::id& th, Functor&& f, bool isAlwaysQueued);
+    void processLockFreeEvents(LockFreeSlot& slot);
+    void setOnEventsQueued(LockFreeSlot& slot, const Functor& f);
+
     std::recursive_mutex m_mutex;
     std::map<std::thread::id, Queue > m_queues;
+    std::map<std::thread::id, Functor> m_onEventsQueued;
+
+    std::array<LockFreeSlot, MAX_LOCKFREE_THREADS> m_lockFreeSlots;
+    std::atomic<size_t> m_lockFreeSlotCount = 0;
 
     std::function<void(const std::function<void()>&, bool)> m_onMainThreadInvoke;
     std::thread::id m_mainThreadID;
@@ -36,6 +36,20 @@ inline void onMainThreadInvoke(const std::function<void(const std::function<void
 {
     AbstractInvoker::onMainThreadInvoke(f);
 }
+
+// Called (from the posting thread) whenever an event is queued for the calling thread,
+// so that a thread which sleeps between processEvents() calls can be woken up
+inline void onEventsQueued(const std::function<void()>& f)
+{
+    AbstractInvoker::onEventsQueued(f);
+}
+
+// Events for the calling thread will go through a bounded lock-free queue instead of the locked one,
+// for real-time threads; `onEventsQueued` is called like above
+inline void useLockFreeQueue(size_t capacity, const std::function<void()>& onEventsQueued = nullptr)
+{
+    AbstractInvoker::useLockFreeQueue(capacity, onEventsQueued);
+}
 }
 
 #endif // KORS_ASYNC_PROCESSEVENTS_H
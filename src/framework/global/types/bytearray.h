@@ -44,6 +44,8 @@ public:
     //! NOTE Not coped!!!
     static ByteArray fromRawData(const uint8_t* data, size_t size);
     static ByteArray fromRawData(const char* data, size_t size);
+    //! NOTE Not copied either, but the owner of the data is kept alive while the array refers to it
+    static ByteArray fromRawData(const uint8_t* data, size_t size, std::shared_ptr<const void> owner);
 
     bool operator==(const ByteArray& other) const;
     bool operator!=(const ByteArray& other) const { return !operator==(other); }
@@ -99,6 +101,7 @@ private:
     struct RawData {
         const uint8_t* data = nullptr;
         size_t size = 0;
+        std::shared_ptr<const void> owner;
     };
 
     void detach();
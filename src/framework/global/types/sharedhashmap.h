@@ -39,7 +39,7 @@ public:
 
     SharedHashMap()
     {
-        m_dataPtr = std::make_shared<Data>();
+        m_dataPtr = emptyData();
     }
 
     SharedHashMap(const size_t reserveSize)
@@ -195,7 +195,11 @@ public:
 
     void clear() noexcept
     {
-        ensureDetach();
+        if (m_dataPtr.use_count() != 1) {
+            m_dataPtr = emptyData(); // no need to copy the data only to clear it
+            return;
+        }
+
         m_dataPtr->clear();
     }
 
@@ -222,6 +226,14 @@ public:
     }
 
 protected:
+    //! NOTE All the empty maps share the same data, so that they don't allocate until something is inserted.
+    //! This data is never modified: it's always shared, so any modification detaches from it first
+    static const DataPtr& emptyData()
+    {
+        static const DataPtr empty = std::make_shared<Data>();
+        return empty;
+    }
+
     void ensureDetach()
     {
         if (!m_dataPtr) {
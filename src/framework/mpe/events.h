@@ -23,6 +23,7 @@
 #ifndef MUSE_MPE_EVENTS_H
 #define MUSE_MPE_EVENTS_H
 
+#include <optional>
 #include <variant>
 #include <vector>
 
@@ -221,6 +222,8 @@ private:
         for (auto& pair : m_pitchCtx.pitchCurve) {
             pair.second = static_cast<pitch_level_t>(RealRound(static_cast<float>(pair.second) * ratio * patternUnitRatio, 0));
         }
+
+        m_pitchCtx.pitchCurve.intern();
     }
 
     void calculateExpressionCurve(const ArticulationMap& articulationsApplied, const float requiredVelocityFraction)
@@ -252,6 +255,8 @@ private:
         for (auto& pair : m_expressionCtx.expressionCurve) {
             pair.second = static_cast<dynamic_level_t>(RealRound(pair.second * ratio, 0));
         }
+
+        m_expressionCtx.expressionCurve.intern();
     }
 
     ArrangementContext m_arrangementCtx;
@@ -315,6 +320,48 @@ struct PlaybackParam {
     }
 };
 
+//! NOTE Replaces the events within [timestampFrom, timestampTo] (both inclusive) with the given ones
+struct PlaybackEventsWindow {
+    timestamp_t timestampFrom = 0;
+    timestamp_t timestampTo = 0;
+    PlaybackEventsMap events;
+
+    bool operator==(const PlaybackEventsWindow& other) const
+    {
+        return timestampFrom == other.timestampFrom
+               && timestampTo == other.timestampTo
+               && events == other.events;
+    }
+};
+
+//! NOTE Incremental update of the main stream: only the edited time windows are sent,
+//! dynamics and params are sent only if they have been changed
+struct MainStreamPatch {
+    std::vector<PlaybackEventsWindow> windows;
+    std::optional<DynamicLevelLayers> dynamics;
+    std::optional<PlaybackParamLayers> params;
+};
+
+using MainStreamPatches = async::Channel<MainStreamPatch>;
+
+//! NOTE Some events might be started RIGHT before the "official" start of the track,
+//! so the window starting at 0 also covers them
+inline std::pair<PlaybackEventsMap::const_iterator, PlaybackEventsMap::const_iterator>
+windowBounds(const PlaybackEventsMap& events, const timestamp_t timestampFrom, const timestamp_t timestampTo)
+{
+    PlaybackEventsMap::const_iterator lowerBound = timestampFrom == 0 ? events.cbegin() : events.lower_bound(timestampFrom);
+    PlaybackEventsMap::const_iterator upperBound = events.upper_bound(timestampTo);
+
+    return { lowerBound, upperBound };
+}
+
+inline void applyWindow(PlaybackEventsMap& events, const PlaybackEventsWindow& window)
+{
+    auto bounds = windowBounds(events, window.timestampFrom, window.timestampTo);
+    events.erase(bounds.first, bounds.second);
+    events.insert(window.events.cbegin(), window.events.cend());
+}
+
 struct PlaybackData {
     PlaybackEventsMap originEvents;
     PlaybackSetupData setupData;
@@ -322,6 +369,7 @@ struct PlaybackData {
     PlaybackParamLayers params;
 
     MainStreamChanges mainStream;
+    MainStreamPatches mainStreamPatches;
     OffStreamChanges offStream;
 
     bool operator==(const PlaybackData& other) const
@@ -29,6 +29,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <map>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -90,6 +91,18 @@ constexpr inline duration_percentage_t occupiedPercentage(const timestamp_t time
 template<typename T>
 struct ValuesCurve : public SharedMap<duration_percentage_t, T>
 {
+    //! NOTE Makes the curve share the data with an equal curve interned earlier,
+    //! so that the many events with the same curve keep only one copy of it
+    void intern()
+    {
+        if (this->empty()) {
+            return;
+        }
+
+        static InternPool pool;
+        this->m_dataPtr = pool.intern(this->m_dataPtr);
+    }
+
     std::pair<duration_percentage_t, T> amplitudeValuePoint() const
     {
         auto max = std::max_element(this->cbegin(), this->cend(), [](const auto& f, const auto& s) {
@@ -133,6 +146,58 @@ struct ValuesCurve : public SharedMap<duration_percentage_t, T>
 
         return (factor + 1.f) / 2.f;
     }
+
+private:
+    using DataPtr = typename SharedMap<duration_percentage_t, T>::DataPtr;
+
+    class InternPool
+    {
+    public:
+        DataPtr intern(const DataPtr& data)
+        {
+            std::lock_guard lock(m_mutex);
+
+            auto it = m_items.find(data);
+            if (it != m_items.end()) {
+                return *it;
+            }
+
+            //! NOTE The sweep goes through the whole pool under the lock,
+            //! so once the pool is full, it's only done on every SWEEP_INTERVAL-th miss, not on each one
+            if (m_items.size() >= MAX_SIZE && m_fullPoolMisses++ % SWEEP_INTERVAL == 0) {
+                removeUnused();
+            }
+
+            if (m_items.size() < MAX_SIZE) {
+                m_items.insert(data);
+            }
+
+            return data;
+        }
+
+    private:
+        static constexpr size_t MAX_SIZE = 4096;
+        static constexpr size_t SWEEP_INTERVAL = MAX_SIZE / 16;
+
+        struct Less {
+            bool operator()(const DataPtr& d1, const DataPtr& d2) const { return *d1 < *d2; }
+        };
+
+        void removeUnused()
+        {
+            for (auto it = m_items.begin(); it != m_items.end();) {
+                if (it->use_count() == 1) {
+                    it = m_items.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        std::mutex m_mutex;
+        std::set<DataPtr, Less> m_items;
+        size_t m_fullPoolMisses = 0;
+    };
 };
 
 // Pitch
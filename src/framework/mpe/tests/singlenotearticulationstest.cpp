@@ -439,3 +439,69 @@ TEST_F(MPE_SingleNoteArticulationsTest, Scoop)
     //        In other words, we'll start to playback a note with pitch offset and then finally land on the note being played
     EXPECT_EQ(event.arrangementCtx().actualTimestamp, m_nominalTimestamp + m_nominalDuration * percentageToFactor(timestampOffset));
 }
+
+/**
+ * @brief MPE_SingleNoteArticulationsTest_EqualCurvesShareData
+ * @details In this case we're gonna build two different notes with the same articulations applied on the top of them
+ *          The pitch and expression curves of the notes are equal, so they should share the same data
+ */
+TEST_F(MPE_SingleNoteArticulationsTest, EqualCurvesShareData)
+{
+    // [GIVEN] Standard articulation applied on the top of the notes
+    auto buildArticulations = [this](timestamp_t timestamp) {
+        ArticulationPattern scope;
+        scope.emplace(0, m_standardPattern);
+
+        ArticulationMeta standardMeta;
+        standardMeta.type = ArticulationType::Standard;
+        standardMeta.pattern = scope;
+        standardMeta.timestamp = timestamp;
+        standardMeta.overallDuration = m_nominalDuration;
+
+        ArticulationMap result;
+        result.emplace(ArticulationType::Standard, ArticulationAppliedData(std::move(standardMeta), 0, HUNDRED_PERCENT));
+        result.preCalculateAverageData();
+
+        return result;
+    };
+
+    // [WHEN] Two notes with different timestamps and pitches being built
+    NoteEvent firstEvent(m_nominalTimestamp, m_nominalDuration, m_voiceIdx, m_staffIdx,
+                         pitchLevel(m_pitchClass, m_octave), m_nominalDynamic,
+                         buildArticulations(m_nominalTimestamp), 0);
+
+    NoteEvent secondEvent(m_nominalTimestamp + m_nominalDuration, m_nominalDuration, m_voiceIdx, m_staffIdx,
+                          pitchLevel(PitchClass::C, m_octave + 1), m_nominalDynamic,
+                          buildArticulations(m_nominalTimestamp + m_nominalDuration), 0);
+
+    // [THEN] We expect that the curves are equal and share the same data
+    const PitchCurve& firstPitchCurve = firstEvent.pitchCtx().pitchCurve;
+    const PitchCurve& secondPitchCurve = secondEvent.pitchCtx().pitchCurve;
+    ASSERT_FALSE(firstPitchCurve.empty());
+    EXPECT_EQ(firstPitchCurve, secondPitchCurve);
+    EXPECT_EQ(&*firstPitchCurve.cbegin(), &*secondPitchCurve.cbegin());
+
+    const ExpressionCurve& firstExpressionCurve = firstEvent.expressionCtx().expressionCurve;
+    const ExpressionCurve& secondExpressionCurve = secondEvent.expressionCtx().expressionCurve;
+    ASSERT_FALSE(firstExpressionCurve.empty());
+    EXPECT_EQ(firstExpressionCurve, secondExpressionCurve);
+    EXPECT_EQ(&*firstExpressionCurve.cbegin(), &*secondExpressionCurve.cbegin());
+
+    // [WHEN] One of the shared curves being modified
+    PitchCurve modifiedCurve = firstPitchCurve;
+    modifiedCurve.insert_or_assign(0, 100);
+
+    // [THEN] We expect that the other curves are not affected
+    EXPECT_EQ(firstPitchCurve, secondPitchCurve);
+    EXPECT_NE(modifiedCurve, firstPitchCurve);
+
+    // [WHEN] An empty curve being modified
+    PitchCurve firstEmptyCurve;
+    PitchCurve secondEmptyCurve;
+    firstEmptyCurve.insert_or_assign(0, 100);
+
+    // [THEN] We expect that the other empty curves are not affected
+    EXPECT_EQ(firstEmptyCurve.size(), 1u);
+    EXPECT_TRUE(secondEmptyCurve.empty());
+    EXPECT_TRUE(PitchCurve().empty());
+}
@@ -128,6 +128,8 @@ void MuseSamplerSequencer::updateOffStreamEvents(const PlaybackEventsMap& events
     const char* textArticulation_cstr = m_offStreamCache.textArticulation.c_str();
     const char* syllable_cstr = m_offStreamCache.syllable.c_str();
 
+    EventSequenceMap offStreamEvents;
+
     for (const auto& pair : events) {
         for (const auto& event : pair.second) {
             if (!std::holds_alternative<mpe::NoteEvent>(event)) {
@@ -155,18 +157,18 @@ void MuseSamplerSequencer::updateOffStreamEvents(const PlaybackEventsMap& events
             noteOn.msTrack = track;
 
             timestamp_t timestampFrom = arrangementCtx.actualTimestamp;
-            m_offStreamEvents[arrangementCtx.actualTimestamp].emplace(std::move(noteOn));
+            offStreamEvents[arrangementCtx.actualTimestamp].emplace(std::move(noteOn));
 
             AuditionStopNoteEvent noteOff;
             noteOff.msEvent = { noteOn.msEvent._pitch };
             noteOff.msTrack = track;
 
             timestamp_t timestampTo = timestampFrom + arrangementCtx.actualDuration;
-            m_offStreamEvents[timestampTo].emplace(std::move(noteOff));
+            offStreamEvents[timestampTo].emplace(std::move(noteOff));
         }
     }
 
-    updateOffSequenceIterator();
+    assignEvents(m_offStreamEvents, offStreamEvents);
 }
 
 void MuseSamplerSequencer::updateMainStreamEvents(const PlaybackEventsMap& events, const DynamicLevelLayers& dynamics,
@@ -42,6 +42,8 @@ MuseSamplerWrapper::MuseSamplerWrapper(MuseSamplerLibHandlerPtr samplerLib,
         return;
     }
 
+    m_eventBuffer.reserve();
+
     m_sequencer.setOnOffStreamFlushed([this]() {
         m_allNotesOffRequested = true;
     });
@@ -109,11 +111,13 @@ samples_t MuseSamplerWrapper::process(float* buffer, samples_t samplesPerChannel
 
     if (!active) {
         msecs_t nextMicros = samplesToMsecs(samplesPerChannel, m_sampleRate);
-        MuseSamplerSequencer::EventSequenceMap sequences = m_sequencer.movePlaybackForward(nextMicros);
+        m_sequencer.movePlaybackForward(nextMicros, m_eventBuffer);
+
+        for (size_t i = 0; i < m_eventBuffer.sequencesCount(); ++i) {
+            const MuseSamplerSequencer::EventBuffer::Sequence& sequence = m_eventBuffer.sequence(i);
 
-        for (const auto& pair : sequences) {
-            for (const MuseSamplerSequencer::EventType& event : pair.second) {
-                handleAuditionEvents(event);
+            for (auto it = m_eventBuffer.eventsBegin(sequence); it != m_eventBuffer.eventsEnd(sequence); ++it) {
+                handleAuditionEvents(*it);
             }
         }
     }
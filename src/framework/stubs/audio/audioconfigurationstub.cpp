@@ -71,11 +71,6 @@ async::Notification AudioConfigurationStub::driverBufferSizeChanged() const
     return async::Notification();
 }
 
-msecs_t AudioConfigurationStub::audioWorkerInterval(const samples_t, const sample_rate_t) const
-{
-    return 0;
-}
-
 samples_t AudioConfigurationStub::minSamplesToReserve(RenderMode) const
 {
     return 0;
@@ -65,8 +65,9 @@ void VstSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& events, c
         m_onOffStreamFlushed();
     }
 
-    updatePlaybackEvents(m_offStreamEvents, events);
-    updateOffSequenceIterator();
+    EventSequenceMap offStreamEvents;
+    updatePlaybackEvents(offStreamEvents, events);
+    assignEvents(m_offStreamEvents, offStreamEvents);
 }
 
 void VstSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
@@ -83,11 +84,15 @@ void VstSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events,
         m_onMainStreamFlushed();
     }
 
-    updatePlaybackEvents(m_mainStreamEvents, events);
+    EventSequenceMap mainStreamEvents;
+    updatePlaybackEvents(mainStreamEvents, events);
+    assignEvents(m_mainStreamEvents, mainStreamEvents);
     updateMainSequenceIterator();
 
     if (m_useDynamicEvents) {
-        updateDynamicEvents(m_dynamicEvents, dynamics);
+        EventSequenceMap dynamicEvents;
+        updateDynamicEvents(dynamicEvents, dynamics);
+        assignEvents(m_dynamicEvents, dynamicEvents);
         updateDynamicChangesIterator();
     }
 }
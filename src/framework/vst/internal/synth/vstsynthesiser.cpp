@@ -43,6 +43,7 @@ VstSynthesiser::VstSynthesiser(const TrackId trackId, const muse::audio::AudioIn
     m_vstAudioClient(std::make_unique<VstAudioClient>()),
     m_trackId(trackId)
 {
+    m_eventBuffer.reserve();
 }
 
 VstSynthesiser::~VstSynthesiser()
@@ -201,17 +202,17 @@ samples_t VstSynthesiser::process(float* buffer, samples_t samplesPerChannel)
     }
 
     const msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
-    const VstSequencer::EventSequenceMap sequences = m_sequencer.movePlaybackForward(nextMsecs);
+    m_sequencer.movePlaybackForward(nextMsecs, m_eventBuffer);
 
     samples_t sampleOffset = 0;
     samples_t processedSamples = 0;
 
-    for (auto it = sequences.cbegin(); it != sequences.cend(); ++it) {
+    for (size_t i = 0; i < m_eventBuffer.sequencesCount(); ++i) {
+        const VstSequencer::EventBuffer::Sequence& sequence = m_eventBuffer.sequence(i);
         samples_t durationInSamples = samplesPerChannel - sampleOffset;
 
-        auto nextIt = std::next(it);
-        if (nextIt != sequences.cend()) {
-            msecs_t duration = nextIt->first - it->first;
+        if (i + 1 < m_eventBuffer.sequencesCount()) {
+            msecs_t duration = m_eventBuffer.sequence(i + 1).timestamp - sequence.timestamp;
             durationInSamples = microSecsToSamples(duration, m_sampleRate);
         }
 
@@ -219,16 +220,21 @@ samples_t VstSynthesiser::process(float* buffer, samples_t samplesPerChannel)
             break;
         }
 
-        processedSamples += processSequence(it->second, durationInSamples, buffer + sampleOffset * m_audioChannelsCount);
+        processedSamples += processSequence(m_eventBuffer.eventsBegin(sequence), m_eventBuffer.eventsEnd(sequence),
+                                            durationInSamples, buffer + sampleOffset * m_audioChannelsCount);
         sampleOffset += durationInSamples;
     }
 
     return processedSamples;
 }
 
-samples_t VstSynthesiser::processSequence(const VstSequencer::EventSequence& sequence, const samples_t samples, float* buffer)
+samples_t VstSynthesiser::processSequence(VstSequencer::EventBuffer::EventIterator eventsBegin,
+                                          VstSequencer::EventBuffer::EventIterator eventsEnd,
+                                          const samples_t samples, float* buffer)
 {
-    for (const VstSequencer::EventType& event : sequence) {
+    for (auto it = eventsBegin; it != eventsEnd; ++it) {
+        const VstSequencer::EventType& event = *it;
+
         if (std::holds_alternative<VstEvent>(event)) {
             m_vstAudioClient->handleEvent(std::get<VstEvent>(event));
         } else if (std::holds_alternative<ParamChangeEvent>(event)) {
@@ -75,7 +75,9 @@ public:
 
 private:
     void toggleVolumeGain(const bool isActive);
-    audio::samples_t processSequence(const VstSequencer::EventSequence& sequence, const audio::samples_t samples, float* buffer);
+    audio::samples_t processSequence(VstSequencer::EventBuffer::EventIterator eventsBegin,
+                                     VstSequencer::EventBuffer::EventIterator eventsEnd,
+                                     const audio::samples_t samples, float* buffer);
 
     IVstPluginInstancePtr m_pluginPtr = nullptr;
     std::unique_ptr<VstAudioClient> m_vstAudioClient = nullptr;
@@ -84,6 +86,7 @@ private:
     async::Channel<unsigned int> m_streamsCountChanged;
 
     VstSequencer m_sequencer;
+    VstSequencer::EventBuffer m_eventBuffer;
 
     muse::audio::TrackId m_trackId = muse::audio::INVALID_TRACK_ID;
 
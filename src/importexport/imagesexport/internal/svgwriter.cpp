@@ -62,13 +62,7 @@ Ret SvgWriter::write(INotationPtr notation, io::IODevice& destinationDevice, con
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true); // don’t print page break symbols etc.
-
-    mu::engraving::MScore::pdfPrinting = true;
-    mu::engraving::MScore::svgPrinting = true;
-
     const std::vector<mu::engraving::Page*>& pages = score->pages();
-    double pixelRationBackup = mu::engraving::MScore::pixelRatio;
 
     const size_t PAGE_NUMBER = muse::value(options, OptionKey::PAGE_NUMBER, Val(0)).toInt();
     if (PAGE_NUMBER >= pages.size()) {
@@ -106,7 +100,8 @@ Ret SvgWriter::write(INotationPtr notation, io::IODevice& destinationDevice, con
         painter.translate(-pageRect.topLeft());
     }
 
-    mu::engraving::MScore::pixelRatio = mu::engraving::DPI / printer.logicalDpiX();
+    //! NOTE The print state may already be set up for all the pages, see PrintStateGuard
+    const mu::engraving::PrintStateGuard printState(score, { mu::engraving::DPI / printer.logicalDpiX(), true });
 
     const bool TRANSPARENT_BACKGROUND = muse::value(options, OptionKey::TRANSPARENT_BACKGROUND,
                                                     Val(configuration()->exportSvgWithTransparentBackground())).toBool();
@@ -261,12 +256,6 @@ Ret SvgWriter::write(INotationPtr notation, io::IODevice& destinationDevice, con
     ByteArray data = ByteArray::fromQByteArrayNoCopy(qdata);
     destinationDevice.write(data);
 
-    // Clean up and return
-    mu::engraving::MScore::pixelRatio = pixelRationBackup;
-    score->setPrinting(false);
-    mu::engraving::MScore::pdfPrinting = false;
-    mu::engraving::MScore::svgPrinting = false;
-
     return true;
 }
 
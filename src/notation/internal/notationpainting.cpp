@@ -124,10 +124,15 @@ void NotationPainting::doPaint(Painter* painter, const Options& opt)
     };
 
     scoreRenderer()->paintScore(painter, score(), myopt);
+}
 
-    if (!myopt.isPrinting) {
-        static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
+void NotationPainting::paintViewOverlays(Painter* painter, bool isPrinting)
+{
+    if (!score() || isPrinting) {
+        return;
     }
+
+    static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
 }
 
 void NotationPainting::paintPageSheet(Painter* painter, const Page* page, const RectF& pageRect, bool printPageBackground) const
@@ -179,6 +184,12 @@ void NotationPainting::paintPageSheet(Painter* painter, const Page* page, const
 }
 
 void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool isPrinting)
+{
+    paintViewContent(painter, frameRect, isPrinting);
+    paintViewOverlays(painter, isPrinting);
+}
+
+void NotationPainting::paintViewContent(Painter* painter, const RectF& frameRect, bool isPrinting)
 {
     Options opt;
     opt.isSetViewport = false;
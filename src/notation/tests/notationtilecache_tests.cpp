@@ -0,0 +1,255 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QImage>
+
+#include "engraving/tests/utils/scorerw.h"
+
+#include "engraving/dom/masterscore.h"
+#include "engraving/dom/measurebase.h"
+#include "engraving/dom/page.h"
+#include "engraving/dom/system.h"
+
+#include "notation/view/notationtilecache.h"
+
+using namespace mu;
+using namespace mu::notation;
+using namespace muse;
+
+static const String TEST_SCORE_PATH(u"data/test.mscx");
+
+class NotationTileCacheTests : public ::testing::Test
+{
+public:
+    using TileKey = NotationTileCache::TileKey;
+
+    static QImage tileImage()
+    {
+        QImage image(NotationTileCache::TILE_SIZE, NotationTileCache::TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::white);
+        return image;
+    }
+
+    static size_t tileByteSize()
+    {
+        return static_cast<size_t>(tileImage().sizeInBytes());
+    }
+
+    static TileKey tileKey(size_t pageIndex, int column = 0, int row = 0)
+    {
+        return TileKey { pageIndex, NotationTileCache::scalingKey(1.0), column, row };
+    }
+
+    //! NOTE The test score, made long enough to be laid out on several pages
+    static engraving::MasterScore* readLongScore()
+    {
+        engraving::MasterScore* score = engraving::ScoreRW::readScore(TEST_SCORE_PATH);
+        if (!score) {
+            return nullptr;
+        }
+
+        score->startCmd(TranslatableString::untranslatable("Notation tile cache tests"));
+        score->appendMeasures(300 - static_cast<int>(score->nmeasures()));
+        score->endCmd();
+
+        return score;
+    }
+
+    static std::vector<const Page*> pages(const engraving::Score* score)
+    {
+        return std::vector<const Page*>(score->pages().begin(), score->pages().end());
+    }
+
+    static int pageStartTick(const Page* page)
+    {
+        return page->systems().front()->first()->tick().ticks();
+    }
+
+    static void insertTileOfEachPage(NotationTileCache& cache, size_t pageCount)
+    {
+        for (size_t i = 0; i < pageCount; ++i) {
+            cache.insert(tileKey(i), tileImage());
+        }
+    }
+};
+
+TEST_F(NotationTileCacheTests, TileRect)
+{
+    //! CHECK The tiles have a fixed size in pixels, so they cover less of the page when zoomed in
+    const TileKey key { 0, NotationTileCache::scalingKey(2.0), 2, 1 };
+    EXPECT_EQ(NotationTileCache::tileRect(key, 2.0), RectF(256.0, 128.0, 128.0, 128.0));
+
+    //! CHECK Close zooms have different keys
+    EXPECT_NE(NotationTileCache::scalingKey(1.0), NotationTileCache::scalingKey(1.001));
+    EXPECT_EQ(NotationTileCache::scalingKey(1.5), NotationTileCache::scalingKey(1.5));
+}
+
+TEST_F(NotationTileCacheTests, InsertAndClear)
+{
+    NotationTileCache cache;
+
+    //! [GIVEN] A cached tile
+    cache.insert(tileKey(0, 1, 2), tileImage());
+
+    //! [THEN] Only this one is found
+    EXPECT_TRUE(cache.contains(tileKey(0, 1, 2)));
+    EXPECT_FALSE(cache.contains(tileKey(0, 2, 1)));
+    EXPECT_FALSE(cache.contains(TileKey { 0, NotationTileCache::scalingKey(2.0), 1, 2 }));
+
+    const QImage* image = cache.tile(tileKey(0, 1, 2));
+    ASSERT_TRUE(image);
+    EXPECT_EQ(image->width(), NotationTileCache::TILE_SIZE);
+    EXPECT_EQ(cache.tile(tileKey(1, 1, 2)), nullptr);
+
+    //! [WHEN] The cache is cleared
+    cache.clear();
+
+    //! [THEN] Nothing is found
+    EXPECT_FALSE(cache.contains(tileKey(0, 1, 2)));
+}
+
+TEST_F(NotationTileCacheTests, Update)
+{
+    engraving::MasterScore* score = readLongScore();
+    ASSERT_TRUE(score);
+
+    const std::vector<const Page*> allPages = pages(score);
+    ASSERT_GE(allPages.size(), 3u);
+
+    NotationTileCache cache;
+
+    //! [GIVEN] Tiles of every page
+    cache.update(allPages, 1.0, false);
+    insertTileOfEachPage(cache, allPages.size());
+
+    //! [WHEN] The pages are the same
+    cache.update(allPages, 1.0, false);
+
+    //! [THEN] All the tiles are kept
+    for (size_t i = 0; i < allPages.size(); ++i) {
+        EXPECT_TRUE(cache.contains(tileKey(i)));
+    }
+
+    //! [WHEN] The layout of the second page has changed
+    std::vector<const Page*> changedPages = allPages;
+    changedPages[1] = allPages[2];
+    cache.update(changedPages, 1.0, false);
+
+    //! [THEN] Only its tiles are dropped
+    for (size_t i = 0; i < allPages.size(); ++i) {
+        EXPECT_EQ(cache.contains(tileKey(i)), i != 1);
+    }
+
+    //! [WHEN] The device pixel ratio changes
+    cache.update(allPages, 1.0, false);
+    insertTileOfEachPage(cache, allPages.size());
+    cache.update(allPages, 2.0, false);
+
+    //! [THEN] All the tiles are dropped
+    for (size_t i = 0; i < allPages.size(); ++i) {
+        EXPECT_FALSE(cache.contains(tileKey(i)));
+    }
+
+    //! [WHEN] Printing starts
+    insertTileOfEachPage(cache, allPages.size());
+    cache.update(allPages, 2.0, true);
+
+    //! [THEN] All the tiles are dropped
+    for (size_t i = 0; i < allPages.size(); ++i) {
+        EXPECT_FALSE(cache.contains(tileKey(i)));
+    }
+
+    //! [WHEN] The page count changes, which may be shown in the headers and footers
+    insertTileOfEachPage(cache, allPages.size());
+    cache.update(std::vector<const Page*>(allPages.begin(), allPages.end() - 1), 2.0, true);
+
+    //! [THEN] All the tiles are dropped
+    for (size_t i = 0; i < allPages.size(); ++i) {
+        EXPECT_FALSE(cache.contains(tileKey(i)));
+    }
+
+    delete score;
+}
+
+TEST_F(NotationTileCacheTests, InvalidateTicks)
+{
+    engraving::MasterScore* score = readLongScore();
+    ASSERT_TRUE(score);
+
+    const std::vector<const Page*> allPages = pages(score);
+    ASSERT_GE(allPages.size(), 3u);
+
+    NotationTileCache cache;
+    cache.update(allPages, 1.0, false);
+
+    //! [GIVEN] Tiles of every page
+    insertTileOfEachPage(cache, allPages.size());
+
+    //! [WHEN] A range in the middle of the second page has changed
+    const int tick = (pageStartTick(allPages[1]) + allPages[1]->endTick().ticks()) / 2;
+    cache.invalidateTicks(tick, tick);
+
+    //! [THEN] Only the tiles of this page are dropped
+    for (size_t i = 0; i < allPages.size(); ++i) {
+        EXPECT_EQ(cache.contains(tileKey(i)), i != 1);
+    }
+
+    //! [WHEN] A range from the second page to the third one has changed
+    insertTileOfEachPage(cache, allPages.size());
+    cache.invalidateTicks(tick, pageStartTick(allPages[2]) + 1);
+
+    //! [THEN] The tiles of both pages are dropped
+    for (size_t i = 0; i < allPages.size(); ++i) {
+        EXPECT_EQ(cache.contains(tileKey(i)), i != 1 && i != 2);
+    }
+
+    delete score;
+}
+
+TEST_F(NotationTileCacheTests, EvictLeastRecentlyUsed)
+{
+    //! [GIVEN] A cache with room for 3 tiles, holding 3 tiles
+    NotationTileCache cache(3 * tileByteSize());
+    cache.insert(tileKey(0, 0), tileImage());
+    cache.insert(tileKey(0, 1), tileImage());
+    cache.insert(tileKey(0, 2), tileImage());
+
+    //! [WHEN] The oldest one is used again, then another tile is inserted
+    EXPECT_TRUE(cache.tile(tileKey(0, 0)));
+    cache.insert(tileKey(0, 3), tileImage());
+
+    //! [THEN] The least recently used one is evicted
+    EXPECT_TRUE(cache.contains(tileKey(0, 0)));
+    EXPECT_FALSE(cache.contains(tileKey(0, 1)));
+    EXPECT_TRUE(cache.contains(tileKey(0, 2)));
+    EXPECT_TRUE(cache.contains(tileKey(0, 3)));
+
+    //! [WHEN] A cached tile is replaced
+    cache.insert(tileKey(0, 2), tileImage());
+
+    //! [THEN] Its previous image doesn't count anymore, nothing is evicted
+    EXPECT_TRUE(cache.contains(tileKey(0, 0)));
+    EXPECT_TRUE(cache.contains(tileKey(0, 2)));
+    EXPECT_TRUE(cache.contains(tileKey(0, 3)));
+}
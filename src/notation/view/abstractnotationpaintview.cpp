@@ -21,6 +21,10 @@
  */
 #include "abstractnotationpaintview.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 #include <QPainter>
 
 #include "actions/actiontypes.h"
@@ -36,6 +40,9 @@ using namespace muse::actions;
 
 static constexpr qreal SCROLL_LIMIT_OFF_OVERSCROLL_FACTOR = 0.75;
 
+//! NOTE The tiles are rendered when the event loop is idle, by slices of this duration
+static constexpr std::chrono::milliseconds TILE_RENDER_SLICE(8);
+
 static void compensateFloatPart(RectF& rect)
 {
     rect.adjust(-1, -1, 1, 1);
@@ -63,6 +70,10 @@ AbstractNotationPaintView::AbstractNotationPaintView(QQuickItem* parent)
     connect(&m_enableAutoScrollTimer, &QTimer::timeout, this, [this]() {
         m_autoScrollEnabled = true;
     });
+
+    m_tileRenderTimer.setSingleShot(true);
+    m_tileRenderTimer.setInterval(0);
+    connect(&m_tileRenderTimer, &QTimer::timeout, this, &AbstractNotationPaintView::renderPendingTiles);
 }
 
 AbstractNotationPaintView::~AbstractNotationPaintView()
@@ -122,6 +133,7 @@ void AbstractNotationPaintView::initBackground()
 
     configuration()->backgroundChanged().onNotify(this, [this]() {
         emit backgroundColorChanged(configuration()->backgroundColor());
+        clearTileCache();
         scheduleRedraw();
     });
 }
@@ -244,9 +256,20 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
             interaction->hideShadowNote();
         }
         m_shadowNoteRect = RectF();
+
+        //! NOTE Not every change is made by a command, the changes without a range may be anywhere
+        if (!m_tileChangesReceived) {
+            clearTileCache();
+        }
+        m_tileChangesReceived = false;
+
         scheduleRedraw();
     });
 
+    m_notation->undoStack()->changesChannel().onReceive(this, [this](const ChangesRange& range) {
+        invalidateTiles(range);
+    });
+
     onNoteInputStateChanged();
     if (isNoteEnterMode()) {
         emit activeFocusRequested();
@@ -265,6 +288,7 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
     });
 
     interaction->selectionChanged().onNotify(this, [this]() {
+        invalidateSelectionTiles();
         scheduleRedraw();
     });
 
@@ -285,6 +309,9 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
     });
 
     interaction->dropChanged().onNotify(this, [this]() {
+        //! NOTE The drop target is highlighted
+        clearTileCache();
+
         if (!hasActiveFocus()) {
             forceFocusIn(); // grab keyboard focus after element added from palette
         }
@@ -296,6 +323,7 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
     });
 
     m_notation->viewModeChanged().onNotify(this, [this]() {
+        clearTileCache();
         updateLoopMarkers();
         ensureViewportInsideScrollableArea();
     });
@@ -334,6 +362,7 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
 void AbstractNotationPaintView::onUnloadNotation(INotationPtr)
 {
     m_notation->notationChanged().resetOnNotify(this);
+    m_notation->undoStack()->changesChannel().resetOnReceive(this);
     INotationInteractionPtr interaction = m_notation->interaction();
     interaction->noteInput()->stateChanged().resetOnNotify(this);
     interaction->selectionChanged().resetOnNotify(this);
@@ -629,7 +658,14 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     painter->setWorldTransform(m_matrix * guiScalingCompensation);
 
     bool isPrinting = publishMode() || m_inputController->readonly();
-    notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    if (isTileCacheUsable()) {
+        paintScoreTiles(qp, painter, rect, guiScaling, isPrinting);
+        notation()->painting()->paintViewOverlays(painter, isPrinting);
+    } else {
+        //! NOTE The items being edited are changed without commands, so nothing is cached meanwhile
+        clearTileCache();
+        notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    }
 
     const ui::UiContext uiCtx = uiContextResolver()->currentUiContext();
     const bool isOnNotationPage = uiCtx == ui::UiCtxProjectOpened || uiCtx == ui::UiCtxProjectFocused;
@@ -657,6 +693,224 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     }
 }
 
+bool AbstractNotationPaintView::isTileCacheUsable() const
+{
+    INotationInteractionPtr interaction = notationInteraction();
+    if (!interaction) {
+        return false;
+    }
+
+    return !interaction->isDragStarted()
+           && !interaction->isTextEditingStarted()
+           && !interaction->isGripEditStarted()
+           && !interaction->isElementEditStarted();
+}
+
+void AbstractNotationPaintView::paintScoreTiles(QPainter* qp, Painter* painter, const RectF& rect, qreal guiScaling, bool isPrinting)
+{
+    TRACEFUNC;
+
+    const PageList pages = notationElements()->pages();
+
+    m_tileScaling = currentScaling() * guiScaling;
+    m_tileDevicePixelRatio = qp->device()->devicePixelRatioF();
+    m_tileIsPrinting = isPrinting;
+    m_tileCache.update(pages, m_tileDevicePixelRatio, m_tileIsPrinting);
+
+    const int64_t scalingKey = NotationTileCache::scalingKey(m_tileScaling);
+    const qreal tileSize = NotationTileCache::TILE_SIZE / m_tileScaling;
+
+    //! NOTE The tiles around the visible ones are prepared too, so that scrolling finds them ready
+    const RectF visibleRect = toLogical(rect);
+    const RectF prefetchRect = visibleRect.adjusted(-tileSize, -tileSize, tileSize, tileSize);
+    const qreal borderWidth = configuration()->borderWidth();
+
+    std::vector<NotationTileCache::TileKey> missingTiles;
+    std::vector<NotationTileCache::TileKey> prefetchTiles;
+
+    for (size_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex) {
+        //! NOTE The page border is centered on the page edge
+        const RectF pageRect = pages.at(pageIndex)->canvasBoundingRect().adjusted(-borderWidth, -borderWidth, borderWidth, borderWidth);
+        const RectF area = pageRect.intersected(prefetchRect);
+        if (area.isEmpty()) {
+            continue;
+        }
+
+        const int firstColumn = static_cast<int>(std::floor((area.left() - pageRect.left()) / tileSize));
+        const int lastColumn = static_cast<int>(std::floor((area.right() - pageRect.left()) / tileSize));
+        const int firstRow = static_cast<int>(std::floor((area.top() - pageRect.top()) / tileSize));
+        const int lastRow = static_cast<int>(std::floor((area.bottom() - pageRect.top()) / tileSize));
+
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                const NotationTileCache::TileKey key { pageIndex, scalingKey, column, row };
+                const RectF tileRect = NotationTileCache::tileRect(key, m_tileScaling).translated(pageRect.topLeft());
+
+                if (!tileRect.intersects(visibleRect)) {
+                    if (!m_tileCache.contains(key)) {
+                        prefetchTiles.push_back(key);
+                    }
+                    continue;
+                }
+
+                const QImage* image = m_tileCache.tile(key);
+                if (!image) {
+                    missingTiles.push_back(key);
+
+                    //! NOTE Painted directly for now, clipped to the tile, so nothing is painted twice
+                    const RectF paintRect = tileRect.intersected(pageRect);
+                    painter->save();
+                    painter->setClipRect(paintRect);
+                    notation()->painting()->paintViewContent(painter, paintRect, isPrinting);
+                    painter->restore();
+                    continue;
+                }
+
+                const PointF topLeft = m_matrix.map(tileRect.topLeft());
+
+                qp->save();
+                qp->setWorldTransform(QTransform());
+                qp->drawImage(QPointF(topLeft.x() * guiScaling, topLeft.y() * guiScaling), *image);
+                qp->restore();
+            }
+        }
+    }
+
+    m_pendingTiles = std::move(missingTiles);
+    m_pendingTiles.insert(m_pendingTiles.end(), prefetchTiles.begin(), prefetchTiles.end());
+
+    if (!m_pendingTiles.empty() && !m_tileRenderTimer.isActive()) {
+        m_tileRenderTimer.start();
+    }
+}
+
+QImage AbstractNotationPaintView::renderTile(const Page* page, const NotationTileCache::TileKey& key) const
+{
+    TRACEFUNC;
+
+    const qreal borderWidth = configuration()->borderWidth();
+    const RectF pageRect = page->canvasBoundingRect().adjusted(-borderWidth, -borderWidth, borderWidth, borderWidth);
+    const RectF tileRect = NotationTileCache::tileRect(key, m_tileScaling).translated(pageRect.topLeft());
+    const RectF paintRect = tileRect.intersected(pageRect);
+
+    const int size = static_cast<int>(std::lrint(NotationTileCache::TILE_SIZE * m_tileDevicePixelRatio));
+    QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(m_tileDevicePixelRatio);
+    image.fill(Qt::transparent);
+
+    Transform transform;
+    transform.scale(m_tileScaling, m_tileScaling);
+    transform.translate(-tileRect.left(), -tileRect.top());
+
+    Painter painter(&image, "notationtile");
+    painter.setWorldTransform(transform);
+    painter.setClipRect(paintRect);
+
+    notation()->painting()->paintViewContent(&painter, paintRect, m_tileIsPrinting);
+
+    painter.endDraw();
+
+    return image;
+}
+
+void AbstractNotationPaintView::renderPendingTiles()
+{
+    TRACEFUNC;
+
+    if (!notation() || !isTileCacheUsable()) {
+        m_pendingTiles.clear();
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    const PageList pages = notationElements()->pages();
+    const int64_t scalingKey = NotationTileCache::scalingKey(m_tileScaling);
+
+    size_t rendered = 0;
+    for (; rendered < m_pendingTiles.size(); ++rendered) {
+        if (std::chrono::steady_clock::now() - start >= TILE_RENDER_SLICE) {
+            break;
+        }
+
+        const NotationTileCache::TileKey& key = m_pendingTiles.at(rendered);
+        if (key.scaling != scalingKey || key.pageIndex >= pages.size() || m_tileCache.contains(key)) {
+            continue;
+        }
+
+        m_tileCache.insert(key, renderTile(pages.at(key.pageIndex), key));
+    }
+
+    m_pendingTiles.erase(m_pendingTiles.begin(), m_pendingTiles.begin() + rendered);
+
+    if (!m_pendingTiles.empty()) {
+        m_tileRenderTimer.start();
+    }
+}
+
+void AbstractNotationPaintView::clearTileCache()
+{
+    m_tileCache.clear();
+    m_pendingTiles.clear();
+    m_tileRenderTimer.stop();
+}
+
+void AbstractNotationPaintView::invalidateTiles(const ChangesRange& range)
+{
+    m_tileChangesReceived = true;
+
+    //! NOTE The style changes may affect every page, the pages moved by the relayout are dropped by NotationTileCache::update
+    if (!range.isValidBoundary() || !range.changedStyleIdSet.empty()) {
+        clearTileCache();
+        return;
+    }
+
+    m_tileCache.invalidateTicks(range.tickFrom, range.tickTo);
+}
+
+void AbstractNotationPaintView::invalidateSelectionTiles()
+{
+    //! NOTE The selected items are painted in the selection color, so the pages of the previous and current selection are repainted
+    std::set<size_t> selectionPages;
+    bool isKnown = true;
+
+    const PageList pages = notationElements()->pages();
+    auto addPage = [&](const EngravingItem* item) {
+        const EngravingItem* page = item ? item->findAncestor(ElementType::PAGE) : nullptr;
+        auto it = page ? std::find(pages.begin(), pages.end(), page) : pages.end();
+        if (it == pages.end()) {
+            isKnown = false;
+            return;
+        }
+
+        selectionPages.insert(static_cast<size_t>(std::distance(pages.begin(), it)));
+    };
+
+    for (const EngravingItem* item : notationSelection()->elements()) {
+        if (item->isSpanner()) {
+            for (const engraving::SpannerSegment* segment : engraving::toSpanner(item)->spannerSegments()) {
+                addPage(segment);
+            }
+        } else {
+            addPage(item);
+        }
+    }
+
+    if (!isKnown) {
+        clearTileCache();
+    } else {
+        for (size_t pageIndex : m_selectionPages) {
+            m_tileCache.invalidatePage(pageIndex);
+        }
+
+        for (size_t pageIndex : selectionPages) {
+            m_tileCache.invalidatePage(pageIndex);
+        }
+    }
+
+    m_selectionPages = std::move(selectionPages);
+}
+
 void AbstractNotationPaintView::onNotationSetup()
 {
     TRACEFUNC;
@@ -676,14 +930,17 @@ void AbstractNotationPaintView::onNotationSetup()
     });
 
     configuration()->foregroundChanged().onNotify(this, [this]() {
+        clearTileCache();
         scheduleRedraw();
     });
 
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
+        clearTileCache();
         scheduleRedraw();
     });
 
     engravingConfiguration()->debuggingOptionsChanged().onNotify(this, [this]() {
+        clearTileCache();
         scheduleRedraw();
     });
 }
@@ -1292,6 +1549,8 @@ void AbstractNotationPaintView::dropEvent(QDropEvent* event)
 
 void AbstractNotationPaintView::setNotation(INotationPtr notation)
 {
+    clearTileCache();
+
     m_notation = notation;
     m_continuousPanel->setNotation(m_notation);
     m_playbackCursor->setNotation(m_notation);
@@ -22,6 +22,8 @@
 #ifndef MU_NOTATION_ABSTRACTNOTATIONPAINTVIEW_H
 #define MU_NOTATION_ABSTRACTNOTATIONPAINTVIEW_H
 
+#include <set>
+
 #include <QTimer>
 
 #include "modularity/ioc.h"
@@ -46,6 +48,7 @@
 #include "playbackcursor.h"
 #include "loopmarker.h"
 #include "continuouspanel.h"
+#include "notationtilecache.h"
 #include "abstractelementpopupmodel.h"
 
 namespace mu::notation {
@@ -260,6 +263,15 @@ private:
 
     void paintBackground(const muse::RectF& rect, muse::draw::Painter* painter);
 
+    // Tile cache
+    bool isTileCacheUsable() const;
+    void paintScoreTiles(QPainter* qp, muse::draw::Painter* painter, const muse::RectF& rect, qreal guiScaling, bool isPrinting);
+    QImage renderTile(const Page* page, const NotationTileCache::TileKey& key) const;
+    void renderPendingTiles();
+    void clearTileCache();
+    void invalidateTiles(const ChangesRange& range);
+    void invalidateSelectionTiles();
+
     muse::PointF canvasCenter() const;
     std::pair<qreal, qreal> constraintCanvas(qreal dx, qreal dy) const;
 
@@ -291,6 +303,15 @@ private:
     muse::RectF m_shadowNoteRect;
 
     QQuickItem* m_playbackCursorItem = nullptr;
+
+    NotationTileCache m_tileCache;
+    std::vector<NotationTileCache::TileKey> m_pendingTiles;
+    QTimer m_tileRenderTimer;
+    qreal m_tileScaling = 1.0;
+    qreal m_tileDevicePixelRatio = 1.0;
+    bool m_tileIsPrinting = false;
+    bool m_tileChangesReceived = false;
+    std::set<size_t> m_selectionPages;
 };
 }
 
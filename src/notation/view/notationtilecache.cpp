@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "notationtilecache.h"
+
+#include <cmath>
+
+#include "realfn.h"
+
+#include "engraving/dom/measurebase.h"
+#include "engraving/dom/page.h"
+#include "engraving/dom/system.h"
+
+using namespace muse;
+using namespace mu::notation;
+
+NotationTileCache::NotationTileCache(size_t maxByteSize)
+    : m_maxByteSize(maxByteSize)
+{
+}
+
+int64_t NotationTileCache::scalingKey(double scaling)
+{
+    return std::llround(scaling * 1e6);
+}
+
+RectF NotationTileCache::tileRect(const TileKey& key, double scaling)
+{
+    const double size = TILE_SIZE / scaling;
+    return RectF(key.column * size, key.row * size, size, size);
+}
+
+size_t NotationTileCache::TileKeyHash::operator()(const TileKey& key) const
+{
+    size_t h = std::hash<size_t>()(key.pageIndex);
+    h = h * 31 + std::hash<int64_t>()(key.scaling);
+    h = h * 31 + std::hash<int>()(key.column);
+    h = h * 31 + std::hash<int>()(key.row);
+    return h;
+}
+
+NotationTileCache::PageState NotationTileCache::pageState(const Page* page)
+{
+    PageState state;
+    state.rect = page->canvasBoundingRect();
+    state.systemCount = page->systems().size();
+
+    if (!page->systems().empty() && !page->systems().front()->measures().empty()) {
+        state.startTick = page->systems().front()->first()->tick().ticks();
+        state.endTick = page->endTick().ticks();
+    }
+
+    return state;
+}
+
+void NotationTileCache::update(const std::vector<const Page*>& pages, double devicePixelRatio, bool isPrinting)
+{
+    if (!RealIsEqual(m_devicePixelRatio, devicePixelRatio) || m_isPrinting != isPrinting) {
+        clear();
+        m_devicePixelRatio = devicePixelRatio;
+        m_isPrinting = isPrinting;
+    }
+
+    //! NOTE The header and footer may show the page count
+    if (pages.size() != m_pages.size()) {
+        clear();
+    }
+
+    m_pages.resize(pages.size());
+
+    for (size_t i = 0; i < pages.size(); ++i) {
+        PageState state = pageState(pages.at(i));
+        if (state == m_pages.at(i)) {
+            continue;
+        }
+
+        invalidatePage(i);
+        m_pages[i] = state;
+    }
+}
+
+const QImage* NotationTileCache::tile(const TileKey& key)
+{
+    auto it = m_tiles.find(key);
+    if (it == m_tiles.end()) {
+        return nullptr;
+    }
+
+    it->second.lastUsed = ++m_usage;
+    return &it->second.image;
+}
+
+bool NotationTileCache::contains(const TileKey& key) const
+{
+    return m_tiles.find(key) != m_tiles.end();
+}
+
+void NotationTileCache::insert(const TileKey& key, QImage image)
+{
+    auto it = m_tiles.find(key);
+    if (it != m_tiles.end()) {
+        m_byteSize -= it->second.image.sizeInBytes();
+        m_tiles.erase(it);
+    }
+
+    m_byteSize += image.sizeInBytes();
+    m_tiles.emplace(key, Tile { std::move(image), ++m_usage });
+
+    evict();
+}
+
+void NotationTileCache::invalidatePage(size_t pageIndex)
+{
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        if (it->first.pageIndex == pageIndex) {
+            m_byteSize -= it->second.image.sizeInBytes();
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NotationTileCache::invalidateTicks(int tickFrom, int tickTo)
+{
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        const PageState& page = m_pages.at(i);
+        if (page.startTick <= tickTo && tickFrom <= page.endTick) {
+            invalidatePage(i);
+        }
+    }
+}
+
+void NotationTileCache::clear()
+{
+    m_tiles.clear();
+    m_pages.clear();
+    m_byteSize = 0;
+}
+
+void NotationTileCache::evict()
+{
+    while (m_byteSize > m_maxByteSize && !m_tiles.empty()) {
+        auto oldest = m_tiles.begin();
+        for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+            if (it->second.lastUsed < oldest->second.lastUsed) {
+                oldest = it;
+            }
+        }
+
+        m_byteSize -= oldest->second.image.sizeInBytes();
+        m_tiles.erase(oldest);
+    }
+}
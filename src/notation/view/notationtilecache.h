@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <QImage>
+
+#include "draw/types/geometry.h"
+
+#include "notation/notationtypes.h"
+
+namespace mu::notation {
+//! NOTE Raster cache of the notation canvas.
+//! The pages are cut into square tiles of a fixed size in device independent pixels, at the current zoom.
+//! The tiles hold the score only: the overlays (selection, cursors, loop markers...) are painted over them on every frame.
+class NotationTileCache
+{
+public:
+    static constexpr int TILE_SIZE = 256;
+
+    //! NOTE About 16 screens of tiles at device pixel ratio 1, 4 at ratio 2
+    static constexpr size_t DEFAULT_MAX_BYTE_SIZE = 128 * 1024 * 1024;
+
+    struct TileKey {
+        size_t pageIndex = 0;
+        int64_t scaling = 0;
+        int column = 0;
+        int row = 0;
+
+        bool operator==(const TileKey& other) const
+        {
+            return pageIndex == other.pageIndex && scaling == other.scaling && column == other.column && row == other.row;
+        }
+    };
+
+    explicit NotationTileCache(size_t maxByteSize = DEFAULT_MAX_BYTE_SIZE);
+
+    static int64_t scalingKey(double scaling);
+
+    //! NOTE Rect of the tile in page coordinates, may exceed the page
+    static muse::RectF tileRect(const TileKey& key, double scaling);
+
+    //! NOTE Drops the tiles rendered with other parameters, or of the pages whose layout has changed
+    void update(const std::vector<const Page*>& pages, double devicePixelRatio, bool isPrinting);
+
+    //! NOTE Returns nullptr if the tile is not cached
+    const QImage* tile(const TileKey& key);
+    bool contains(const TileKey& key) const;
+    void insert(const TileKey& key, QImage image);
+
+    void invalidatePage(size_t pageIndex);
+    void invalidateTicks(int tickFrom, int tickTo);
+    void clear();
+
+private:
+    struct TileKeyHash {
+        size_t operator()(const TileKey& key) const;
+    };
+
+    struct Tile {
+        QImage image;
+        uint64_t lastUsed = 0;
+    };
+
+    struct PageState {
+        muse::RectF rect;
+        int startTick = -1;
+        int endTick = -1;
+        size_t systemCount = 0;
+
+        bool operator==(const PageState& other) const
+        {
+            return rect == other.rect && startTick == other.startTick && endTick == other.endTick && systemCount == other.systemCount;
+        }
+    };
+
+    static PageState pageState(const Page* page);
+
+    void evict();
+
+    std::unordered_map<TileKey, Tile, TileKeyHash> m_tiles;
+    std::vector<PageState> m_pages;
+
+    double m_devicePixelRatio = 0.0;
+    bool m_isPrinting = false;
+
+    size_t m_maxByteSize = 0;
+    size_t m_byteSize = 0;
+    uint64_t m_usage = 0;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
@@ -22,10 +22,12 @@
 #ifndef MU_PROJECT_INOTATIONPROJECT_H
 #define MU_PROJECT_INOTATIONPROJECT_H
 
+#include <functional>
 #include <memory>
 
 #include "io/path.h"
 #include "types/ret.h"
+#include "types/retval.h"
 
 #include "iprojectaudiosettings.h"
 #include "notation/imasternotation.h"
@@ -73,6 +75,11 @@ public:
         const muse::io::path_t& path = muse::io::path_t(), SaveMode saveMode = SaveMode::Save, bool createBackup = true) = 0;
     virtual muse::Ret writeToDevice(QIODevice* device) = 0;
 
+    //! NOTE Autosave in two steps: the project is serialized in memory by makeAutoSaveJob (on the main thread),
+    //! then the returned job compresses and writes it to the path, without touching the score, so on any thread
+    using AutoSaveJob = std::function<muse::Ret()>;
+    virtual muse::RetVal<AutoSaveJob> makeAutoSaveJob(const muse::io::path_t& path) = 0;
+
     virtual ProjectMeta metaInfo() const = 0;
     virtual void setMetaInfo(const ProjectMeta& meta, bool undoable = false) = 0;
 
@@ -36,6 +36,7 @@
 #include "engraving/engravingproject.h"
 #include "engraving/compat/engravingcompat.h"
 #include "engraving/infrastructure/mscio.h"
+#include "engraving/rw/mscsaver.h"
 #include "engraving/engravingerrors.h"
 
 #include "iprojectautosaver.h"
@@ -76,6 +77,21 @@ static void setupScoreMetaTags(mu::engraving::MasterScore* masterScore, const Pr
     }
 }
 
+static std::string autoSaveSuffix(const muse::io::path_t& path)
+{
+    std::string suffix = io::suffix(path);
+    if (suffix == IProjectAutoSaver::AUTOSAVE_SUFFIX) {
+        suffix = io::suffix(io::completeBasename(path));
+    }
+
+    if (suffix.empty()) {
+        // Then it must be a MSCX folder
+        suffix = engraving::MSCX;
+    }
+
+    return suffix;
+}
+
 static QString scoreDefaultTitle()
 {
     return muse::qtrc("project", "Untitled score");
@@ -494,17 +510,7 @@ Ret NotationProject::save(const muse::io::path_t& path, SaveMode saveMode, bool
         return ret;
     }
     case SaveMode::AutoSave:
-        std::string suffix = io::suffix(path);
-        if (suffix == IProjectAutoSaver::AUTOSAVE_SUFFIX) {
-            suffix = io::suffix(io::completeBasename(path));
-        }
-
-        if (suffix.empty()) {
-            // Then it must be a MSCX folder
-            suffix = engraving::MSCX;
-        }
-
-        return saveScore(path, suffix, false /*generateBackup*/, false /*createThumbnail*/, true /*isAutosave*/);
+        return saveScore(path, autoSaveSuffix(path), false /*generateBackup*/, false /*createThumbnail*/, true /*isAutosave*/);
     }
 
     return make_ret(notation::Err::UnknownError);
@@ -550,6 +556,53 @@ Ret NotationProject::writeToDevice(QIODevice* device)
     return ret;
 }
 
+RetVal<INotationProject::AutoSaveJob> NotationProject::makeAutoSaveJob(const muse::io::path_t& path)
+{
+    TRACEFUNC;
+
+    const std::string suffix = autoSaveSuffix(path);
+
+    //! NOTE The exported formats are written at once
+    if (!isMuseScoreFile(suffix)) {
+        Ret ret = saveScore(path, suffix, false /*generateBackup*/, false /*createThumbnail*/, true /*isAutosave*/);
+        if (!ret) {
+            return RetVal<AutoSaveJob>(ret);
+        }
+
+        return RetVal<AutoSaveJob>::make_ok([]() { return make_ok(); });
+    }
+
+    const MscIoMode ioMode = mscIoModeBySuffix(suffix);
+
+    if (!m_autoSaveExcerptsCache) {
+        m_autoSaveExcerptsCache = std::make_unique<engraving::MscExcerptsCache>();
+    }
+
+    auto snapshot = std::make_shared<MscWriter::Snapshot>();
+
+    MscWriter::Params params;
+    params.filePath = engraving::containerPath(path);
+    params.mainFileName = engraving::mainFileName(path).toString();
+    params.mode = ioMode;
+    params.snapshot = snapshot.get();
+
+    MscWriter snapshotWriter(params);
+    Ret ret = writeProject(snapshotWriter, false /*onlySelection*/, false /*createThumbnail*/, m_autoSaveExcerptsCache.get());
+    snapshotWriter.close();
+
+    if (!ret) {
+        LOGE() << "failed write project snapshot: " << ret.toString();
+        return RetVal<AutoSaveJob>(ret);
+    }
+
+    //! NOTE The project is kept alive by the caller until the job is done
+    AutoSaveJob job = [this, path, ioMode, snapshot]() {
+        return doSave(path, ioMode, false /*generateBackup*/, false /*createThumbnail*/, true /*isAutosave*/, snapshot.get());
+    };
+
+    return RetVal<AutoSaveJob>::make_ok(job);
+}
+
 Ret NotationProject::saveScore(const muse::io::path_t& path, const std::string& fileSuffix,
                                bool generateBackup, bool createThumbnail, bool isAutosave)
 {
@@ -563,7 +616,7 @@ Ret NotationProject::saveScore(const muse::io::path_t& path, const std::string&
 }
 
 Ret NotationProject::doSave(const muse::io::path_t& path, engraving::MscIoMode ioMode,
-                            bool generateBackup, bool createThumbnail, bool isAutosave)
+                            bool generateBackup, bool createThumbnail, bool isAutosave, const MscWriter::Snapshot* snapshot)
 {
     TRACEFUNC;
 
@@ -607,7 +660,15 @@ Ret NotationProject::doSave(const muse::io::path_t& path, engraving::MscIoMode i
         }
 
         MscWriter msczWriter(params);
-        Ret ret = writeProject(msczWriter, false /*onlySelection*/, createThumbnail);
+        Ret ret = muse::make_ok();
+        if (snapshot) {
+            ret = msczWriter.open();
+            if (ret && !msczWriter.writeSnapshot(*snapshot)) {
+                ret = make_ret(Ret::Code::UnknownError);
+            }
+        } else {
+            ret = writeProject(msczWriter, false /*onlySelection*/, createThumbnail);
+        }
         msczWriter.close();
         if (params.device) {
             delete params.device;
@@ -730,7 +791,8 @@ Ret NotationProject::makeBackup(muse::io::path_t filePath)
     return ret;
 }
 
-Ret NotationProject::writeProject(MscWriter& msczWriter, bool onlySelection, bool createThumbnail)
+Ret NotationProject::writeProject(MscWriter& msczWriter, bool onlySelection, bool createThumbnail,
+                                  engraving::MscExcerptsCache* excerptsCache)
 {
     TRACEFUNC;
 
@@ -742,7 +804,7 @@ Ret NotationProject::writeProject(MscWriter& msczWriter, bool onlySelection, boo
     }
 
     // Write engraving project
-    ret = m_engravingProject->writeMscz(msczWriter, onlySelection, createThumbnail);
+    ret = m_engravingProject->writeMscz(msczWriter, onlySelection, createThumbnail, excerptsCache);
     if (!ret) {
         LOGE() << "failed write engraving project to mscz: " << ret.toString();
         return make_ret(notation::Err::UnknownError);
@@ -896,12 +958,21 @@ bool NotationProject::isImported() const
 
 void NotationProject::markAsUnsaved()
 {
+    //! NOTE The changes outside of the undo stack don't tell which excerpts they affect
+    if (m_autoSaveExcerptsCache) {
+        m_autoSaveExcerptsCache->clear();
+    }
+
     setNeedSave(true);
 }
 
 void NotationProject::listenIfNeedSaveChanges()
 {
-    m_masterNotation->notation()->undoStack()->changesChannel().onReceive(this, [this](const ScoreChangesRange&) {
+    m_masterNotation->notation()->undoStack()->changesChannel().onReceive(this, [this](const ScoreChangesRange& range) {
+        if (m_autoSaveExcerptsCache) {
+            m_autoSaveExcerptsCache->invalidate(range);
+        }
+
         bool isStackClean = m_masterNotation && m_masterNotation->notation()->undoStack()->isStackClean();
 
         if (isStackClean && !m_hasNonUndoStackChanges) {
@@ -930,6 +1001,10 @@ void NotationProject::listenIfNeedSaveChanges()
     }
 
     m_masterNotation->excerptsChanged().onNotify(this, [this, listenNonUndoStackChanges]() {
+        if (m_autoSaveExcerptsCache) {
+            m_autoSaveExcerptsCache->clear();
+        }
+
         for (const IExcerptNotationPtr& excerpt : m_masterNotation->excerpts()) {
             listenNonUndoStackChanges(excerpt->notation());
         }
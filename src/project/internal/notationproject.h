@@ -44,6 +44,7 @@
 namespace mu::engraving {
 class MscReader;
 class MscWriter;
+struct MscExcerptsCache;
 }
 
 namespace mu::project {
@@ -98,6 +99,8 @@ public:
         const muse::io::path_t& path = muse::io::path_t(), SaveMode saveMode = SaveMode::Save, bool createBackup = true) override;
     muse::Ret writeToDevice(QIODevice* device) override;
 
+    muse::RetVal<AutoSaveJob> makeAutoSaveJob(const muse::io::path_t& path) override;
+
     ProjectMeta metaInfo() const override;
     void setMetaInfo(const ProjectMeta& meta, bool undoable = false) override;
 
@@ -117,9 +120,10 @@ private:
     muse::Ret saveSelectionOnScore(const muse::io::path_t& path = muse::io::path_t());
     muse::Ret exportProject(const muse::io::path_t& path, const std::string& suffix);
     muse::Ret doSave(const muse::io::path_t& path, engraving::MscIoMode ioMode, bool generateBackup = true, bool createThumbnail = true,
-                     bool isAutosave = false);
+                     bool isAutosave = false, const engraving::MscWriter::Snapshot* snapshot = nullptr);
     muse::Ret makeBackup(muse::io::path_t filePath);
-    muse::Ret writeProject(engraving::MscWriter& msczWriter, bool onlySelection, bool createThumbnail = true);
+    muse::Ret writeProject(engraving::MscWriter& msczWriter, bool onlySelection, bool createThumbnail = true,
+                           engraving::MscExcerptsCache* excerptsCache = nullptr);
     muse::Ret checkSavedFileForCorruption(engraving::MscIoMode ioMode, const muse::io::path_t& path, const muse::io::path_t& scoreFileName);
 
     void listenIfNeedSaveChanges();
@@ -142,6 +146,9 @@ private:
     bool m_isImported = false;
     bool m_needAutoSave = false;
     bool m_hasNonUndoStackChanges = false;
+
+    //! NOTE The excerpts serialized by the last autosave, the changed ones are dropped
+    std::unique_ptr<engraving::MscExcerptsCache> m_autoSaveExcerptsCache;
 };
 }
 
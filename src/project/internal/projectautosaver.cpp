@@ -21,9 +21,13 @@
  */
 #include "projectautosaver.h"
 
+#include <chrono>
+
+#include "async/async.h"
 #include "engraving/infrastructure/mscio.h"
 
 #include "defer.h"
+#include "runtime.h"
 #include "log.h"
 
 using namespace muse;
@@ -167,16 +171,67 @@ void ProjectAutoSaver::onTrySave()
         return;
     }
 
+    if (m_isSaving) {
+        LOGD() << "[autosave] the previous autosave is still being written";
+        return;
+    }
+
     muse::io::path_t projectPath = this->projectPath(project);
     muse::io::path_t savePath = project->isNewlyCreated() ? projectPath : projectAutoSavePath(projectPath);
 
-    Ret ret = project->save(savePath, SaveMode::AutoSave);
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point snapshotStart = Clock::now();
+
+    RetVal<INotationProject::AutoSaveJob> job = project->makeAutoSaveJob(savePath);
+    if (!job.ret) {
+        LOGE() << "[autosave] failed to save project, err: " << job.ret.toString();
+        return;
+    }
+
+    const Clock::duration snapshotTime = Clock::now() - snapshotStart;
+
+    //! NOTE The changes made from now on are not in the snapshot
+    project->setNeedAutoSave(false);
+
+    if (!m_saveThread) {
+        m_saveThread = std::make_unique<TaskScheduler>(1);
+    }
+
+    m_isSaving = true;
+
+    m_saveThread->submit([this, project, projectPath, job = job.val, snapshotTime]() {
+        const Clock::time_point writeStart = Clock::now();
+        Ret ret = job();
+        const Clock::duration writeTime = Clock::now() - writeStart;
+
+        //! NOTE The durations go to the log, collected by the diagnostic files
+        using std::chrono::duration_cast;
+        using std::chrono::milliseconds;
+        LOGI() << "[autosave] snapshot: " << duration_cast<milliseconds>(snapshotTime).count() << " ms (main thread)"
+               << ", write: " << duration_cast<milliseconds>(writeTime).count() << " ms";
+
+        async::Async::call(this, [this, project, projectPath, ret]() {
+            onSaveFinished(project, projectPath, ret);
+        }, runtime::mainThreadId());
+    });
+}
+
+void ProjectAutoSaver::onSaveFinished(INotationProjectPtr project, const muse::io::path_t& projectPath, const Ret& ret)
+{
+    m_isSaving = false;
+
     if (!ret) {
         LOGE() << "[autosave] failed to save project, err: " << ret.toString();
+        project->setNeedAutoSave(true);
         return;
     }
 
-    project->setNeedAutoSave(false);
+    //! NOTE The project may have been saved or closed while the autosave was written,
+    //! then its unsaved changes were removed before the autosave file was there
+    if (project != currentProject() || !project->needSave().val) {
+        removeProjectUnsavedChanges(projectPath);
+        return;
+    }
 
     LOGD() << "[autosave] successfully saved project";
 }
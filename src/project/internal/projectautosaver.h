@@ -22,6 +22,8 @@
 #ifndef MU_PROJECT_PROJECTAUTOSAVER_H
 #define MU_PROJECT_PROJECTAUTOSAVER_H
 
+#include <memory>
+
 #include <QTimer>
 
 #include "async/asyncable.h"
@@ -29,6 +31,7 @@
 #include "modularity/ioc.h"
 #include "context/iglobalcontext.h"
 #include "io/ifilesystem.h"
+#include "concurrency/taskscheduler.h"
 #include "iprojectconfiguration.h"
 
 #include "../iprojectautosaver.h"
@@ -59,11 +62,16 @@ private:
     void update();
 
     void onTrySave();
+    void onSaveFinished(INotationProjectPtr project, const muse::io::path_t& projectPath, const muse::Ret& ret);
 
     muse::io::path_t projectPath(INotationProjectPtr project) const;
 
     QTimer m_timer;
     muse::io::path_t m_lastProjectPathNeedingAutosave;
+
+    //! NOTE The snapshot of the project is made on the main thread, then written on this one
+    std::unique_ptr<muse::TaskScheduler> m_saveThread;
+    bool m_isSaving = false;
 };
 }
 